@@ -0,0 +1,24 @@
+set(NENOSERPENT_CATALOG_GENERATOR "${CMAKE_CURRENT_LIST_DIR}/generate_catalog.cmake")
+
+# Compiles a built-in JSON catalog into a header of constexpr tables for `target_name`.
+# OUTPUT is the include path of the header, relative to the target's generated include dir.
+function(nenoserpent_add_catalog target_name)
+    cmake_parse_arguments(ARG "" "KIND;INPUT;OUTPUT" "" ${ARGN})
+
+    set(input "${CMAKE_CURRENT_SOURCE_DIR}/${ARG_INPUT}")
+    set(include_dir "${CMAKE_CURRENT_BINARY_DIR}/generated")
+    set(output "${include_dir}/${ARG_OUTPUT}")
+    add_custom_command(
+        OUTPUT "${output}"
+        COMMAND "${CMAKE_COMMAND}"
+            "-DKIND=${ARG_KIND}"
+            "-DINPUT=${input}"
+            "-DOUTPUT=${output}"
+            -P "${NENOSERPENT_CATALOG_GENERATOR}"
+        DEPENDS "${input}" "${NENOSERPENT_CATALOG_GENERATOR}"
+        COMMENT "Generating ${ARG_OUTPUT} from ${ARG_INPUT}"
+        VERBATIM
+    )
+    target_sources("${target_name}" PRIVATE "${output}")
+    target_include_directories("${target_name}" PRIVATE "${include_dir}")
+endfunction()
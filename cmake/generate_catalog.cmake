@@ -0,0 +1,385 @@
+# Script mode: cmake -DKIND=<levels|score|strategy> -DINPUT=<json> -DOUTPUT=<header> -P this file.
+# Writes a header of constexpr tables for one built-in JSON catalog. The output is only replaced
+# when its content changes, so touching the JSON without editing it does not rebuild dependents.
+
+cmake_minimum_required(VERSION 3.21)
+
+foreach(required IN ITEMS KIND INPUT OUTPUT)
+    if(NOT DEFINED ${required})
+        message(FATAL_ERROR "generate_catalog.cmake: ${required} is not set")
+    endif()
+endforeach()
+
+file(READ "${INPUT}" catalog_json)
+get_filename_component(catalog_name "${INPUT}" NAME)
+
+function(catalog_fail message)
+    message(FATAL_ERROR "${catalog_name}: ${message}")
+endfunction()
+
+# Reads an optional member; `out` is left empty when it is missing.
+function(catalog_get out)
+    string(JSON value ERROR_VARIABLE error GET "${catalog_json}" ${ARGN})
+    if(error)
+        set(value "")
+    endif()
+    set(${out} "${value}" PARENT_SCOPE)
+endfunction()
+
+function(catalog_type out)
+    string(JSON value ERROR_VARIABLE error TYPE "${catalog_json}" ${ARGN})
+    if(error)
+        set(value "MISSING")
+    endif()
+    set(${out} "${value}" PARENT_SCOPE)
+endfunction()
+
+function(catalog_length out)
+    catalog_type(type ${ARGN})
+    if(type STREQUAL "ARRAY" OR type STREQUAL "OBJECT")
+        string(JSON value LENGTH "${catalog_json}" ${ARGN})
+    else()
+        set(value 0)
+    endif()
+    set(${out} "${value}" PARENT_SCOPE)
+endfunction()
+
+# Reads an integer member, or `fallback` when it is missing. Anything else fails the build.
+function(catalog_int out fallback)
+    catalog_type(type ${ARGN})
+    if(type STREQUAL "MISSING" OR type STREQUAL "NULL")
+        set(${out} "${fallback}" PARENT_SCOPE)
+        return()
+    endif()
+    catalog_get(value ${ARGN})
+    if(NOT type STREQUAL "NUMBER" OR NOT value MATCHES "^-?[0-9]+$")
+        string(JOIN "." path ${ARGN})
+        catalog_fail("${path} must be an integer, got '${value}'")
+    endif()
+    set(${out} "${value}" PARENT_SCOPE)
+endfunction()
+
+# "menu_emerald_dawn" -> "MenuEmeraldDawn".
+function(catalog_identifier out key)
+    string(REPLACE "_" ";" words "${key}")
+    set(identifier "")
+    foreach(word IN LISTS words)
+        string(SUBSTRING "${word}" 0 1 head)
+        string(SUBSTRING "${word}" 1 -1 tail)
+        string(TOUPPER "${head}" head)
+        string(APPEND identifier "${head}${tail}")
+    endforeach()
+    set(${out} "${identifier}" PARENT_SCOPE)
+endfunction()
+
+function(catalog_string_literal out value)
+    if(value MATCHES "\\)catalog\"")
+        catalog_fail("strings may not contain ')catalog\"'")
+    endif()
+    set(${out} "QStringView(uR\"catalog(${value})catalog\")" PARENT_SCOPE)
+endfunction()
+
+# `{QPoint(x, y), ...}` of a JSON array of {"x", "y"} objects.
+function(catalog_points out)
+    catalog_length(count ${ARGN})
+    set(points "")
+    if(count GREATER 0)
+        math(EXPR last "${count} - 1")
+        foreach(index RANGE ${last})
+            catalog_int(x 0 ${ARGN} ${index} x)
+            catalog_int(y 0 ${ARGN} ${index} y)
+            list(APPEND points "QPoint(${x}, ${y})")
+        endforeach()
+    endif()
+    list(JOIN points ", " joined)
+    set(${out} "${joined}" PARENT_SCOPE)
+    set(${out}_COUNT "${count}" PARENT_SCOPE)
+endfunction()
+
+set(body "")
+
+if(KIND STREQUAL "levels")
+    set(header_includes "#include \"core/level/catalog.h\"")
+    set(namespace "nenoserpent::core::generated")
+    catalog_length(level_count levels)
+    if(level_count EQUAL 0)
+        catalog_fail("needs at least one level")
+    endif()
+    # Scripts hold semicolons, so level entries are joined by hand rather than as a CMake list.
+    set(levels "")
+    math(EXPR last_level "${level_count} - 1")
+    foreach(level RANGE ${last_level})
+        catalog_get(name levels ${level} name)
+        catalog_get(script levels ${level} script)
+        catalog_int(period_ticks 0 levels ${level} periodTicks)
+        catalog_string_literal(name_literal "${name}")
+        catalog_string_literal(script_literal "${script}")
+
+        # Same reading rules as resolvedLevelDataFromJson(): walls only without a script, and an
+        # animation only when it has both phases and groups.
+        set(walls "")
+        set(walls_COUNT 0)
+        if(script STREQUAL "")
+            catalog_points(walls levels ${level} walls)
+        endif()
+        string(APPEND body "inline constexpr std::array<QPoint, ${walls_COUNT}> Level${level}Walls{"
+                           "{${walls}}};\n")
+
+        catalog_length(phase_count levels ${level} animation phases)
+        catalog_length(group_count levels ${level} animation groups)
+        if(phase_count EQUAL 0 OR group_count EQUAL 0)
+            set(phase_count 0)
+            set(group_count 0)
+        endif()
+        catalog_int(phase_ticks 1 levels ${level} animation phaseTicks)
+        set(phases "")
+        set(groups "")
+        if(phase_count GREATER 0)
+            math(EXPR last_phase "${phase_count} - 1")
+            foreach(phase RANGE ${last_phase})
+                catalog_int(value 0 levels ${level} animation phases ${phase})
+                list(APPEND phases "${value}")
+            endforeach()
+            math(EXPR last_group "${group_count} - 1")
+            foreach(group RANGE ${last_group})
+                catalog_points(group_walls levels ${level} animation groups ${group} walls)
+                catalog_int(step_x 0 levels ${level} animation groups ${group} step x)
+                catalog_int(step_y 0 levels ${level} animation groups ${group} step y)
+                string(APPEND body
+                       "inline constexpr std::array<QPoint, ${group_walls_COUNT}> "
+                       "Level${level}Group${group}Walls{{${group_walls}}};\n")
+                set(group_name "Level${level}Group${group}Walls")
+                list(APPEND groups "{.walls = ${group_name}, .step = QPoint(${step_x}, ${step_y})}")
+            endforeach()
+        endif()
+        list(JOIN phases ", " phases)
+        list(JOIN groups ",\n  " groups)
+        string(APPEND body
+               "inline constexpr std::array<int, ${phase_count}> "
+               "Level${level}Phases{{${phases}}};\n"
+               "inline constexpr std::array<CatalogWallGroup, ${group_count}> "
+               "Level${level}Groups{{\n  ${groups}}};\n\n")
+        if(NOT levels STREQUAL "")
+            string(APPEND levels ",\n  ")
+        endif()
+        string(APPEND levels
+               "{.name = ${name_literal},\n"
+               "   .script = ${script_literal},\n"
+               "   .periodTicks = ${period_ticks},\n"
+               "   .walls = Level${level}Walls,\n"
+               "   .phaseTicks = ${phase_ticks},\n"
+               "   .phases = Level${level}Phases,\n"
+               "   .groups = Level${level}Groups}")
+    endforeach()
+    string(APPEND body
+           "inline constexpr std::array<CatalogLevel, ${level_count}> Levels{{\n  ${levels}}};\n")
+
+elseif(KIND STREQUAL "score")
+    set(header_includes "#include \"audio/score.h\"")
+    set(namespace "nenoserpent::audio::generated")
+    set(duty_narrow "PulseDuty::Narrow")
+    set(duty_quarter "PulseDuty::Quarter")
+    set(duty_half "PulseDuty::Half")
+    set(duty_wide "PulseDuty::Wide")
+
+    catalog_length(cue_count cues)
+    set(cue_entries "")
+    if(cue_count GREATER 0)
+        math(EXPR last_cue "${cue_count} - 1")
+        foreach(cue RANGE ${last_cue})
+            string(JSON key MEMBER "${catalog_json}" cues ${cue})
+            catalog_identifier(id "${key}")
+            catalog_length(step_count cues "${key}")
+            set(steps "")
+            if(step_count GREATER 0)
+                math(EXPR last_step "${step_count} - 1")
+                foreach(step RANGE ${last_step})
+                    catalog_int(frequency 0 cues "${key}" ${step} frequencyHz)
+                    catalog_int(duration 0 cues "${key}" ${step} durationMs)
+                    catalog_int(amplitude 32 cues "${key}" ${step} amplitude)
+                    catalog_type(duty_type cues "${key}" ${step} duty)
+                    set(duty 0.5)
+                    if(duty_type STREQUAL "NUMBER")
+                        catalog_get(duty cues "${key}" ${step} duty)
+                    endif()
+                    list(APPEND steps "{.frequencyHz = ${frequency}, .durationMs = ${duration}, \
+.duty = ${duty}, .amplitude = ${amplitude}}")
+                endforeach()
+            endif()
+            list(JOIN steps ",\n  " steps)
+            string(APPEND body "inline constexpr std::array<ScoreStep, ${step_count}> Cue${id}{{\n"
+                               "  ${steps}}};\n")
+            list(APPEND cue_entries "{ScoreCueId::${id}, Cue${id}}")
+        endforeach()
+    endif()
+
+    catalog_length(track_count tracks)
+    set(track_entries "")
+    if(track_count GREATER 0)
+        math(EXPR last_track "${track_count} - 1")
+        foreach(track RANGE ${last_track})
+            string(JSON key MEMBER "${catalog_json}" tracks ${track})
+            catalog_identifier(id "${key}")
+            catalog_length(step_count tracks "${key}")
+            set(steps "")
+            if(step_count GREATER 0)
+                math(EXPR last_step "${step_count} - 1")
+                foreach(step RANGE ${last_step})
+                    set(pitches "")
+                    foreach(voice IN ITEMS lead bass)
+                        catalog_get(note tracks "${key}" ${step} ${voice})
+                        # pitchFromName() reads unknown or missing notes as rests.
+                        if(note MATCHES "^[A-G][3-5]$" AND NOT note STREQUAL "B5")
+                            list(APPEND pitches "Pitch::${note}")
+                        else()
+                            list(APPEND pitches "Pitch::Rest")
+                        endif()
+                    endforeach()
+                    list(GET pitches 0 lead_pitch)
+                    list(GET pitches 1 bass_pitch)
+                    catalog_int(duration 0 tracks "${key}" ${step} durationMs)
+                    catalog_get(lead_duty tracks "${key}" ${step} leadDuty)
+                    catalog_get(bass_duty tracks "${key}" ${step} bassDuty)
+                    set(lead_duty_value "PulseDuty::Quarter")
+                    set(bass_duty_value "PulseDuty::Half")
+                    if(DEFINED duty_${lead_duty})
+                        set(lead_duty_value "${duty_${lead_duty}}")
+                    endif()
+                    if(DEFINED duty_${bass_duty})
+                        set(bass_duty_value "${duty_${bass_duty}}")
+                    endif()
+                    list(APPEND steps "{.leadPitch = ${lead_pitch}, .bassPitch = ${bass_pitch}, \
+.durationMs = ${duration}, .leadDuty = ${lead_duty_value}, .bassDuty = ${bass_duty_value}}")
+                endforeach()
+            endif()
+            list(JOIN steps ",\n  " steps)
+            string(APPEND body
+                   "inline constexpr std::array<ScoreTrackStep, ${step_count}> Track${id}{{\n"
+                   "  ${steps}}};\n")
+            list(APPEND track_entries "{ScoreTrackId::${id}, Track${id}}")
+        endforeach()
+    endif()
+
+    list(LENGTH cue_entries cue_entry_count)
+    list(LENGTH track_entries track_entry_count)
+    list(JOIN cue_entries ",\n  " cue_entries)
+    list(JOIN track_entries ",\n  " track_entries)
+    string(APPEND body
+           "\ninline constexpr std::array<std::pair<ScoreCueId, std::span<const ScoreStep>>, "
+           "${cue_entry_count}> Cues{{\n  ${cue_entries}}};\n"
+           "inline constexpr std::array<std::pair<ScoreTrackId, std::span<const ScoreTrackStep>>, "
+           "${track_entry_count}> Tracks{{\n  ${track_entries}}};\n")
+
+elseif(KIND STREQUAL "strategy")
+    set(header_includes "#include \"adapter/bot/catalog.h\"")
+    set(namespace "nenoserpent::adapter::bot::generated")
+    set(groups modeWeights loopGuard recovery)
+    set(modeWeights_type "StrategyConfig::ModeWeights")
+    set(loopGuard_type "StrategyConfig::LoopGuard")
+    set(recovery_type "StrategyConfig::Recovery")
+
+    # Emits `std::array<StrategyCatalogValue<type>, n> name` for the integer members of an object.
+    # Non-integer members are skipped, as intOrDefault() skips them.
+    function(strategy_values out name type)
+        catalog_length(count ${ARGN})
+        set(values "")
+        if(count GREATER 0)
+            math(EXPR last "${count} - 1")
+            foreach(index RANGE ${last})
+                string(JSON key MEMBER "${catalog_json}" ${ARGN} ${index})
+                catalog_type(value_type ${ARGN} "${key}")
+                if(NOT value_type STREQUAL "NUMBER" OR key STREQUAL "powerPriorityByType")
+                    continue()
+                endif()
+                catalog_int(value 0 ${ARGN} "${key}")
+                list(APPEND values "{&${type}::${key}, ${value}}")
+            endforeach()
+        endif()
+        list(LENGTH values value_count)
+        list(JOIN values ",\n  " values)
+        string(CONCAT declaration
+               "inline constexpr std::array<StrategyCatalogValue<${type}>, ${value_count}> "
+               "${name}{{\n  ${values}}};\n")
+        set(${out} "${declaration}" PARENT_SCOPE)
+    endfunction()
+
+    catalog_length(profile_count profiles)
+    set(profiles "")
+    if(profile_count GREATER 0)
+        math(EXPR last_profile "${profile_count} - 1")
+        foreach(profile RANGE ${last_profile})
+            string(JSON key MEMBER "${catalog_json}" profiles ${profile})
+            catalog_type(profile_type profiles "${key}")
+            if(NOT profile_type STREQUAL "OBJECT")
+                continue()
+            endif()
+            catalog_identifier(id "${key}")
+            strategy_values(values "Profile${id}Values" "StrategyConfig" profiles "${key}")
+            string(APPEND body "${values}")
+            set(grouped false)
+            set(group_fields "")
+            foreach(group IN LISTS groups)
+                catalog_identifier(group_id "${group}")
+                catalog_type(group_type profiles "${key}" "${group}")
+                if(group_type STREQUAL "OBJECT")
+                    set(grouped true)
+                endif()
+                strategy_values(values "Profile${id}${group_id}" "${${group}_type}"
+                                profiles "${key}" "${group}")
+                string(APPEND body "${values}")
+                list(APPEND group_fields "   .${group} = Profile${id}${group_id},\n")
+            endforeach()
+
+            catalog_length(priority_count profiles "${key}" powerPriorityByType)
+            set(priorities "")
+            if(priority_count GREATER 0)
+                math(EXPR last_priority "${priority_count} - 1")
+                foreach(priority RANGE ${last_priority})
+                    string(JSON type MEMBER "${catalog_json}" profiles "${key}"
+                           powerPriorityByType ${priority})
+                    catalog_type(priority_type profiles "${key}" powerPriorityByType "${type}")
+                    if(NOT type MATCHES "^-?[0-9]+$" OR NOT priority_type STREQUAL "NUMBER")
+                        continue()
+                    endif()
+                    catalog_int(value 0 profiles "${key}" powerPriorityByType "${type}")
+                    list(APPEND priorities "{${type}, ${value}}")
+                endforeach()
+            endif()
+            list(LENGTH priorities priority_entry_count)
+            list(JOIN priorities ", " priorities)
+            string(APPEND body
+                   "inline constexpr std::array<std::pair<int, int>, ${priority_entry_count}> "
+                   "Profile${id}PowerPriority{{${priorities}}};\n\n")
+
+            catalog_string_literal(name_literal "${key}")
+            string(CONCAT entry
+                   "{.name = ${name_literal},\n"
+                   "   .values = Profile${id}Values,\n"
+                   ${group_fields}
+                   "   .groupedOverride = ${grouped},\n"
+                   "   .powerPriorityByType = Profile${id}PowerPriority}")
+            list(APPEND profiles "${entry}")
+        endforeach()
+    endif()
+    list(LENGTH profiles profile_entry_count)
+    list(JOIN profiles ",\n  " profiles)
+    string(APPEND body
+           "inline constexpr std::array<StrategyCatalogProfile, ${profile_entry_count}> "
+           "Profiles{{\n  ${profiles}}};\n")
+
+else()
+    message(FATAL_ERROR "generate_catalog.cmake: unknown KIND '${KIND}'")
+endif()
+
+string(CONCAT header
+       "// Generated from ${catalog_name} by cmake/generate_catalog.cmake. Do not edit.\n"
+       "#pragma once\n\n"
+       "#include <array>\n#include <span>\n#include <utility>\n\n"
+       "${header_includes}\n\n"
+       "namespace ${namespace} {\n\n"
+       "${body}\n"
+       "} // namespace ${namespace}\n")
+
+file(WRITE "${OUTPUT}.tmp" "${header}")
+file(COPY_FILE "${OUTPUT}.tmp" "${OUTPUT}" ONLY_IF_DIFFERENT)
+file(REMOVE "${OUTPUT}.tmp")
@@ -63,8 +63,7 @@ set(NENOSERPENT_QML_RESOURCE_FILES
     "src/qml/icons/PowerGlyph.qml"
     "src/qml/icons/PowerIcon.qml"
     "src/qml/icon.svg"
-    "src/themes/theme_catalog.json"
-    "src/levels/levels.json")
+    "src/themes/theme_catalog.json")
 
 set(NENOSERPENT_SHADER_FILES
     "src/qml/blur.frag"
@@ -22,6 +22,8 @@ Commands:
   clang-tidy       Run clang-tidy wrapper on specific files/build-dir.
   android-icons    Generate Android launcher icon assets.
   bot-benchmark    Run bot benchmark suite.
+  replay-verify    Re-simulate ghost.dat replays in parallel and report verdicts.
+  tick-benchmark   Time headless ticks by board size.
   bot-dataset      Build training dataset from simulations.
   bot-choice-dataset Build choice decision dataset from simulations.
   bot-power-dataset Build power-up chase decision dataset from simulations.
@@ -67,6 +69,18 @@ EOF
       cat <<'EOF'
 Usage: ./scripts/dev.sh bot-benchmark [--games N --max-ticks M ...]
 Purpose: run benchmark scenarios for bot performance.
+EOF
+      ;;
+    replay-verify)
+      cat <<'EOF'
+Usage: ./scripts/dev.sh replay-verify [--jobs N --output verdicts.jsonl] <ghost files or dirs...>
+Purpose: headlessly re-run ghost.dat replays and emit one JSON verdict line per file.
+EOF
+      ;;
+    tick-benchmark)
+      cat <<'EOF'
+Usage: ./scripts/dev.sh tick-benchmark [--sides 32,256 --rounds 3 --ticks 300]
+Purpose: time headless ticks (a food spawn each) per board size and print ratios to the first.
 EOF
       ;;
     bot-dataset)
@@ -245,6 +259,12 @@ case "${subcommand}" in
   bot-benchmark)
     exec "${ROOT_DIR}/dev/bot_benchmark.sh" "$@"
     ;;
+  replay-verify)
+    exec "${ROOT_DIR}/dev/replay_verify.sh" "$@"
+    ;;
+  tick-benchmark)
+    exec "${ROOT_DIR}/dev/tick_benchmark.sh" "$@"
+    ;;
   bot-dataset)
     exec "${ROOT_DIR}/dev/bot_dataset.sh" "$@"
     ;;
@@ -6,18 +6,28 @@
 
 void EngineAdapter::spawnFood() {
   if (m_sessionCore.spawnFood(
-        BOARD_WIDTH, BOARD_HEIGHT, [this](const int size) { return m_rng.bounded(size); })) {
-    emit foodChanged();
+        BOARD_WIDTH, BOARD_HEIGHT, [this](const int size) { return drawBounded(size); })) {
+    emitFrameSignal(FrameFood);
   }
 }
 
 void EngineAdapter::spawnPowerUp() {
   if (m_sessionCore.spawnPowerUp(
-        BOARD_WIDTH, BOARD_HEIGHT, [this](const int size) { return m_rng.bounded(size); })) {
-    emit powerUpChanged();
+        BOARD_WIDTH, BOARD_HEIGHT, [this](const int size) { return drawBounded(size); })) {
+    emitFrameSignal(FramePowerUp);
   }
 }
 
+auto EngineAdapter::drawBounded(const int bound) -> int {
+  ++m_rngDraws;
+  return m_rng.bounded(bound);
+}
+
+auto EngineAdapter::drawWord() -> quint32 {
+  ++m_rngDraws;
+  return m_rng.generate();
+}
+
 auto EngineAdapter::isOutOfBounds(const QPoint& p) noexcept -> bool {
   return !m_boardRect.contains(p);
 }
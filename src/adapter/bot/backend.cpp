@@ -3,14 +3,17 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <deque>
 #include <limits>
 #include <optional>
-#include <unordered_map>
 #include <vector>
 
 #include <QStringList>
 
+#include "adapter/bot/grid.h"
+#include "core/game/hash_window.h"
 #include "core/game/rules.h"
+#include "core/game/zobrist.h"
 
 namespace nenoserpent::adapter::bot {
 
@@ -23,6 +26,14 @@ constexpr std::array<QPoint, 4> kDirections = {
   QPoint{1, 0},
 };
 
+// kDirections as indices into the board geometry's neighbour tables.
+constexpr std::array<std::size_t, 4> kDirectionSteps = {
+  nenoserpent::core::boardStepIndex(kDirections[0]),
+  nenoserpent::core::boardStepIndex(kDirections[1]),
+  nenoserpent::core::boardStepIndex(kDirections[2]),
+  nenoserpent::core::boardStepIndex(kDirections[3]),
+};
+
 auto isReverseDirection(const QPoint& a, const QPoint& b) -> bool {
   return a.x() == -b.x() && a.y() == -b.y();
 }
@@ -53,8 +64,9 @@ auto toroidalDistance(const QPoint& from, const QPoint& to, const int width, con
 struct MoveState {
   QPoint head{0, 0};
   QPoint direction{0, -1};
-  std::deque<QPoint> body;
+  nenoserpent::core::SnakeBody body;
   int score = 0;
+  std::uint64_t bodyHash = 0;
 };
 
 struct StageSignals {
@@ -242,32 +254,19 @@ struct CandidateTelemetry {
   int total = std::numeric_limits<int>::min();
 };
 
-auto mixHash(std::uint64_t seed, const std::uint64_t value) -> std::uint64_t {
-  constexpr std::uint64_t kPrime = 1099511628211ULL;
-  seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U);
-  seed *= kPrime;
-  return seed;
-}
-
 auto stateHash(const Snapshot& snapshot, const MoveState& state) -> std::uint64_t {
-  std::uint64_t hash = 1469598103934665603ULL;
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.boardWidth));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.boardHeight));
-  hash = mixHash(hash, static_cast<std::uint64_t>(state.head.x() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(state.head.y() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(state.direction.x() + 16));
-  hash = mixHash(hash, static_cast<std::uint64_t>(state.direction.y() + 16));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.food.x() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.food.y() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.powerUpPos.x() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.powerUpPos.y() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.powerUpType + 32));
-  hash = mixHash(hash, static_cast<std::uint64_t>(state.body.size()));
-  for (const QPoint& segment : state.body) {
-    hash = mixHash(hash, static_cast<std::uint64_t>(segment.x() + 1024));
-    hash = mixHash(hash, static_cast<std::uint64_t>(segment.y() + 1024));
-  }
-  return hash;
+  return nenoserpent::core::loopStateHash({
+    .bodyHash = state.bodyHash,
+    .bodyLength = state.body.size(),
+    .head = state.head,
+    .tail = state.body.empty() ? QPoint() : state.body.back(),
+    .direction = state.direction,
+    .food = snapshot.food,
+    .powerUpPos = snapshot.powerUpPos,
+    .powerUpType = snapshot.powerUpType,
+    .boardWidth = snapshot.boardWidth,
+    .boardHeight = snapshot.boardHeight,
+  });
 }
 
 auto directionIndex(const QPoint& direction) -> int;
@@ -275,24 +274,18 @@ auto directionIndex(const QPoint& direction) -> int;
 class LoopMemory {
 public:
   auto clear() -> void {
-    m_recent.clear();
-    m_counts.clear();
+    m_window.clear();
     m_observeTick = 0;
   }
 
   auto observe(const Snapshot& snapshot, const MoveState& state) -> int {
-    const std::uint64_t hash = stateHash(snapshot, state);
-    const int repeats = ++m_counts[hash];
-    m_recent.push_back(hash);
-    trim();
+    const int repeats = m_window.observe(stateHash(snapshot, state));
     ++m_observeTick;
     return repeats;
   }
 
   [[nodiscard]] auto repeatsFor(const Snapshot& snapshot, const MoveState& state) const -> int {
-    const std::uint64_t hash = stateHash(snapshot, state);
-    const auto it = m_counts.find(hash);
-    return it == m_counts.end() ? 0 : it->second;
+    return m_window.countOf(stateHash(snapshot, state));
   }
 
   [[nodiscard]] auto observeTick() const -> std::uint64_t {
@@ -301,24 +294,8 @@ public:
 
 private:
   static constexpr int kWindow = 96;
-  std::deque<std::uint64_t> m_recent;
-  std::unordered_map<std::uint64_t, int> m_counts;
+  nenoserpent::core::HashWindow m_window{kWindow};
   std::uint64_t m_observeTick = 0;
-
-  auto trim() -> void {
-    while (static_cast<int>(m_recent.size()) > kWindow) {
-      const std::uint64_t dropped = m_recent.front();
-      m_recent.pop_front();
-      auto it = m_counts.find(dropped);
-      if (it == m_counts.end()) {
-        continue;
-      }
-      --it->second;
-      if (it->second <= 0) {
-        m_counts.erase(it);
-      }
-    }
-  }
 };
 
 class LoopController {
@@ -739,10 +716,11 @@ auto targetModeName(const TargetMode mode) -> QString {
   return QStringLiteral("Unknown");
 }
 
-auto buildBlockedMap(const Snapshot& snapshot, const std::deque<QPoint>& body)
-  -> std::vector<bool> {
-  std::vector<bool> blocked(static_cast<std::size_t>(snapshot.boardWidth * snapshot.boardHeight),
-                            false);
+// Refills `blocked` in place, so a map rebuilt for every move keeps its storage.
+void buildBlockedMap(const Snapshot& snapshot,
+                     const nenoserpent::core::SnakeBody& body,
+                     std::vector<bool>& blocked) {
+  blocked.assign(static_cast<std::size_t>(snapshot.boardWidth * snapshot.boardHeight), false);
   if (!snapshot.portalActive && !snapshot.laserActive) {
     for (const QPoint& obstacle : snapshot.obstacles) {
       if (const auto index = tryBoardIndex(obstacle, snapshot.boardWidth, snapshot.boardHeight);
@@ -759,7 +737,6 @@ auto buildBlockedMap(const Snapshot& snapshot, const std::deque<QPoint>& body)
       }
     }
   }
-  return blocked;
 }
 
 auto directionIndex(const QPoint& direction) -> int {
@@ -771,59 +748,62 @@ auto directionIndex(const QPoint& direction) -> int {
   return 0;
 }
 
-auto floodReachable(const QPoint& start, const Snapshot& snapshot, const std::vector<bool>& blocked)
-  -> int {
-  if (snapshot.boardWidth <= 0 || snapshot.boardHeight <= 0) {
-    return 0;
-  }
-  std::vector<bool> visited(blocked.size(), false);
-  std::deque<QPoint> queue;
-  const QPoint wrappedStart =
-    nenoserpent::core::wrapPoint(start, snapshot.boardWidth, snapshot.boardHeight);
-  const auto startIndex = tryBoardIndex(wrappedStart, snapshot.boardWidth, snapshot.boardHeight);
-  if (!startIndex.has_value()) {
-    return 0;
-  }
-  queue.push_back(wrappedStart);
-  visited[*startIndex] = true;
-  int reachable = 0;
-  while (!queue.empty()) {
-    const QPoint current = queue.front();
-    queue.pop_front();
-    ++reachable;
-    for (const QPoint& dir : kDirections) {
-      const QPoint next =
-        nenoserpent::core::wrapPoint(current + dir, snapshot.boardWidth, snapshot.boardHeight);
-      const auto nextIndex = tryBoardIndex(next, snapshot.boardWidth, snapshot.boardHeight);
-      if (!nextIndex.has_value() || visited[*nextIndex] || blocked[*nextIndex]) {
-        continue;
-      }
-      visited[*nextIndex] = true;
-      queue.push_back(next);
-    }
-  }
-  return reachable;
+auto floodReachable(const QPoint& start,
+                    const Snapshot& snapshot,
+                    const std::vector<bool>& blocked,
+                    SearchScratch& scratch) -> int {
+  return countReachableCells(start, snapshot.boardWidth, snapshot.boardHeight, blocked, scratch);
 }
 
 auto countSafeNeighbors(const QPoint& from,
                         const Snapshot& snapshot,
                         const std::vector<bool>& blocked) -> int {
-  int safe = 0;
-  for (const QPoint& dir : kDirections) {
-    const QPoint next =
-      nenoserpent::core::wrapPoint(from + dir, snapshot.boardWidth, snapshot.boardHeight);
-    const auto index = tryBoardIndex(next, snapshot.boardWidth, snapshot.boardHeight);
-    if (index.has_value() && !blocked[*index]) {
-      ++safe;
+  return countOpenNeighbors(from, snapshot.boardWidth, snapshot.boardHeight, blocked);
+}
+
+// Past `limit` visited cells the target is taken to be reachable at its toroidal distance: on a
+// large board a target outside the searched region is far more likely distant than walled off.
+template <typename Geometry>
+auto shortestReachableDistanceOn(const Geometry& board,
+                                 const int fromCell,
+                                 const int toCell,
+                                 const std::vector<bool>& blocked,
+                                 SearchScratch& scratch,
+                                 const std::size_t limit) -> std::optional<int> {
+  scratch.begin(blocked.size());
+  std::vector<int>& queue = scratch.queue();
+  queue.push_back(fromCell);
+  scratch.visit(static_cast<std::size_t>(fromCell));
+
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    if (queue.size() >= limit) {
+      const QPoint from = board.cellPoint(fromCell);
+      const QPoint to = board.cellPoint(toCell);
+      return toroidalDistance(from, to, board.width(), board.height());
+    }
+    const int current = queue[head];
+    const int nextDistance = scratch.distance(static_cast<std::size_t>(current)) + 1;
+    for (const std::size_t step : kDirectionSteps) {
+      const int next = board.neighbor(current, step);
+      const auto idx = static_cast<std::size_t>(next);
+      if (blocked[idx] || scratch.visited(idx)) {
+        continue;
+      }
+      if (next == toCell) {
+        return nextDistance;
+      }
+      scratch.visit(idx, nextDistance);
+      queue.push_back(next);
     }
   }
-  return safe;
+  return std::nullopt;
 }
 
 auto shortestReachableDistance(const QPoint& from,
                                const QPoint& to,
                                const Snapshot& snapshot,
-                               const std::vector<bool>& blocked) -> std::optional<int> {
+                               const std::vector<bool>& blocked,
+                               SearchScratch& scratch) -> std::optional<int> {
   if (snapshot.boardWidth <= 0 || snapshot.boardHeight <= 0) {
     return std::nullopt;
   }
@@ -835,35 +815,15 @@ auto shortestReachableDistance(const QPoint& from,
   if (from == to) {
     return 0;
   }
-
-  std::vector<int> distance(blocked.size(), -1);
-  std::deque<QPoint> queue;
-  queue.push_back(from);
-  distance[*fromIndex] = 0;
-
-  while (!queue.empty()) {
-    const QPoint current = queue.front();
-    queue.pop_front();
-    const auto currentIndex = tryBoardIndex(current, snapshot.boardWidth, snapshot.boardHeight);
-    if (!currentIndex.has_value()) {
-      continue;
-    }
-    const int nextDistance = distance[*currentIndex] + 1;
-    for (const QPoint& dir : kDirections) {
-      const QPoint next =
-        nenoserpent::core::wrapPoint(current + dir, snapshot.boardWidth, snapshot.boardHeight);
-      const auto nextIndex = tryBoardIndex(next, snapshot.boardWidth, snapshot.boardHeight);
-      if (!nextIndex.has_value() || blocked[*nextIndex] || distance[*nextIndex] >= 0) {
-        continue;
-      }
-      if (next == to) {
-        return nextDistance;
-      }
-      distance[*nextIndex] = nextDistance;
-      queue.push_back(next);
-    }
-  }
-  return std::nullopt;
+  return nenoserpent::core::visitBoardGeometry(
+    snapshot.boardWidth, snapshot.boardHeight, [&](const auto& board) {
+      return shortestReachableDistanceOn(board,
+                                         static_cast<int>(*fromIndex),
+                                         static_cast<int>(*toIndex),
+                                         blocked,
+                                         scratch,
+                                         searchLimitFor(snapshot.boardWidth, snapshot.boardHeight));
+    });
 }
 
 struct TargetDistance {
@@ -875,21 +835,23 @@ auto resolveTargetDistance(const QPoint& head,
                            const QPoint& target,
                            const Snapshot& snapshot,
                            const std::vector<bool>& blocked,
-                           const QPoint& tailFallback) -> TargetDistance {
-  if (const auto reachable = shortestReachableDistance(head, target, snapshot, blocked);
+                           const QPoint& tailFallback,
+                           SearchScratch& scratch) -> TargetDistance {
+  if (const auto reachable = shortestReachableDistance(head, target, snapshot, blocked, scratch);
       reachable.has_value()) {
     return {.distance = *reachable, .unreachablePenalty = 0};
   }
 
   if (target != snapshot.food) {
     if (const auto foodReachable =
-          shortestReachableDistance(head, snapshot.food, snapshot, blocked);
+          shortestReachableDistance(head, snapshot.food, snapshot, blocked, scratch);
         foodReachable.has_value()) {
       return {.distance = *foodReachable, .unreachablePenalty = 64};
     }
   }
 
-  if (const auto tailReachable = shortestReachableDistance(head, tailFallback, snapshot, blocked);
+  if (const auto tailReachable =
+        shortestReachableDistance(head, tailFallback, snapshot, blocked, scratch);
       tailReachable.has_value()) {
     return {.distance = *tailReachable, .unreachablePenalty = 96};
   }
@@ -899,51 +861,35 @@ auto resolveTargetDistance(const QPoint& head,
   return {.distance = fallbackDistance, .unreachablePenalty = 180};
 }
 
-auto pocketPenaltyTowardTarget(const QPoint& from,
-                               const QPoint& target,
-                               const Snapshot& snapshot,
-                               const std::vector<bool>& blocked) -> int {
-  if (snapshot.boardWidth <= 0 || snapshot.boardHeight <= 0) {
-    return 0;
-  }
-  const auto fromIndex = tryBoardIndex(from, snapshot.boardWidth, snapshot.boardHeight);
-  const auto targetIndex = tryBoardIndex(target, snapshot.boardWidth, snapshot.boardHeight);
-  if (!fromIndex.has_value() || !targetIndex.has_value()) {
-    return 0;
-  }
-  if (from == target) {
-    return 0;
-  }
-
-  std::vector<int> distance(blocked.size(), -1);
-  std::vector<int> parent(blocked.size(), -1);
-  std::deque<QPoint> queue;
-  queue.push_back(from);
-  distance[static_cast<std::size_t>(*fromIndex)] = 0;
+// Walks one shortest path to the target (first-found parents, kDirections order) and charges for
+// every narrow cell on it. A target beyond `limit` visited cells is charged nothing.
+template <typename Geometry>
+auto pocketPenaltyTowardTargetOn(const Geometry& board,
+                                 const int fromCell,
+                                 const int targetCell,
+                                 const std::vector<bool>& blocked,
+                                 SearchScratch& scratch,
+                                 const std::size_t limit) -> int {
+  scratch.begin(blocked.size());
+  std::vector<int>& queue = scratch.queue();
+  queue.push_back(fromCell);
+  scratch.visit(static_cast<std::size_t>(fromCell));
   bool reached = false;
 
-  while (!queue.empty() && !reached) {
-    const QPoint current = queue.front();
-    queue.pop_front();
-    const auto currentIndex = tryBoardIndex(current, snapshot.boardWidth, snapshot.boardHeight);
-    if (!currentIndex.has_value()) {
-      continue;
+  for (std::size_t head = 0; head < queue.size() && !reached; ++head) {
+    if (queue.size() >= limit) {
+      return 0;
     }
-    const int nextDistance = distance[static_cast<std::size_t>(*currentIndex)] + 1;
-    for (const QPoint& dir : kDirections) {
-      const QPoint next =
-        nenoserpent::core::wrapPoint(current + dir, snapshot.boardWidth, snapshot.boardHeight);
-      const auto nextIndex = tryBoardIndex(next, snapshot.boardWidth, snapshot.boardHeight);
-      if (!nextIndex.has_value()) {
+    const int current = queue[head];
+    const int nextDistance = scratch.distance(static_cast<std::size_t>(current)) + 1;
+    for (const std::size_t step : kDirectionSteps) {
+      const int next = board.neighbor(current, step);
+      const auto idx = static_cast<std::size_t>(next);
+      if (blocked[idx] || scratch.visited(idx)) {
         continue;
       }
-      const auto idx = static_cast<std::size_t>(*nextIndex);
-      if (blocked[idx] || distance[idx] >= 0) {
-        continue;
-      }
-      distance[idx] = nextDistance;
-      parent[idx] = *currentIndex;
-      if (next == target) {
+      scratch.visit(idx, nextDistance, current);
+      if (next == targetCell) {
         reached = true;
         break;
       }
@@ -951,25 +897,51 @@ auto pocketPenaltyTowardTarget(const QPoint& from,
     }
   }
 
-  if (distance[static_cast<std::size_t>(*targetIndex)] < 0) {
+  if (!scratch.visited(static_cast<std::size_t>(targetCell))) {
     return 24;
   }
 
   int penalty = 0;
-  int cursor = *targetIndex;
-  while (cursor >= 0 && cursor != static_cast<int>(*fromIndex)) {
-    const QPoint point(cursor % snapshot.boardWidth, cursor / snapshot.boardWidth);
-    const int safeNeighbors = countSafeNeighbors(point, snapshot, blocked);
+  int cursor = targetCell;
+  while (cursor >= 0 && cursor != fromCell) {
+    const int safeNeighbors = countOpenNeighborsOn(board, board.cellPoint(cursor), blocked);
     if (safeNeighbors <= 1) {
       penalty += 30;
     } else if (safeNeighbors == 2) {
       penalty += 8;
     }
-    cursor = parent[static_cast<std::size_t>(cursor)];
+    cursor = scratch.parent(static_cast<std::size_t>(cursor));
   }
   return penalty;
 }
 
+auto pocketPenaltyTowardTarget(const QPoint& from,
+                               const QPoint& target,
+                               const Snapshot& snapshot,
+                               const std::vector<bool>& blocked,
+                               SearchScratch& scratch) -> int {
+  if (snapshot.boardWidth <= 0 || snapshot.boardHeight <= 0) {
+    return 0;
+  }
+  const auto fromIndex = tryBoardIndex(from, snapshot.boardWidth, snapshot.boardHeight);
+  const auto targetIndex = tryBoardIndex(target, snapshot.boardWidth, snapshot.boardHeight);
+  if (!fromIndex.has_value() || !targetIndex.has_value()) {
+    return 0;
+  }
+  if (from == target) {
+    return 0;
+  }
+  return nenoserpent::core::visitBoardGeometry(
+    snapshot.boardWidth, snapshot.boardHeight, [&](const auto& board) {
+      return pocketPenaltyTowardTargetOn(board,
+                                         static_cast<int>(*fromIndex),
+                                         static_cast<int>(*targetIndex),
+                                         blocked,
+                                         scratch,
+                                         searchLimitFor(snapshot.boardWidth, snapshot.boardHeight));
+    });
+}
+
 auto previewMove(const Snapshot& snapshot, const MoveState& state, const QPoint& candidate)
   -> MovePreview {
   MovePreview preview{};
@@ -980,12 +952,14 @@ auto previewMove(const Snapshot& snapshot, const MoveState& state, const QPoint&
   const QPoint nextHeadRaw = state.head + candidate;
   const QPoint wrappedHead =
     nenoserpent::core::wrapPoint(nextHeadRaw, snapshot.boardWidth, snapshot.boardHeight);
-  std::deque<QPoint> collisionBody = state.body;
+  nenoserpent::core::SnakeBody collisionBody = state.body;
+  std::uint64_t bodyHash = state.bodyHash;
   const bool ateFood = wrappedHead == snapshot.food;
   const bool atePower = snapshot.powerUpPos.x() >= 0 && snapshot.powerUpPos.y() >= 0 &&
                         wrappedHead == snapshot.powerUpPos;
 
   if (!ateFood && !collisionBody.empty()) {
+    bodyHash ^= nenoserpent::core::zobristCellKey(collisionBody.back());
     collisionBody.pop_back();
   }
   const auto collision = nenoserpent::core::collisionOutcomeForHead(nextHeadRaw,
@@ -1007,6 +981,7 @@ auto previewMove(const Snapshot& snapshot, const MoveState& state, const QPoint&
     .direction = candidate,
     .body = std::move(collisionBody),
     .score = state.score + (ateFood ? 1 : 0),
+    .bodyHash = bodyHash ^ nenoserpent::core::zobristCellKey(wrappedHead),
   };
   preview.valid = true;
   preview.ateFood = ateFood;
@@ -1017,17 +992,19 @@ auto previewMove(const Snapshot& snapshot, const MoveState& state, const QPoint&
 auto evaluateLeaf(const Snapshot& snapshot,
                   const MoveState& state,
                   const StrategyConfig& config,
-                  const QPoint& target) -> int {
-  auto blocked = buildBlockedMap(snapshot, state.body);
+                  const QPoint& target,
+                  SearchScratch& scratch) -> int {
+  std::vector<bool>& blocked = scratch.blockedScratch();
+  buildBlockedMap(snapshot, state.body, blocked);
   if (const auto headIndex = tryBoardIndex(state.head, snapshot.boardWidth, snapshot.boardHeight);
       headIndex.has_value()) {
     blocked[*headIndex] = false;
   }
-  const int openSpace = floodReachable(state.head, snapshot, blocked);
+  const int openSpace = floodReachable(state.head, snapshot, blocked, scratch);
   const int safeNeighbors = countSafeNeighbors(state.head, snapshot, blocked);
   const QPoint tailFallback = state.body.empty() ? state.head : state.body.back();
   const TargetDistance targetDistance =
-    resolveTargetDistance(state.head, target, snapshot, blocked, tailFallback);
+    resolveTargetDistance(state.head, target, snapshot, blocked, tailFallback, scratch);
   const int trapPenalty = safeNeighbors <= 1 ? config.modeWeights.trapPenalty : 0;
   return (openSpace * config.modeWeights.openSpaceWeight) +
          (safeNeighbors * config.modeWeights.safeNeighborWeight) -
@@ -1039,9 +1016,10 @@ auto searchValue(const Snapshot& snapshot,
                  const MoveState& state,
                  const StrategyConfig& config,
                  const int depth,
-                 const QPoint& target) -> int {
+                 const QPoint& target,
+                 SearchScratch& scratch) -> int {
   if (depth <= 0) {
-    return evaluateLeaf(snapshot, state, config, target);
+    return evaluateLeaf(snapshot, state, config, target, scratch);
   }
 
   int best = std::numeric_limits<int>::min();
@@ -1059,7 +1037,8 @@ auto searchValue(const Snapshot& snapshot,
     if (preview.atePower) {
       immediate += powerPriority(config, snapshot.powerUpType);
     }
-    const int score = immediate + searchValue(snapshot, preview.next, config, depth - 1, target);
+    const int score =
+      immediate + searchValue(snapshot, preview.next, config, depth - 1, target, scratch);
     if (score > best) {
       best = score;
     }
@@ -1078,7 +1057,8 @@ auto rolloutHorizon(const StrategyConfig& config) -> int {
 auto rolloutScore(const Snapshot& snapshot,
                   const MoveState& startState,
                   const StrategyConfig& config,
-                  const QPoint& target) -> int {
+                  const QPoint& target,
+                  SearchScratch& scratch) -> int {
   MoveState current = startState;
   int total = 0;
   const int horizon = rolloutHorizon(config);
@@ -1091,7 +1071,7 @@ auto rolloutScore(const Snapshot& snapshot,
       if (!preview.valid) {
         continue;
       }
-      int score = evaluateLeaf(snapshot, preview.next, config, target);
+      int score = evaluateLeaf(snapshot, preview.next, config, target, scratch);
       if (preview.ateFood) {
         score += config.modeWeights.foodConsumeBonus * 2;
       }
@@ -1120,14 +1100,16 @@ auto rolloutScore(const Snapshot& snapshot,
 auto evaluateEscapeCandidate(const Snapshot& snapshot,
                              const MovePreview& preview,
                              const StrategyConfig& config,
-                             const int revisitCount) -> int {
-  auto blocked = buildBlockedMap(snapshot, preview.next.body);
+                             const int revisitCount,
+                             SearchScratch& scratch) -> int {
+  std::vector<bool>& blocked = scratch.blockedScratch();
+  buildBlockedMap(snapshot, preview.next.body, blocked);
   if (const auto headIndex =
         tryBoardIndex(preview.next.head, snapshot.boardWidth, snapshot.boardHeight);
       headIndex.has_value()) {
     blocked[*headIndex] = false;
   }
-  const int openSpace = floodReachable(preview.next.head, snapshot, blocked);
+  const int openSpace = floodReachable(preview.next.head, snapshot, blocked, scratch);
   const int safeNeighbors = countSafeNeighbors(preview.next.head, snapshot, blocked);
   const QPoint tail = preview.next.body.empty() ? preview.next.head : preview.next.body.back();
   const int tailDistance =
@@ -1268,6 +1250,7 @@ struct DecisionContext {
   const ModePlanner& modePlanner;
   const QPoint& primaryTarget;
   const QPoint& boardMid;
+  SearchScratch& scratch;
   bool useSearchScoring = false;
   bool escapeMode = false;
   int noScoreTicks = 0;
@@ -1303,13 +1286,15 @@ auto evaluateCandidateScore(const CandidateStats& candidateStats, const Decision
   const int safeNeighbors = candidateStats.safeNeighbors;
   const auto& blocked = candidateStats.blocked;
   const int pocketPenalty =
-    pocketPenaltyTowardTarget(preview.next.head, ctx.primaryTarget, ctx.snapshot, blocked);
+    pocketPenaltyTowardTarget(
+      preview.next.head, ctx.primaryTarget, ctx.snapshot, blocked, ctx.scratch);
   const int boardArea = std::max(1, ctx.snapshot.boardWidth * ctx.snapshot.boardHeight);
   const int openSpacePct = (openSpace * 100) / boardArea;
   const int normalizedSafeNeighbors = safeNeighbors * 20;
 
   if (ctx.escapeMode) {
-    const int escapeBase = evaluateEscapeCandidate(ctx.snapshot, preview, ctx.config, revisitCount);
+    const int escapeBase =
+      evaluateEscapeCandidate(ctx.snapshot, preview, ctx.config, revisitCount, ctx.scratch);
     const int compressedEscapeBase = (escapeBase * 3) / 10;
     const int openSpaceTerm = (openSpacePct * 7) / 4;
     const int safeNeighborTerm = safeNeighbors * 22;
@@ -1370,11 +1355,11 @@ auto evaluateCandidateScore(const CandidateStats& candidateStats, const Decision
     const QPoint tailFallback =
       preview.next.body.empty() ? preview.next.head : preview.next.body.back();
     const TargetDistance targetDistance = resolveTargetDistance(
-      preview.next.head, ctx.primaryTarget, ctx.snapshot, blocked, tailFallback);
-    const int searchTerm =
-      searchValue(ctx.snapshot, preview.next, ctx.config, ctx.depth - 1, ctx.primaryTarget);
+      preview.next.head, ctx.primaryTarget, ctx.snapshot, blocked, tailFallback, ctx.scratch);
+    const int searchTerm = searchValue(
+      ctx.snapshot, preview.next, ctx.config, ctx.depth - 1, ctx.primaryTarget, ctx.scratch);
     const int rolloutTerm =
-      rolloutScore(ctx.snapshot, preview.next, ctx.config, ctx.primaryTarget) / 6;
+      rolloutScore(ctx.snapshot, preview.next, ctx.config, ctx.primaryTarget, ctx.scratch) / 6;
     evaluation.breakdown.progress =
       clampScoreBlock(approachTargetBonus(ctx.initial.head,
                                           preview.next.head,
@@ -1400,7 +1385,7 @@ auto evaluateCandidateScore(const CandidateStats& candidateStats, const Decision
     const QPoint tailFallback =
       preview.next.body.empty() ? preview.next.head : preview.next.body.back();
     const TargetDistance targetDistance = resolveTargetDistance(
-      preview.next.head, ctx.primaryTarget, ctx.snapshot, blocked, tailFallback);
+      preview.next.head, ctx.primaryTarget, ctx.snapshot, blocked, tailFallback, ctx.scratch);
     int immediate =
       (candidate == ctx.snapshot.direction ? ctx.config.modeWeights.straightBonus : 0);
     if (preview.ateFood) {
@@ -1544,8 +1529,10 @@ auto evaluateCandidateScore(const CandidateStats& candidateStats, const Decision
   return evaluation;
 }
 
-auto collectLegalCandidates(const Snapshot& snapshot, const MoveState& initial, LoopMemory& memory)
-  -> std::vector<CandidateStats> {
+auto collectLegalCandidates(const Snapshot& snapshot,
+                            const MoveState& initial,
+                            LoopMemory& memory,
+                            SearchScratch& scratch) -> std::vector<CandidateStats> {
   std::vector<CandidateStats> legalCandidates;
   legalCandidates.reserve(kDirections.size());
   for (const QPoint& candidate : kDirections) {
@@ -1557,25 +1544,28 @@ auto collectLegalCandidates(const Snapshot& snapshot, const MoveState& initial,
     stats.candidate = candidate;
     stats.preview = preview;
     stats.revisitCount = memory.repeatsFor(snapshot, preview.next);
-    stats.blocked = buildBlockedMap(snapshot, preview.next.body);
+    buildBlockedMap(snapshot, preview.next.body, stats.blocked);
     if (const auto headIndex =
           tryBoardIndex(preview.next.head, snapshot.boardWidth, snapshot.boardHeight);
         headIndex.has_value()) {
       stats.blocked[*headIndex] = false;
     }
-    stats.openSpace = floodReachable(preview.next.head, snapshot, stats.blocked);
+    stats.openSpace = floodReachable(preview.next.head, snapshot, stats.blocked, scratch);
     stats.safeNeighbors = countSafeNeighbors(preview.next.head, snapshot, stats.blocked);
     const QPoint tailFallback =
       preview.next.body.empty() ? preview.next.head : preview.next.body.back();
-    auto tailReachBlocked = stats.blocked;
-    if (const auto tailIndex =
-          tryBoardIndex(tailFallback, snapshot.boardWidth, snapshot.boardHeight);
-        tailIndex.has_value()) {
-      tailReachBlocked[*tailIndex] = false;
+    // The tail cell is opened only for this search.
+    const auto tailIndex = tryBoardIndex(tailFallback, snapshot.boardWidth, snapshot.boardHeight);
+    const bool tailBlocked = tailIndex.has_value() && stats.blocked[*tailIndex];
+    if (tailIndex.has_value()) {
+      stats.blocked[*tailIndex] = false;
     }
     stats.tailReachable =
-      shortestReachableDistance(preview.next.head, tailFallback, snapshot, tailReachBlocked)
+      shortestReachableDistance(preview.next.head, tailFallback, snapshot, stats.blocked, scratch)
         .has_value();
+    if (tailIndex.has_value()) {
+      stats.blocked[*tailIndex] = tailBlocked;
+    }
     legalCandidates.push_back(std::move(stats));
   }
   return legalCandidates;
@@ -1635,6 +1625,7 @@ auto selectLoopAwareDirection(const Snapshot& snapshot,
                               LoopMemory& memory,
                               LoopController& loopController,
                               ModePlanner& modePlanner,
+                              SearchScratch& scratch,
                               QString* decisionSummaryOut,
                               const bool useSearchScoring) -> std::optional<QPoint> {
   if (snapshot.body.empty() || snapshot.boardWidth <= 0 || snapshot.boardHeight <= 0) {
@@ -1649,6 +1640,8 @@ auto selectLoopAwareDirection(const Snapshot& snapshot,
     .direction = snapshot.direction,
     .body = snapshot.body,
     .score = snapshot.score,
+    .bodyHash = snapshot.bodyHash != 0 ? snapshot.bodyHash
+                                       : nenoserpent::core::zobristBodyHash(snapshot.body),
   };
 
   const int repeats = memory.observe(snapshot, initial);
@@ -1676,20 +1669,23 @@ auto selectLoopAwareDirection(const Snapshot& snapshot,
     toroidalDistance(initial.head, primaryTarget, snapshot.boardWidth, snapshot.boardHeight);
   const int currentFoodDistance =
     toroidalDistance(initial.head, snapshot.food, snapshot.boardWidth, snapshot.boardHeight);
-  auto initialBlocked = buildBlockedMap(snapshot, initial.body);
+  std::vector<bool>& initialBlocked = scratch.blockedScratch();
+  buildBlockedMap(snapshot, initial.body, initialBlocked);
   if (const auto headIndex = tryBoardIndex(initial.head, snapshot.boardWidth, snapshot.boardHeight);
       headIndex.has_value()) {
     initialBlocked[*headIndex] = false;
   }
   const bool foodReachable =
-    shortestReachableDistance(initial.head, snapshot.food, snapshot, initialBlocked).has_value();
+    shortestReachableDistance(initial.head, snapshot.food, snapshot, initialBlocked, scratch)
+      .has_value();
   const bool centerFoodPush = foodReachable && isPointInCenterBand(snapshot.food, snapshot);
   const QPoint boardMid = boardCenter(snapshot);
   const bool earlyFoodChaseGuard = (modePlanner.mode() == TargetMode::FoodChase) &&
                                    (primaryTarget == snapshot.food) && snapshot.score < 40 &&
                                    static_cast<int>(snapshot.body.size()) < 12 && !escapeMode;
 
-  std::vector<CandidateStats> legalCandidates = collectLegalCandidates(snapshot, initial, memory);
+  std::vector<CandidateStats> legalCandidates =
+    collectLegalCandidates(snapshot, initial, memory, scratch);
   if (legalCandidates.empty()) {
     if (decisionSummaryOut != nullptr) {
       *decisionSummaryOut = QStringLiteral("bot decision: no legal candidates");
@@ -1780,6 +1776,7 @@ auto selectLoopAwareDirection(const Snapshot& snapshot,
     .modePlanner = modePlanner,
     .primaryTarget = primaryTarget,
     .boardMid = boardMid,
+    .scratch = scratch,
     .useSearchScoring = useSearchScoring,
     .escapeMode = escapeMode,
     .noScoreTicks = noScoreTicks,
@@ -1830,6 +1827,7 @@ public:
                                     m_loopMemory,
                                     m_loopController,
                                     m_modePlanner,
+                                    m_searchScratch,
                                     &m_lastDecisionSummary,
                                     false);
   }
@@ -1854,6 +1852,7 @@ private:
   mutable LoopMemory m_loopMemory;
   mutable LoopController m_loopController;
   mutable ModePlanner m_modePlanner;
+  mutable SearchScratch m_searchScratch;
   mutable QString m_lastDecisionSummary;
 };
 
@@ -1870,6 +1869,7 @@ public:
                                     m_loopMemory,
                                     m_loopController,
                                     m_modePlanner,
+                                    m_searchScratch,
                                     &m_lastDecisionSummary,
                                     true);
   }
@@ -1894,6 +1894,7 @@ private:
   mutable LoopMemory m_loopMemory;
   mutable LoopController m_loopController;
   mutable ModePlanner m_modePlanner;
+  mutable SearchScratch m_searchScratch;
   mutable QString m_lastDecisionSummary;
 };
 
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <span>
+#include <utility>
+
+#include <QStringView>
+
+#include "adapter/bot/config.h"
+
+namespace nenoserpent::adapter::bot {
+
+// Compile-time form of the built-in strategy profiles. The tables are generated from
+// adapter/bot/strategy_profiles.json at build time (cmake/catalogs.cmake); loadStrategyConfig()
+// reads them unless an override file is given.
+template <typename Group>
+struct StrategyCatalogValue {
+  int Group::* field = nullptr;
+  int value = 0;
+};
+
+// One profile's overrides, applied in the same order as a JSON profile object.
+struct StrategyCatalogProfile {
+  QStringView name;
+  std::span<const StrategyCatalogValue<StrategyConfig>> values;
+  std::span<const StrategyCatalogValue<StrategyConfig::ModeWeights>> modeWeights;
+  std::span<const StrategyCatalogValue<StrategyConfig::LoopGuard>> loopGuard;
+  std::span<const StrategyCatalogValue<StrategyConfig::Recovery>> recovery;
+  // Set when the profile has any of the grouped objects, even an empty one.
+  bool groupedOverride = false;
+  std::span<const std::pair<int, int>> powerPriorityByType;
+};
+
+} // namespace nenoserpent::adapter::bot
@@ -1,12 +1,15 @@
 #include "adapter/bot/config.h"
 
 #include <algorithm>
+#include <span>
 
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 
+#include "adapter/bot/catalog.h"
+#include "adapter/bot/strategy_profiles_catalog.h"
 #include "power_up_id.h"
 
 namespace nenoserpent::adapter::bot {
@@ -195,6 +198,34 @@ void applyOverrides(StrategyConfig& config, const QJsonObject& object) {
   }
 }
 
+template <typename Group>
+void applyCatalogValues(Group& group, const std::span<const StrategyCatalogValue<Group>> values) {
+  for (const auto& [field, value] : values) {
+    group.*field = value;
+  }
+}
+
+// Same steps as applyOverrides(), over a profile compiled in from strategy_profiles.json.
+void applyCatalogProfile(StrategyConfig& config, const StrategyCatalogProfile& profile) {
+  applyCatalogValues(config, profile.values);
+  syncLegacyToGrouped(config);
+  applyCatalogValues(config.modeWeights, profile.modeWeights);
+  applyCatalogValues(config.loopGuard, profile.loopGuard);
+  applyCatalogValues(config.recovery, profile.recovery);
+  if (profile.groupedOverride) {
+    syncGroupedToLegacy(config);
+  }
+  for (const auto& [type, priority] : profile.powerPriorityByType) {
+    config.powerPriorityByType.insert(type, priority);
+  }
+}
+
+auto catalogProfile(const QStringView name) -> const StrategyCatalogProfile* {
+  const auto* const profile =
+    std::ranges::find(generated::Profiles, name, &StrategyCatalogProfile::name);
+  return profile == generated::Profiles.end() ? nullptr : profile;
+}
+
 auto loadJsonBytes(const QString& filePath, QByteArray& outBytes, QString& outError) -> bool {
   QFile file(filePath);
   if (!file.open(QIODevice::ReadOnly)) {
@@ -399,6 +430,27 @@ auto loadStrategyConfigFromJson(const QByteArray& json,
   return result;
 }
 
+auto loadBuiltInStrategyConfig(const QString& profile) -> StrategyLoadResult {
+  StrategyLoadResult result{
+    .config = defaultStrategyConfig(),
+    .loaded = false,
+    .profile = profile,
+    .source = QStringLiteral("built-in"),
+    .error = {},
+  };
+  if (const auto* defaultProfile = catalogProfile(u"default"); defaultProfile != nullptr) {
+    applyCatalogProfile(result.config, *defaultProfile);
+  }
+  const auto* selected = catalogProfile(profile);
+  if (selected == nullptr) {
+    result.error = QStringLiteral("missing profile: %1").arg(profile);
+    return result;
+  }
+  applyCatalogProfile(result.config, *selected);
+  result.loaded = true;
+  return result;
+}
+
 auto loadStrategyConfig(const QString& profile,
                         const QString& overrideFilePath,
                         const QString& resourcePath) -> StrategyLoadResult {
@@ -422,6 +474,10 @@ auto loadStrategyConfig(const QString& profile,
     };
   }
 
+  if (resourcePath.isEmpty()) {
+    return loadBuiltInStrategyConfig(profile);
+  }
+
   QByteArray jsonBytes;
   QString error;
   if (!loadJsonBytes(resourcePath, jsonBytes, error)) {
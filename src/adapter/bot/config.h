@@ -110,10 +110,12 @@ void applyModeDefaults(StrategyConfig& config, BotMode mode);
                                               const QString& profile,
                                               const QString& source = QStringLiteral("inline"))
   -> StrategyLoadResult;
-[[nodiscard]] auto loadStrategyConfig(
-  const QString& profile,
-  const QString& overrideFilePath = QString(),
-  const QString& resourcePath = QStringLiteral(":/adapter/bot/strategy_profiles.json"))
+// The profiles compiled in from strategy_profiles.json, "default" first and then `profile`.
+[[nodiscard]] auto loadBuiltInStrategyConfig(const QString& profile) -> StrategyLoadResult;
+// Reads `overrideFilePath` when given, otherwise `resourcePath`, otherwise the built-in profiles.
+[[nodiscard]] auto loadStrategyConfig(const QString& profile,
+                                      const QString& overrideFilePath = QString(),
+                                      const QString& resourcePath = QString())
   -> StrategyLoadResult;
 
 } // namespace nenoserpent::adapter::bot
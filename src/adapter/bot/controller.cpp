@@ -5,6 +5,7 @@
 #include <limits>
 #include <vector>
 
+#include "adapter/bot/grid.h"
 #include "core/game/rules.h"
 
 namespace nenoserpent::adapter::bot {
@@ -33,10 +34,10 @@ auto boardIndex(const QPoint& p, const int width) -> int {
   return p.y() * width + p.x();
 }
 
-auto buildBlockedMap(const Snapshot& snapshot, const std::deque<QPoint>& projectedBody)
-  -> std::vector<bool> {
-  std::vector<bool> blocked(static_cast<std::size_t>(snapshot.boardWidth * snapshot.boardHeight),
-                            false);
+void buildBlockedMap(const Snapshot& snapshot,
+                     const nenoserpent::core::SnakeBody& projectedBody,
+                     std::vector<bool>& blocked) {
+  blocked.assign(static_cast<std::size_t>(snapshot.boardWidth * snapshot.boardHeight), false);
 
   if (!snapshot.portalActive && !snapshot.laserActive) {
     for (const QPoint& obstacle : snapshot.obstacles) {
@@ -49,68 +50,31 @@ auto buildBlockedMap(const Snapshot& snapshot, const std::deque<QPoint>& project
       blocked[static_cast<std::size_t>(boardIndex(bodyPart, snapshot.boardWidth))] = true;
     }
   }
-
-  return blocked;
 }
 
-auto floodReachable(const QPoint& start, const Snapshot& snapshot, const std::vector<bool>& blocked)
-  -> int {
-  const int width = snapshot.boardWidth;
-  const int height = snapshot.boardHeight;
-  if (width <= 0 || height <= 0) {
-    return 0;
-  }
-
-  std::vector<bool> visited(blocked.size(), false);
-  std::deque<QPoint> queue;
-  queue.push_back(start);
-  visited[static_cast<std::size_t>(boardIndex(start, width))] = true;
-  int count = 0;
-
-  while (!queue.empty()) {
-    const QPoint current = queue.front();
-    queue.pop_front();
-    ++count;
-
-    for (const QPoint& dir : kDirections) {
-      const QPoint next = nenoserpent::core::wrapPoint(current + dir, width, height);
-      const std::size_t nextIndex = static_cast<std::size_t>(boardIndex(next, width));
-      if (visited[nextIndex] || blocked[nextIndex]) {
-        continue;
-      }
-      visited[nextIndex] = true;
-      queue.push_back(next);
-    }
-  }
-
-  return count;
+auto floodReachable(const QPoint& start,
+                    const Snapshot& snapshot,
+                    const std::vector<bool>& blocked,
+                    SearchScratch& scratch) -> int {
+  return countReachableCells(start, snapshot.boardWidth, snapshot.boardHeight, blocked, scratch);
 }
 
 auto countSafeNeighbors(const QPoint& from,
                         const Snapshot& snapshot,
                         const std::vector<bool>& blocked) -> int {
-  int safe = 0;
-  for (const QPoint& dir : kDirections) {
-    const QPoint next =
-      nenoserpent::core::wrapPoint(from + dir, snapshot.boardWidth, snapshot.boardHeight);
-    const std::size_t index = static_cast<std::size_t>(boardIndex(next, snapshot.boardWidth));
-    if (!blocked[index]) {
-      ++safe;
-    }
-  }
-  return safe;
+  return countOpenNeighbors(from, snapshot.boardWidth, snapshot.boardHeight, blocked);
 }
 
 struct MovePreview {
   bool valid = false;
   QPoint wrappedHead{0, 0};
-  std::deque<QPoint> nextBody;
+  nenoserpent::core::SnakeBody nextBody;
 };
 
 auto previewMove(const Snapshot& snapshot,
                  const QPoint& head,
                  const QPoint& direction,
-                 const std::deque<QPoint>& body,
+                 const nenoserpent::core::SnakeBody& body,
                  const QPoint& candidate) -> MovePreview {
   MovePreview preview{};
   if (isReverseDirection(candidate, direction)) {
@@ -120,7 +84,7 @@ auto previewMove(const Snapshot& snapshot,
   const QPoint nextHead = head + candidate;
   preview.wrappedHead =
     nenoserpent::core::wrapPoint(nextHead, snapshot.boardWidth, snapshot.boardHeight);
-  std::deque<QPoint> collisionBody = body;
+  nenoserpent::core::SnakeBody collisionBody = body;
   const bool wouldEatFood = preview.wrappedHead == snapshot.food;
   if (!wouldEatFood && !collisionBody.empty()) {
     collisionBody.pop_back();
@@ -147,7 +111,7 @@ auto previewMove(const Snapshot& snapshot,
 auto countSafeContinuations(const Snapshot& snapshot,
                             const QPoint& head,
                             const QPoint& direction,
-                            const std::deque<QPoint>& body,
+                            const nenoserpent::core::SnakeBody& body,
                             const int depth) -> int {
   if (depth <= 0) {
     return 0;
@@ -182,6 +146,8 @@ auto pickDirection(const Snapshot& snapshot, const StrategyConfig& config)
 
   const bool hasPowerUp = snapshot.powerUpPos.x() >= 0 && snapshot.powerUpPos.y() >= 0;
   const int priority = powerPriority(config, snapshot.powerUpType);
+  SearchScratch scratch;
+  std::vector<bool>& blocked = scratch.blockedScratch();
 
   for (const QPoint& candidate : kDirections) {
     const auto preview =
@@ -194,12 +160,12 @@ auto pickDirection(const Snapshot& snapshot, const StrategyConfig& config)
     const bool wouldEatFood = wrappedHead == snapshot.food;
     const bool wouldEatPower = hasPowerUp && wrappedHead == snapshot.powerUpPos;
 
-    auto blocked = buildBlockedMap(snapshot, preview.nextBody);
+    buildBlockedMap(snapshot, preview.nextBody, blocked);
     const std::size_t headIndex =
       static_cast<std::size_t>(boardIndex(wrappedHead, snapshot.boardWidth));
     blocked[headIndex] = false;
 
-    const int openSpace = floodReachable(wrappedHead, snapshot, blocked);
+    const int openSpace = floodReachable(wrappedHead, snapshot, blocked, scratch);
     const int safeNeighbors = countSafeNeighbors(wrappedHead, snapshot, blocked);
 
     QPoint target = snapshot.food;
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <deque>
+#include <cstdint>
 #include <optional>
 
 #include <QList>
@@ -8,6 +8,8 @@
 #include <QVariantList>
 
 #include "adapter/bot/config.h"
+#include "core/game/board_geometry.h"
+#include "core/game/body.h"
 
 namespace nenoserpent::adapter::bot {
 
@@ -23,10 +25,12 @@ struct Snapshot {
   bool shieldActive = false;
   bool portalActive = false;
   bool laserActive = false;
-  int boardWidth = 20;
-  int boardHeight = 18;
+  int boardWidth = nenoserpent::core::StandardBoardWidth;
+  int boardHeight = nenoserpent::core::StandardBoardHeight;
   QList<QPoint> obstacles;
-  std::deque<QPoint> body;
+  nenoserpent::core::SnakeBody body;
+  // core::zobristBodyHash(body) when the producer already tracks it; 0 means derive from body.
+  std::uint64_t bodyHash = 0;
 };
 
 [[nodiscard]] auto pickDirection(const Snapshot& snapshot,
@@ -1,7 +1,5 @@
 #include "adapter/bot/features.h"
 
-#include <deque>
-
 #include "core/game/rules.h"
 
 namespace nenoserpent::adapter::bot {
@@ -16,7 +14,7 @@ auto isFatalCollisionOnMove(const Snapshot& snapshot, const QPoint& candidate) -
   const QPoint nextHeadRaw = snapshot.head + candidate;
   const QPoint wrappedHead =
     nenoserpent::core::wrapPoint(nextHeadRaw, snapshot.boardWidth, snapshot.boardHeight);
-  std::deque<QPoint> collisionBody = snapshot.body;
+  nenoserpent::core::SnakeBody collisionBody = snapshot.body;
   const bool wouldEatFood = wrappedHead == snapshot.food;
   if (!wouldEatFood && !collisionBody.empty()) {
     collisionBody.pop_back();
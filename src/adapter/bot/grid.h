@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <QPoint>
+
+#include "core/game/board_geometry.h"
+
+namespace nenoserpent::adapter::bot {
+
+// Grid searches shared by the bot backends. `blocked` is indexed by cell (y * width + x). Each
+// search is written once against a board geometry and dispatched through visitBoardGeometry, so
+// the standard board walks precomputed neighbour tables.
+
+// On large boards every search stops after this many cells, so a move costs at most what it
+// would on a 64x64 board however far the flood could spread.
+inline constexpr std::size_t LargeBoardSearchLimit = nenoserpent::core::LargeBoardCells;
+
+[[nodiscard]] constexpr auto searchLimitFor(const int boardWidth, const int boardHeight)
+  -> std::size_t {
+  return nenoserpent::core::isLargeBoard(boardWidth, boardHeight)
+           ? LargeBoardSearchLimit
+           : std::numeric_limits<std::size_t>::max();
+}
+
+// Buffers the searches reuse from one call to the next. A cell counts as visited while its stamp
+// matches the running search, so starting a search costs nothing however large the board is.
+class SearchScratch {
+public:
+  // Starts a search over `cells` cells, forgetting every cell the previous one visited.
+  void begin(const std::size_t cells) {
+    if (m_stamp.size() < cells) {
+      m_stamp.resize(cells, 0);
+      m_distance.resize(cells, -1);
+      m_parent.resize(cells, -1);
+    }
+    if (++m_search == 0) {
+      std::ranges::fill(m_stamp, 0U);
+      m_search = 1;
+    }
+    m_queue.clear();
+  }
+
+  [[nodiscard]] auto visited(const std::size_t cell) const -> bool {
+    return m_stamp[cell] == m_search;
+  }
+  void visit(const std::size_t cell, const int distance = 0, const int parent = -1) {
+    m_stamp[cell] = m_search;
+    m_distance[cell] = distance;
+    m_parent[cell] = parent;
+  }
+  [[nodiscard]] auto distance(const std::size_t cell) const -> int {
+    return visited(cell) ? m_distance[cell] : -1;
+  }
+  [[nodiscard]] auto parent(const std::size_t cell) const -> int {
+    return visited(cell) ? m_parent[cell] : -1;
+  }
+  [[nodiscard]] auto queue() -> std::vector<int>& {
+    return m_queue;
+  }
+  // A blocked map for callers that rebuild one per candidate move.
+  [[nodiscard]] auto blockedScratch() -> std::vector<bool>& {
+    return m_blocked;
+  }
+
+private:
+  std::vector<std::uint32_t> m_stamp;
+  std::vector<int> m_distance;
+  std::vector<int> m_parent;
+  std::vector<int> m_queue;
+  std::vector<bool> m_blocked;
+  std::uint32_t m_search = 0;
+};
+
+template <typename Geometry>
+auto countReachableCellsOn(const Geometry& board,
+                           const QPoint& start,
+                           const std::vector<bool>& blocked,
+                           SearchScratch& scratch,
+                           const std::size_t limit = std::numeric_limits<std::size_t>::max())
+  -> int {
+  const int startCell = board.cellIndex(board.wrapPoint(start));
+  scratch.begin(blocked.size());
+  std::vector<int>& queue = scratch.queue();
+  queue.push_back(startCell);
+  scratch.visit(static_cast<std::size_t>(startCell));
+  for (std::size_t head = 0; head < queue.size() && queue.size() < limit; ++head) {
+    const int current = queue[head];
+    for (std::size_t step = 0; step < nenoserpent::core::BoardSteps.size(); ++step) {
+      const int next = board.neighbor(current, step);
+      const auto index = static_cast<std::size_t>(next);
+      if (scratch.visited(index) || blocked[index]) {
+        continue;
+      }
+      scratch.visit(index);
+      queue.push_back(next);
+    }
+  }
+  return static_cast<int>(std::min(queue.size(), limit));
+}
+
+template <typename Geometry>
+auto countOpenNeighborsOn(const Geometry& board,
+                          const QPoint& from,
+                          const std::vector<bool>& blocked) -> int {
+  const int cell = board.cellIndex(board.wrapPoint(from));
+  int open = 0;
+  for (std::size_t step = 0; step < nenoserpent::core::BoardSteps.size(); ++step) {
+    if (!blocked[static_cast<std::size_t>(board.neighbor(cell, step))]) {
+      ++open;
+    }
+  }
+  return open;
+}
+
+// Cells reachable from `start` through unblocked cells; `start` itself always counts. Large boards
+// report at most LargeBoardSearchLimit.
+inline auto countReachableCells(const QPoint& start,
+                                const int boardWidth,
+                                const int boardHeight,
+                                const std::vector<bool>& blocked,
+                                SearchScratch& scratch) -> int {
+  if (boardWidth <= 0 || boardHeight <= 0) {
+    return 0;
+  }
+  return nenoserpent::core::visitBoardGeometry(
+    boardWidth, boardHeight, [&](const auto& board) {
+      return countReachableCellsOn(
+        board, start, blocked, scratch, searchLimitFor(boardWidth, boardHeight));
+    });
+}
+
+// Unblocked cells one step from `from`, wrapping at the edges.
+inline auto countOpenNeighbors(const QPoint& from,
+                               const int boardWidth,
+                               const int boardHeight,
+                               const std::vector<bool>& blocked) -> int {
+  if (boardWidth <= 0 || boardHeight <= 0) {
+    return 0;
+  }
+  return nenoserpent::core::visitBoardGeometry(
+    boardWidth, boardHeight, [&](const auto& board) {
+      return countOpenNeighborsOn(board, from, blocked);
+    });
+}
+
+} // namespace nenoserpent::adapter::bot
@@ -3,7 +3,6 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
-#include <deque>
 #include <cmath>
 #include <limits>
 #include <ranges>
@@ -16,7 +15,9 @@
 
 #include "adapter/bot/controller.h"
 #include "adapter/bot/features.h"
+#include "adapter/bot/grid.h"
 #include "core/game/rules.h"
+#include "core/game/zobrist.h"
 
 namespace nenoserpent::adapter::bot {
 
@@ -57,13 +58,6 @@ auto boardIndex(const QPoint& point, const int width) -> int {
   return point.y() * width + point.x();
 }
 
-auto mixHash(std::uint64_t seed, const std::uint64_t value) -> std::uint64_t {
-  constexpr std::uint64_t kPrime = 1099511628211ULL;
-  seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U);
-  seed *= kPrime;
-  return seed;
-}
-
 auto clampedFloat(const QJsonObject& object, const QString& key, const float fallback) -> float {
   const auto value = object.value(key);
   if (!value.isDouble()) {
@@ -129,7 +123,8 @@ auto cornerDistance(const QPoint& point, const Snapshot& snapshot) -> int {
 struct CandidateMetrics {
   QPoint direction{0, 0};
   QPoint nextHead{0, 0};
-  std::deque<QPoint> nextBody;
+  nenoserpent::core::SnakeBody nextBody;
+  std::uint64_t nextBodyHash = 0;
   int openSpace = 0;
   int safeNeighbors = 0;
   int repeats = 0;
@@ -150,10 +145,8 @@ void MlBackend::setConfidenceGate(const float minConfidence, const float minMarg
 }
 
 void MlBackend::reset() {
-  m_recentHashes.clear();
-  m_hashCounts.clear();
-  m_recentOrbitHashes.clear();
-  m_orbitCounts.clear();
+  m_stateHashes.clear();
+  m_orbitHashes.clear();
   m_lastScore = 0;
   m_noScoreTicks = 0;
   m_hasScore = false;
@@ -284,6 +277,8 @@ auto MlBackend::loadFromJson(const QByteArray& jsonBytes, const QString& sourceL
     clampedFloat(hybrid, QStringLiteral("safe_neighbor_weight"), 0.12F);
   m_hybridConfig.hashWindow = std::clamp(clampedInt(hybrid, QStringLiteral("hash_window"), 192), 64, 512);
   m_hybridConfig.tieBreakSeed = clampedInt(hybrid, QStringLiteral("tie_break_seed"), 17);
+  m_stateHashes.setWindow(m_hybridConfig.hashWindow);
+  m_orbitHashes.setWindow(m_hybridConfig.hashWindow);
 
   m_source = sourceLabel;
   m_layers = std::move(parsedLayers);
@@ -371,7 +366,7 @@ auto MlBackend::isDirectionAllowed(const Snapshot& snapshot, const QPoint& candi
   const QPoint nextHeadRaw = snapshot.head + candidate;
   const QPoint wrappedHead =
     nenoserpent::core::wrapPoint(nextHeadRaw, snapshot.boardWidth, snapshot.boardHeight);
-  std::deque<QPoint> collisionBody = snapshot.body;
+  nenoserpent::core::SnakeBody collisionBody = snapshot.body;
   const bool wouldEatFood = wrappedHead == snapshot.food;
   if (!wouldEatFood && !collisionBody.empty()) {
     collisionBody.pop_back();
@@ -391,69 +386,37 @@ auto MlBackend::isDirectionAllowed(const Snapshot& snapshot, const QPoint& candi
 auto MlBackend::stateHash(const Snapshot& snapshot,
                           const QPoint& head,
                           const QPoint& direction,
-                          const std::deque<QPoint>& body) const -> std::uint64_t {
-  std::uint64_t hash = 1469598103934665603ULL;
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.boardWidth));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.boardHeight));
-  hash = mixHash(hash, static_cast<std::uint64_t>(head.x() + 2048));
-  hash = mixHash(hash, static_cast<std::uint64_t>(head.y() + 2048));
-  hash = mixHash(hash, static_cast<std::uint64_t>(direction.x() + 16));
-  hash = mixHash(hash, static_cast<std::uint64_t>(direction.y() + 16));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.food.x() + 2048));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.food.y() + 2048));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.powerUpPos.x() + 2048));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.powerUpPos.y() + 2048));
-  hash = mixHash(hash, static_cast<std::uint64_t>(snapshot.powerUpType + 64));
-  hash = mixHash(hash, static_cast<std::uint64_t>(body.size()));
-  for (const QPoint& segment : body) {
-    hash = mixHash(hash, static_cast<std::uint64_t>(segment.x() + 2048));
-    hash = mixHash(hash, static_cast<std::uint64_t>(segment.y() + 2048));
-  }
-  return hash;
+                          const std::uint64_t bodyHash,
+                          const nenoserpent::core::SnakeBody* body) const -> std::uint64_t {
+  const bool hasBody = body != nullptr && !body->empty();
+  return nenoserpent::core::loopStateHash({
+    .bodyHash = bodyHash,
+    .bodyLength = hasBody ? body->size() : 0U,
+    .head = head,
+    .tail = hasBody ? body->back() : QPoint(),
+    .direction = direction,
+    .food = snapshot.food,
+    .powerUpPos = snapshot.powerUpPos,
+    .powerUpType = snapshot.powerUpType,
+    .boardWidth = snapshot.boardWidth,
+    .boardHeight = snapshot.boardHeight,
+  });
 }
 
 auto MlBackend::loopRepeatsFor(const std::uint64_t hash) const -> int {
-  const auto it = m_hashCounts.find(hash);
-  return it == m_hashCounts.end() ? 0 : it->second;
+  return m_stateHashes.countOf(hash);
 }
 
 auto MlBackend::orbitRepeatsFor(const std::uint64_t hash) const -> int {
-  const auto it = m_orbitCounts.find(hash);
-  return it == m_orbitCounts.end() ? 0 : it->second;
+  return m_orbitHashes.countOf(hash);
 }
 
 auto MlBackend::observeStateHash(const std::uint64_t hash) const -> void {
-  ++m_hashCounts[hash];
-  m_recentHashes.push_back(hash);
-  while (static_cast<int>(m_recentHashes.size()) > m_hybridConfig.hashWindow) {
-    const std::uint64_t dropped = m_recentHashes.front();
-    m_recentHashes.pop_front();
-    auto it = m_hashCounts.find(dropped);
-    if (it == m_hashCounts.end()) {
-      continue;
-    }
-    --it->second;
-    if (it->second <= 0) {
-      m_hashCounts.erase(it);
-    }
-  }
+  m_stateHashes.observe(hash);
 }
 
 auto MlBackend::observeOrbitHash(const std::uint64_t hash) const -> void {
-  ++m_orbitCounts[hash];
-  m_recentOrbitHashes.push_back(hash);
-  while (static_cast<int>(m_recentOrbitHashes.size()) > m_hybridConfig.hashWindow) {
-    const std::uint64_t dropped = m_recentOrbitHashes.front();
-    m_recentOrbitHashes.pop_front();
-    auto it = m_orbitCounts.find(dropped);
-    if (it == m_orbitCounts.end()) {
-      continue;
-    }
-    --it->second;
-    if (it->second <= 0) {
-      m_orbitCounts.erase(it);
-    }
-  }
+  m_orbitHashes.observe(hash);
 }
 
 auto MlBackend::observeScore(const int score) const -> int {
@@ -499,8 +462,9 @@ auto MlBackend::decideDirection(const Snapshot& snapshot, const StrategyConfig&
   const int boardArea = std::max(1, snapshot.boardWidth * snapshot.boardHeight);
   const int maxFoodDistance = std::max(1, (snapshot.boardWidth / 2) + (snapshot.boardHeight / 2));
 
-  auto buildBlockedMap = [&](const std::deque<QPoint>& body) -> std::vector<bool> {
-    std::vector<bool> blocked(static_cast<std::size_t>(boardArea), false);
+  std::vector<bool>& blocked = m_searchScratch.blockedScratch();
+  auto buildBlockedMap = [&](const nenoserpent::core::SnakeBody& body) {
+    blocked.assign(static_cast<std::size_t>(boardArea), false);
     if (!snapshot.portalActive && !snapshot.laserActive) {
       for (const QPoint& obstacle : snapshot.obstacles) {
         blocked[static_cast<std::size_t>(boardIndex(obstacle, snapshot.boardWidth))] = true;
@@ -511,44 +475,15 @@ auto MlBackend::decideDirection(const Snapshot& snapshot, const StrategyConfig&
         blocked[static_cast<std::size_t>(boardIndex(segment, snapshot.boardWidth))] = true;
       }
     }
-    return blocked;
   };
 
-  auto floodReachable = [&](const QPoint& start, const std::vector<bool>& blocked) -> int {
-    std::vector<bool> visited(blocked.size(), false);
-    std::deque<QPoint> queue;
-    queue.push_back(start);
-    visited[static_cast<std::size_t>(boardIndex(start, snapshot.boardWidth))] = true;
-    int reachable = 0;
-    while (!queue.empty()) {
-      const QPoint current = queue.front();
-      queue.pop_front();
-      ++reachable;
-      for (const QPoint& dir : kDirections) {
-        const QPoint next =
-          nenoserpent::core::wrapPoint(current + dir, snapshot.boardWidth, snapshot.boardHeight);
-        const std::size_t idx = static_cast<std::size_t>(boardIndex(next, snapshot.boardWidth));
-        if (visited[idx] || blocked[idx]) {
-          continue;
-        }
-        visited[idx] = true;
-        queue.push_back(next);
-      }
-    }
-    return reachable;
+  auto floodReachable = [&](const QPoint& start) -> int {
+    return countReachableCells(
+      start, snapshot.boardWidth, snapshot.boardHeight, blocked, m_searchScratch);
   };
 
-  auto countSafeNeighbors = [&](const QPoint& from, const std::vector<bool>& blocked) -> int {
-    int safe = 0;
-    for (const QPoint& dir : kDirections) {
-      const QPoint next =
-        nenoserpent::core::wrapPoint(from + dir, snapshot.boardWidth, snapshot.boardHeight);
-      const std::size_t idx = static_cast<std::size_t>(boardIndex(next, snapshot.boardWidth));
-      if (!blocked[idx]) {
-        ++safe;
-      }
-    }
-    return safe;
+  auto countSafeNeighbors = [&](const QPoint& from) -> int {
+    return countOpenNeighbors(from, snapshot.boardWidth, snapshot.boardHeight, blocked);
   };
 
   const QPoint center = boardCenter(snapshot);
@@ -598,6 +533,9 @@ auto MlBackend::decideDirection(const Snapshot& snapshot, const StrategyConfig&
     return factor;
   };
 
+  const std::uint64_t snapshotBodyHash = snapshot.bodyHash != 0
+                                           ? snapshot.bodyHash
+                                           : nenoserpent::core::zobristBodyHash(snapshot.body);
   std::array<CandidateMetrics, 4> candidates{};
   int candidateCount = 0;
 
@@ -609,9 +547,11 @@ auto MlBackend::decideDirection(const Snapshot& snapshot, const StrategyConfig&
     const QPoint nextHeadRaw = snapshot.head + *candidate;
     const QPoint wrappedHead =
       nenoserpent::core::wrapPoint(nextHeadRaw, snapshot.boardWidth, snapshot.boardHeight);
-    std::deque<QPoint> collisionBody = snapshot.body;
+    nenoserpent::core::SnakeBody collisionBody = snapshot.body;
+    std::uint64_t nextBodyHash = snapshotBodyHash;
     const bool wouldEatFood = wrappedHead == snapshot.food;
     if (!wouldEatFood && !collisionBody.empty()) {
+      nextBodyHash ^= nenoserpent::core::zobristCellKey(collisionBody.back());
       collisionBody.pop_back();
     }
     const auto collision = nenoserpent::core::collisionOutcomeForHead(nextHeadRaw,
@@ -626,28 +566,31 @@ auto MlBackend::decideDirection(const Snapshot& snapshot, const StrategyConfig&
     if (collision.collision) {
       continue;
     }
-    std::deque<QPoint> nextBody = collisionBody;
+    nenoserpent::core::SnakeBody nextBody = collisionBody;
     nextBody.push_front(wrappedHead);
+    nextBodyHash ^= nenoserpent::core::zobristCellKey(wrappedHead);
 
-    auto blocked = buildBlockedMap(nextBody);
+    buildBlockedMap(nextBody);
     blocked[static_cast<std::size_t>(boardIndex(wrappedHead, snapshot.boardWidth))] = false;
-    const int openSpace = floodReachable(wrappedHead, blocked);
-    const int safeNeighbors = countSafeNeighbors(wrappedHead, blocked);
+    const int openSpace = floodReachable(wrappedHead);
+    const int safeNeighbors = countSafeNeighbors(wrappedHead);
 
     CandidateMetrics metrics{};
     metrics.direction = *candidate;
     metrics.nextHead = wrappedHead;
     metrics.nextBody = std::move(nextBody);
+    metrics.nextBodyHash = nextBodyHash;
     metrics.openSpace = openSpace;
     metrics.safeNeighbors = safeNeighbors;
     metrics.logit = logits->at(static_cast<std::size_t>(index));
-    metrics.hash = stateHash(snapshot, wrappedHead, *candidate, metrics.nextBody);
+    metrics.hash =
+      stateHash(snapshot, wrappedHead, *candidate, metrics.nextBodyHash, &metrics.nextBody);
     metrics.repeats = loopRepeatsFor(metrics.hash);
     metrics.foodDistance = wrappedManhattanDistance(wrappedHead,
                                                     snapshot.food,
                                                     snapshot.boardWidth,
                                                     snapshot.boardHeight);
-    metrics.orbitHash = stateHash(snapshot, wrappedHead, *candidate, {});
+    metrics.orbitHash = stateHash(snapshot, wrappedHead, *candidate, 0, nullptr);
     metrics.orbitRepeats = orbitRepeatsFor(metrics.orbitHash);
     metrics.tieRank = (index + m_hybridConfig.tieBreakSeed) % static_cast<int>(kDirections.size());
 
@@ -4,13 +4,14 @@
 #include <cstdint>
 #include <deque>
 #include <optional>
-#include <unordered_map>
 #include <vector>
 
 #include <QByteArray>
 #include <QString>
 
 #include "adapter/bot/backend.h"
+#include "adapter/bot/grid.h"
+#include "core/game/hash_window.h"
 
 namespace nenoserpent::adapter::bot {
 
@@ -52,6 +53,8 @@ private:
     std::vector<float> bias;
   };
 
+  static constexpr int kDefaultHashWindow = 192;
+
   struct HybridConfig {
     float logitWeight = 1.0F;
     float riskWeight = 0.9F;
@@ -62,7 +65,7 @@ private:
     float foodWeight = 0.35F;
     float spaceWeight = 0.16F;
     float safeNeighborWeight = 0.12F;
-    int hashWindow = 192;
+    int hashWindow = kDefaultHashWindow;
     int tieBreakSeed = 17;
   };
 
@@ -75,7 +78,8 @@ private:
   [[nodiscard]] auto stateHash(const Snapshot& snapshot,
                                const QPoint& head,
                                const QPoint& direction,
-                               const std::deque<QPoint>& body) const -> std::uint64_t;
+                               std::uint64_t bodyHash,
+                               const nenoserpent::core::SnakeBody* body) const -> std::uint64_t;
   [[nodiscard]] auto loopRepeatsFor(std::uint64_t hash) const -> int;
   [[nodiscard]] auto orbitRepeatsFor(std::uint64_t hash) const -> int;
   auto observeStateHash(std::uint64_t hash) const -> void;
@@ -93,10 +97,8 @@ private:
   HybridConfig m_hybridConfig{};
   float m_minConfidence = 0.55F;
   float m_minMargin = 0.10F;
-  mutable std::deque<std::uint64_t> m_recentHashes;
-  mutable std::unordered_map<std::uint64_t, int> m_hashCounts;
-  mutable std::deque<std::uint64_t> m_recentOrbitHashes;
-  mutable std::unordered_map<std::uint64_t, int> m_orbitCounts;
+  mutable nenoserpent::core::HashWindow m_stateHashes{kDefaultHashWindow};
+  mutable nenoserpent::core::HashWindow m_orbitHashes{kDefaultHashWindow};
   mutable int m_lastScore = 0;
   mutable int m_noScoreTicks = 0;
   mutable bool m_hasScore = false;
@@ -105,6 +107,7 @@ private:
   mutable bool m_hasFoodDistance = false;
   mutable std::deque<QPoint> m_recentDirections;
   mutable std::deque<bool> m_recentEscapeLikeMoves;
+  mutable SearchScratch m_searchScratch;
 };
 
 } // namespace nenoserpent::adapter::bot
@@ -21,6 +21,7 @@ auto buildSnapshot(const SnapshotBuilderInput& input) -> Snapshot {
     .boardHeight = input.boardHeight,
     .obstacles = input.obstacles,
     .body = input.body,
+    .bodyHash = input.bodyHash,
   };
 }
 
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <deque>
+#include <cstdint>
 
 #include <QList>
 #include <QPoint>
@@ -19,10 +19,11 @@ struct SnapshotBuilderInput {
   int levelIndex = 0;
   int activeBuff = 0;
   bool shieldActive = false;
-  int boardWidth = 20;
-  int boardHeight = 18;
+  int boardWidth = nenoserpent::core::StandardBoardWidth;
+  int boardHeight = nenoserpent::core::StandardBoardHeight;
   QList<QPoint> obstacles;
-  std::deque<QPoint> body;
+  nenoserpent::core::SnakeBody body;
+  std::uint64_t bodyHash = 0;
 };
 
 [[nodiscard]] auto buildSnapshot(const SnapshotBuilderInput& input) -> Snapshot;
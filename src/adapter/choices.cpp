@@ -7,14 +7,13 @@
 #include "adapter/models/library.h"
 #include "adapter/profile/bridge.h"
 #include "core/choice/runtime.h"
+#include "core/session/tick_driver.h"
 #include "fsm/game_state.h"
 #include "power_up_id.h"
 
 using namespace Qt::StringLiterals;
 
 namespace {
-constexpr int BuffDurationTicks = 40;
-
 auto choiceSpecForType(const int type) -> std::optional<nenoserpent::core::ChoiceSpec> {
   using nenoserpent::core::ChoiceSpec;
   switch (type) {
@@ -137,7 +136,7 @@ auto easeInOutCubic(const float t) -> float {
 
 void EngineAdapter::generateChoices() {
   const QList<nenoserpent::core::ChoiceSpec> allChoices =
-    nenoserpent::core::pickRoguelikeChoices(m_rng.generate(), 3);
+    nenoserpent::core::pickRoguelikeChoices(drawWord(), 3);
   m_choices = nenoserpent::adapter::buildChoiceModel(allChoices);
   emit choicesChanged();
 }
@@ -178,6 +177,7 @@ void EngineAdapter::selectChoice(const int index) {
 
   if (m_state != AppState::Replaying) {
     m_currentChoiceHistory.append({.frame = m_sessionCore.tickCounter(), .index = index});
+    m_rewind.keepLastTickBody(m_sessionCore);
   }
 
   const auto type = nenoserpent::adapter::choiceTypeAt(m_choices, index);
@@ -185,7 +185,8 @@ void EngineAdapter::selectChoice(const int index) {
     return;
   }
   const int preChoiceTickIntervalMs = gameplayTickIntervalMs();
-  const auto result = m_sessionCore.selectChoice(type.value(), BuffDurationTicks * 2, false);
+  const auto result =
+    m_sessionCore.selectChoice(type.value(), nenoserpent::core::ChoiceBuffDurationTicks, false);
   if (m_state != AppState::Replaying &&
       nenoserpent::adapter::discoverFruit(m_profileManager.get(), type.value())) {
     emit fruitLibraryChanged();
@@ -198,10 +199,10 @@ void EngineAdapter::selectChoice(const int index) {
   }
   if (result.miniApplied) {
     syncSnakeModelFromCore();
-    emit eventPrompt(u"MINI BLITZ! SIZE CUT"_s);
+    emitFramePrompt(u"MINI BLITZ! SIZE CUT"_s);
   }
 
-  emit buffChanged();
+  emitFrameSignal(FrameBuff);
   if (m_state == AppState::Replaying) {
     cancelChoiceSpeedRecovery();
     m_timer->setInterval(gameplayTickIntervalMs());
@@ -4,8 +4,10 @@
 #include <QDateTime>
 #include <QDebug>
 #include <QProcessEnvironment>
+#include <QRandomGenerator>
 
 #include "adapter/bot/facade.h"
+#include "adapter/profile/bridge.h"
 #include "fsm/game_state.h"
 #include "fsm/state_factory.h"
 #include "logging/categories.h"
@@ -59,13 +61,14 @@ auto parseNonNegativeIntEnv(const QString& name, const int fallback) -> int {
 
 EngineAdapter::EngineAdapter(QObject* parent)
     : QObject(parent),
-      m_rng(QRandomGenerator::securelySeeded()),
+      m_rng(QRandomGenerator::global()->generate()),
       m_session(m_sessionCore.state()),
       m_timer(std::make_unique<QTimer>()),
 #ifdef NENOSERPENT_HAS_SENSORS
       m_accelerometer(std::make_unique<QAccelerometer>()),
 #endif
       m_profileManager(std::make_unique<ProfileManager>()),
+      m_persistenceWorker(std::make_unique<nenoserpent::services::PersistenceWorker>()),
       m_inputQueue(m_sessionCore.inputQueue()),
       m_fsmState(nullptr) {
   m_botReportScoreGoal =
@@ -112,10 +115,11 @@ EngineAdapter::EngineAdapter(QObject* parent)
   setupAudioSignals();
   setupSensorRuntime();
   m_snakeModel.setBodyChangedCallback(
-    [this](const std::deque<QPoint>& body) { m_sessionCore.setBody(body); });
+    [this](const nenoserpent::core::SnakeBody& body) { m_sessionCore.setBody(body); });
 
   m_sessionCore.setBody({{10, 10}, {10, 11}, {10, 12}});
   syncSnakeModelFromCore();
+  m_rewind.configure(RewindBudgetBytes);
 
   if (m_botReportScoreGoal > 0) {
     qCInfo(nenoserpentStateLog).noquote()
@@ -147,6 +151,11 @@ EngineAdapter::~EngineAdapter() {
 }
 
 void EngineAdapter::syncSnakeModelFromCore() {
+  // Inside a turbo replay frame the view gets one reset for the whole batch.
+  if (m_replayBatchActive) {
+    m_snakeModelSyncPending = true;
+    return;
+  }
   m_snakeModel.reset(m_sessionCore.body());
 }
 
@@ -262,6 +271,10 @@ void EngineAdapter::setInternalState(const int s) {
     m_previousAudioState = previous;
     m_audioStateToken++;
     m_audioBus.syncPausedState(static_cast<int>(m_state));
+    nenoserpent::adapter::flushPendingWrites(m_profileManager.get());
+    if (previous == AppState::Replaying) {
+      resetReplaySpeed();
+    }
     emit stateChanged();
   }
 }
@@ -307,6 +320,9 @@ void EngineAdapter::stopEngineTimer() {
 }
 
 void EngineAdapter::triggerHaptic(const int magnitude) {
+  if (m_replayBatchActive) {
+    return;
+  }
   emit requestFeedback(magnitude);
   m_haptics.trigger(magnitude);
 }
@@ -2,10 +2,10 @@
 
 #include <QAbstractListModel>
 #include <QColor>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QJSEngine>
 #include <QObject>
-#include <QRandomGenerator>
 #include <QRect>
 #include <QSet>
 #include <QTimer>
@@ -14,8 +14,12 @@
 
 #include "adapter/bot/port.h"
 #include "adapter/haptics/controller.h"
+#include "adapter/session/store.h"
 #include "adapter/ui/action.h"
 #include "app_state.h"
+#include "core/level/schedule.h"
+#include "core/replay/keyframe.h"
+#include "core/replay/rewind.h"
 #include "core/replay/types.h"
 #include "core/session/core.h"
 #include "core/session/state.h"
@@ -23,11 +27,12 @@
 #include "services/audio/bus.h"
 #include "services/level/repository.h"
 #include "services/save/repository.h"
+#include "services/save/worker.h"
 #ifdef NENOSERPENT_HAS_SENSORS
 #include <QAccelerometer>
 #endif
 #include <array>
-#include <deque>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -58,13 +63,13 @@ public:
   [[nodiscard]] auto roleNames() const -> QHash<int, QByteArray> override {
     return {{PositionRole, "pos"}};
   }
-  [[nodiscard]] auto body() const noexcept -> const std::deque<QPoint>& {
+  [[nodiscard]] auto body() const noexcept -> const nenoserpent::core::SnakeBody& {
     return m_body;
   }
-  void setBodyChangedCallback(std::function<void(const std::deque<QPoint>&)> callback) {
+  void setBodyChangedCallback(std::function<void(const nenoserpent::core::SnakeBody&)> callback) {
     m_bodyChangedCallback = std::move(callback);
   }
-  void reset(const std::deque<QPoint>& newBody) {
+  void reset(const nenoserpent::core::SnakeBody& newBody) {
     beginResetModel();
     m_body = newBody;
     endResetModel();
@@ -92,8 +97,8 @@ private:
     }
   }
 
-  std::deque<QPoint> m_body;
-  std::function<void(const std::deque<QPoint>&)> m_bodyChangedCallback;
+  nenoserpent::core::SnakeBody m_body;
+  std::function<void(const nenoserpent::core::SnakeBody&)> m_bodyChangedCallback;
 };
 
 class EngineAdapter final : public QObject, public IGameEngine {
@@ -137,9 +142,6 @@ public:
   [[nodiscard]] auto hasSave() const -> bool override;
   [[nodiscard]] auto hasReplay() const noexcept -> bool override;
 
-  auto advanceSessionStep(const nenoserpent::core::SessionAdvanceConfig& config)
-    -> nenoserpent::core::SessionAdvanceResult override;
-
   void restart() override;
   void startReplay() override;
   void loadLastSession() override;
@@ -214,6 +216,12 @@ public:
   Q_INVOKABLE void handleSelect();
   Q_INVOKABLE void handleStart();
   Q_INVOKABLE void deleteSave();
+  // Takes a live run back about `seconds` (to the rewind keyframe at or before that point) and
+  // pauses it. Returns false when there is nothing to rewind.
+  Q_INVOKABLE bool rewindSeconds(int seconds);
+  // Replay playback speed: 1, 2, 8 or UnlimitedReplaySpeed. Only takes effect while replaying,
+  // and drops back to 1 when the replay ends. Left/right step through the speeds in a replay.
+  Q_INVOKABLE void setReplaySpeed(int speed);
   Q_INVOKABLE void toggleBotAutoplay();
   Q_INVOKABLE void cycleBotMode();
   Q_INVOKABLE void cycleBotStrategyMode();
@@ -304,9 +312,13 @@ public:
   [[nodiscard]] auto botControlPort() const -> nenoserpent::adapter::bot::BotControlPort* {
     return m_botControlPort;
   }
+  [[nodiscard]] auto replaySpeed() const noexcept -> int {
+    return m_replaySpeed;
+  }
 
-  static constexpr int BOARD_WIDTH = 20;
-  static constexpr int BOARD_HEIGHT = 18;
+  static constexpr int BOARD_WIDTH = nenoserpent::core::StandardBoardWidth;
+  static constexpr int BOARD_HEIGHT = nenoserpent::core::StandardBoardHeight;
+  static constexpr int UnlimitedReplaySpeed = 0;
 
 signals:
   void foodChanged();
@@ -336,6 +348,7 @@ signals:
   void eventPrompt(QString text);
   void botAutoplayChanged();
   void botStrategyChanged();
+  void replaySpeedChanged();
 
   void foodEaten(float pan);
   void powerUpEaten();
@@ -358,14 +371,33 @@ private slots:
 private:
   void setupAudioSignals();
   void setupSensorRuntime();
-  void applyReplayTimelineForCurrentTick(int& inputHistoryIndex, int& choiceHistoryIndex);
-  void applyPostTickTasks();
+  void runSimulationTick();
+  void advanceSessionTick(bool replaying);
+  void trackReplayChecksum();
+  void captureReplayKeyframe();
   auto driveBotAutoplay() -> bool;
   void updateReflectionFallback();
   [[nodiscard]] auto initialGameplayIntervalMs() const -> int;
   [[nodiscard]] auto gameplayTickIntervalMs() const -> int;
+  [[nodiscard]] auto simulatedTickIntervalMs() const -> int;
+  [[nodiscard]] auto turboReplayActive() const -> bool;
+  void stepReplaySpeed(int step);
+  void resetReplaySpeed();
+  void advanceTurboReplay();
+  void flushReplayFrame();
+  // Inside a turbo replay frame these hold the signal for flushReplayFrame(); otherwise they emit.
+  enum FrameSignal : std::uint8_t {
+    FrameScore = 1U << 0U,
+    FrameFood = 1U << 1U,
+    FrameObstacles = 1U << 2U,
+    FramePowerUp = 1U << 3U,
+    FrameBuff = 1U << 4U,
+  };
+  void emitFrameSignal(FrameSignal signal);
+  void emitFramePrompt(const QString& text);
   void dispatchStateCallback(const std::function<void(GameState&)>& callback);
   void applyPendingStateChangeIfNeeded();
+  void applySessionStepEffects(const nenoserpent::core::SessionAdvanceResult& result);
   void applyCollisionMitigationEffects(const nenoserpent::core::SessionAdvanceResult& result);
   void applyChoiceTransition();
   void applyFoodConsumptionEffects(float pan, bool triggerChoice, bool spawnPowerUp);
@@ -380,6 +412,7 @@ private:
   void spawnPowerUp();
   void syncSnakeModelFromCore();
   void updateHighScore();
+  void archiveFinishedRun();
   void saveCurrentState();
   void clearSavedState();
   void resetTransientRuntimeState();
@@ -388,15 +421,23 @@ private:
   void loadLevelData(int index);
   void applyFallbackLevelData(int levelIndex);
   void checkAchievements();
+  auto startObstacleAnimation(const nenoserpent::core::ObstacleAnimation& animation) -> bool;
+  void compileLevelSchedule(const QString& script, int declaredPeriodTicks);
   void runLevelScript();
   void initHumanTeachCapture();
   void recordHumanTeachSample(int dx, int dy);
   void appendHumanTeachCsvRow(const std::array<float, 21>& features, int action);
   static auto isOutOfBounds(const QPoint& p) noexcept -> bool;
+  // Every draw from m_rng goes through these, so m_rngDraws counts the draws that rewind marks
+  // and replay keyframes refer to.
+  auto drawBounded(int bound) -> int;
+  auto drawWord() -> quint32;
+  [[nodiscard]] auto rewindMarks() const -> nenoserpent::core::RewindMarks;
+  void applyRewindMarks(const nenoserpent::core::RewindMarks& marks);
   [[nodiscard]] auto saveRepository() const -> nenoserpent::services::SaveRepository;
 
   SnakeModel m_snakeModel;
-  QRandomGenerator m_rng;
+  nenoserpent::core::ReplayRng m_rng;
   nenoserpent::core::SessionCore m_sessionCore;
   nenoserpent::core::SessionState& m_session;
   AppState::Value m_state = AppState::Splash;
@@ -415,20 +456,49 @@ private:
   QList<ReplayFrame> m_bestInputHistory;
   QList<ChoiceRecord> m_currentChoiceHistory;
   QList<ChoiceRecord> m_bestChoiceHistory;
+  QList<ChecksumRecord> m_currentChecksumHistory;
+  QList<nenoserpent::core::ReplayKeyframe> m_currentKeyframes;
+  QList<ChecksumRecord> m_bestChecksumHistory;
+  // The continue save. Held here so hasSave and resume never wait on the write behind it.
+  std::optional<nenoserpent::adapter::PersistedSession> m_savedSession;
+  quint64 m_rollingChecksum = 0;
   bool m_hasAccelerometerReading = false;
   int m_audioStateToken = 0;
   uint m_randomSeed = 0;
+  quint64 m_rngDraws = 0;
+  static constexpr std::size_t RewindBudgetBytes = std::size_t{1} << 20;
+  nenoserpent::core::RewindBuffer m_rewind;
   uint m_bestRandomSeed = 0;
   int m_bestLevelIndex = 0;
   int m_ghostFrameIndex = 0;
   int m_replayInputHistoryIndex = 0;
   int m_replayChoiceHistoryIndex = 0;
+  int m_replayChecksumIndex = 0;
+  bool m_replayChecksumDiverged = false;
+  // Turbo replay runs at frame cadence and batches ticks; see advanceTurboReplay().
+  static constexpr int ReplayFrameIntervalMs = 16;
+  static constexpr qint64 ReplayFrameBudgetMs = 12;
+  static constexpr qint64 ReplayMaxCatchUpMs = 100;
+  int m_replaySpeed = 1;
+  qint64 m_replayBacklogMs = 0;
+  QElapsedTimer m_replayFrameClock;
+  bool m_replayBatchActive = false;
+  bool m_snakeModelSyncPending = false;
+  std::uint8_t m_pendingFrameSignals = 0;
+  // Only the latest prompt of a frame is shown.
+  QString m_pendingFramePrompt;
   qint64 m_sessionStartTime = 0;
   qint64 m_lastUiInteractAudioMs = 0;
   nenoserpent::adapter::haptics::Controller m_haptics;
   QPointF m_reflectionOffset = {0.0, 0.0};
   QJSEngine m_jsEngine;
   QString m_currentScript;
+  // Layouts of the current level's walls when they move on a fixed cycle: its declarative
+  // animation, or its script when that is pure and periodic. Otherwise the script runs live.
+  std::optional<nenoserpent::core::ObstacleSchedule> m_obstacleSchedule;
+  // Cached layouts of m_scheduledScript; see compileLevelSchedule().
+  QString m_scheduledScript;
+  std::optional<nenoserpent::core::ObstacleSchedule> m_scriptSchedule;
   nenoserpent::services::AudioBus m_audioBus;
   nenoserpent::services::LevelRepository m_levelRepository;
 
@@ -437,7 +507,8 @@ private:
   std::unique_ptr<QAccelerometer> m_accelerometer;
 #endif
   std::unique_ptr<ProfileManager> m_profileManager;
-  std::deque<QPoint>& m_inputQueue;
+  std::unique_ptr<nenoserpent::services::PersistenceWorker> m_persistenceWorker;
+  nenoserpent::core::DirectionQueue& m_inputQueue;
   std::unique_ptr<GameState> m_fsmState;
   bool m_musicEnabled = true;
   int m_bgmVariant = 0;
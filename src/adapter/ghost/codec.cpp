@@ -0,0 +1,415 @@
+#include "adapter/ghost/codec.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <QDataStream>
+#include <QtEndian>
+
+namespace nenoserpent::adapter {
+
+namespace {
+constexpr quint16 HasRecordingFlag = 0x1;
+constexpr qsizetype HeaderSize = 8;
+constexpr qsizetype IndexEntrySize = 12;
+// The keyframe sections are QDataStream payloads; pinned so a Qt upgrade cannot change the layout
+// under a saved ghost.
+constexpr auto KeyframeStreamVersion = QDataStream::Qt_6_7;
+
+void putU16(QByteArray& out, const quint16 value) {
+  out.append(static_cast<char>(value & 0xFFU));
+  out.append(static_cast<char>(value >> 8U));
+}
+
+void putU32(QByteArray& out, const quint32 value) {
+  putU16(out, static_cast<quint16>(value & 0xFFFFU));
+  putU16(out, static_cast<quint16>(value >> 16U));
+}
+
+void putU64(QByteArray& out, const quint64 value) {
+  putU32(out, static_cast<quint32>(value & 0xFFFFFFFFU));
+  putU32(out, static_cast<quint32>(value >> 32U));
+}
+
+void putVarint(QByteArray& out, quint64 value) {
+  while (value >= 0x80U) {
+    out.append(static_cast<char>((value & 0x7FU) | 0x80U));
+    value >>= 7U;
+  }
+  out.append(static_cast<char>(value));
+}
+
+void putSigned(QByteArray& out, const qint64 value) {
+  putVarint(out, (static_cast<quint64>(value) << 1U) ^ static_cast<quint64>(value >> 63));
+}
+
+// Bounds-checked cursor over one section. Reads past the end yield 0 and mark it failed, so
+// callers check ok() once at the end instead of after every field.
+class Reader {
+public:
+  Reader(const uchar* data, const qsizetype size)
+      : m_pos(data),
+        m_end(data + size) {
+  }
+
+  [[nodiscard]] auto ok() const -> bool {
+    return m_ok;
+  }
+
+  auto varint() -> quint64 {
+    quint64 value = 0;
+    for (unsigned shift = 0; shift < 64U; shift += 7U) {
+      if (m_pos == m_end) {
+        m_ok = false;
+        return 0;
+      }
+      const uchar byte = *m_pos++;
+      value |= static_cast<quint64>(byte & 0x7FU) << shift;
+      if ((byte & 0x80U) == 0) {
+        return value;
+      }
+    }
+    m_ok = false;
+    return 0;
+  }
+
+  auto signedVarint() -> qint64 {
+    const quint64 raw = varint();
+    return static_cast<qint64>(raw >> 1U) ^ -static_cast<qint64>(raw & 1U);
+  }
+
+  auto u64() -> quint64 {
+    if (m_end - m_pos < 8) {
+      m_ok = false;
+      return 0;
+    }
+    quint64 value = 0;
+    for (unsigned i = 0; i < 8U; ++i) {
+      value |= static_cast<quint64>(*m_pos++) << (8U * i);
+    }
+    return value;
+  }
+
+  // Element count, rejected when the section cannot hold that many (every element is at least
+  // one byte), so a corrupt count never drives a huge reserve.
+  auto count() -> qsizetype {
+    const quint64 value = varint();
+    if (value > static_cast<quint64>(m_end - m_pos)) {
+      m_ok = false;
+      return 0;
+    }
+    return static_cast<qsizetype>(value);
+  }
+
+private:
+  const uchar* m_pos;
+  const uchar* m_end;
+  bool m_ok = true;
+};
+
+// Corrupt deltas may push a running value out of range; wrap instead of overflowing.
+auto addDelta(const int value, const qint64 delta) -> int {
+  return static_cast<int>(static_cast<quint32>(value) + static_cast<quint32>(delta));
+}
+
+auto readU16(const uchar* data) -> quint16 {
+  return static_cast<quint16>(data[0] | (data[1] << 8U));
+}
+
+auto readU32(const uchar* data) -> quint32 {
+  return static_cast<quint32>(readU16(data)) | (static_cast<quint32>(readU16(data + 2)) << 16U);
+}
+
+auto encodeInputs(const QList<ReplayFrame>& frames) -> QByteArray {
+  QByteArray out;
+  out.reserve(frames.size() * 3 + 4);
+  putVarint(out, static_cast<quint64>(frames.size()));
+  int previous = 0;
+  for (const ReplayFrame& frame : frames) {
+    putSigned(out, qint64{frame.frame} - previous);
+    putSigned(out, frame.dx);
+    putSigned(out, frame.dy);
+    previous = frame.frame;
+  }
+  return out;
+}
+
+auto encodeChoices(const QList<ChoiceRecord>& choices) -> QByteArray {
+  QByteArray out;
+  putVarint(out, static_cast<quint64>(choices.size()));
+  int previous = 0;
+  for (const ChoiceRecord& choice : choices) {
+    putSigned(out, qint64{choice.frame} - previous);
+    putSigned(out, choice.index);
+    previous = choice.frame;
+  }
+  return out;
+}
+
+auto encodeChecksums(const QList<ChecksumRecord>& checksums) -> QByteArray {
+  QByteArray out;
+  out.reserve(checksums.size() * 9 + 4);
+  putVarint(out, static_cast<quint64>(checksums.size()));
+  int previous = 0;
+  for (const ChecksumRecord& record : checksums) {
+    putSigned(out, qint64{record.frame} - previous);
+    putU64(out, record.checksum);
+    previous = record.frame;
+  }
+  return out;
+}
+
+// Consecutive heads differ by one step (or a wrap), so deltas stay within a byte per axis.
+auto encodeRecording(const QList<QPoint>& recording) -> QByteArray {
+  QByteArray out;
+  out.reserve(recording.size() * 2 + 8);
+  putVarint(out, static_cast<quint64>(recording.size()));
+  QPoint previous(0, 0);
+  for (const QPoint& point : recording) {
+    putSigned(out, qint64{point.x()} - previous.x());
+    putSigned(out, qint64{point.y()} - previous.y());
+    previous = point;
+  }
+  return out;
+}
+} // namespace
+
+auto encodeGhostV5(const GhostSnapshot& snapshot, const bool includeRecording) -> QByteArray {
+  const bool storeRecording = includeRecording && !snapshot.recording.isEmpty();
+  const int recordedMoves = snapshot.recording.isEmpty()
+                              ? snapshot.recordedMoves
+                              : static_cast<int>(snapshot.recording.size());
+
+  std::vector<std::pair<GhostFileView::Section, QByteArray>> sections;
+  QByteArray meta;
+  putVarint(meta, snapshot.randomSeed);
+  putSigned(meta, snapshot.levelIndex);
+  putVarint(meta, static_cast<quint64>(std::max(0, recordedMoves)));
+  sections.emplace_back(GhostFileView::Section::Meta, std::move(meta));
+  sections.emplace_back(GhostFileView::Section::Inputs, encodeInputs(snapshot.inputHistory));
+  sections.emplace_back(GhostFileView::Section::Choices, encodeChoices(snapshot.choiceHistory));
+  if (!snapshot.checksumHistory.isEmpty()) {
+    sections.emplace_back(GhostFileView::Section::Checksums,
+                          encodeChecksums(snapshot.checksumHistory));
+  }
+  if (!snapshot.keyframes.isEmpty()) {
+    QByteArray keyframes;
+    QDataStream stream(&keyframes, QIODevice::WriteOnly);
+    stream.setVersion(KeyframeStreamVersion);
+    stream << snapshot.keyframes;
+    sections.emplace_back(GhostFileView::Section::Keyframes, std::move(keyframes));
+  }
+  const bool keyframesHaveRng =
+    std::ranges::all_of(snapshot.keyframes, [](const nenoserpent::core::ReplayKeyframe& keyframe) {
+      return keyframe.rng.has_value();
+    });
+  if (!snapshot.keyframes.isEmpty() && keyframesHaveRng) {
+    QByteArray states;
+    QDataStream stream(&states, QIODevice::WriteOnly);
+    stream.setVersion(KeyframeStreamVersion);
+    stream << static_cast<quint32>(snapshot.keyframes.size());
+    for (const auto& keyframe : snapshot.keyframes) {
+      stream << *keyframe.rng;
+    }
+    sections.emplace_back(GhostFileView::Section::KeyframeRng, std::move(states));
+  }
+  if (storeRecording) {
+    sections.emplace_back(GhostFileView::Section::Recording,
+                          encodeRecording(snapshot.recording));
+  }
+
+  qsizetype total = HeaderSize + (IndexEntrySize * static_cast<qsizetype>(sections.size()));
+  for (const auto& [id, payload] : sections) {
+    total += payload.size();
+  }
+  QByteArray out;
+  out.reserve(total);
+  // The magic is big-endian, as QDataStream wrote it for v2 and v4.
+  for (const unsigned shift : {24U, 16U, 8U, 0U}) {
+    out.append(static_cast<char>((GhostFileMagicV5 >> shift) & 0xFFU));
+  }
+  putU16(out, storeRecording ? HasRecordingFlag : 0);
+  putU16(out, static_cast<quint16>(sections.size()));
+  auto offset =
+    static_cast<quint32>(HeaderSize + (IndexEntrySize * static_cast<qsizetype>(sections.size())));
+  for (const auto& [id, payload] : sections) {
+    putU16(out, static_cast<quint16>(id));
+    putU16(out, 0);
+    putU32(out, offset);
+    putU32(out, static_cast<quint32>(payload.size()));
+    offset += static_cast<quint32>(payload.size());
+  }
+  for (const auto& [id, payload] : sections) {
+    out.append(payload);
+  }
+  return out;
+}
+
+auto GhostFileView::open(const QStringView filePath) -> bool {
+  m_file.close();
+  m_fallback.clear();
+  m_file.setFileName(filePath.toString());
+  if (!m_file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+  const qint64 size = m_file.size();
+  if (size < HeaderSize) {
+    return false;
+  }
+  const uchar* data = m_file.map(0, size);
+  if (data == nullptr) {
+    // Some file systems cannot map; fall back to one read.
+    m_fallback = m_file.readAll();
+    data = reinterpret_cast<const uchar*>(m_fallback.constData());
+  }
+  return parse(data, static_cast<qsizetype>(size));
+}
+
+auto GhostFileView::openBytes(const QByteArray& bytes) -> bool {
+  m_file.close();
+  m_fallback.clear();
+  return parse(reinterpret_cast<const uchar*>(bytes.constData()), bytes.size());
+}
+
+auto GhostFileView::parse(const uchar* data, const qsizetype size) -> bool {
+  m_sections = {};
+  if (size < HeaderSize || qFromBigEndian<quint32>(data) != GhostFileMagicV5) {
+    return false;
+  }
+  const qsizetype sectionCount = readU16(data + 6);
+  if (size < HeaderSize + (sectionCount * IndexEntrySize)) {
+    return false;
+  }
+  for (qsizetype i = 0; i < sectionCount; ++i) {
+    const uchar* entry = data + HeaderSize + (i * IndexEntrySize);
+    const quint16 id = readU16(entry);
+    const qsizetype offset = readU32(entry + 4);
+    const qsizetype length = readU32(entry + 8);
+    if (offset > size || length > size - offset) {
+      return false;
+    }
+    if (id < SectionSlots) {
+      m_sections[id] = {.data = data + offset, .size = length};
+    }
+  }
+
+  const Span meta = section(Section::Meta);
+  if (meta.data == nullptr) {
+    return false;
+  }
+  Reader reader(meta.data, meta.size);
+  m_randomSeed = static_cast<uint>(reader.varint());
+  m_levelIndex = static_cast<int>(reader.signedVarint());
+  m_recordedMoves = static_cast<int>(reader.varint());
+  return reader.ok();
+}
+
+auto GhostFileView::section(const Section section) const -> Span {
+  return m_sections[static_cast<std::size_t>(section)];
+}
+
+auto GhostFileView::hasSection(const Section section) const -> bool {
+  return this->section(section).data != nullptr;
+}
+
+auto GhostFileView::decode(GhostSnapshot& snapshot) const -> bool {
+  snapshot = {};
+  snapshot.randomSeed = m_randomSeed;
+  snapshot.levelIndex = m_levelIndex;
+  snapshot.recordedMoves = m_recordedMoves;
+
+  if (const Span inputs = section(Section::Inputs); inputs.data != nullptr) {
+    Reader reader(inputs.data, inputs.size);
+    const qsizetype count = reader.count();
+    snapshot.inputHistory.reserve(count);
+    int frame = 0;
+    for (qsizetype i = 0; i < count && reader.ok(); ++i) {
+      frame = addDelta(frame, reader.signedVarint());
+      const auto dx = static_cast<int>(reader.signedVarint());
+      const auto dy = static_cast<int>(reader.signedVarint());
+      snapshot.inputHistory.push_back({.frame = frame, .dx = dx, .dy = dy});
+    }
+    if (!reader.ok()) {
+      return false;
+    }
+  }
+
+  if (const Span choices = section(Section::Choices); choices.data != nullptr) {
+    Reader reader(choices.data, choices.size);
+    const qsizetype count = reader.count();
+    snapshot.choiceHistory.reserve(count);
+    int frame = 0;
+    for (qsizetype i = 0; i < count && reader.ok(); ++i) {
+      frame = addDelta(frame, reader.signedVarint());
+      snapshot.choiceHistory.push_back(
+        {.frame = frame, .index = static_cast<int>(reader.signedVarint())});
+    }
+    if (!reader.ok()) {
+      return false;
+    }
+  }
+
+  if (const Span checksums = section(Section::Checksums); checksums.data != nullptr) {
+    Reader reader(checksums.data, checksums.size);
+    const qsizetype count = reader.count();
+    snapshot.checksumHistory.reserve(count);
+    int frame = 0;
+    for (qsizetype i = 0; i < count && reader.ok(); ++i) {
+      frame = addDelta(frame, reader.signedVarint());
+      snapshot.checksumHistory.push_back({.frame = frame, .checksum = reader.u64()});
+    }
+    if (!reader.ok()) {
+      return false;
+    }
+  }
+
+  if (const Span keyframes = section(Section::Keyframes); keyframes.data != nullptr) {
+    const QByteArray raw =
+      QByteArray::fromRawData(reinterpret_cast<const char*>(keyframes.data), keyframes.size);
+    QDataStream stream(raw);
+    stream.setVersion(KeyframeStreamVersion);
+    stream >> snapshot.keyframes;
+    if (stream.status() != QDataStream::Ok) {
+      return false;
+    }
+  }
+
+  if (const Span states = section(Section::KeyframeRng); states.data != nullptr) {
+    const QByteArray raw =
+      QByteArray::fromRawData(reinterpret_cast<const char*>(states.data), states.size);
+    QDataStream stream(raw);
+    stream.setVersion(KeyframeStreamVersion);
+    quint32 count = 0;
+    stream >> count;
+    if (count != static_cast<quint32>(snapshot.keyframes.size())) {
+      return false;
+    }
+    for (auto& keyframe : snapshot.keyframes) {
+      nenoserpent::core::ReplayRng rng;
+      stream >> rng;
+      keyframe.rng = rng;
+    }
+    if (stream.status() != QDataStream::Ok) {
+      return false;
+    }
+  }
+
+  if (const Span recording = section(Section::Recording); recording.data != nullptr) {
+    Reader reader(recording.data, recording.size);
+    const qsizetype count = reader.count();
+    snapshot.recording.reserve(count);
+    QPoint point(0, 0);
+    for (qsizetype i = 0; i < count && reader.ok(); ++i) {
+      point.rx() = addDelta(point.x(), reader.signedVarint());
+      point.ry() = addDelta(point.y(), reader.signedVarint());
+      snapshot.recording.push_back(point);
+    }
+    if (!reader.ok()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace nenoserpent::adapter
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <QByteArray>
+#include <QFile>
+#include <QStringView>
+
+#include "adapter/ghost/store.h"
+
+namespace nenoserpent::adapter {
+
+inline constexpr quint32 GhostFileMagicV5 = 0x534E4B05;
+
+// v5 layout: big-endian magic, read the way QDataStream wrote the v2 and v4 magics, then a
+// little-endian header index of {id, offset, size} sections. Builds from before v5 accept any
+// magic from v2 up as a v2 file, so they misread a v5 ghost rather than rejecting it. Frames are
+// delta + zigzag-varint encoded; the recording is optional because it can be re-derived from seed
+// and inputs. Unknown sections are skipped.
+[[nodiscard]] auto encodeGhostV5(const GhostSnapshot& snapshot, bool includeRecording)
+  -> QByteArray;
+
+// Read-only view of a v5 ghost file. The file is memory-mapped and every section is decoded
+// straight from the mapping; header fields are available without decoding any section.
+class GhostFileView {
+public:
+  enum class Section : quint16 {
+    Meta = 1,
+    Inputs = 2,
+    Choices = 3,
+    Checksums = 4,
+    Keyframes = 5,
+    Recording = 6,
+    // Generator state per keyframe, in keyframe order; older files have keyframes without it.
+    KeyframeRng = 7,
+  };
+
+  auto open(QStringView filePath) -> bool;
+  // Views bytes owned by the caller, which must outlive the view.
+  auto openBytes(const QByteArray& bytes) -> bool;
+
+  [[nodiscard]] auto randomSeed() const -> uint {
+    return m_randomSeed;
+  }
+  [[nodiscard]] auto levelIndex() const -> int {
+    return m_levelIndex;
+  }
+  [[nodiscard]] auto recordedMoves() const -> int {
+    return m_recordedMoves;
+  }
+  [[nodiscard]] auto hasSection(Section section) const -> bool;
+
+  [[nodiscard]] auto decode(GhostSnapshot& snapshot) const -> bool;
+
+private:
+  struct Span {
+    const uchar* data = nullptr;
+    qsizetype size = 0;
+  };
+
+  auto parse(const uchar* data, qsizetype size) -> bool;
+  [[nodiscard]] auto section(Section section) const -> Span;
+
+  static constexpr std::size_t SectionSlots = 8;
+
+  QFile m_file;
+  QByteArray m_fallback;
+  std::array<Span, SectionSlots> m_sections{};
+  uint m_randomSeed = 0;
+  int m_levelIndex = 0;
+  int m_recordedMoves = 0;
+};
+
+} // namespace nenoserpent::adapter
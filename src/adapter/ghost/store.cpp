@@ -1,8 +1,11 @@
 #include "adapter/ghost/store.h"
 
+#include "adapter/ghost/codec.h"
+
 #include <QDataStream>
 #include <QDir>
 #include <QFile>
+#include <QSaveFile>
 #include <QStandardPaths>
 
 using namespace Qt::StringLiterals;
@@ -30,28 +33,40 @@ auto loadGhostSnapshotFromFile(const QStringView filePath, GhostSnapshot& snapsh
   QDataStream in(&file);
   quint32 magic = 0;
   in >> magic;
+  if (magic == GhostFileMagicV5) {
+    file.close();
+    GhostFileView view;
+    return view.open(filePath) && view.decode(snapshot);
+  }
   if (magic == GhostFileMagicV4) {
     in >> snapshot.recording >> snapshot.randomSeed >> snapshot.inputHistory >>
       snapshot.levelIndex >> snapshot.choiceHistory;
+    snapshot.checksumHistory.clear();
+    snapshot.keyframes.clear();
+    snapshot.recordedMoves = static_cast<int>(snapshot.recording.size());
     return true;
   }
-  if (magic >= GhostFileMagicV2) {
+  if (magic >= GhostFileMagicV2 && magic < GhostFileMagicV4) {
     in >> snapshot.recording >> snapshot.randomSeed >> snapshot.inputHistory >> snapshot.levelIndex;
     snapshot.choiceHistory.clear();
+    snapshot.checksumHistory.clear();
+    snapshot.keyframes.clear();
+    snapshot.recordedMoves = static_cast<int>(snapshot.recording.size());
     return true;
   }
   return false;
 }
 
-auto saveGhostSnapshotToFile(const QStringView filePath, const GhostSnapshot& snapshot) -> bool {
-  QFile file(filePath.toString());
+auto saveGhostSnapshotToFile(const QStringView filePath,
+                             const GhostSnapshot& snapshot,
+                             const GhostSaveOptions options) -> bool {
+  // Written beside the target and renamed over it, so a crash mid-write keeps the old ghost.
+  QSaveFile file(filePath.toString());
   if (!file.open(QIODevice::WriteOnly)) {
     return false;
   }
-  QDataStream out(&file);
-  out << GhostFileMagicV4 << snapshot.recording << snapshot.randomSeed << snapshot.inputHistory
-      << snapshot.levelIndex << snapshot.choiceHistory;
-  return out.status() == QDataStream::Ok;
+  const QByteArray bytes = encodeGhostV5(snapshot, options.includeRecording);
+  return file.write(bytes) == bytes.size() && file.commit();
 }
 
 auto loadGhostSnapshot(GhostSnapshot& snapshot) -> bool {
@@ -60,10 +75,10 @@ auto loadGhostSnapshot(GhostSnapshot& snapshot) -> bool {
   return loadGhostSnapshotFromFile(ghostFilePathForDirectory(appDataDirectory), snapshot);
 }
 
-auto saveGhostSnapshot(const GhostSnapshot& snapshot) -> bool {
+auto saveGhostSnapshot(const GhostSnapshot& snapshot, const GhostSaveOptions options) -> bool {
   const QString appDataDirectory =
     QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-  return saveGhostSnapshotToFile(ghostFilePathForDirectory(appDataDirectory), snapshot);
+  return saveGhostSnapshotToFile(ghostFilePathForDirectory(appDataDirectory), snapshot, options);
 }
 
 } // namespace nenoserpent::adapter
@@ -5,6 +5,7 @@
 #include <QString>
 #include <QStringView>
 
+#include "core/replay/keyframe.h"
 #include "core/replay/types.h"
 
 namespace nenoserpent::adapter {
@@ -15,13 +16,26 @@ struct GhostSnapshot {
   QList<ReplayFrame> inputHistory;
   int levelIndex = 0;
   QList<ChoiceRecord> choiceHistory;
+  // These trail the v4 payload; files written before they existed end early and load them empty.
+  QList<ChecksumRecord> checksumHistory;
+  QList<nenoserpent::core::ReplayKeyframe> keyframes;
+  // Movements in the run. Equals recording.size() unless a v5 file was saved without it.
+  int recordedMoves = 0;
+};
+
+struct GhostSaveOptions {
+  // Ghost playback draws the recording; archives that only re-verify can leave it out and
+  // re-derive it from the seed and inputs.
+  bool includeRecording = true;
 };
 
 [[nodiscard]] auto ghostFilePathForDirectory(QStringView appDataDirectory) -> QString;
 [[nodiscard]] auto loadGhostSnapshotFromFile(QStringView filePath, GhostSnapshot& snapshot) -> bool;
-[[nodiscard]] auto saveGhostSnapshotToFile(QStringView filePath, const GhostSnapshot& snapshot)
-  -> bool;
+[[nodiscard]] auto saveGhostSnapshotToFile(QStringView filePath,
+                                           const GhostSnapshot& snapshot,
+                                           GhostSaveOptions options = {}) -> bool;
 [[nodiscard]] auto loadGhostSnapshot(GhostSnapshot& snapshot) -> bool;
-[[nodiscard]] auto saveGhostSnapshot(const GhostSnapshot& snapshot) -> bool;
+[[nodiscard]] auto saveGhostSnapshot(const GhostSnapshot& snapshot, GhostSaveOptions options = {})
+  -> bool;
 
 } // namespace nenoserpent::adapter
@@ -64,6 +64,9 @@ void EngineAdapter::move(const int dx, const int dy) {
     recordHumanTeachSample(dx, dy);
     emit uiInteractTriggered();
   }
+  if (m_state == AppState::Replaying && dx != 0) {
+    stepReplaySpeed(dx);
+  }
 }
 
 void EngineAdapter::initHumanTeachCapture() {
@@ -132,6 +135,7 @@ void EngineAdapter::recordHumanTeachSample(const int dx, const int dy) {
     .boardHeight = BOARD_HEIGHT,
     .obstacles = m_session.obstacles,
     .body = m_sessionCore.body(),
+    .bodyHash = m_sessionCore.bodyHash(),
   });
   appendHumanTeachCsvRow(nenoserpent::adapter::bot::extractFeatures(snapshot).values, action);
 }
@@ -2,14 +2,24 @@
 
 namespace nenoserpent::adapter {
 
-auto applyResolvedLevelData(const nenoserpent::core::ResolvedLevelData& resolvedLevel,
-                            QString& currentLevelName,
-                            QString& currentScript,
-                            QList<QPoint>& obstacles,
-                            const std::function<bool(const QString&)>& evaluateAndRunScript)
-  -> bool {
+auto applyResolvedLevelData(
+  const nenoserpent::core::ResolvedLevelData& resolvedLevel,
+  QString& currentLevelName,
+  QString& currentScript,
+  QList<QPoint>& obstacles,
+  const std::function<bool(const QString&)>& evaluateAndRunScript,
+  const std::function<bool(const nenoserpent::core::ObstacleAnimation&)>& startAnimation) -> bool {
   currentLevelName = resolvedLevel.name;
   obstacles.clear();
+
+  if (resolvedLevel.animation.has_value()) {
+    currentScript.clear();
+    if (!startAnimation || !startAnimation(*resolvedLevel.animation)) {
+      return false;
+    }
+    return !obstacles.isEmpty();
+  }
+
   currentScript = resolvedLevel.script;
 
   if (!currentScript.isEmpty()) {
@@ -12,11 +12,14 @@ namespace nenoserpent::adapter {
 
 // Applies resolved level data into runtime fields.
 // Returns true when resolved data is accepted, false when caller should fallback.
-[[nodiscard]] auto
-applyResolvedLevelData(const nenoserpent::core::ResolvedLevelData& resolvedLevel,
-                       QString& currentLevelName,
-                       QString& currentScript,
-                       QList<QPoint>& obstacles,
-                       const std::function<bool(const QString&)>& evaluateAndRunScript) -> bool;
+// Animated levels go to `startAnimation`, which fills `obstacles`; their script is ignored.
+[[nodiscard]] auto applyResolvedLevelData(
+  const nenoserpent::core::ResolvedLevelData& resolvedLevel,
+  QString& currentLevelName,
+  QString& currentScript,
+  QList<QPoint>& obstacles,
+  const std::function<bool(const QString&)>& evaluateAndRunScript,
+  const std::function<bool(const nenoserpent::core::ObstacleAnimation&)>& startAnimation = {})
+  -> bool;
 
 } // namespace nenoserpent::adapter
@@ -7,6 +7,7 @@
 #include "adapter/models/library.h"
 #include "adapter/profile/bridge.h"
 #include "core/level/runtime.h"
+#include "logging/categories.h"
 #include "power_up_id.h"
 
 using namespace Qt::StringLiterals;
@@ -17,9 +18,15 @@ void EngineAdapter::applyFallbackLevelData(const int levelIndex) {
   m_session.obstacles.clear();
   m_currentLevelName = fallback.name;
   m_currentScript = fallback.script;
-  if (!m_currentScript.isEmpty()) {
+  m_obstacleSchedule.reset();
+  if (fallback.animation.has_value()) {
+    if (!startObstacleAnimation(*fallback.animation)) {
+      m_session.obstacles = fallback.walls;
+    }
+  } else if (!m_currentScript.isEmpty()) {
     const QJSValue res = m_jsEngine.evaluate(m_currentScript);
     if (!res.isError()) {
+      compileLevelSchedule(m_currentScript, fallback.scriptPeriodTicks);
       runLevelScript();
     }
   } else {
@@ -32,25 +39,31 @@ void EngineAdapter::loadLevelData(const int i) {
   const int safeIndex = nenoserpent::core::normalizedFallbackLevelIndex(i);
   m_currentLevelName = nenoserpent::core::fallbackLevelData(safeIndex).name;
 
+  m_obstacleSchedule.reset();
   const auto resolvedLevel = m_levelRepository.loadResolvedLevel(i);
   if (!resolvedLevel.has_value()) {
     applyFallbackLevelData(safeIndex);
     return;
   }
 
-  const bool applied =
-    nenoserpent::adapter::applyResolvedLevelData(*resolvedLevel,
-                                                 m_currentLevelName,
-                                                 m_currentScript,
-                                                 m_session.obstacles,
-                                                 [this](const QString& script) -> bool {
-                                                   const QJSValue res = m_jsEngine.evaluate(script);
-                                                   if (res.isError()) {
-                                                     return false;
-                                                   }
-                                                   runLevelScript();
-                                                   return true;
-                                                 });
+  const auto evaluateAndRunScript = [this, &resolvedLevel](const QString& script) -> bool {
+    const QJSValue res = m_jsEngine.evaluate(script);
+    if (res.isError()) {
+      return false;
+    }
+    compileLevelSchedule(script, resolvedLevel->scriptPeriodTicks);
+    runLevelScript();
+    return true;
+  };
+  const bool applied = nenoserpent::adapter::applyResolvedLevelData(
+    *resolvedLevel,
+    m_currentLevelName,
+    m_currentScript,
+    m_session.obstacles,
+    evaluateAndRunScript,
+    [this](const nenoserpent::core::ObstacleAnimation& animation) -> bool {
+      return startObstacleAnimation(animation);
+    });
   if (!applied) {
     applyFallbackLevelData(safeIndex);
     return;
@@ -61,7 +74,7 @@ void EngineAdapter::loadLevelData(const int i) {
 void EngineAdapter::checkAchievements() {
   const nenoserpent::core::AchievementStats stats{
     .score = m_session.score,
-    .tickIntervalMs = m_timer->interval(),
+    .tickIntervalMs = simulatedTickIntervalMs(),
     .timerActive = m_timer->isActive(),
     .totalCrashes = nenoserpent::adapter::totalCrashes(m_profileManager.get()),
     .totalFoodEaten = nenoserpent::adapter::totalFoodEaten(m_profileManager.get()),
@@ -84,12 +97,44 @@ void EngineAdapter::checkAchievements() {
   }
 }
 
+auto EngineAdapter::startObstacleAnimation(const nenoserpent::core::ObstacleAnimation& animation)
+  -> bool {
+  m_obstacleSchedule = nenoserpent::core::ObstacleSchedule::fromAnimation(animation);
+  if (!m_obstacleSchedule.has_value()) {
+    return false;
+  }
+  runLevelScript();
+  return true;
+}
+
+// Sampled once per script, so restarting the same level reuses the layouts.
+void EngineAdapter::compileLevelSchedule(const QString& script, const int declaredPeriodTicks) {
+  if (script != m_scheduledScript) {
+    m_scheduledScript = script;
+    m_scriptSchedule = nenoserpent::adapter::compileObstacleSchedule(script, declaredPeriodTicks);
+    if (m_scriptSchedule.has_value()) {
+      qCDebug(nenoserpentLevelLog).noquote()
+        << "level script scheduled:" << m_currentLevelName
+        << "period=" << m_scriptSchedule->periodTicks()
+        << "phases=" << m_scriptSchedule->phaseCount();
+    }
+  }
+  m_obstacleSchedule = m_scriptSchedule;
+}
+
 void EngineAdapter::runLevelScript() {
   if (m_session.activeBuff == PowerUpId::Freeze) {
     return;
   }
+  if (m_obstacleSchedule.has_value()) {
+    if (nenoserpent::adapter::applyObstacleSchedule(
+          *m_obstacleSchedule, m_session.tickCounter, m_session.obstacles)) {
+      emitFrameSignal(FrameObstacles);
+    }
+    return;
+  }
   if (nenoserpent::adapter::applyLevelScriptStep(
         m_jsEngine, m_currentLevelName, m_session.tickCounter, m_session.obstacles)) {
-    emit obstaclesChanged();
+    emitFrameSignal(FrameObstacles);
   }
 }
@@ -1,32 +1,113 @@
 #include "adapter/level/script_runtime.h"
 
+#include <utility>
+
 #include "core/level/runtime.h"
 
 using namespace Qt::StringLiterals;
 
 namespace nenoserpent::adapter {
 
+namespace {
+
+auto obstaclesFromScriptResult(const QJSValue& result) -> std::optional<QList<QPoint>> {
+  if (!result.isArray()) {
+    return std::nullopt;
+  }
+  QList<QPoint> parsedObstacles;
+  const int len = result.property(u"length"_s).toInt();
+  parsedObstacles.reserve(len);
+  for (int i = 0; i < len; ++i) {
+    const QJSValue item = result.property(i);
+    parsedObstacles.append(QPoint(item.property(u"x"_s).toInt(), item.property(u"y"_s).toInt()));
+  }
+  return parsedObstacles;
+}
+
+auto sampleOnTick(const QJSValue& onTick, const int tick) -> std::optional<QList<QPoint>> {
+  QJSValueList args;
+  args << tick;
+  return obstaclesFromScriptResult(onTick.call(args));
+}
+
+} // namespace
+
 auto tryApplyOnTickScript(QJSEngine& engine, const int gameTickCounter, QList<QPoint>& obstacles)
   -> bool {
   const QJSValue onTick = engine.globalObject().property(u"onTick"_s);
   if (!onTick.isCallable()) {
     return false;
   }
-  QJSValueList args;
-  args << gameTickCounter;
-  const QJSValue result = onTick.call(args);
-  if (!result.isArray()) {
+  auto parsedObstacles = sampleOnTick(onTick, gameTickCounter);
+  if (!parsedObstacles.has_value()) {
     return false;
   }
+  obstacles = std::move(*parsedObstacles);
+  return true;
+}
 
-  QList<QPoint> parsedObstacles;
-  const int len = result.property(u"length"_s).toInt();
-  parsedObstacles.reserve(len);
-  for (int i = 0; i < len; ++i) {
-    const QJSValue item = result.property(i);
-    parsedObstacles.append(QPoint(item.property(u"x"_s).toInt(), item.property(u"y"_s).toInt()));
+auto compileObstacleSchedule(const QString& script, const int declaredPeriodTicks)
+  -> std::optional<nenoserpent::core::ObstacleSchedule> {
+  using nenoserpent::core::ObstacleSchedule;
+  if (declaredPeriodTicks > ObstacleSchedule::MaxPeriodTicks) {
+    return std::nullopt;
+  }
+  // A scratch engine, so sampling never touches state the live script keeps between calls.
+  QJSEngine engine;
+  if (engine.evaluate(script).isError()) {
+    return std::nullopt;
+  }
+  const QJSValue onTick = engine.globalObject().property(u"onTick"_s);
+  if (!onTick.isCallable()) {
+    return std::nullopt;
+  }
+
+  // Two full periods, so a declared period is checked rather than trusted.
+  const int sampleTicks =
+    2 * (declaredPeriodTicks > 0 ? declaredPeriodTicks : ObstacleSchedule::MaxPeriodTicks);
+  QList<QList<QPoint>> samples;
+  samples.reserve(sampleTicks);
+  for (int tick = 0; tick < sampleTicks; ++tick) {
+    auto sample = sampleOnTick(onTick, tick);
+    if (!sample.has_value()) {
+      return std::nullopt;
+    }
+    samples.append(std::move(*sample));
+  }
+
+  const int period = ObstacleSchedule::detectPeriod(samples);
+  if (period == 0 || (declaredPeriodTicks > 0 && declaredPeriodTicks % period != 0)) {
+    return std::nullopt;
+  }
+  // Asking again, backwards, catches scripts that count calls or draw random numbers.
+  for (int tick = period - 1; tick >= 0; --tick) {
+    if (sampleOnTick(onTick, tick) != samples.at(tick)) {
+      return std::nullopt;
+    }
+  }
+  samples.resize(period);
+  return ObstacleSchedule::fromFrames(samples);
+}
+
+auto levelObstacleSchedule(const nenoserpent::core::ResolvedLevelData& level)
+  -> std::optional<nenoserpent::core::ObstacleSchedule> {
+  if (level.animation.has_value()) {
+    return nenoserpent::core::ObstacleSchedule::fromAnimation(*level.animation);
+  }
+  if (level.script.isEmpty()) {
+    return std::nullopt;
+  }
+  return compileObstacleSchedule(level.script, level.scriptPeriodTicks);
+}
+
+auto applyObstacleSchedule(const nenoserpent::core::ObstacleSchedule& schedule,
+                           const int gameTickCounter,
+                           QList<QPoint>& obstacles) -> bool {
+  const QList<QPoint>& layout = schedule.obstaclesAt(gameTickCounter);
+  if (obstacles.isSharedWith(layout)) {
+    return false;
   }
-  obstacles = parsedObstacles;
+  obstacles = layout;
   return true;
 }
 
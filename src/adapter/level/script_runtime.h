@@ -1,10 +1,15 @@
 #pragma once
 
+#include <optional>
+
 #include <QJSEngine>
 #include <QList>
 #include <QPoint>
 #include <QStringView>
 
+#include "core/level/runtime.h"
+#include "core/level/schedule.h"
+
 namespace nenoserpent::adapter {
 
 [[nodiscard]] auto
@@ -12,6 +17,20 @@ tryApplyOnTickScript(QJSEngine& engine, int gameTickCounter, QList<QPoint>& obst
 [[nodiscard]] auto applyDynamicLevelFallback(QStringView levelName,
                                              int gameTickCounter,
                                              QList<QPoint>& obstacles) -> bool;
+// Samples `script`'s onTick in a scratch engine and caches its layouts when it is a pure,
+// periodic function of the tick: over its declared period when `declaredPeriodTicks` > 0,
+// otherwise over a detected one. Scripts that do not repeat, or that answer the same tick
+// differently twice, return nullopt and stay on the live per-tick call.
+[[nodiscard]] auto compileObstacleSchedule(const QString& script, int declaredPeriodTicks)
+  -> std::optional<nenoserpent::core::ObstacleSchedule>;
+// Schedule the walls of `level` follow: its animation laid out, or its script when that compiles.
+// Static levels, and scripts that have to stay on the live call, return nullopt.
+[[nodiscard]] auto levelObstacleSchedule(const nenoserpent::core::ResolvedLevelData& level)
+  -> std::optional<nenoserpent::core::ObstacleSchedule>;
+// Returns true when `obstacles` changed, i.e. it no longer shares the layout for this tick.
+[[nodiscard]] auto applyObstacleSchedule(const nenoserpent::core::ObstacleSchedule& schedule,
+                                         int gameTickCounter,
+                                         QList<QPoint>& obstacles) -> bool;
 [[nodiscard]] auto applyLevelScriptStep(QJSEngine& engine,
                                         QStringView levelName,
                                         int gameTickCounter,
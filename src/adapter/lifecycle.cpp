@@ -11,7 +11,9 @@ void EngineAdapter::restart() {
   resetReplayRuntimeTracking();
 
   m_randomSeed = static_cast<uint>(QDateTime::currentMSecsSinceEpoch());
-  m_rng.seed(m_randomSeed);
+  m_rng.reseed(m_randomSeed);
+  m_rngDraws = 0;
+  m_rewind.clear();
 
   loadLevelData(m_levelIndex);
   m_sessionCore.applyMetaAction(
@@ -43,7 +45,9 @@ void EngineAdapter::startReplay() {
   m_sessionCore.applyMetaAction(
     nenoserpent::core::MetaAction::bootstrapForLevel(m_session.obstacles, BOARD_WIDTH, BOARD_HEIGHT));
   syncSnakeModelFromCore();
-  m_rng.seed(m_bestRandomSeed);
+  m_rng.reseed(m_bestRandomSeed);
+  m_rngDraws = 0;
+  m_rewind.clear();
   m_timer->setInterval(initialGameplayIntervalMs());
   m_timer->start();
   spawnFood();
@@ -6,23 +6,41 @@
 using namespace Qt::StringLiterals;
 
 auto EngineAdapter::saveRepository() const -> nenoserpent::services::SaveRepository {
-  return nenoserpent::services::SaveRepository(m_profileManager.get());
+  return nenoserpent::services::SaveRepository(m_profileManager.get(), m_persistenceWorker.get());
 }
 
 void EngineAdapter::loadLastSession() {
-  const auto snapshot = saveRepository().loadSessionSnapshot();
-  if (!snapshot.has_value()) {
+  if (!m_savedSession.has_value()) {
     return;
   }
+  const auto& saved = *m_savedSession;
 
   resetReplayRuntimeTracking();
-  m_sessionCore.applyMetaAction(nenoserpent::core::MetaAction::restorePersistedSession(
-    nenoserpent::adapter::toCoreStateSnapshot(*snapshot)));
-  syncSnakeModelFromCore();
-
-  for (const auto& p : snapshot->body) {
-    m_currentRecording.append(p);
+  m_rewind.clear();
+  if (saved.exact) {
+    if (saved.levelIndex != m_levelIndex) {
+      m_levelIndex = saved.levelIndex;
+      loadLevelData(m_levelIndex);
+      emit levelChanged();
+    }
+    m_sessionCore.restoreKeyframe(saved.session);
+    m_randomSeed = saved.randomSeed;
+    m_rng = saved.rng;
+    m_rngDraws = saved.rngDraws;
+    m_rollingChecksum = saved.rollingChecksum;
+    m_currentRecording = saved.recording;
+    m_currentInputHistory = saved.inputHistory;
+    m_currentChoiceHistory = saved.choiceHistory;
+    m_currentChecksumHistory = saved.checksumHistory;
+    m_currentKeyframes = saved.keyframes;
+  } else {
+    m_sessionCore.applyMetaAction(
+      nenoserpent::core::MetaAction::restorePersistedSession(saved.session.snapshot));
+    for (const auto& p : saved.session.snapshot.body) {
+      m_currentRecording.append(p);
+    }
   }
+  syncSnakeModelFromCore();
 
   m_timer->setInterval(gameplayTickIntervalMs());
   m_timer->start();
@@ -35,6 +53,7 @@ void EngineAdapter::loadLastSession() {
 }
 
 void EngineAdapter::updatePersistence() {
+  archiveFinishedRun();
   updateHighScore();
   nenoserpent::adapter::incrementCrashes(m_profileManager.get());
   checkAchievements();
@@ -57,7 +76,9 @@ void EngineAdapter::lazyInit() {
     m_bestInputHistory = snapshot.inputHistory;
     m_bestLevelIndex = snapshot.levelIndex;
     m_bestChoiceHistory = snapshot.choiceHistory;
+    m_bestChecksumHistory = snapshot.checksumHistory;
   }
+  m_savedSession = saveRepository().loadSession();
 
   loadLevelData(m_levelIndex);
   spawnFood();
@@ -71,6 +92,7 @@ void EngineAdapter::updateHighScore() {
     m_bestInputHistory = m_currentInputHistory;
     m_bestRecording = m_currentRecording;
     m_bestChoiceHistory = m_currentChoiceHistory;
+    m_bestChecksumHistory = m_currentChecksumHistory;
     m_bestRandomSeed = m_randomSeed;
     m_bestLevelIndex = m_levelIndex;
 
@@ -80,6 +102,8 @@ void EngineAdapter::updateHighScore() {
       .inputHistory = m_bestInputHistory,
       .levelIndex = m_bestLevelIndex,
       .choiceHistory = m_bestChoiceHistory,
+      .checksumHistory = m_bestChecksumHistory,
+      .keyframes = m_currentKeyframes,
     };
     const bool savedGhost = saveRepository().saveGhostSnapshot(ghostSnapshot);
     if (!savedGhost) {
@@ -89,15 +113,43 @@ void EngineAdapter::updateHighScore() {
   }
 }
 
-void EngineAdapter::saveCurrentState() {
-  if (m_profileManager) {
-    saveRepository().saveSession(m_sessionCore.snapshot({}));
-    emit hasSaveChanged();
+void EngineAdapter::archiveFinishedRun() {
+  const nenoserpent::adapter::GhostSnapshot run{
+    .recording = m_currentRecording,
+    .randomSeed = m_randomSeed,
+    .inputHistory = m_currentInputHistory,
+    .levelIndex = m_levelIndex,
+    .choiceHistory = m_currentChoiceHistory,
+    .checksumHistory = m_currentChecksumHistory,
+    .keyframes = m_currentKeyframes,
+  };
+  if (!saveRepository().archiveReplay(run, m_session.score)) {
+    qCWarning(nenoserpentReplayLog).noquote() << "failed to archive finished run";
   }
 }
 
+void EngineAdapter::saveCurrentState() {
+  m_savedSession = nenoserpent::adapter::PersistedSession{
+    .session = m_sessionCore.captureKeyframe(),
+    .randomSeed = m_randomSeed,
+    .rngDraws = m_rngDraws,
+    .rng = m_rng,
+    .levelIndex = m_levelIndex,
+    .rollingChecksum = m_rollingChecksum,
+    .recording = m_currentRecording,
+    .inputHistory = m_currentInputHistory,
+    .choiceHistory = m_currentChoiceHistory,
+    .checksumHistory = m_currentChecksumHistory,
+    .keyframes = m_currentKeyframes,
+  };
+  saveRepository().saveSession(*m_savedSession);
+  emit hasSaveChanged();
+}
+
 void EngineAdapter::clearSavedState() {
-  if (m_profileManager) {
+  const bool hadSave = m_savedSession.has_value();
+  m_savedSession.reset();
+  if (hadSave || saveRepository().hasSession()) {
     saveRepository().clearSession();
     emit hasSaveChanged();
   }
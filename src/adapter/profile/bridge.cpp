@@ -81,6 +81,12 @@ auto totalFoodEaten(const ProfileManager* profile) -> int {
   return profile != nullptr ? profile->totalFoodEaten() : 0;
 }
 
+void flushPendingWrites(ProfileManager* profile) {
+  if (profile != nullptr) {
+    profile->flushPendingWrites();
+  }
+}
+
 auto unlockedMedals(const ProfileManager* profile) -> QStringList {
   return profile != nullptr ? profile->unlockedMedals() : QStringList{};
 }
@@ -100,27 +106,6 @@ auto hasSession(const ProfileManager* profile) -> bool {
   return profile != nullptr ? profile->hasSession() : false;
 }
 
-void saveSession(ProfileManager* profile,
-                 const int score,
-                 const std::deque<QPoint>& body,
-                 const QList<QPoint>& obstacles,
-                 const QPoint food,
-                 const QPoint direction) {
-  if (profile != nullptr) {
-    profile->saveSession(score, body, obstacles, food, direction);
-  }
-}
-
-void saveSession(ProfileManager* profile, const nenoserpent::core::StateSnapshot& snapshot) {
-  const auto persisted = fromCoreStateSnapshot(snapshot);
-  saveSession(profile,
-              persisted.score,
-              persisted.body,
-              persisted.obstacles,
-              persisted.food,
-              persisted.direction);
-}
-
 void clearSession(ProfileManager* profile) {
   if (profile != nullptr) {
     profile->clearSession();
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <deque>
 #include <optional>
 
 #include <QList>
@@ -33,19 +32,13 @@ void logFoodEaten(ProfileManager* profile);
 [[nodiscard]] auto discoverFruit(ProfileManager* profile, int type) -> bool;
 [[nodiscard]] auto totalCrashes(const ProfileManager* profile) -> int;
 [[nodiscard]] auto totalFoodEaten(const ProfileManager* profile) -> int;
+void flushPendingWrites(ProfileManager* profile);
 
 [[nodiscard]] auto unlockedMedals(const ProfileManager* profile) -> QStringList;
 [[nodiscard]] auto unlockMedal(ProfileManager* profile, const QString& title) -> bool;
 [[nodiscard]] auto discoveredFruits(const ProfileManager* profile) -> QList<int>;
 
 [[nodiscard]] auto hasSession(const ProfileManager* profile) -> bool;
-void saveSession(ProfileManager* profile,
-                 int score,
-                 const std::deque<QPoint>& body,
-                 const QList<QPoint>& obstacles,
-                 QPoint food,
-                 QPoint direction);
-void saveSession(ProfileManager* profile, const nenoserpent::core::StateSnapshot& snapshot);
 void clearSession(ProfileManager* profile);
 [[nodiscard]] auto loadSession(ProfileManager* profile) -> QVariantMap;
 [[nodiscard]] auto loadSessionSnapshot(ProfileManager* profile) -> std::optional<SessionSnapshot>;
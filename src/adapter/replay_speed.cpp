@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+
+#include <QElapsedTimer>
+
+#include "adapter/engine.h"
+#include "fsm/game_state.h"
+
+namespace {
+constexpr std::array ReplaySpeeds{1, 2, 8, EngineAdapter::UnlimitedReplaySpeed};
+} // namespace
+
+void EngineAdapter::setReplaySpeed(const int speed) {
+  if (m_state != AppState::Replaying || speed == m_replaySpeed ||
+      std::ranges::find(ReplaySpeeds, speed) == ReplaySpeeds.end()) {
+    return;
+  }
+  m_replaySpeed = speed;
+  m_replayBacklogMs = 0;
+  m_replayFrameClock.start();
+  m_timer->setInterval(turboReplayActive() ? ReplayFrameIntervalMs : gameplayTickIntervalMs());
+  emit replaySpeedChanged();
+}
+
+void EngineAdapter::stepReplaySpeed(const int step) {
+  const auto current = std::ranges::find(ReplaySpeeds, m_replaySpeed);
+  const auto index = static_cast<int>(std::distance(ReplaySpeeds.begin(), current));
+  const int next = std::clamp(index + step, 0, static_cast<int>(ReplaySpeeds.size()) - 1);
+  setReplaySpeed(ReplaySpeeds.at(static_cast<std::size_t>(next)));
+}
+
+void EngineAdapter::resetReplaySpeed() {
+  if (m_replaySpeed == 1) {
+    return;
+  }
+  m_replaySpeed = 1;
+  m_replayBacklogMs = 0;
+  if (m_timer->isActive()) {
+    m_timer->setInterval(gameplayTickIntervalMs());
+  }
+  emit replaySpeedChanged();
+}
+
+auto EngineAdapter::turboReplayActive() const -> bool {
+  return m_replaySpeed != 1 && m_fsmState && m_state == AppState::Replaying;
+}
+
+auto EngineAdapter::simulatedTickIntervalMs() const -> int {
+  // A turbo frame runs the timer at frame cadence; each tick in it still lasts a gameplay tick.
+  return m_replayBatchActive ? gameplayTickIntervalMs() : m_timer->interval();
+}
+
+// Runs as many replay ticks as the speed owes since the last frame, or, unlimited, as many as fit
+// in the frame budget. Board, HUD, ghost and buff signals go out once at the end of the frame.
+void EngineAdapter::advanceTurboReplay() {
+  const qint64 elapsedMs = std::min(m_replayFrameClock.restart(), ReplayMaxCatchUpMs);
+  if (m_replaySpeed != UnlimitedReplaySpeed) {
+    m_replayBacklogMs += elapsedMs * m_replaySpeed;
+  }
+
+  QElapsedTimer frameBudget;
+  frameBudget.start();
+  m_replayBatchActive = true;
+  while (m_state == AppState::Replaying) {
+    if (m_replaySpeed != UnlimitedReplaySpeed) {
+      const int tickMs = gameplayTickIntervalMs();
+      if (m_replayBacklogMs < tickMs) {
+        break;
+      }
+      m_replayBacklogMs -= tickMs;
+    }
+    runSimulationTick();
+    if (frameBudget.elapsed() >= ReplayFrameBudgetMs) {
+      // Whatever the frame could not afford is dropped rather than owed to the next one.
+      m_replayBacklogMs = 0;
+      break;
+    }
+  }
+  m_replayBatchActive = false;
+  flushReplayFrame();
+
+  // Eating and buffs reset the interval to the gameplay tick; keep the frame cadence.
+  if (m_state == AppState::Replaying && m_timer->interval() != ReplayFrameIntervalMs) {
+    m_timer->setInterval(ReplayFrameIntervalMs);
+  }
+}
+
+void EngineAdapter::flushReplayFrame() {
+  if (m_snakeModelSyncPending) {
+    m_snakeModelSyncPending = false;
+    syncSnakeModelFromCore();
+  }
+  const std::uint8_t pending = std::exchange(m_pendingFrameSignals, std::uint8_t{0});
+  for (const FrameSignal signal : {FrameScore, FrameFood, FrameObstacles, FramePowerUp}) {
+    if ((pending & signal) != 0) {
+      emitFrameSignal(signal);
+    }
+  }
+  // The ghost and the buff countdown move on every tick, so these always go out.
+  emit ghostChanged();
+  emit buffChanged();
+  if (!m_pendingFramePrompt.isEmpty()) {
+    emit eventPrompt(std::exchange(m_pendingFramePrompt, QString()));
+  }
+}
+
+void EngineAdapter::emitFrameSignal(const FrameSignal signal) {
+  if (m_replayBatchActive) {
+    m_pendingFrameSignals |= signal;
+    return;
+  }
+  switch (signal) {
+  case FrameScore:
+    emit scoreChanged();
+    break;
+  case FrameFood:
+    emit foodChanged();
+    break;
+  case FrameObstacles:
+    emit obstaclesChanged();
+    break;
+  case FramePowerUp:
+    emit powerUpChanged();
+    break;
+  case FrameBuff:
+    emit buffChanged();
+    break;
+  }
+}
+
+void EngineAdapter::emitFramePrompt(const QString& text) {
+  if (m_replayBatchActive) {
+    m_pendingFramePrompt = text;
+    return;
+  }
+  emit eventPrompt(text);
+}
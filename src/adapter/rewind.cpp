@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <optional>
+
+#include "adapter/engine.h"
+#include "fsm/game_state.h"
+
+auto EngineAdapter::rewindSeconds(const int seconds) -> bool {
+  if ((m_state != AppState::Playing && m_state != AppState::Paused) || seconds <= 0) {
+    return false;
+  }
+  const int ticks = std::max(1, (seconds * 1000) / std::max(1, gameplayTickIntervalMs()));
+  std::optional<nenoserpent::core::RewindMarks> marks;
+  for (int stepped = 0; stepped < ticks; ++stepped) {
+    auto stepMarks = m_rewind.stepBack(m_sessionCore);
+    if (!stepMarks.has_value()) {
+      break;
+    }
+    marks = stepMarks;
+  }
+  if (!marks.has_value()) {
+    return false;
+  }
+  applyRewindMarks(*marks);
+  // The deltas restore the board; settling also rebuilds the stall guard, recent spawns and RNG,
+  // so the rest of the run still replays from the ghost.
+  m_rewind.settle(m_sessionCore, m_rng, m_rngDraws);
+  syncSnakeModelFromCore();
+  m_timer->setInterval(gameplayTickIntervalMs());
+
+  emit scoreChanged();
+  emit foodChanged();
+  emit obstaclesChanged();
+  emit powerUpChanged();
+  emit buffChanged();
+  emit ghostChanged();
+  if (m_state == AppState::Playing) {
+    requestStateChange(AppState::Paused);
+  }
+  return true;
+}
+
+auto EngineAdapter::rewindMarks() const -> nenoserpent::core::RewindMarks {
+  return {
+    .rngDraws = m_rngDraws,
+    .rollingChecksum = m_rollingChecksum,
+    .recordedFrames = static_cast<int>(m_currentRecording.size()),
+    .inputFrames = static_cast<int>(m_currentInputHistory.size()),
+    .choiceFrames = static_cast<int>(m_currentChoiceHistory.size()),
+    .checksumFrames = static_cast<int>(m_currentChecksumHistory.size()),
+  };
+}
+
+void EngineAdapter::applyRewindMarks(const nenoserpent::core::RewindMarks& marks) {
+  m_rngDraws = marks.rngDraws;
+  m_rollingChecksum = marks.rollingChecksum;
+  m_currentRecording.resize(std::min<qsizetype>(m_currentRecording.size(), marks.recordedFrames));
+  m_currentInputHistory.resize(
+    std::min<qsizetype>(m_currentInputHistory.size(), marks.inputFrames));
+  m_currentChoiceHistory.resize(
+    std::min<qsizetype>(m_currentChoiceHistory.size(), marks.choiceFrames));
+  m_currentChecksumHistory.resize(
+    std::min<qsizetype>(m_currentChecksumHistory.size(), marks.checksumFrames));
+  const qsizetype keptKeyframes =
+    nenoserpent::core::keyframeIndexAtOrBefore(m_currentKeyframes, m_sessionCore.tickCounter()) + 1;
+  m_currentKeyframes.resize(keptKeyframes);
+  m_ghostFrameIndex =
+    std::min(static_cast<int>(m_currentRecording.size()), static_cast<int>(m_bestRecording.size()));
+  m_noFoodElapsedMs = 0;
+}
@@ -7,7 +7,7 @@
 using namespace Qt::StringLiterals;
 
 auto EngineAdapter::hasSave() const -> bool {
-  return saveRepository().hasSession();
+  return m_savedSession.has_value();
 }
 
 auto EngineAdapter::hasReplay() const noexcept -> bool {
@@ -37,9 +37,14 @@ void EngineAdapter::resetReplayRuntimeTracking() {
   m_ghostFrameIndex = 0;
   m_replayInputHistoryIndex = 0;
   m_replayChoiceHistoryIndex = 0;
+  m_replayChecksumIndex = 0;
+  m_replayChecksumDiverged = false;
+  m_rollingChecksum = 0;
   m_currentInputHistory.clear();
   m_currentRecording.clear();
   m_currentChoiceHistory.clear();
+  m_currentChecksumHistory.clear();
+  m_currentKeyframes.clear();
 }
 
 void EngineAdapter::nextLevel() {
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <deque>
 #include <optional>
 
 #include <QList>
@@ -16,7 +15,7 @@ struct SessionSnapshot {
   QPoint food;
   QPoint direction;
   QList<QPoint> obstacles;
-  std::deque<QPoint> body;
+  nenoserpent::core::SnakeBody body;
 };
 
 [[nodiscard]] auto decodeSessionSnapshot(const QVariantMap& data) -> std::optional<SessionSnapshot>;
@@ -0,0 +1,100 @@
+#include "adapter/session/store.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+#include "core/replay/keyframe.h"
+
+using namespace Qt::StringLiterals;
+
+namespace nenoserpent::adapter {
+
+namespace {
+// Pinned so a Qt upgrade cannot change the layout under a saved session.
+constexpr auto SessionStreamVersion = QDataStream::Qt_6_7;
+
+// The keyframes' generator states follow the list, which streams without them.
+void writeKeyframeGenerators(QDataStream& out,
+                             const QList<nenoserpent::core::ReplayKeyframe>& keyframes) {
+  for (const auto& keyframe : keyframes) {
+    out << keyframe.rng.has_value();
+    if (keyframe.rng.has_value()) {
+      out << *keyframe.rng;
+    }
+  }
+}
+
+void readKeyframeGenerators(QDataStream& in, QList<nenoserpent::core::ReplayKeyframe>& keyframes) {
+  for (auto& keyframe : keyframes) {
+    bool hasRng = false;
+    in >> hasRng;
+    if (hasRng) {
+      nenoserpent::core::ReplayRng rng;
+      in >> rng;
+      keyframe.rng = rng;
+    }
+  }
+}
+} // namespace
+
+auto sessionFilePathForDirectory(const QStringView appDataDirectory) -> QString {
+  QDir dir(appDataDirectory.toString());
+  if (!dir.exists()) {
+    dir.mkpath(u"."_s);
+  }
+  return dir.filePath(u"session.dat"_s);
+}
+
+auto encodePersistedSession(const PersistedSession& session) -> QByteArray {
+  QByteArray bytes;
+  QDataStream out(&bytes, QIODevice::WriteOnly);
+  out.setVersion(SessionStreamVersion);
+  out << SessionFileMagic << SessionFileVersion << session.randomSeed << session.rngDraws
+      << session.levelIndex << session.rollingChecksum << session.session << session.recording
+      << session.inputHistory << session.choiceHistory << session.checksumHistory << session.rng
+      << session.keyframes;
+  writeKeyframeGenerators(out, session.keyframes);
+  return bytes;
+}
+
+auto decodePersistedSession(const QByteArray& bytes) -> std::optional<PersistedSession> {
+  QDataStream in(bytes);
+  in.setVersion(SessionStreamVersion);
+  quint32 magic = 0;
+  quint16 version = 0;
+  in >> magic >> version;
+  if (magic != SessionFileMagic || version != SessionFileVersion) {
+    return std::nullopt;
+  }
+  PersistedSession session;
+  in >> session.randomSeed >> session.rngDraws >> session.levelIndex >> session.rollingChecksum >>
+    session.session >> session.recording >> session.inputHistory >> session.choiceHistory >>
+    session.checksumHistory >> session.rng >> session.keyframes;
+  readKeyframeGenerators(in, session.keyframes);
+  if (in.status() != QDataStream::Ok || session.session.snapshot.body.empty()) {
+    return std::nullopt;
+  }
+  return session;
+}
+
+auto loadPersistedSessionFromFile(const QStringView filePath) -> std::optional<PersistedSession> {
+  QFile file(filePath.toString());
+  if (!file.open(QIODevice::ReadOnly)) {
+    return std::nullopt;
+  }
+  return decodePersistedSession(file.readAll());
+}
+
+auto savePersistedSessionToFile(const QStringView filePath, const PersistedSession& session)
+  -> bool {
+  QSaveFile file(filePath.toString());
+  if (!file.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+  const QByteArray bytes = encodePersistedSession(session);
+  return file.write(bytes) == bytes.size() && file.commit();
+}
+
+} // namespace nenoserpent::adapter
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <optional>
+
+#include <QByteArray>
+#include <QList>
+#include <QPoint>
+#include <QString>
+#include <QStringView>
+
+#include "core/game/random.h"
+#include "core/replay/keyframe.h"
+#include "core/replay/types.h"
+#include "core/session/snapshot.h"
+
+namespace nenoserpent::adapter {
+
+inline constexpr quint32 SessionFileMagic = 0x534E4B53;
+inline constexpr quint16 SessionFileVersion = 1;
+
+// A paused run, complete enough to resume bit-exactly: the full core keyframe, the generator
+// state, and the replay being recorded so the run still becomes a ghost.
+struct PersistedSession {
+  nenoserpent::core::SessionKeyframe session;
+  uint randomSeed = 0;
+  quint64 rngDraws = 0;
+  nenoserpent::core::ReplayRng rng;
+  int levelIndex = 0;
+  quint64 rollingChecksum = 0;
+  QList<QPoint> recording;
+  QList<ReplayFrame> inputHistory;
+  QList<ChoiceRecord> choiceHistory;
+  QList<ChecksumRecord> checksumHistory;
+  QList<nenoserpent::core::ReplayKeyframe> keyframes;
+  // False for a session migrated from the old QSettings point lists, which held only score,
+  // food, direction, body and obstacles; those resume through restorePersistedSession.
+  bool exact = true;
+};
+
+[[nodiscard]] auto sessionFilePathForDirectory(QStringView appDataDirectory) -> QString;
+[[nodiscard]] auto encodePersistedSession(const PersistedSession& session) -> QByteArray;
+[[nodiscard]] auto decodePersistedSession(const QByteArray& bytes)
+  -> std::optional<PersistedSession>;
+// One read of the whole file, then an in-memory decode.
+[[nodiscard]] auto loadPersistedSessionFromFile(QStringView filePath)
+  -> std::optional<PersistedSession>;
+// One buffered write to a temporary file that is renamed over the target.
+[[nodiscard]] auto savePersistedSessionToFile(QStringView filePath, const PersistedSession& session)
+  -> bool;
+
+} // namespace nenoserpent::adapter
@@ -1,52 +1,83 @@
 #include "adapter/engine.h"
 #include "adapter/models/library.h"
 #include "adapter/profile/bridge.h"
+#include "core/replay/checksum.h"
+#include "core/session/tick_driver.h"
+#include "logging/categories.h"
 #include "power_up_id.h"
 
 using namespace Qt::StringLiterals;
 
-namespace {
-
-struct SessionStepDriverConfig {
-  int activeState = AppState::Playing;
-  int collisionTargetState = AppState::GameOver;
-  bool consumeInputQueue = true;
-  bool recordConsumedInput = true;
-  bool emitCrashFeedbackOnCollision = true;
-};
-
-auto runSessionStepDriver(IGameEngine& engine, const SessionStepDriverConfig& config) -> bool {
-  const auto result = engine.advanceSessionStep({
-    .boardWidth = 20,
-    .boardHeight = 18,
-    .consumeInputQueue = config.consumeInputQueue,
-    .pauseOnChoiceTrigger = (config.activeState != AppState::Replaying),
-  });
+void EngineAdapter::advancePlayingState() {
+  advanceSessionTick(false);
+}
 
-  if (result.consumedInput && config.recordConsumedInput) {
-    engine.recordInputAtCurrentTick(result.consumedDirection);
-  }
+void EngineAdapter::advanceReplayState() {
+  advanceSessionTick(true);
+}
+
+void EngineAdapter::advanceSessionTick(const bool replaying) {
+  struct Host {
+    EngineAdapter& engine;
+    bool replaying;
 
-  if (result.collision) {
-    if (config.emitCrashFeedbackOnCollision) {
-      engine.triggerHaptic(8);
-      engine.emitAudioEvent(nenoserpent::audio::Event::Crash);
+    auto drawBounded(const int bound) -> int {
+      return engine.drawBounded(bound);
+    }
+    void selectReplayChoice(const int index) {
+      engine.selectChoice(index);
+    }
+    void applyStep(const nenoserpent::core::SessionAdvanceResult& step) {
+      engine.applySessionStepEffects(step);
+      if (step.consumedInput && !replaying) {
+        engine.recordInputAtCurrentTick(step.consumedDirection);
+      }
+      if (!step.collision) {
+        return;
+      }
+      if (!replaying) {
+        engine.triggerHaptic(8);
+        engine.emitAudioEvent(nenoserpent::audio::Event::Crash);
+      }
+      engine.requestStateChange(replaying ? AppState::StartMenu : AppState::GameOver);
     }
-    engine.requestStateChange(config.collisionTargetState);
-    return false;
+    void applyRuntimeUpdate(const nenoserpent::core::RuntimeUpdateResult& update) {
+      if (update.buffExpired) {
+        engine.deactivateBuff();
+      }
+      if (update.powerUpExpired) {
+        engine.emitFrameSignal(FramePowerUp);
+      }
+      if (engine.m_obstacleSchedule.has_value() || !engine.m_currentScript.isEmpty()) {
+        engine.runLevelScript();
+      }
+    }
+  } host{.engine = *this, .replaying = replaying};
+  const nenoserpent::core::ReplayCursor replay{
+    .inputFrames = &m_bestInputHistory,
+    .inputHistoryIndex = &m_replayInputHistoryIndex,
+    .choiceFrames = &m_bestChoiceHistory,
+    .choiceHistoryIndex = &m_replayChoiceHistoryIndex,
+  };
+  const auto outcome = nenoserpent::core::runSessionTick(m_sessionCore,
+                                                         nenoserpent::core::StandardBoardWidth,
+                                                         nenoserpent::core::StandardBoardHeight,
+                                                         replaying ? &replay : nullptr,
+                                                         host);
+  if (!outcome.counted) {
+    return;
+  }
+  trackReplayChecksum();
+  // A keyframe on a choice tick would resume without the choices the recorded pick refers to.
+  const bool choicePending =
+    outcome.step.triggerChoice || outcome.step.triggerChoiceAfterMagnet;
+  if (!replaying && !choicePending &&
+      m_sessionCore.tickCounter() % nenoserpent::core::ReplayKeyframeIntervalTicks == 0) {
+    captureReplayKeyframe();
   }
-
-  return result.appliedMovement && engine.currentState() == config.activeState &&
-         !engine.hasPendingStateChange();
 }
 
-} // namespace
-
-auto EngineAdapter::advanceSessionStep(const nenoserpent::core::SessionAdvanceConfig& config)
-  -> nenoserpent::core::SessionAdvanceResult {
-  const auto result = m_sessionCore.advanceSessionStep(
-    config, [this](const int bound) { return m_rng.bounded(bound); });
-
+void EngineAdapter::applySessionStepEffects(const nenoserpent::core::SessionAdvanceResult& result) {
   applyCollisionMitigationEffects(result);
 
   if (result.ateFood) {
@@ -60,56 +91,21 @@ auto EngineAdapter::advanceSessionStep(const nenoserpent::core::SessionAdvanceCo
   if (result.appliedMovement) {
     applyMovementEffects(result);
   }
-
-  return result;
-}
-
-void EngineAdapter::applyReplayTimelineForCurrentTick(int& inputHistoryIndex,
-                                                      int& choiceHistoryIndex) {
-  const auto result = m_sessionCore.applyReplayTimeline(
-    m_bestInputHistory, inputHistoryIndex, m_bestChoiceHistory, choiceHistoryIndex);
-  if (result.choiceIndex.has_value()) {
-    selectChoice(*result.choiceIndex);
-  }
-}
-
-void EngineAdapter::advancePlayingState() {
-  runSessionStepDriver(*this,
-                       {
-                         .activeState = AppState::Playing,
-                         .collisionTargetState = AppState::GameOver,
-                         .consumeInputQueue = true,
-                         .recordConsumedInput = true,
-                         .emitCrashFeedbackOnCollision = true,
-                       });
-}
-
-void EngineAdapter::advanceReplayState() {
-  applyReplayTimelineForCurrentTick(m_replayInputHistoryIndex, m_replayChoiceHistoryIndex);
-
-  runSessionStepDriver(*this,
-                       {
-                         .activeState = AppState::Replaying,
-                         .collisionTargetState = AppState::StartMenu,
-                         .consumeInputQueue = false,
-                         .recordConsumedInput = false,
-                         .emitCrashFeedbackOnCollision = false,
-                       });
 }
 
 void EngineAdapter::applyCollisionMitigationEffects(
   const nenoserpent::core::SessionAdvanceResult& result) {
   if (result.consumeLaser && result.obstacleIndex >= 0 &&
       result.obstacleIndex < m_session.obstacles.size()) {
-    emit obstaclesChanged();
+    emitFrameSignal(FrameObstacles);
     triggerHaptic(8);
-    emit buffChanged();
+    emitFrameSignal(FrameBuff);
   }
   if (result.consumeShield) {
     m_shieldConsumedThisRun = true;
     m_sinceShieldConsumedMs = 0;
     triggerHaptic(5);
-    emit buffChanged();
+    emitFrameSignal(FrameBuff);
   }
 }
 
@@ -127,9 +123,12 @@ void EngineAdapter::applyFoodConsumptionEffects(const float pan,
   nenoserpent::adapter::logFoodEaten(m_profileManager.get());
   m_foodEatenThisRun++;
   m_noFoodElapsedMs = 0;
-  emit foodEaten(pan);
+  // Turbo replay frames play no sound.
+  if (!m_replayBatchActive) {
+    emit foodEaten(pan);
+  }
   m_timer->setInterval(gameplayTickIntervalMs());
-  emit scoreChanged();
+  emitFrameSignal(FrameScore);
   spawnFood();
 
   if (triggerChoice) {
@@ -157,26 +156,29 @@ void EngineAdapter::applyPowerUpConsumptionEffects(
   }
   if (result.miniApplied) {
     syncSnakeModelFromCore();
-    emit eventPrompt(u"MINI BLITZ! SIZE CUT"_s);
+    emitFramePrompt(u"MINI BLITZ! SIZE CUT"_s);
   }
 
-  emit powerUpEaten();
+  if (!m_replayBatchActive) {
+    emit powerUpEaten();
+  }
   m_timer->setInterval(gameplayTickIntervalMs());
 
   triggerHaptic(5);
-  emit buffChanged();
-  emit powerUpChanged();
+  emitFrameSignal(FrameBuff);
+  emitFrameSignal(FramePowerUp);
 }
 
 void EngineAdapter::applyMovementEffects(const nenoserpent::core::SessionAdvanceResult& result) {
   syncSnakeModelFromCore();
   m_currentRecording.append(m_sessionCore.headPosition());
-  m_noFoodElapsedMs += m_timer->interval();
+  const int tickMs = simulatedTickIntervalMs();
+  m_noFoodElapsedMs += tickMs;
   if (m_shieldConsumedThisRun) {
-    m_sinceShieldConsumedMs += m_timer->interval();
+    m_sinceShieldConsumedMs += tickMs;
   }
   if (gameplayTickIntervalMs() <= 100) {
-    m_highSpeedElapsedMs += m_timer->interval();
+    m_highSpeedElapsedMs += tickMs;
   } else {
     m_highSpeedElapsedMs = 0;
   }
@@ -195,10 +197,12 @@ void EngineAdapter::applyMovementEffects(const nenoserpent::core::SessionAdvance
 
   if (m_ghostFrameIndex < static_cast<int>(m_bestRecording.size())) {
     m_ghostFrameIndex++;
-    emit ghostChanged();
+    if (!m_replayBatchActive) {
+      emit ghostChanged();
+    }
   }
   if (result.movedFood) {
-    emit foodChanged();
+    emitFrameSignal(FrameFood);
   }
   if (result.magnetAteFood) {
     m_triggeredPowerTypesThisRun.insert(PowerUpId::Magnet);
@@ -208,14 +212,50 @@ void EngineAdapter::applyMovementEffects(const nenoserpent::core::SessionAdvance
   checkAchievements();
 }
 
-void EngineAdapter::applyPostTickTasks() {
-  if (!m_currentScript.isEmpty()) {
-    runLevelScript();
+// Live runs sample the rolling checksum into the ghost; replays compare against it and log the
+// first tick that no longer matches. Playback carries on so the ghost stays watchable.
+void EngineAdapter::trackReplayChecksum() {
+  const int frame = m_sessionCore.tickCounter();
+  if (m_state == AppState::Playing) {
+    if (frame % nenoserpent::core::ReplayChecksumIntervalTicks == 0) {
+      m_rollingChecksum = nenoserpent::core::rollReplayChecksum(
+        m_rollingChecksum, nenoserpent::core::sessionStateChecksum(m_sessionCore));
+      m_currentChecksumHistory.append({.frame = frame, .checksum = m_rollingChecksum});
+    }
+    return;
+  }
+  if (m_state != AppState::Replaying || m_replayChecksumDiverged) {
+    return;
+  }
+
+  while (m_replayChecksumIndex < m_bestChecksumHistory.size() &&
+         m_bestChecksumHistory.at(m_replayChecksumIndex).frame < frame) {
+    ++m_replayChecksumIndex;
+  }
+  if (m_replayChecksumIndex >= m_bestChecksumHistory.size() ||
+      m_bestChecksumHistory.at(m_replayChecksumIndex).frame != frame) {
+    return;
   }
-  m_sessionCore.finishRuntimeUpdate();
+  m_rollingChecksum = nenoserpent::core::rollReplayChecksum(
+    m_rollingChecksum, nenoserpent::core::sessionStateChecksum(m_sessionCore));
+  if (m_rollingChecksum != m_bestChecksumHistory.at(m_replayChecksumIndex++).checksum) {
+    m_replayChecksumDiverged = true;
+    qCWarning(nenoserpentReplayLog).noquote() << "replay diverged from ghost at tick" << frame;
+  }
+}
+
+void EngineAdapter::captureReplayKeyframe() {
+  m_currentKeyframes.append({
+    .frame = m_sessionCore.tickCounter(),
+    .rngDraws = m_rngDraws,
+    .checksum = m_rollingChecksum,
+    .recordedFrames = static_cast<int>(m_currentRecording.size()),
+    .session = m_sessionCore.captureKeyframe(),
+    .rng = m_rng,
+  });
 }
 
 void EngineAdapter::deactivateBuff() {
   m_timer->setInterval(gameplayTickIntervalMs());
-  emit buffChanged();
+  emitFrameSignal(FrameBuff);
 }
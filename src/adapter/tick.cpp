@@ -19,38 +19,43 @@ void EngineAdapter::update() {
     updateReflectionFallback();
     return;
   }
+  if (turboReplayActive()) {
+    advanceTurboReplay();
+  } else {
+    runSimulationTick();
+  }
+  updateReflectionFallback();
+}
 
+void EngineAdapter::runSimulationTick() {
   const int prevActiveBuff = m_session.activeBuff;
   const int prevBuffTicksRemaining = m_session.buffTicksRemaining;
   const int prevBuffTicksTotal = m_session.buffTicksTotal;
   const bool prevShieldActive = m_session.shieldActive;
   const QPoint prevScoutHintCell = m_session.scoutHintCell;
 
+  // Only live ticks go into the rewind ring; replays and menus never step back.
+  const bool recordRewind = m_fsmState && m_state == AppState::Playing;
+  if (recordRewind) {
+    m_rewind.beginTick(m_sessionCore, rewindMarks(), m_rng);
+  }
   if (m_fsmState) {
     dispatchStateCallback([](GameState& state) -> void { state.update(); });
-    if (m_state == AppState::Playing || m_state == AppState::Replaying) {
-      const auto runtimeUpdate = m_sessionCore.beginRuntimeUpdate();
-      if (runtimeUpdate.buffExpired) {
-        deactivateBuff();
-      }
-      if (runtimeUpdate.powerUpExpired) {
-        emit powerUpChanged();
-      }
-      applyPostTickTasks();
-    }
     if (m_state == AppState::Playing) {
       advanceChoiceSpeedRecovery();
     } else {
       cancelChoiceSpeedRecovery();
     }
   }
+  if (recordRewind) {
+    m_rewind.endTick(m_sessionCore);
+  }
   if (prevActiveBuff != m_session.activeBuff ||
       prevBuffTicksRemaining != m_session.buffTicksRemaining ||
       prevBuffTicksTotal != m_session.buffTicksTotal ||
       prevShieldActive != m_session.shieldActive || prevScoutHintCell != m_session.scoutHintCell) {
-    emit buffChanged();
+    emitFrameSignal(FrameBuff);
   }
-  updateReflectionFallback();
 }
 
 auto EngineAdapter::driveBotAutoplay() -> bool {
@@ -75,6 +80,7 @@ auto EngineAdapter::driveBotAutoplay() -> bool {
           .boardHeight = BOARD_HEIGHT,
           .obstacles = m_session.obstacles,
           .body = m_sessionCore.body(),
+          .bodyHash = m_sessionCore.bodyHash(),
         },
       .choices = m_choices,
       .currentChoiceIndex = m_choiceIndex,
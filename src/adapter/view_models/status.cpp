@@ -21,6 +21,10 @@ SessionStatusViewModel::SessionStatusViewModel(EngineAdapter* engineAdapter, QOb
           &SessionStatusViewModel::highScoreChanged);
   connect(
     m_engineAdapter, &EngineAdapter::levelChanged, this, &SessionStatusViewModel::levelChanged);
+  connect(m_engineAdapter,
+          &EngineAdapter::replaySpeedChanged,
+          this,
+          &SessionStatusViewModel::replaySpeedChanged);
 }
 
 auto SessionStatusViewModel::hasSave() const -> bool {
@@ -42,3 +46,7 @@ auto SessionStatusViewModel::level() const -> int {
 auto SessionStatusViewModel::currentLevelName() const -> QString {
   return m_engineAdapter != nullptr ? m_engineAdapter->currentLevelName() : QString{};
 }
+
+auto SessionStatusViewModel::replaySpeed() const -> int {
+  return m_engineAdapter != nullptr ? m_engineAdapter->replaySpeed() : 1;
+}
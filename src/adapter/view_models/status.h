@@ -12,6 +12,7 @@ class SessionStatusViewModel final : public QObject {
   Q_PROPERTY(int highScore READ highScore NOTIFY highScoreChanged)
   Q_PROPERTY(int level READ level NOTIFY levelChanged)
   Q_PROPERTY(QString currentLevelName READ currentLevelName NOTIFY levelChanged)
+  Q_PROPERTY(int replaySpeed READ replaySpeed NOTIFY replaySpeedChanged)
 
 public:
   explicit SessionStatusViewModel(EngineAdapter* engineAdapter, QObject* parent = nullptr);
@@ -21,12 +22,14 @@ public:
   [[nodiscard]] auto highScore() const -> int;
   [[nodiscard]] auto level() const -> int;
   [[nodiscard]] auto currentLevelName() const -> QString;
+  [[nodiscard]] auto replaySpeed() const -> int;
 
 signals:
   void hasSaveChanged();
   void hasReplayChanged();
   void highScoreChanged();
   void levelChanged();
+  void replaySpeedChanged();
 
 private:
   EngineAdapter* m_engineAdapter = nullptr;
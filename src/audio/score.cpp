@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cmath>
+#include <utility>
 
 #include <QDir>
 #include <QFile>
@@ -10,24 +11,36 @@
 #include <QJsonObject>
 #include <QStandardPaths>
 
+#include "audio/score_catalog.h"
+
 namespace nenoserpent::audio {
 namespace {
 
+constexpr auto ScoreCueCount = static_cast<std::size_t>(ScoreCueId::Confirm) + 1;
+constexpr auto ScoreTrackCount = static_cast<std::size_t>(ScoreTrackId::ReplayAfterglowEcho) + 1;
+
+// Built-in cues and tracks, indexed by id, straight from the compiled-in score catalog.
+constexpr auto BuiltInCues = [] {
+  std::array<std::span<const ScoreStep>, ScoreCueCount> cues{};
+  for (const auto& [cueId, steps] : generated::Cues) {
+    cues.at(static_cast<std::size_t>(cueId)) = steps;
+  }
+  return cues;
+}();
+
+constexpr auto BuiltInTracks = [] {
+  std::array<std::span<const ScoreTrackStep>, ScoreTrackCount> tracks{};
+  for (const auto& [trackId, steps] : generated::Tracks) {
+    tracks.at(static_cast<std::size_t>(trackId)) = steps;
+  }
+  return tracks;
+}();
+
 struct ScoreCatalog {
-  QVector<ScoreStep> uiInteractCue;
-  QVector<ScoreStep> confirmCue;
-  QVector<ScoreTrackStep> menuEmeraldDawnTrack;
-  QVector<ScoreTrackStep> menuNeonPulseTrack;
-  QVector<ScoreTrackStep> menuCipherRunTrack;
-  QVector<ScoreTrackStep> menuAfterglowEchoTrack;
-  QVector<ScoreTrackStep> gameplayEmeraldDawnTrack;
-  QVector<ScoreTrackStep> gameplayNeonPulseTrack;
-  QVector<ScoreTrackStep> gameplayCipherRunTrack;
-  QVector<ScoreTrackStep> gameplayAfterglowEchoTrack;
-  QVector<ScoreTrackStep> replayEmeraldDawnTrack;
-  QVector<ScoreTrackStep> replayNeonPulseTrack;
-  QVector<ScoreTrackStep> replayCipherRunTrack;
-  QVector<ScoreTrackStep> replayAfterglowEchoTrack;
+  std::array<std::span<const ScoreStep>, ScoreCueCount> cues = BuiltInCues;
+  std::array<std::span<const ScoreTrackStep>, ScoreTrackCount> tracks = BuiltInTracks;
+  // Tracks read from the override file; the matching `tracks` entries point into these.
+  std::array<QVector<ScoreTrackStep>, ScoreTrackCount> overrideTracks;
 };
 
 struct ScoreCatalogCache {
@@ -52,21 +65,6 @@ auto parseDuty(const QStringView name, const PulseDuty fallback) -> PulseDuty {
   return fallback;
 }
 
-auto parseCueSteps(const QJsonArray& stepsJson) -> QVector<ScoreStep> {
-  QVector<ScoreStep> steps;
-  steps.reserve(stepsJson.size());
-  for (const auto& item : stepsJson) {
-    const auto object = item.toObject();
-    steps.push_back({
-      .frequencyHz = object.value("frequencyHz").toInt(),
-      .durationMs = object.value("durationMs").toInt(),
-      .duty = object.value("duty").toDouble(0.5),
-      .amplitude = object.value("amplitude").toInt(32),
-    });
-  }
-  return steps;
-}
-
 auto parseTrackSteps(const QJsonArray& stepsJson) -> QVector<ScoreTrackStep> {
   QVector<ScoreTrackStep> steps;
   steps.reserve(stepsJson.size());
@@ -85,11 +83,15 @@ auto parseTrackSteps(const QJsonArray& stepsJson) -> QVector<ScoreTrackStep> {
 
 void applyTrackOverride(const QJsonObject& tracks,
                         const char* key,
-                        QVector<ScoreTrackStep>& target) {
-  const auto override = parseTrackSteps(tracks.value(QLatin1String(key)).toArray());
-  if (!override.isEmpty()) {
-    target = override;
+                        const ScoreTrackId trackId,
+                        ScoreCatalog& catalog) {
+  auto override = parseTrackSteps(tracks.value(QLatin1String(key)).toArray());
+  if (override.isEmpty()) {
+    return;
   }
+  const auto index = static_cast<std::size_t>(trackId);
+  catalog.overrideTracks.at(index) = std::move(override);
+  catalog.tracks.at(index) = catalog.overrideTracks.at(index);
 }
 
 auto defaultOverridePath() -> QString {
@@ -128,67 +130,34 @@ void applyExternalOverrides(ScoreCatalog& catalog, const QString& overridePath)
     return;
   }
 
-  applyTrackOverride(tracks, "menu_emerald_dawn", catalog.menuEmeraldDawnTrack);
-  applyTrackOverride(tracks, "menu_neon_pulse", catalog.menuNeonPulseTrack);
-  applyTrackOverride(tracks, "menu_cipher_run", catalog.menuCipherRunTrack);
-  applyTrackOverride(tracks, "menu_afterglow_echo", catalog.menuAfterglowEchoTrack);
-  applyTrackOverride(tracks, "gameplay_emerald_dawn", catalog.gameplayEmeraldDawnTrack);
-  applyTrackOverride(tracks, "gameplay_neon_pulse", catalog.gameplayNeonPulseTrack);
-  applyTrackOverride(tracks, "gameplay_cipher_run", catalog.gameplayCipherRunTrack);
-  applyTrackOverride(tracks, "gameplay_afterglow_echo", catalog.gameplayAfterglowEchoTrack);
-  applyTrackOverride(tracks, "replay_emerald_dawn", catalog.replayEmeraldDawnTrack);
-  applyTrackOverride(tracks, "replay_neon_pulse", catalog.replayNeonPulseTrack);
-  applyTrackOverride(tracks, "replay_cipher_run", catalog.replayCipherRunTrack);
-  applyTrackOverride(tracks, "replay_afterglow_echo", catalog.replayAfterglowEchoTrack);
+  applyTrackOverride(tracks, "menu_emerald_dawn", ScoreTrackId::MenuEmeraldDawn, catalog);
+  applyTrackOverride(tracks, "menu_neon_pulse", ScoreTrackId::MenuNeonPulse, catalog);
+  applyTrackOverride(tracks, "menu_cipher_run", ScoreTrackId::MenuCipherRun, catalog);
+  applyTrackOverride(tracks, "menu_afterglow_echo", ScoreTrackId::MenuAfterglowEcho, catalog);
+  applyTrackOverride(tracks, "gameplay_emerald_dawn", ScoreTrackId::GameplayEmeraldDawn, catalog);
+  applyTrackOverride(tracks, "gameplay_neon_pulse", ScoreTrackId::GameplayNeonPulse, catalog);
+  applyTrackOverride(tracks, "gameplay_cipher_run", ScoreTrackId::GameplayCipherRun, catalog);
+  applyTrackOverride(
+    tracks, "gameplay_afterglow_echo", ScoreTrackId::GameplayAfterglowEcho, catalog);
+  applyTrackOverride(tracks, "replay_emerald_dawn", ScoreTrackId::ReplayEmeraldDawn, catalog);
+  applyTrackOverride(tracks, "replay_neon_pulse", ScoreTrackId::ReplayNeonPulse, catalog);
+  applyTrackOverride(tracks, "replay_cipher_run", ScoreTrackId::ReplayCipherRun, catalog);
+  applyTrackOverride(tracks, "replay_afterglow_echo", ScoreTrackId::ReplayAfterglowEcho, catalog);
 
   // Backward compatible keys from the older two-variant scheme.
-  applyTrackOverride(tracks, "menu", catalog.menuEmeraldDawnTrack);
-  applyTrackOverride(tracks, "menu_alt", catalog.menuNeonPulseTrack);
-  applyTrackOverride(tracks, "gameplay", catalog.gameplayEmeraldDawnTrack);
-  applyTrackOverride(tracks, "gameplay_alt", catalog.gameplayNeonPulseTrack);
-  applyTrackOverride(tracks, "replay", catalog.replayEmeraldDawnTrack);
-  applyTrackOverride(tracks, "replay_alt", catalog.replayNeonPulseTrack);
-}
-
-auto loadBuiltInCatalog() -> ScoreCatalog {
-  QFile file(":/audio/score_catalog.json");
-  if (!file.open(QIODevice::ReadOnly)) {
-    return {};
-  }
-
-  const auto document = QJsonDocument::fromJson(file.readAll());
-  if (!document.isObject()) {
-    return {};
-  }
-
-  const auto root = document.object();
-  const auto cues = root.value("cues").toObject();
-  const auto tracks = root.value("tracks").toObject();
-
-  return {
-    .uiInteractCue = parseCueSteps(cues.value("ui_interact").toArray()),
-    .confirmCue = parseCueSteps(cues.value("confirm").toArray()),
-    .menuEmeraldDawnTrack = parseTrackSteps(tracks.value("menu_emerald_dawn").toArray()),
-    .menuNeonPulseTrack = parseTrackSteps(tracks.value("menu_neon_pulse").toArray()),
-    .menuCipherRunTrack = parseTrackSteps(tracks.value("menu_cipher_run").toArray()),
-    .menuAfterglowEchoTrack = parseTrackSteps(tracks.value("menu_afterglow_echo").toArray()),
-    .gameplayEmeraldDawnTrack = parseTrackSteps(tracks.value("gameplay_emerald_dawn").toArray()),
-    .gameplayNeonPulseTrack = parseTrackSteps(tracks.value("gameplay_neon_pulse").toArray()),
-    .gameplayCipherRunTrack = parseTrackSteps(tracks.value("gameplay_cipher_run").toArray()),
-    .gameplayAfterglowEchoTrack =
-      parseTrackSteps(tracks.value("gameplay_afterglow_echo").toArray()),
-    .replayEmeraldDawnTrack = parseTrackSteps(tracks.value("replay_emerald_dawn").toArray()),
-    .replayNeonPulseTrack = parseTrackSteps(tracks.value("replay_neon_pulse").toArray()),
-    .replayCipherRunTrack = parseTrackSteps(tracks.value("replay_cipher_run").toArray()),
-    .replayAfterglowEchoTrack = parseTrackSteps(tracks.value("replay_afterglow_echo").toArray()),
-  };
+  applyTrackOverride(tracks, "menu", ScoreTrackId::MenuEmeraldDawn, catalog);
+  applyTrackOverride(tracks, "menu_alt", ScoreTrackId::MenuNeonPulse, catalog);
+  applyTrackOverride(tracks, "gameplay", ScoreTrackId::GameplayEmeraldDawn, catalog);
+  applyTrackOverride(tracks, "gameplay_alt", ScoreTrackId::GameplayNeonPulse, catalog);
+  applyTrackOverride(tracks, "replay", ScoreTrackId::ReplayEmeraldDawn, catalog);
+  applyTrackOverride(tracks, "replay_alt", ScoreTrackId::ReplayNeonPulse, catalog);
 }
 
 auto catalog() -> const ScoreCatalog& {
   static ScoreCatalogCache cache;
   const auto overridePath = activeOverridePath();
   if (!cache.initialized || cache.overridePath != overridePath) {
-    cache.catalog = loadBuiltInCatalog();
+    cache.catalog = ScoreCatalog{};
     applyExternalOverrides(cache.catalog, overridePath);
     cache.overridePath = overridePath;
     cache.initialized = true;
@@ -255,43 +224,11 @@ auto pitchFromName(const QStringView name) -> Pitch {
 }
 
 auto scoreCueSteps(const ScoreCueId cueId) -> std::span<const ScoreStep> {
-  switch (cueId) {
-  case ScoreCueId::UiInteract:
-    return catalog().uiInteractCue;
-  case ScoreCueId::Confirm:
-    return catalog().confirmCue;
-  }
-  return {};
+  return catalog().cues.at(static_cast<std::size_t>(cueId));
 }
 
 auto scoreTrackSteps(const ScoreTrackId trackId) -> std::span<const ScoreTrackStep> {
-  switch (trackId) {
-  case ScoreTrackId::MenuEmeraldDawn:
-    return catalog().menuEmeraldDawnTrack;
-  case ScoreTrackId::MenuNeonPulse:
-    return catalog().menuNeonPulseTrack;
-  case ScoreTrackId::MenuCipherRun:
-    return catalog().menuCipherRunTrack;
-  case ScoreTrackId::MenuAfterglowEcho:
-    return catalog().menuAfterglowEchoTrack;
-  case ScoreTrackId::GameplayEmeraldDawn:
-    return catalog().gameplayEmeraldDawnTrack;
-  case ScoreTrackId::GameplayNeonPulse:
-    return catalog().gameplayNeonPulseTrack;
-  case ScoreTrackId::GameplayCipherRun:
-    return catalog().gameplayCipherRunTrack;
-  case ScoreTrackId::GameplayAfterglowEcho:
-    return catalog().gameplayAfterglowEchoTrack;
-  case ScoreTrackId::ReplayEmeraldDawn:
-    return catalog().replayEmeraldDawnTrack;
-  case ScoreTrackId::ReplayNeonPulse:
-    return catalog().replayNeonPulseTrack;
-  case ScoreTrackId::ReplayCipherRun:
-    return catalog().replayCipherRunTrack;
-  case ScoreTrackId::ReplayAfterglowEcho:
-    return catalog().replayAfterglowEchoTrack;
-  }
-  return {};
+  return catalog().tracks.at(static_cast<std::size_t>(trackId));
 }
 
 auto bgmVariantCount() -> int {
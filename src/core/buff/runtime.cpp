@@ -6,6 +6,24 @@
 
 namespace nenoserpent::core {
 
+namespace {
+// Keep utility fruits common while gating the stronger tempo/control fruits.
+constexpr std::array<std::pair<BuffId, int>, 12> WeightedBuffTable{{
+  {BuffId::Ghost, 3},
+  {BuffId::Slow, 3},
+  {BuffId::Magnet, 3},
+  {BuffId::Shield, 3},
+  {BuffId::Portal, 3},
+  {BuffId::Gold, 3},
+  {BuffId::Laser, 2},
+  {BuffId::Mini, 1},
+  {BuffId::Freeze, 2},
+  {BuffId::Scout, 2},
+  {BuffId::Vacuum, 2},
+  {BuffId::Anchor, 2},
+}};
+} // namespace
+
 auto foodPointsForBuff(BuffId activeBuff) -> int {
   if (activeBuff == BuffId::Gold) {
     return 2;
@@ -30,29 +48,16 @@ auto miniShrinkTargetLength(std::size_t currentLength, std::size_t minimumLength
   return std::max(minimumLength, currentLength / 2);
 }
 
-auto weightedRandomBuffId(const std::function<int(int)>& pickBounded) -> BuffId {
-  // Keep utility fruits common while gating the stronger tempo/control fruits.
-  static constexpr std::array<std::pair<BuffId, int>, 12> weightedTable{{
-    {BuffId::Ghost, 3},
-    {BuffId::Slow, 3},
-    {BuffId::Magnet, 3},
-    {BuffId::Shield, 3},
-    {BuffId::Portal, 3},
-    {BuffId::Gold, 3},
-    {BuffId::Laser, 2},
-    {BuffId::Mini, 1},
-    {BuffId::Freeze, 2},
-    {BuffId::Scout, 2},
-    {BuffId::Vacuum, 2},
-    {BuffId::Anchor, 2},
-  }};
-
+auto buffWeightTotal() -> int {
   int totalWeight = 0;
-  for (const auto& item : weightedTable) {
+  for (const auto& item : WeightedBuffTable) {
     totalWeight += item.second;
   }
-  int pick = pickBounded(totalWeight);
-  for (const auto& item : weightedTable) {
+  return totalWeight;
+}
+
+auto buffIdForWeightedPick(int pick) -> BuffId {
+  for (const auto& item : WeightedBuffTable) {
     if (pick < item.second) {
       return item.first;
     }
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <cstddef>
-#include <functional>
 
 namespace nenoserpent::core {
 
@@ -25,7 +24,13 @@ auto foodPointsForBuff(BuffId activeBuff) -> int;
 auto buffDurationTicks(BuffId acquiredBuff, int baseDurationTicks) -> int;
 auto miniShrinkTargetLength(std::size_t currentLength, std::size_t minimumLength = 3)
   -> std::size_t;
-auto weightedRandomBuffId(const std::function<int(int)>& pickBounded) -> BuffId;
+// Power-up rolls draw in [0, buffWeightTotal()); buffIdForWeightedPick maps the draw to a buff.
+auto buffWeightTotal() -> int;
+auto buffIdForWeightedPick(int pick) -> BuffId;
+template <typename PickBounded>
+auto weightedRandomBuffId(PickBounded&& pickBounded) -> BuffId {
+  return buffIdForWeightedPick(pickBounded(buffWeightTotal()));
+}
 auto tickBuffCountdown(int& remainingTicks) -> bool;
 
 } // namespace nenoserpent::core
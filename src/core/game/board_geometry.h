@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <QPoint>
+
+namespace nenoserpent::core {
+
+// The board every shipped level, the adapter and the tools run on.
+inline constexpr int StandardBoardWidth = 20;
+inline constexpr int StandardBoardHeight = 18;
+
+// Headless sessions (SessionRunner, bot-benchmark) accept any board within these sides. Boards of
+// more than LargeBoardCells switch spawning and bot search to bounded local windows.
+inline constexpr int MinBoardSide = 3;
+inline constexpr int MaxBoardSide = 256;
+inline constexpr int LargeBoardCells = 64 * 64;
+
+// Neighbour order of the geometry tables: right, left, down, up.
+inline constexpr std::array<QPoint, 4> BoardSteps = {
+  QPoint{1, 0},
+  QPoint{-1, 0},
+  QPoint{0, 1},
+  QPoint{0, -1},
+};
+
+constexpr auto boardStepIndex(const QPoint& step) -> std::size_t {
+  for (std::size_t i = 0; i < BoardSteps.size(); ++i) {
+    if (BoardSteps[i] == step) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+constexpr auto wrapAxis(const int value, const int size) -> int {
+  int wrapped = value % size;
+  if (wrapped < 0) {
+    wrapped += size;
+  }
+  return wrapped;
+}
+
+// Torus of any size; the generic fallback for every geometry-templated helper.
+class BoardGeometry {
+public:
+  constexpr BoardGeometry(const int width, const int height)
+      : m_width(width),
+        m_height(height) {
+  }
+
+  [[nodiscard]] constexpr auto width() const -> int {
+    return m_width;
+  }
+  [[nodiscard]] constexpr auto height() const -> int {
+    return m_height;
+  }
+  [[nodiscard]] constexpr auto cellCount() const -> std::size_t {
+    return static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height);
+  }
+  [[nodiscard]] constexpr auto contains(const QPoint& point) const -> bool {
+    return point.x() >= 0 && point.y() >= 0 && point.x() < m_width && point.y() < m_height;
+  }
+  [[nodiscard]] constexpr auto wrapPoint(const QPoint& point) const -> QPoint {
+    return {wrapAxis(point.x(), m_width), wrapAxis(point.y(), m_height)};
+  }
+  // `point` must be on the board.
+  [[nodiscard]] constexpr auto cellIndex(const QPoint& point) const -> int {
+    return (point.y() * m_width) + point.x();
+  }
+  [[nodiscard]] constexpr auto cellPoint(const int cell) const -> QPoint {
+    return {cell % m_width, cell / m_width};
+  }
+  // `step` indexes BoardSteps.
+  [[nodiscard]] constexpr auto neighbor(const int cell, const std::size_t step) const -> int {
+    return cellIndex(wrapPoint(cellPoint(cell) + BoardSteps[step]));
+  }
+
+private:
+  int m_width;
+  int m_height;
+};
+
+namespace detail {
+// Indexed by coordinate + Size, covering [-Size, 2 * Size).
+template <int Size>
+using WrapTable = std::array<std::int16_t, static_cast<std::size_t>(3 * Size)>;
+
+template <int Size>
+constexpr auto makeWrapTable() -> WrapTable<Size> {
+  WrapTable<Size> table{};
+  for (int i = 0; i < 3 * Size; ++i) {
+    table[static_cast<std::size_t>(i)] = static_cast<std::int16_t>(i % Size);
+  }
+  return table;
+}
+
+template <int Width, int Height>
+struct CellTables {
+  static constexpr auto Count = static_cast<std::size_t>(Width * Height);
+  std::array<std::int16_t, Count> x{};
+  std::array<std::int16_t, Count> y{};
+  std::array<std::array<std::int16_t, BoardSteps.size()>, Count> neighbors{};
+};
+
+template <int Width, int Height>
+constexpr auto makeCellTables() -> CellTables<Width, Height> {
+  CellTables<Width, Height> tables{};
+  for (int cell = 0; cell < Width * Height; ++cell) {
+    const auto index = static_cast<std::size_t>(cell);
+    const int x = cell % Width;
+    const int y = cell / Width;
+    tables.x[index] = static_cast<std::int16_t>(x);
+    tables.y[index] = static_cast<std::int16_t>(y);
+    for (std::size_t step = 0; step < BoardSteps.size(); ++step) {
+      const int nx = wrapAxis(x + BoardSteps[step].x(), Width);
+      const int ny = wrapAxis(y + BoardSteps[step].y(), Height);
+      tables.neighbors[index][step] = static_cast<std::int16_t>((ny * Width) + nx);
+    }
+  }
+  return tables;
+}
+} // namespace detail
+
+// Same interface as BoardGeometry for a board fixed at compile time. Wrapping a coordinate that
+// is at most one board out of range, splitting a cell index and stepping to a neighbour are all
+// table lookups; nothing on the hot path divides.
+template <int Width, int Height>
+class FixedBoardGeometry {
+  static_assert(Width > 0 && Height > 0 &&
+                Width * Height <= std::numeric_limits<std::int16_t>::max());
+
+  static constexpr auto WrapX = detail::makeWrapTable<Width>();
+  static constexpr auto WrapY = detail::makeWrapTable<Height>();
+  static constexpr auto Cells = detail::makeCellTables<Width, Height>();
+
+  template <int Size>
+  static constexpr auto wrapWithTable(const int value, const detail::WrapTable<Size>& table)
+    -> int {
+    if (value >= -Size && value < 2 * Size) {
+      return table[static_cast<std::size_t>(value + Size)];
+    }
+    // Constant divisor: the compiler strength-reduces this to multiplies.
+    return wrapAxis(value, Size);
+  }
+
+public:
+  [[nodiscard]] static constexpr auto width() -> int {
+    return Width;
+  }
+  [[nodiscard]] static constexpr auto height() -> int {
+    return Height;
+  }
+  [[nodiscard]] static constexpr auto cellCount() -> std::size_t {
+    return static_cast<std::size_t>(Width * Height);
+  }
+  [[nodiscard]] static constexpr auto contains(const QPoint& point) -> bool {
+    return point.x() >= 0 && point.y() >= 0 && point.x() < Width && point.y() < Height;
+  }
+  [[nodiscard]] static constexpr auto wrapPoint(const QPoint& point) -> QPoint {
+    return {wrapWithTable<Width>(point.x(), WrapX), wrapWithTable<Height>(point.y(), WrapY)};
+  }
+  [[nodiscard]] static constexpr auto cellIndex(const QPoint& point) -> int {
+    return (point.y() * Width) + point.x();
+  }
+  [[nodiscard]] static constexpr auto cellPoint(const int cell) -> QPoint {
+    const auto index = static_cast<std::size_t>(cell);
+    return {Cells.x[index], Cells.y[index]};
+  }
+  [[nodiscard]] static constexpr auto neighbor(const int cell, const std::size_t step) -> int {
+    return Cells.neighbors[static_cast<std::size_t>(cell)][step];
+  }
+};
+
+using StandardBoardGeometry = FixedBoardGeometry<StandardBoardWidth, StandardBoardHeight>;
+
+[[nodiscard]] constexpr auto isStandardBoard(const int width, const int height) -> bool {
+  return width == StandardBoardWidth && height == StandardBoardHeight;
+}
+
+[[nodiscard]] constexpr auto isLargeBoard(const int width, const int height) -> bool {
+  return width * height > LargeBoardCells;
+}
+
+[[nodiscard]] constexpr auto clampBoardSide(const int side) -> int {
+  return std::clamp(side, MinBoardSide, MaxBoardSide);
+}
+
+// Runs `visit` with StandardBoardGeometry on the standard board and BoardGeometry otherwise, so
+// a geometry-templated helper gets a table-driven instantiation for the common case.
+template <typename Visitor>
+auto visitBoardGeometry(const int width, const int height, Visitor&& visit) -> decltype(auto) {
+  if (isStandardBoard(width, height)) {
+    return visit(StandardBoardGeometry{});
+  }
+  return visit(BoardGeometry(width, height));
+}
+
+inline auto wrapPoint(const QPoint& point, const int boardWidth, const int boardHeight) -> QPoint {
+  if (isStandardBoard(boardWidth, boardHeight)) {
+    return StandardBoardGeometry::wrapPoint(point);
+  }
+  return {wrapAxis(point.x(), boardWidth), wrapAxis(point.y(), boardHeight)};
+}
+
+} // namespace nenoserpent::core
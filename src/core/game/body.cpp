@@ -0,0 +1,80 @@
+#include "core/game/body.h"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+namespace nenoserpent::core {
+
+namespace {
+constexpr std::size_t MinimumCapacity = 8;
+} // namespace
+
+SnakeBody::SnakeBody(std::initializer_list<QPoint> cells) {
+  reserve(cells.size());
+  for (const QPoint& cell : cells) {
+    push_back(cell);
+  }
+}
+
+SnakeBody::SnakeBody(const SnakeBody& other) {
+  copyFrom(other);
+}
+
+SnakeBody::SnakeBody(SnakeBody&& other) noexcept
+    : m_cells(std::move(other.m_cells)),
+      m_capacity(std::exchange(other.m_capacity, 0)),
+      m_head(std::exchange(other.m_head, 0)),
+      m_size(std::exchange(other.m_size, 0)) {
+}
+
+auto SnakeBody::operator=(const SnakeBody& other) -> SnakeBody& {
+  if (this != &other) {
+    copyFrom(other);
+  }
+  return *this;
+}
+
+auto SnakeBody::operator=(SnakeBody&& other) noexcept -> SnakeBody& {
+  if (this != &other) {
+    m_cells = std::move(other.m_cells);
+    m_capacity = std::exchange(other.m_capacity, 0);
+    m_head = std::exchange(other.m_head, 0);
+    m_size = std::exchange(other.m_size, 0);
+  }
+  return *this;
+}
+
+void SnakeBody::reserve(const std::size_t cells) {
+  if (cells > m_capacity) {
+    grow(cells);
+  }
+}
+
+void SnakeBody::grow(const std::size_t cells) {
+  const std::size_t capacity = std::bit_ceil(std::max({cells, MinimumCapacity, m_capacity * 2}));
+  auto next = std::make_unique<Cell[]>(capacity);
+  for (std::size_t i = 0; i < m_size; ++i) {
+    next[i] = m_cells[slot(i)];
+  }
+  m_cells = std::move(next);
+  m_capacity = capacity;
+  m_head = 0;
+}
+
+// Copies land linearized at slot 0 and reuse the existing ring when it is large enough.
+void SnakeBody::copyFrom(const SnakeBody& other) {
+  m_head = 0;
+  m_size = 0;
+  reserve(other.m_size);
+  const std::size_t firstRun = std::min(other.m_size, other.m_capacity - other.m_head);
+  std::copy_n(other.m_cells.get() + other.m_head, firstRun, m_cells.get());
+  std::copy_n(other.m_cells.get(), other.m_size - firstRun, m_cells.get() + firstRun);
+  m_size = other.m_size;
+}
+
+auto operator==(const SnakeBody& lhs, const SnakeBody& rhs) -> bool {
+  return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+} // namespace nenoserpent::core
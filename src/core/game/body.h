@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+
+#include <QPoint>
+
+namespace nenoserpent::core {
+
+// Snake body as a contiguous ring of packed 16-bit cells, head first.
+// Head push / tail pop are O(1) and never allocate once the ring holds the board's cell count,
+// and a copy only touches the live segments, so snapshots and bot lookahead stay cheap.
+// Coordinates must fit in int16 (boards are at most 256x256).
+class SnakeBody {
+public:
+  using value_type = QPoint;
+  using size_type = std::size_t;
+
+  class const_iterator {
+  public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = QPoint;
+    using difference_type = std::ptrdiff_t;
+    using reference = QPoint;
+
+    const_iterator() = default;
+    const_iterator(const SnakeBody* body, const std::size_t index)
+        : m_body(body),
+          m_index(index) {
+    }
+
+    [[nodiscard]] auto operator*() const -> QPoint {
+      return (*m_body)[m_index];
+    }
+    [[nodiscard]] auto operator[](const difference_type offset) const -> QPoint {
+      return *(*this + offset);
+    }
+    auto operator++() -> const_iterator& {
+      ++m_index;
+      return *this;
+    }
+    auto operator++(int) -> const_iterator {
+      auto previous = *this;
+      ++m_index;
+      return previous;
+    }
+    auto operator--() -> const_iterator& {
+      --m_index;
+      return *this;
+    }
+    auto operator--(int) -> const_iterator {
+      auto previous = *this;
+      --m_index;
+      return previous;
+    }
+    auto operator+=(const difference_type offset) -> const_iterator& {
+      m_index = static_cast<std::size_t>(static_cast<difference_type>(m_index) + offset);
+      return *this;
+    }
+    auto operator-=(const difference_type offset) -> const_iterator& {
+      return *this += -offset;
+    }
+    [[nodiscard]] friend auto operator+(const_iterator it, const difference_type offset)
+      -> const_iterator {
+      return it += offset;
+    }
+    [[nodiscard]] friend auto operator+(const difference_type offset, const_iterator it)
+      -> const_iterator {
+      return it += offset;
+    }
+    [[nodiscard]] friend auto operator-(const_iterator it, const difference_type offset)
+      -> const_iterator {
+      return it -= offset;
+    }
+    [[nodiscard]] friend auto operator-(const const_iterator& lhs, const const_iterator& rhs)
+      -> difference_type {
+      return static_cast<difference_type>(lhs.m_index) - static_cast<difference_type>(rhs.m_index);
+    }
+    [[nodiscard]] friend auto operator==(const const_iterator& lhs, const const_iterator& rhs)
+      -> bool {
+      return lhs.m_index == rhs.m_index;
+    }
+    [[nodiscard]] friend auto operator<=>(const const_iterator& lhs, const const_iterator& rhs) {
+      return lhs.m_index <=> rhs.m_index;
+    }
+
+  private:
+    const SnakeBody* m_body = nullptr;
+    std::size_t m_index = 0;
+  };
+  using iterator = const_iterator;
+
+  SnakeBody() = default;
+  SnakeBody(std::initializer_list<QPoint> cells);
+  SnakeBody(const SnakeBody& other);
+  SnakeBody(SnakeBody&& other) noexcept;
+  auto operator=(const SnakeBody& other) -> SnakeBody&;
+  auto operator=(SnakeBody&& other) noexcept -> SnakeBody&;
+  ~SnakeBody() = default;
+
+  // Grows the ring to hold at least `cells` segments; never shrinks.
+  void reserve(std::size_t cells);
+  [[nodiscard]] auto capacity() const -> std::size_t {
+    return m_capacity;
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t {
+    return m_size;
+  }
+  [[nodiscard]] auto empty() const -> bool {
+    return m_size == 0;
+  }
+  void clear() {
+    m_head = 0;
+    m_size = 0;
+  }
+
+  [[nodiscard]] auto operator[](const std::size_t index) const -> QPoint {
+    return unpack(m_cells[slot(index)]);
+  }
+  [[nodiscard]] auto front() const -> QPoint {
+    return (*this)[0];
+  }
+  [[nodiscard]] auto back() const -> QPoint {
+    return (*this)[m_size - 1];
+  }
+
+  void push_front(const QPoint& cell) {
+    if (m_size == m_capacity) {
+      grow(m_size + 1);
+    }
+    m_head = (m_head + m_capacity - 1) & (m_capacity - 1);
+    m_cells[m_head] = pack(cell);
+    ++m_size;
+  }
+  void push_back(const QPoint& cell) {
+    if (m_size == m_capacity) {
+      grow(m_size + 1);
+    }
+    m_cells[slot(m_size)] = pack(cell);
+    ++m_size;
+  }
+  void emplace_front(const QPoint& cell) {
+    push_front(cell);
+  }
+  void emplace_back(const QPoint& cell) {
+    push_back(cell);
+  }
+  void pop_front() {
+    m_head = (m_head + 1) & (m_capacity - 1);
+    --m_size;
+  }
+  void pop_back() {
+    --m_size;
+  }
+
+  [[nodiscard]] auto begin() const -> const_iterator {
+    return {this, 0};
+  }
+  [[nodiscard]] auto end() const -> const_iterator {
+    return {this, m_size};
+  }
+  [[nodiscard]] auto cbegin() const -> const_iterator {
+    return begin();
+  }
+  [[nodiscard]] auto cend() const -> const_iterator {
+    return end();
+  }
+
+  friend auto operator==(const SnakeBody& lhs, const SnakeBody& rhs) -> bool;
+
+private:
+  struct Cell {
+    std::int16_t x = 0;
+    std::int16_t y = 0;
+  };
+
+  [[nodiscard]] static auto pack(const QPoint& point) -> Cell {
+    return {.x = static_cast<std::int16_t>(point.x()), .y = static_cast<std::int16_t>(point.y())};
+  }
+  [[nodiscard]] static auto unpack(const Cell cell) -> QPoint {
+    return {cell.x, cell.y};
+  }
+  [[nodiscard]] auto slot(const std::size_t index) const -> std::size_t {
+    return (m_head + index) & (m_capacity - 1);
+  }
+  void grow(std::size_t cells);
+  void copyFrom(const SnakeBody& other);
+
+  std::unique_ptr<Cell[]> m_cells;
+  std::size_t m_capacity = 0;
+  std::size_t m_head = 0;
+  std::size_t m_size = 0;
+};
+
+} // namespace nenoserpent::core
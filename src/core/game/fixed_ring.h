@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+
+namespace nenoserpent::core {
+
+// Bounded FIFO stored inline, for the small per-session queues on the tick path (queued turns,
+// recent spawn cells). Unlike std::deque it never allocates, however pushes and pops interleave.
+// Pushing onto a full ring is a caller bug; check full() first.
+template <typename T, std::size_t Capacity>
+class FixedRing {
+  static_assert(Capacity > 0);
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  class const_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T*;
+    using reference = const T&;
+
+    const_iterator() = default;
+    const_iterator(const FixedRing* ring, const std::size_t index)
+        : m_ring(ring),
+          m_index(index) {
+    }
+
+    [[nodiscard]] auto operator*() const -> const T& {
+      return (*m_ring)[m_index];
+    }
+    auto operator++() -> const_iterator& {
+      ++m_index;
+      return *this;
+    }
+    auto operator++(int) -> const_iterator {
+      auto previous = *this;
+      ++m_index;
+      return previous;
+    }
+    [[nodiscard]] friend auto operator==(const const_iterator& lhs, const const_iterator& rhs)
+      -> bool {
+      return lhs.m_index == rhs.m_index;
+    }
+
+  private:
+    const FixedRing* m_ring = nullptr;
+    std::size_t m_index = 0;
+  };
+
+  [[nodiscard]] static constexpr auto capacity() -> std::size_t {
+    return Capacity;
+  }
+  [[nodiscard]] auto size() const -> std::size_t {
+    return m_size;
+  }
+  [[nodiscard]] auto empty() const -> bool {
+    return m_size == 0;
+  }
+  [[nodiscard]] auto full() const -> bool {
+    return m_size == Capacity;
+  }
+  void clear() {
+    m_head = 0;
+    m_size = 0;
+  }
+
+  [[nodiscard]] auto operator[](const std::size_t index) const -> const T& {
+    return m_items[(m_head + index) % Capacity];
+  }
+  [[nodiscard]] auto front() const -> const T& {
+    return m_items[m_head];
+  }
+  [[nodiscard]] auto back() const -> const T& {
+    return (*this)[m_size - 1];
+  }
+
+  void push_back(const T& value) {
+    m_items[(m_head + m_size) % Capacity] = value;
+    ++m_size;
+  }
+  void pop_front() {
+    m_head = (m_head + 1) % Capacity;
+    --m_size;
+  }
+
+  [[nodiscard]] auto begin() const -> const_iterator {
+    return {this, 0};
+  }
+  [[nodiscard]] auto end() const -> const_iterator {
+    return {this, m_size};
+  }
+
+private:
+  std::array<T, Capacity> m_items{};
+  std::size_t m_head = 0;
+  std::size_t m_size = 0;
+};
+
+} // namespace nenoserpent::core
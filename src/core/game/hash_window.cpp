@@ -0,0 +1,90 @@
+#include "core/game/hash_window.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace nenoserpent::core {
+
+HashWindow::HashWindow(const int window) {
+  setWindow(window);
+}
+
+void HashWindow::setWindow(const int window) {
+  const auto capacity = static_cast<std::size_t>(std::max(1, window));
+  m_ring.assign(capacity, 0);
+  // At most `capacity` distinct keys are live, so this keeps the load factor at or below 1/2.
+  m_slots.assign(std::bit_ceil(capacity * 2), Slot{});
+  m_mask = m_slots.size() - 1;
+  m_oldest = 0;
+  m_size = 0;
+}
+
+// Releases only the live entries: the stall guard clears on every scoring and replay tick, and
+// wiping the whole table each time would cost its full size even when the window is nearly empty.
+void HashWindow::clear() {
+  if (m_size == 0) {
+    return;
+  }
+  for (int index = 0; index < m_size; ++index) {
+    release(at(index));
+  }
+  m_oldest = 0;
+  m_size = 0;
+}
+
+auto HashWindow::observe(const std::uint64_t hash) -> int {
+  Slot& slot = m_slots[findSlot(hash)];
+  slot.key = hash;
+  const int repeats = ++slot.count;
+
+  const std::size_t capacity = m_ring.size();
+  if (static_cast<std::size_t>(m_size) < capacity) {
+    m_ring[(m_oldest + static_cast<std::size_t>(m_size)) % capacity] = hash;
+    ++m_size;
+    return repeats;
+  }
+  release(m_ring[m_oldest]);
+  m_ring[m_oldest] = hash;
+  m_oldest = (m_oldest + 1) % capacity;
+  return repeats;
+}
+
+auto HashWindow::countOf(const std::uint64_t hash) const -> int {
+  return m_slots[findSlot(hash)].count;
+}
+
+auto HashWindow::homeSlot(const std::uint64_t hash) const -> std::size_t {
+  return static_cast<std::size_t>((hash ^ (hash >> 29U)) * 0x9e3779b97f4a7c15ULL >> 32U) & m_mask;
+}
+
+auto HashWindow::findSlot(const std::uint64_t hash) const -> std::size_t {
+  std::size_t index = homeSlot(hash);
+  while (m_slots[index].count > 0 && m_slots[index].key != hash) {
+    index = (index + 1) & m_mask;
+  }
+  return index;
+}
+
+void HashWindow::release(const std::uint64_t hash) {
+  std::size_t hole = findSlot(hash);
+  if (m_slots[hole].count == 0 || --m_slots[hole].count > 0) {
+    return;
+  }
+  m_slots[hole] = {};
+  // Backward-shift deletion: pull later members of the probe run into the hole whenever their
+  // home slot does not lie cyclically in (hole, index].
+  for (std::size_t index = (hole + 1) & m_mask; m_slots[index].count > 0;
+       index = (index + 1) & m_mask) {
+    const std::size_t home = homeSlot(m_slots[index].key);
+    const bool homeBetween =
+      hole <= index ? (home > hole && home <= index) : (home > hole || home <= index);
+    if (homeBetween) {
+      continue;
+    }
+    m_slots[hole] = m_slots[index];
+    m_slots[index] = {};
+    hole = index;
+  }
+}
+
+} // namespace nenoserpent::core
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nenoserpent::core {
+
+// Sliding-window multiset of the last `window` observed hashes.
+// Storage is a fixed ring plus an open-addressing (linear probing, backward-shift delete)
+// count table sized once in setWindow, so observe/countOf never allocate.
+class HashWindow {
+public:
+  explicit HashWindow(int window = 128);
+
+  void setWindow(int window);
+  void clear();
+
+  // Records `hash` and returns its count including this observation. The oldest entry is
+  // evicted afterwards once the window is full, matching the old deque + map bookkeeping.
+  auto observe(std::uint64_t hash) -> int;
+  [[nodiscard]] auto countOf(std::uint64_t hash) const -> int;
+  [[nodiscard]] auto size() const -> int {
+    return m_size;
+  }
+  [[nodiscard]] auto window() const -> int {
+    return static_cast<int>(m_ring.size());
+  }
+  // Observed hash `index` places after the oldest one still in the window.
+  [[nodiscard]] auto at(const int index) const -> std::uint64_t {
+    return m_ring[(m_oldest + static_cast<std::size_t>(index)) % m_ring.size()];
+  }
+
+private:
+  struct Slot {
+    std::uint64_t key = 0;
+    int count = 0;
+  };
+
+  [[nodiscard]] auto homeSlot(std::uint64_t hash) const -> std::size_t;
+  [[nodiscard]] auto findSlot(std::uint64_t hash) const -> std::size_t;
+  void release(std::uint64_t hash);
+
+  std::vector<std::uint64_t> m_ring;
+  std::size_t m_oldest = 0;
+  int m_size = 0;
+  std::vector<Slot> m_slots;
+  std::size_t m_mask = 0;
+};
+
+} // namespace nenoserpent::core
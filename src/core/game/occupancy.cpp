@@ -0,0 +1,230 @@
+#include "core/game/occupancy.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+
+namespace nenoserpent::core {
+
+namespace {
+constexpr std::size_t BitsPerWord = 64;
+
+auto cellIndex(const QPoint& point, const int boardWidth) -> std::size_t {
+  return static_cast<std::size_t>((point.y() * boardWidth) + point.x());
+}
+
+auto wordCount(const std::size_t bits) -> std::size_t {
+  return (bits + BitsPerWord - 1) / BitsPerWord;
+}
+
+auto bitMask(const std::size_t bit) -> std::uint64_t {
+  return std::uint64_t{1} << (bit % BitsPerWord);
+}
+} // namespace
+
+void OccupancyGrid::resize(const int boardWidth, const int boardHeight) {
+  m_width = std::max(0, boardWidth);
+  m_height = std::max(0, boardHeight);
+  reset(m_body);
+  reset(m_obstacles);
+  rebuildFreeCells();
+}
+
+void OccupancyGrid::clearBody() {
+  reset(m_body);
+  rebuildFreeCells();
+}
+
+void OccupancyGrid::clearObstacles() {
+  reset(m_obstacles);
+  rebuildFreeCells();
+}
+
+void OccupancyGrid::addBody(const QPoint& point) {
+  add(m_body, m_obstacles, point);
+}
+
+void OccupancyGrid::removeBody(const QPoint& point) {
+  remove(m_body, m_obstacles, point);
+}
+
+void OccupancyGrid::addObstacle(const QPoint& point) {
+  add(m_obstacles, m_body, point);
+}
+
+void OccupancyGrid::removeObstacle(const QPoint& point) {
+  remove(m_obstacles, m_body, point);
+}
+
+auto OccupancyGrid::hasBody(const QPoint& point) const -> bool {
+  return test(m_body, point);
+}
+
+auto OccupancyGrid::hasObstacle(const QPoint& point) const -> bool {
+  return test(m_obstacles, point);
+}
+
+auto OccupancyGrid::isOccupied(const QPoint& point) const -> bool {
+  if (!contains(point)) {
+    return false;
+  }
+  const std::size_t index = cellIndex(point, m_width);
+  const std::size_t word = index / BitsPerWord;
+  return ((m_body.bits[word] | m_obstacles.bits[word]) & bitMask(index)) != 0;
+}
+
+auto OccupancyGrid::freeCount(const QPoint& reserved) const -> int {
+  const int count = static_cast<int>(m_freeCells.size());
+  if (contains(reserved) && m_freeSlots[cellIndex(reserved, m_width)] >= 0) {
+    return count - 1;
+  }
+  return count;
+}
+
+auto OccupancyGrid::freeCellAt(const int rank, const FreeCellOrder order, const QPoint& reserved)
+  const -> QPoint {
+  if (rank < 0 || rank >= freeCount(reserved)) {
+    return {-1, -1};
+  }
+  // Skipping the reserved cell keeps the mapping a bijection onto the remaining free cells.
+  if (order == FreeCellOrder::Dense) {
+    const int reservedSlot =
+      contains(reserved) ? m_freeSlots[cellIndex(reserved, m_width)] : -1;
+    const int slot = (reservedSlot >= 0 && rank >= reservedSlot) ? rank + 1 : rank;
+    return denseFreeCell(slot);
+  }
+  const int reservedRank = freeScanRank(reserved);
+  return freeCellAtScanRank((reservedRank >= 0 && rank >= reservedRank) ? rank + 1 : rank);
+}
+
+auto OccupancyGrid::denseFreeCell(const int slot) const -> QPoint {
+  const int index = m_freeCells[static_cast<std::size_t>(slot)];
+  return {index % m_width, index / m_width};
+}
+
+void OccupancyGrid::add(Layer& layer, const Layer& other, const QPoint& point) {
+  if (!contains(point)) {
+    ++layer.outside;
+    return;
+  }
+  const std::size_t index = cellIndex(point, m_width);
+  if (layer.counts[index]++ == 0) {
+    layer.bits[index / BitsPerWord] |= bitMask(index);
+    if (other.counts[index] == 0) {
+      markOccupied(index);
+    }
+  }
+}
+
+void OccupancyGrid::remove(Layer& layer, const Layer& other, const QPoint& point) {
+  if (!contains(point)) {
+    layer.outside = std::max(0, layer.outside - 1);
+    return;
+  }
+  const std::size_t index = cellIndex(point, m_width);
+  if (layer.counts[index] == 0) {
+    return;
+  }
+  if (--layer.counts[index] == 0) {
+    layer.bits[index / BitsPerWord] &= ~bitMask(index);
+    if (other.counts[index] == 0) {
+      markFree(index);
+    }
+  }
+}
+
+auto OccupancyGrid::test(const Layer& layer, const QPoint& point) const -> bool {
+  if (!contains(point)) {
+    return false;
+  }
+  const std::size_t index = cellIndex(point, m_width);
+  return (layer.bits[index / BitsPerWord] & bitMask(index)) != 0;
+}
+
+void OccupancyGrid::reset(Layer& layer) const {
+  const auto cells = static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height);
+  layer.bits.assign(wordCount(cells), 0);
+  layer.counts.assign(cells, 0);
+  layer.outside = 0;
+}
+
+void OccupancyGrid::markOccupied(const std::size_t index) {
+  const int slot = m_freeSlots[index];
+  if (slot < 0) {
+    return;
+  }
+  const int last = m_freeCells.back();
+  m_freeCells[static_cast<std::size_t>(slot)] = last;
+  m_freeSlots[static_cast<std::size_t>(last)] = slot;
+  m_freeCells.pop_back();
+  m_freeSlots[index] = -1;
+  const std::size_t bit = scanBit(index);
+  m_freeScanBits[bit / BitsPerWord] &= ~bitMask(bit);
+}
+
+void OccupancyGrid::markFree(const std::size_t index) {
+  if (m_freeSlots[index] >= 0) {
+    return;
+  }
+  m_freeSlots[index] = static_cast<int>(m_freeCells.size());
+  m_freeCells.push_back(static_cast<int>(index));
+  const std::size_t bit = scanBit(index);
+  m_freeScanBits[bit / BitsPerWord] |= bitMask(bit);
+}
+
+void OccupancyGrid::rebuildFreeCells() {
+  const auto cells = static_cast<std::size_t>(m_width) * static_cast<std::size_t>(m_height);
+  m_freeCells.clear();
+  m_freeCells.reserve(cells);
+  m_freeSlots.assign(cells, -1);
+  m_freeScanBits.assign(wordCount(cells), 0);
+  for (int x = 0; x < m_width; ++x) {
+    for (int y = 0; y < m_height; ++y) {
+      const std::size_t index = cellIndex(QPoint(x, y), m_width);
+      if (m_body.counts[index] == 0 && m_obstacles.counts[index] == 0) {
+        markFree(index);
+      }
+    }
+  }
+}
+
+auto OccupancyGrid::scanBit(const std::size_t index) const -> std::size_t {
+  const auto width = static_cast<std::size_t>(m_width);
+  const auto height = static_cast<std::size_t>(m_height);
+  return ((index % width) * height) + (index / width);
+}
+
+auto OccupancyGrid::cellAtScanBit(const std::size_t bit) const -> QPoint {
+  const auto height = static_cast<std::size_t>(m_height);
+  return {static_cast<int>(bit / height), static_cast<int>(bit % height)};
+}
+
+auto OccupancyGrid::freeScanRank(const QPoint& point) const -> int {
+  if (!contains(point) || m_freeSlots[cellIndex(point, m_width)] < 0) {
+    return -1;
+  }
+  const std::size_t bit = scanBit(cellIndex(point, m_width));
+  int rank = 0;
+  for (std::size_t word = 0; word < bit / BitsPerWord; ++word) {
+    rank += std::popcount(m_freeScanBits[word]);
+  }
+  return rank + std::popcount(m_freeScanBits[bit / BitsPerWord] & (bitMask(bit) - 1));
+}
+
+auto OccupancyGrid::freeCellAtScanRank(int rank) const -> QPoint {
+  for (std::size_t word = 0; word < m_freeScanBits.size(); ++word) {
+    std::uint64_t bits = m_freeScanBits[word];
+    const int population = std::popcount(bits);
+    if (rank >= population) {
+      rank -= population;
+      continue;
+    }
+    for (; rank > 0; --rank) {
+      bits &= bits - 1;
+    }
+    return cellAtScanBit((word * BitsPerWord) + static_cast<std::size_t>(std::countr_zero(bits)));
+  }
+  return {-1, -1};
+}
+
+} // namespace nenoserpent::core
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <QPoint>
+
+namespace nenoserpent::core {
+
+// How a rank in [0, freeCount) maps to a free cell.
+// Scan follows collectFreeSpots (x outer, y inner) so seeded picks match recorded replays;
+// Dense indexes the internal swap-remove array and is O(1), but its order depends on history.
+enum class FreeCellOrder {
+  Scan,
+  Dense,
+};
+
+// Packed per-cell occupancy for one board. Each layer keeps a bitboard for constant-time tests
+// plus a per-cell multiplicity so overlapping segments (ghost pass-through, duplicate walls) can
+// be removed one at a time. Points outside the board are only counted, never stored.
+// Cells with neither body nor obstacle are mirrored in a free-cell set that is updated on the
+// same transitions, so free-spot picks never rescan the board.
+class OccupancyGrid {
+public:
+  void resize(int boardWidth, int boardHeight);
+  void clearBody();
+  void clearObstacles();
+
+  [[nodiscard]] auto width() const -> int {
+    return m_width;
+  }
+  [[nodiscard]] auto height() const -> int {
+    return m_height;
+  }
+  [[nodiscard]] auto contains(const QPoint& point) const -> bool {
+    return point.x() >= 0 && point.y() >= 0 && point.x() < m_width && point.y() < m_height;
+  }
+
+  void addBody(const QPoint& point);
+  void removeBody(const QPoint& point);
+  void addObstacle(const QPoint& point);
+  void removeObstacle(const QPoint& point);
+
+  [[nodiscard]] auto hasBody(const QPoint& point) const -> bool;
+  [[nodiscard]] auto hasObstacle(const QPoint& point) const -> bool;
+  [[nodiscard]] auto isOccupied(const QPoint& point) const -> bool;
+  [[nodiscard]] auto outsideCount() const -> int {
+    return m_body.outside + m_obstacles.outside;
+  }
+
+  // `reserved` is an extra cell treated as blocked (the food or power-up slot).
+  [[nodiscard]] auto freeCount(const QPoint& reserved = {-1, -1}) const -> int;
+  [[nodiscard]] auto freeCellAt(int rank, FreeCellOrder order, const QPoint& reserved = {-1, -1})
+    const -> QPoint;
+  [[nodiscard]] auto denseFreeCell(int slot) const -> QPoint;
+
+private:
+  struct Layer {
+    std::vector<std::uint64_t> bits;
+    std::vector<std::uint16_t> counts;
+    int outside = 0;
+  };
+
+  void add(Layer& layer, const Layer& other, const QPoint& point);
+  void remove(Layer& layer, const Layer& other, const QPoint& point);
+  [[nodiscard]] auto test(const Layer& layer, const QPoint& point) const -> bool;
+  void reset(Layer& layer) const;
+  void markOccupied(std::size_t index);
+  void markFree(std::size_t index);
+  void rebuildFreeCells();
+  [[nodiscard]] auto scanBit(std::size_t index) const -> std::size_t;
+  [[nodiscard]] auto cellAtScanBit(std::size_t bit) const -> QPoint;
+  [[nodiscard]] auto freeScanRank(const QPoint& point) const -> int;
+  [[nodiscard]] auto freeCellAtScanRank(int rank) const -> QPoint;
+
+  int m_width = 0;
+  int m_height = 0;
+  Layer m_body;
+  Layer m_obstacles;
+  std::vector<int> m_freeCells;
+  std::vector<int> m_freeSlots;
+  std::vector<std::uint64_t> m_freeScanBits;
+};
+
+} // namespace nenoserpent::core
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <type_traits>
+
+namespace nenoserpent::core {
+
+// Non-owning view of a bounded random source: `source(bound)` returns a value in [0, bound).
+// It is two pointers and never allocates, but every draw is an indirect call the compiler cannot
+// inline; spawn helpers are templated on the source instead, so CounterRng draws stay direct.
+// It does not extend the source's lifetime: use it as a parameter type only.
+class RandomBounded {
+public:
+  template <typename Source>
+    requires(!std::is_same_v<std::remove_cvref_t<Source>, RandomBounded> &&
+             std::is_invocable_r_v<int, Source&, int>)
+  // NOLINTNEXTLINE(google-explicit-constructor,bugprone-forwarding-reference-overload)
+  RandomBounded(Source&& source) noexcept
+      : m_source(const_cast<void*>(static_cast<const void*>(std::addressof(source)))),
+        m_call([](void* erased, const int bound) -> int {
+          return (*static_cast<std::remove_reference_t<Source>*>(erased))(bound);
+        }) {
+  }
+
+  auto operator()(const int bound) const -> int {
+    return m_call(m_source, bound);
+  }
+
+private:
+  void* m_source;
+  int (*m_call)(void*, int);
+};
+
+// Counter-based generator: draw n is a keyed bijective mix of n, so the state is just
+// (key, position). That makes skip-ahead O(1) and lets split() fork independent, reproducible
+// streams (per simulated session, per verification worker) from one seed.
+// Not cryptographic. Recorded replays keep using ReplayRng, whose sequence they depend on.
+class CounterRng {
+public:
+  explicit CounterRng(const std::uint64_t seed = 0, const std::uint64_t stream = 0) {
+    reseed(seed, stream);
+  }
+
+  void reseed(const std::uint64_t seed, const std::uint64_t stream = 0) {
+    m_key0 = splitMix(seed ^ splitMix(stream + 0x632be59bd9b4e019ULL));
+    m_key1 = splitMix(m_key0 ^ stream);
+    m_position = 0;
+  }
+
+  [[nodiscard]] auto next() -> std::uint64_t {
+    return draw(m_position++);
+  }
+  [[nodiscard]] auto generate() -> std::uint32_t {
+    return static_cast<std::uint32_t>(next() >> 32U);
+  }
+
+  // Unbiased value in [0, bound) (Lemire's multiply-shift with rejection); 0 when bound <= 0.
+  [[nodiscard]] auto bounded(const int bound) -> int {
+    if (bound <= 0) {
+      return 0;
+    }
+    const auto range = static_cast<std::uint32_t>(bound);
+    std::uint64_t product = std::uint64_t{generate()} * range;
+    auto low = static_cast<std::uint32_t>(product);
+    if (low < range) {
+      const std::uint32_t threshold = (0U - range) % range;
+      while (low < threshold) {
+        product = std::uint64_t{generate()} * range;
+        low = static_cast<std::uint32_t>(product);
+      }
+    }
+    return static_cast<int>(product >> 32U);
+  }
+  auto operator()(const int bound) -> int {
+    return bounded(bound);
+  }
+
+  void discard(const std::uint64_t count) {
+    m_position += count;
+  }
+  [[nodiscard]] auto position() const -> std::uint64_t {
+    return m_position;
+  }
+  void setPosition(const std::uint64_t position) {
+    m_position = position;
+  }
+
+  // Child stream `stream` of this generator, starting at position 0. Independent of the
+  // parent's current position, so forks are reproducible regardless of when they are taken.
+  [[nodiscard]] auto split(const std::uint64_t stream) const -> CounterRng {
+    CounterRng child;
+    child.m_key0 = splitMix(m_key0 ^ splitMix(stream + 0x9e3779b97f4a7c15ULL));
+    child.m_key1 = splitMix(m_key1 + child.m_key0);
+    return child;
+  }
+
+  [[nodiscard]] auto key() const -> std::uint64_t {
+    return m_key0;
+  }
+  [[nodiscard]] auto streamKey() const -> std::uint64_t {
+    return m_key1;
+  }
+  void restore(const std::uint64_t key,
+               const std::uint64_t streamKey,
+               const std::uint64_t position) {
+    m_key0 = key;
+    m_key1 = streamKey;
+    m_position = position;
+  }
+
+  friend auto operator==(const CounterRng&, const CounterRng&) -> bool = default;
+
+private:
+  [[nodiscard]] static auto splitMix(std::uint64_t z) -> std::uint64_t {
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31U);
+  }
+  [[nodiscard]] static auto finalize(std::uint64_t z) -> std::uint64_t {
+    z = (z ^ (z >> 33U)) * 0xff51afd7ed558ccdULL;
+    z = (z ^ (z >> 33U)) * 0xc4ceb9fe1a85ec53ULL;
+    return z ^ (z >> 33U);
+  }
+  [[nodiscard]] auto draw(const std::uint64_t counter) const -> std::uint64_t {
+    return finalize(finalize((counter * 0x9e3779b97f4a7c15ULL) + m_key0) ^ m_key1);
+  }
+
+  std::uint64_t m_key0 = 0;
+  std::uint64_t m_key1 = 0;
+  std::uint64_t m_position = 0;
+};
+
+// The generator recorded runs draw from: the 32-bit Mersenne Twister that QRandomGenerator(seed)
+// wraps, seeded the same way, so ghosts recorded through QRandomGenerator replay unchanged. Unlike
+// QRandomGenerator its state is open, so a keyframe or saved session stores it and resumes with a
+// copy instead of re-drawing every output since the seed.
+class ReplayRng {
+public:
+  static constexpr std::size_t StateWords = 624;
+  using Words = std::array<std::uint32_t, StateWords>;
+
+  explicit ReplayRng(const std::uint32_t seed = 1) {
+    reseed(seed);
+  }
+
+  void reseed(const std::uint32_t seed) {
+    std::seed_seq sequence{seed};
+    sequence.generate(m_words.begin(), m_words.end());
+    // As std::mt19937::seed(seed_seq&): a state that is zero but for word 0's low bits would
+    // only ever produce zeros.
+    bool zero = (m_words[0] & UpperMask) == 0;
+    for (std::size_t i = 1; zero && i < StateWords; ++i) {
+      zero = m_words[i] == 0;
+    }
+    if (zero) {
+      m_words[0] = UpperMask;
+    }
+    m_index = StateWords;
+  }
+
+  [[nodiscard]] auto generate() -> std::uint32_t {
+    if (m_index >= StateWords) {
+      twist();
+    }
+    std::uint32_t y = m_words[m_index++];
+    y ^= y >> 11U;
+    y ^= (y << 7U) & 0x9d2c5680U;
+    y ^= (y << 15U) & 0xefc60000U;
+    return y ^ (y >> 18U);
+  }
+  // Value in [0, bound), as QRandomGenerator::bounded: one draw scaled down, never rejected.
+  [[nodiscard]] auto bounded(const int bound) -> int {
+    return static_cast<int>((std::uint64_t{generate()} * static_cast<std::uint32_t>(bound)) >>
+                            32U);
+  }
+
+  // Skips `count` draws at one twist per StateWords of them.
+  void discard(std::uint64_t count) {
+    while (count > 0) {
+      if (m_index >= StateWords) {
+        twist();
+      }
+      const std::uint64_t step = std::min<std::uint64_t>(count, StateWords - m_index);
+      m_index += static_cast<std::size_t>(step);
+      count -= step;
+    }
+  }
+
+  [[nodiscard]] auto words() const -> const Words& {
+    return m_words;
+  }
+  // Draws taken from words() since its last twist.
+  [[nodiscard]] auto index() const -> std::size_t {
+    return m_index;
+  }
+  void restore(const Words& words, const std::size_t index) {
+    m_words = words;
+    m_index = std::min(index, StateWords);
+  }
+
+  friend auto operator==(const ReplayRng&, const ReplayRng&) -> bool = default;
+
+private:
+  static constexpr std::uint32_t UpperMask = 0x80000000U;
+
+  void twist() {
+    for (std::size_t i = 0; i < StateWords; ++i) {
+      const std::uint32_t y =
+        (m_words[i] & UpperMask) | (m_words[(i + 1) % StateWords] & ~UpperMask);
+      m_words[i] = m_words[(i + 397) % StateWords] ^ (y >> 1U) ^ ((y & 1U) != 0 ? 0x9908b0dfU : 0U);
+    }
+    m_index = 0;
+  }
+
+  Words m_words{};
+  std::size_t m_index = StateWords;
+};
+
+} // namespace nenoserpent::core
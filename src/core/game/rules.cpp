@@ -5,6 +5,39 @@
 
 namespace nenoserpent::core {
 
+namespace {
+auto outcomeForProbe(const CollisionProbe& probe,
+                     const bool portalActive,
+                     const bool laserActive,
+                     const bool shieldActive) -> CollisionOutcome {
+  CollisionOutcome outcome;
+  if (probe.hitsObstacle) {
+    if (portalActive) {
+      return outcome;
+    }
+    if (laserActive) {
+      outcome.consumeLaser = true;
+      outcome.obstacleIndex = probe.obstacleIndex;
+      return outcome;
+    }
+    if (shieldActive) {
+      outcome.consumeShield = true;
+      return outcome;
+    }
+    outcome.collision = true;
+    return outcome;
+  }
+  if (probe.hitsBody) {
+    if (shieldActive) {
+      outcome.consumeShield = true;
+      return outcome;
+    }
+    outcome.collision = true;
+  }
+  return outcome;
+}
+} // namespace
+
 auto roguelikeChoiceChancePercent(const RoguelikeChoiceContext& ctx) -> int {
   if (ctx.newScore < 8) {
     return 0;
@@ -42,20 +75,14 @@ auto tickIntervalForScore(const int score) -> int {
   return std::max(72, 230 - ((score / 8) * 5));
 }
 
-auto wrapAxis(int value, int size) -> int {
-  int wrapped = value % size;
-  if (wrapped < 0) {
-    wrapped += size;
-  }
-  return wrapped;
-}
-
-auto wrapPoint(const QPoint& point, int boardWidth, int boardHeight) -> QPoint {
-  return {wrapAxis(point.x(), boardWidth), wrapAxis(point.y(), boardHeight)};
+auto toroidalDistance(const QPoint& a, const QPoint& b, int boardWidth, int boardHeight) -> int {
+  const int dx = std::abs(a.x() - b.x());
+  const int dy = std::abs(a.y() - b.y());
+  return std::min(dx, boardWidth - dx) + std::min(dy, boardHeight - dy);
 }
 
 auto buildSafeInitialSnakeBody(const QList<QPoint>& obstacles, int boardWidth, int boardHeight)
-  -> std::deque<QPoint> {
+  -> SnakeBody {
   auto blocked = [&obstacles](const QPoint& point) -> bool {
     for (const QPoint& obstaclePoint : obstacles) {
       if (obstaclePoint == point) {
@@ -102,7 +129,7 @@ auto collectFreeSpots(int boardWidth,
 auto pickRandomFreeSpot(int boardWidth,
                         int boardHeight,
                         const std::function<bool(const QPoint&)>& isBlocked,
-                        const std::function<int(int)>& pickIndex,
+                        const RandomBounded pickIndex,
                         QPoint& pickedPoint) -> bool {
   const QList<QPoint> freeSpots = collectFreeSpots(boardWidth, boardHeight, isBlocked);
   if (freeSpots.isEmpty()) {
@@ -116,8 +143,8 @@ auto pickRandomFreeSpot(int boardWidth,
   return true;
 }
 
-auto magnetCandidateSpots(const QPoint& food, const QPoint& head, int boardWidth, int boardHeight)
-  -> QList<QPoint> {
+auto magnetCandidates(const QPoint& food, const QPoint& head, int boardWidth, int boardHeight)
+  -> MagnetCandidates {
   auto axisStepToward = [](int from, int to, int size) -> int {
     if (from == to) {
       return 0;
@@ -131,18 +158,20 @@ auto magnetCandidateSpots(const QPoint& food, const QPoint& head, int boardWidth
   const int stepY = axisStepToward(food.y(), head.y(), boardHeight);
   const bool preferX = std::abs(head.x() - food.x()) >= std::abs(head.y() - food.y());
 
-  QList<QPoint> candidates;
+  MagnetCandidates candidates;
   auto pushCandidate = [&](bool xAxis) -> void {
     if (xAxis) {
       if (stepX == 0) {
         return;
       }
-      candidates.append(QPoint(wrapAxis(food.x() + stepX, boardWidth), food.y()));
+      candidates.points[static_cast<std::size_t>(candidates.count++)] =
+        QPoint(wrapAxis(food.x() + stepX, boardWidth), food.y());
     } else {
       if (stepY == 0) {
         return;
       }
-      candidates.append(QPoint(food.x(), wrapAxis(food.y() + stepY, boardHeight)));
+      candidates.points[static_cast<std::size_t>(candidates.count++)] =
+        QPoint(food.x(), wrapAxis(food.y() + stepY, boardHeight));
     }
   };
 
@@ -156,9 +185,15 @@ auto magnetCandidateSpots(const QPoint& food, const QPoint& head, int boardWidth
   return candidates;
 }
 
+auto magnetCandidateSpots(const QPoint& food, const QPoint& head, int boardWidth, int boardHeight)
+  -> QList<QPoint> {
+  const MagnetCandidates candidates = magnetCandidates(food, head, boardWidth, boardHeight);
+  return QList<QPoint>(candidates.begin(), candidates.end());
+}
+
 auto probeCollision(const QPoint& wrappedHead,
                     const QList<QPoint>& obstacles,
-                    const std::deque<QPoint>& snakeBody,
+                    const SnakeBody& snakeBody,
                     bool ghostActive) -> CollisionProbe {
   CollisionProbe probe;
   for (int i = 0; i < obstacles.size(); ++i) {
@@ -180,42 +215,49 @@ auto probeCollision(const QPoint& wrappedHead,
   return probe;
 }
 
+auto probeCollision(const QPoint& wrappedHead,
+                    const QList<QPoint>& obstacles,
+                    const OccupancyGrid& occupancy,
+                    bool ghostActive) -> CollisionProbe {
+  CollisionProbe probe;
+  if (occupancy.hasObstacle(wrappedHead)) {
+    probe.hitsObstacle = true;
+    probe.obstacleIndex = static_cast<int>(obstacles.indexOf(wrappedHead));
+    return probe;
+  }
+  if (ghostActive) {
+    return probe;
+  }
+  probe.hitsBody = occupancy.hasBody(wrappedHead);
+  return probe;
+}
+
 auto collisionOutcomeForHead(const QPoint& head,
                              const int boardWidth,
                              const int boardHeight,
                              const QList<QPoint>& obstacles,
-                             const std::deque<QPoint>& snakeBody,
+                             const SnakeBody& snakeBody,
                              const bool ghostActive,
                              const bool portalActive,
                              const bool laserActive,
                              const bool shieldActive) -> CollisionOutcome {
   const QPoint wrappedHead = wrapPoint(head, boardWidth, boardHeight);
   const CollisionProbe probe = probeCollision(wrappedHead, obstacles, snakeBody, ghostActive);
-  CollisionOutcome outcome;
-  if (probe.hitsObstacle) {
-    if (portalActive) {
-      return outcome;
-    }
-    if (laserActive) {
-      outcome.consumeLaser = true;
-      outcome.obstacleIndex = probe.obstacleIndex;
-      return outcome;
-    }
-    if (shieldActive) {
-      outcome.consumeShield = true;
-      return outcome;
-    }
-    outcome.collision = true;
-    return outcome;
-  }
-  if (probe.hitsBody) {
-    if (shieldActive) {
-      outcome.consumeShield = true;
-      return outcome;
-    }
-    outcome.collision = true;
-  }
-  return outcome;
+  return outcomeForProbe(probe, portalActive, laserActive, shieldActive);
+}
+
+auto collisionOutcomeForHead(const QPoint& head,
+                             const int boardWidth,
+                             const int boardHeight,
+                             const QList<QPoint>& obstacles,
+                             const OccupancyGrid& occupancy,
+                             const bool ghostActive,
+                             const bool portalActive,
+                             const bool laserActive,
+                             const bool shieldActive) -> CollisionOutcome {
+  const QPoint wrappedHead = wrapPoint(head, boardWidth, boardHeight);
+  const CollisionProbe probe = probeCollision(wrappedHead, obstacles, occupancy, ghostActive);
+  return outcomeForProbe(probe, portalActive, laserActive, shieldActive);
 }
 
 } // namespace nenoserpent::core
@@ -1,11 +1,16 @@
 #pragma once
 
-#include <deque>
+#include <array>
 #include <functional>
 
 #include <QList>
 #include <QPoint>
 
+#include "core/game/board_geometry.h"
+#include "core/game/body.h"
+#include "core/game/occupancy.h"
+#include "core/game/random.h"
+
 namespace nenoserpent::core {
 
 struct RoguelikeChoiceContext {
@@ -20,6 +25,19 @@ struct CollisionProbe {
   bool hitsBody = false;
 };
 
+// Up to two cells one step from the food toward the head, preferred axis first.
+struct MagnetCandidates {
+  std::array<QPoint, 2> points;
+  int count = 0;
+
+  [[nodiscard]] auto begin() const -> const QPoint* {
+    return points.data();
+  }
+  [[nodiscard]] auto end() const -> const QPoint* {
+    return points.data() + count;
+  }
+};
+
 struct CollisionOutcome {
   bool collision = false;
   bool consumeShield = false;
@@ -31,29 +49,65 @@ struct CollisionOutcome {
 auto roguelikeChoiceChancePercent(const RoguelikeChoiceContext& ctx) -> int;
 auto tickIntervalForScore(int score) -> int;
 
-auto wrapAxis(int value, int size) -> int;
-auto wrapPoint(const QPoint& point, int boardWidth, int boardHeight) -> QPoint;
+auto toroidalDistance(const QPoint& a, const QPoint& b, int boardWidth, int boardHeight) -> int;
 auto buildSafeInitialSnakeBody(const QList<QPoint>& obstacles, int boardWidth, int boardHeight)
-  -> std::deque<QPoint>;
+  -> SnakeBody;
 auto collectFreeSpots(int boardWidth,
                       int boardHeight,
                       const std::function<bool(const QPoint&)>& isBlocked) -> QList<QPoint>;
 auto pickRandomFreeSpot(int boardWidth,
                         int boardHeight,
                         const std::function<bool(const QPoint&)>& isBlocked,
-                        const std::function<int(int)>& pickIndex,
+                        RandomBounded pickIndex,
                         QPoint& pickedPoint) -> bool;
+// Same contract as above without a board scan; Scan order reproduces the predicate variant's
+// pickIndex sequence exactly, so it is the one to use for anything that is recorded. Templated on
+// the source so that spawns drawing from a concrete generator call it directly.
+template <typename PickIndex>
+auto pickRandomFreeSpot(const OccupancyGrid& occupancy,
+                        const QPoint& reserved,
+                        const FreeCellOrder order,
+                        PickIndex&& pickIndex,
+                        QPoint& pickedPoint) -> bool {
+  const int freeCount = occupancy.freeCount(reserved);
+  if (freeCount <= 0) {
+    return false;
+  }
+  const int selected = pickIndex(freeCount);
+  if (selected < 0 || selected >= freeCount) {
+    return false;
+  }
+  pickedPoint = occupancy.freeCellAt(selected, order, reserved);
+  return true;
+}
+auto magnetCandidates(const QPoint& food, const QPoint& head, int boardWidth, int boardHeight)
+  -> MagnetCandidates;
 auto magnetCandidateSpots(const QPoint& food, const QPoint& head, int boardWidth, int boardHeight)
   -> QList<QPoint>;
 auto probeCollision(const QPoint& wrappedHead,
                     const QList<QPoint>& obstacles,
-                    const std::deque<QPoint>& snakeBody,
+                    const SnakeBody& snakeBody,
+                    bool ghostActive) -> CollisionProbe;
+auto collisionOutcomeForHead(const QPoint& head,
+                             int boardWidth,
+                             int boardHeight,
+                             const QList<QPoint>& obstacles,
+                             const SnakeBody& snakeBody,
+                             bool ghostActive,
+                             bool portalActive,
+                             bool laserActive,
+                             bool shieldActive) -> CollisionOutcome;
+// Grid-backed variants: body hits become a bit test and the obstacle list is only scanned to
+// resolve the index once the grid reports a wall under the head.
+auto probeCollision(const QPoint& wrappedHead,
+                    const QList<QPoint>& obstacles,
+                    const OccupancyGrid& occupancy,
                     bool ghostActive) -> CollisionProbe;
 auto collisionOutcomeForHead(const QPoint& head,
                              int boardWidth,
                              int boardHeight,
                              const QList<QPoint>& obstacles,
-                             const std::deque<QPoint>& snakeBody,
+                             const OccupancyGrid& occupancy,
                              bool ghostActive,
                              bool portalActive,
                              bool laserActive,
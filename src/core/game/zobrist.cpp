@@ -0,0 +1,44 @@
+#include "core/game/zobrist.h"
+
+namespace nenoserpent::core {
+
+namespace {
+auto mixHash(std::uint64_t seed, const std::uint64_t value) -> std::uint64_t {
+  constexpr std::uint64_t kPrime = 1099511628211ULL;
+  seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U);
+  seed *= kPrime;
+  return seed;
+}
+
+auto mixPoint(const std::uint64_t seed, const QPoint& point) -> std::uint64_t {
+  return mixHash(mixHash(seed, static_cast<std::uint64_t>(point.x() + 1024)),
+                 static_cast<std::uint64_t>(point.y() + 1024));
+}
+} // namespace
+
+auto zobristBodyHash(const SnakeBody& body) -> std::uint64_t {
+  std::uint64_t hash = 0;
+  for (const QPoint& segment : body) {
+    hash ^= zobristCellKey(segment);
+  }
+  return hash;
+}
+
+auto loopStateHash(const LoopStateKey& key) -> std::uint64_t {
+  std::uint64_t hash = 1469598103934665603ULL;
+  hash = mixHash(hash, static_cast<std::uint64_t>(key.boardWidth));
+  hash = mixHash(hash, static_cast<std::uint64_t>(key.boardHeight));
+  hash = mixPoint(hash, key.head);
+  hash = mixHash(hash, static_cast<std::uint64_t>(key.direction.x() + 16));
+  hash = mixHash(hash, static_cast<std::uint64_t>(key.direction.y() + 16));
+  hash = mixPoint(hash, key.food);
+  hash = mixPoint(hash, key.powerUpPos);
+  hash = mixHash(hash, static_cast<std::uint64_t>(key.powerUpType + 32));
+  hash = mixHash(hash, static_cast<std::uint64_t>(key.bodyLength));
+  if (key.bodyLength > 0) {
+    hash = mixPoint(hash, key.tail);
+  }
+  return mixHash(hash, key.bodyHash);
+}
+
+} // namespace nenoserpent::core
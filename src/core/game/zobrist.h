@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <QPoint>
+
+#include "core/game/body.h"
+
+namespace nenoserpent::core {
+
+// Per-cell key for Zobrist-style body signatures. Keys are derived from the coordinates alone
+// (splitmix64), so they need no table and stay valid for any board size.
+[[nodiscard]] inline auto zobristCellKey(const QPoint& cell) -> std::uint64_t {
+  std::uint64_t z = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cell.x())) << 32U) |
+                    static_cast<std::uint32_t>(cell.y());
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31U);
+}
+
+// XOR of the cell keys of every segment. A head push or tail pop is a single
+// `hash ^= zobristCellKey(cell)`, so callers keep it up to date instead of rehashing.
+[[nodiscard]] auto zobristBodyHash(const SnakeBody& body) -> std::uint64_t;
+
+// Everything the loop / stall detectors compare besides the body cells. The body contributes
+// through its Zobrist hash plus length and tail, which keeps the combined hash O(1).
+struct LoopStateKey {
+  std::uint64_t bodyHash = 0;
+  std::size_t bodyLength = 0;
+  QPoint head{0, 0};
+  QPoint tail{0, 0};
+  QPoint direction{0, 0};
+  QPoint food{0, 0};
+  QPoint powerUpPos{-1, -1};
+  int powerUpType = 0;
+  int boardWidth = 0;
+  int boardHeight = 0;
+};
+
+[[nodiscard]] auto loopStateHash(const LoopStateKey& key) -> std::uint64_t;
+
+} // namespace nenoserpent::core
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <span>
+
+#include <QPoint>
+#include <QStringView>
+
+namespace nenoserpent::core {
+
+// Compile-time form of the built-in levels. The tables are generated from src/levels/levels.json
+// at build time (cmake/catalogs.cmake) and read through builtInLevels().
+struct CatalogWallGroup {
+  std::span<const QPoint> walls;
+  QPoint step;
+};
+
+struct CatalogLevel {
+  QStringView name;
+  QStringView script;
+  int periodTicks = 0;
+  std::span<const QPoint> walls;
+  // An empty phase list means the level has no animation.
+  int phaseTicks = 1;
+  std::span<const int> phases;
+  std::span<const CatalogWallGroup> groups;
+};
+
+} // namespace nenoserpent::core
@@ -4,30 +4,50 @@
 
 #include <QByteArray>
 #include <QJsonArray>
+#include <QJsonObject>
 #include <QList>
 #include <QPoint>
 #include <QString>
 #include <QStringView>
 
+#include "core/level/schedule.h"
+
 namespace nenoserpent::core {
 
 struct FallbackLevelData {
   QString name;
   QString script;
   QList<QPoint> walls;
+  // Declared period of a pure, periodic script; 0 leaves it to be detected at load.
+  int scriptPeriodTicks = 0;
+  // Declarative wall animation; when set it replaces `walls` and needs no script.
+  std::optional<ObstacleAnimation> animation;
 };
 
 using ResolvedLevelData = FallbackLevelData;
+// Every level of a levels document, in file order.
+using ResolvedLevelTable = QList<ResolvedLevelData>;
 
 auto dynamicObstaclesForLevel(QStringView levelName, int gameTickCounter)
   -> std::optional<QList<QPoint>>;
 auto normalizedFallbackLevelIndex(int levelIndex) -> int;
+// The levels compiled in from src/levels/levels.json, built once on first use.
+auto builtInLevels() -> const ResolvedLevelTable&;
 auto fallbackLevelData(int levelIndex) -> FallbackLevelData;
 auto wallsFromJsonArray(const QJsonArray& wallsJson) -> QList<QPoint>;
+auto obstacleAnimationFromJson(const QJsonObject& animationJson)
+  -> std::optional<ObstacleAnimation>;
+// Empty when there are no levels, or when the level declares an animation that does not parse:
+// its walls live in the animation, so loading it without one would leave the board bare.
 auto resolvedLevelDataFromJson(const QJsonArray& levelsJson, int levelIndex)
   -> std::optional<ResolvedLevelData>;
 auto resolvedLevelDataFromJsonBytes(const QByteArray& levelsJsonBytes, int levelIndex)
   -> std::optional<ResolvedLevelData>;
+// Empty when the document is invalid or has no levels. A level rejected by
+// resolvedLevelDataFromJson is replaced by the built-in level at its index, which is appended to
+// `replacedLevels` when given.
+auto resolvedLevelTableFromJsonBytes(const QByteArray& levelsJsonBytes,
+                                     QList<int>* replacedLevels = nullptr) -> ResolvedLevelTable;
 auto levelCountFromJsonBytes(const QByteArray& levelsJsonBytes, int fallbackCount) -> int;
 
 } // namespace nenoserpent::core
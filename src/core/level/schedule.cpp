@@ -0,0 +1,104 @@
+#include "core/level/schedule.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace nenoserpent::core {
+
+auto ObstacleAnimation::periodTicks() const -> int {
+  return std::max(1, phaseTicks) * static_cast<int>(phases.size());
+}
+
+auto ObstacleAnimation::obstaclesAtPhase(const int phase) const -> QList<QPoint> {
+  QList<QPoint> obstacles;
+  for (const ObstacleGroup& group : groups) {
+    const QPoint offset = group.step * phase;
+    for (const QPoint& wall : group.walls) {
+      obstacles.append(wall + offset);
+    }
+  }
+  return obstacles;
+}
+
+auto ObstacleAnimation::obstaclesAt(const int tick) const -> QList<QPoint> {
+  if (phases.isEmpty()) {
+    return obstaclesAtPhase(0);
+  }
+  const auto count = static_cast<int>(phases.size());
+  const int step = tick / std::max(1, phaseTicks);
+  return obstaclesAtPhase(phases.at(((step % count) + count) % count));
+}
+
+auto ObstacleSchedule::fromFrames(const QList<QList<QPoint>>& frames)
+  -> std::optional<ObstacleSchedule> {
+  if (frames.isEmpty() || frames.size() > MaxPeriodTicks) {
+    return std::nullopt;
+  }
+  ObstacleSchedule schedule;
+  schedule.m_phaseAtTick.reserve(frames.size());
+  for (const QList<QPoint>& frame : frames) {
+    // Phases are few (a handful per script), so a linear search beats hashing point lists.
+    qsizetype phase = schedule.m_phases.indexOf(frame);
+    if (phase < 0) {
+      phase = schedule.m_phases.size();
+      schedule.m_phases.append(frame);
+    }
+    schedule.m_phaseAtTick.append(static_cast<int>(phase));
+  }
+  return schedule;
+}
+
+auto ObstacleSchedule::fromAnimation(const ObstacleAnimation& animation)
+  -> std::optional<ObstacleSchedule> {
+  if (animation.phases.isEmpty() || animation.periodTicks() > MaxAnimationPeriodTicks) {
+    return std::nullopt;
+  }
+  ObstacleSchedule schedule;
+  schedule.m_phaseAtTick.reserve(animation.periodTicks());
+  const int phaseTicks = std::max(1, animation.phaseTicks);
+  for (const int value : animation.phases) {
+    QList<QPoint> layout = animation.obstaclesAtPhase(value);
+    qsizetype phase = schedule.m_phases.indexOf(layout);
+    if (phase < 0) {
+      phase = schedule.m_phases.size();
+      schedule.m_phases.append(std::move(layout));
+    }
+    for (int tick = 0; tick < phaseTicks; ++tick) {
+      schedule.m_phaseAtTick.append(static_cast<int>(phase));
+    }
+  }
+  return schedule;
+}
+
+auto ObstacleSchedule::detectPeriod(const QList<QList<QPoint>>& samples) -> int {
+  const auto count = static_cast<int>(samples.size());
+  for (int period = 1; period * 2 <= count && period <= MaxPeriodTicks; ++period) {
+    bool repeats = true;
+    for (int tick = period; tick < count && repeats; ++tick) {
+      repeats = samples.at(tick) == samples.at(tick - period);
+    }
+    if (repeats) {
+      return period;
+    }
+  }
+  return 0;
+}
+
+auto ObstacleSchedule::obstaclesAt(const int tick) const -> const QList<QPoint>& {
+  const int period = periodTicks();
+  const int index = ((tick % period) + period) % period;
+  return m_phases.at(m_phaseAtTick.at(index));
+}
+
+auto ObstacleSchedule::clippedTo(const int boardWidth, const int boardHeight) const
+  -> ObstacleSchedule {
+  ObstacleSchedule clipped = *this;
+  for (QList<QPoint>& layout : clipped.m_phases) {
+    layout.removeIf([boardWidth, boardHeight](const QPoint& wall) {
+      return wall.x() >= boardWidth || wall.y() >= boardHeight;
+    });
+  }
+  return clipped;
+}
+
+} // namespace nenoserpent::core
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <optional>
+
+#include <QList>
+#include <QPoint>
+
+namespace nenoserpent::core {
+
+// Walls that move together: at phase value p each wall sits at wall + p * step.
+struct ObstacleGroup {
+  QList<QPoint> walls;
+  QPoint step;
+};
+
+// A level's declarative wall animation. Every `phaseTicks` the phase value advances to the next
+// entry of `phases`, wrapping around; the layout is the groups, in order, at that value.
+struct ObstacleAnimation {
+  int phaseTicks = 1;
+  QList<int> phases;
+  QList<ObstacleGroup> groups;
+
+  [[nodiscard]] auto periodTicks() const -> int;
+  [[nodiscard]] auto obstaclesAtPhase(int phase) const -> QList<QPoint>;
+  [[nodiscard]] auto obstaclesAt(int tick) const -> QList<QPoint>;
+};
+
+// Every obstacle layout of one period of a dynamic level, from an ObstacleAnimation or from a
+// pure, periodic level script sampled once at load. Ticks that land on the same layout share
+// one list, so a lookup hands out the same buffer until the phase turns and callers can tell
+// "unchanged" with isSharedWith().
+class ObstacleSchedule {
+public:
+  // Longest period detectPeriod() looks for; declared script periods may not exceed it either.
+  static constexpr int MaxPeriodTicks = 512;
+  // Longest animation cycle fromAnimation() lays out.
+  static constexpr int MaxAnimationPeriodTicks = 1 << 16;
+
+  // `frames[t]` is the layout at tick t of one period. Empty or overlong input yields nullopt.
+  [[nodiscard]] static auto fromFrames(const QList<QList<QPoint>>& frames)
+    -> std::optional<ObstacleSchedule>;
+  // Every layout of `animation`, laid out once per tick of its period.
+  [[nodiscard]] static auto fromAnimation(const ObstacleAnimation& animation)
+    -> std::optional<ObstacleSchedule>;
+  // Smallest period that `samples` (layouts for ticks 0, 1, ...) repeat with across the whole
+  // window, seen at least twice. Returns 0 when there is none.
+  [[nodiscard]] static auto detectPeriod(const QList<QList<QPoint>>& samples) -> int;
+
+  [[nodiscard]] auto periodTicks() const -> int {
+    return static_cast<int>(m_phaseAtTick.size());
+  }
+  [[nodiscard]] auto phaseCount() const -> int {
+    return static_cast<int>(m_phases.size());
+  }
+  [[nodiscard]] auto obstaclesAt(int tick) const -> const QList<QPoint>&;
+  // The same schedule without the walls past the right or bottom edge of a smaller board.
+  [[nodiscard]] auto clippedTo(int boardWidth, int boardHeight) const -> ObstacleSchedule;
+
+private:
+  QList<QList<QPoint>> m_phases;
+  QList<int> m_phaseAtTick;
+};
+
+} // namespace nenoserpent::core
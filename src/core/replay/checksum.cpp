@@ -0,0 +1,55 @@
+#include "core/replay/checksum.h"
+
+#include "core/game/zobrist.h"
+
+namespace nenoserpent::core {
+
+namespace {
+auto mixChecksum(std::uint64_t seed, const std::uint64_t value) -> std::uint64_t {
+  constexpr std::uint64_t kPrime = 1099511628211ULL;
+  seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6U) + (seed >> 2U);
+  seed *= kPrime;
+  return seed;
+}
+
+auto mixChecksum(const std::uint64_t seed, const QPoint& point) -> std::uint64_t {
+  return mixChecksum(mixChecksum(seed, static_cast<std::uint64_t>(point.x() + 1024)),
+                     static_cast<std::uint64_t>(point.y() + 1024));
+}
+
+auto mixChecksum(const std::uint64_t seed, const int value) -> std::uint64_t {
+  return mixChecksum(seed, static_cast<std::uint64_t>(static_cast<std::uint32_t>(value)));
+}
+} // namespace
+
+auto sessionStateChecksum(const SessionCore& core) -> std::uint64_t {
+  const SessionState& state = core.state();
+  std::uint64_t hash = 1469598103934665603ULL;
+  hash = mixChecksum(hash, state.tickCounter);
+  hash = mixChecksum(hash, state.score);
+  hash = mixChecksum(hash, state.direction);
+  hash = mixChecksum(hash, state.food);
+  hash = mixChecksum(hash, state.powerUpPos);
+  hash = mixChecksum(hash, state.powerUpType);
+  hash = mixChecksum(hash, state.powerUpTicksRemaining);
+  hash = mixChecksum(hash, state.activeBuff);
+  hash = mixChecksum(hash, state.buffTicksRemaining);
+  hash = mixChecksum(hash, state.shieldActive ? 1 : 0);
+  hash = mixChecksum(hash, static_cast<int>(state.obstacles.size()));
+  // Scripted walls move and lasers burn them away, so where they stand is state too.
+  std::uint64_t obstacleHash = 0;
+  for (const QPoint& obstacle : state.obstacles) {
+    obstacleHash ^= zobristCellKey(obstacle);
+  }
+  hash = mixChecksum(hash, obstacleHash);
+  hash = mixChecksum(hash, static_cast<int>(core.body().size()));
+  hash = mixChecksum(hash, core.headPosition());
+  return mixChecksum(hash, core.bodyHash());
+}
+
+auto rollReplayChecksum(const std::uint64_t rolling, const std::uint64_t stateChecksum)
+  -> std::uint64_t {
+  return mixChecksum(rolling, stateChecksum);
+}
+
+} // namespace nenoserpent::core
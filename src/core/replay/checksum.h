@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+#include "core/session/core.h"
+
+namespace nenoserpent::core {
+
+// Ticks between checksum samples in recorded ghosts.
+inline constexpr int ReplayChecksumIntervalTicks = 8;
+
+// Digest of everything a replay must reproduce: body and wall cells (through Zobrist keys),
+// direction, pickups, buff and score. Costs one pass over the walls; the body hash is kept up to
+// date by the core. The scout hint is left out; it is a derived UI cue.
+[[nodiscard]] auto sessionStateChecksum(const SessionCore& core) -> std::uint64_t;
+
+// Folds one sample into the running checksum, so a divergence stays visible in every later
+// sample even if the states happen to line up again.
+[[nodiscard]] auto rollReplayChecksum(std::uint64_t rolling, std::uint64_t stateChecksum)
+  -> std::uint64_t;
+
+} // namespace nenoserpent::core
@@ -0,0 +1,119 @@
+#include "core/replay/keyframe.h"
+
+#include <algorithm>
+
+namespace nenoserpent::core {
+
+namespace {
+void writeState(QDataStream& out, const SessionState& state) {
+  out << state.food << state.powerUpPos << state.powerUpType << state.powerUpTicksRemaining
+      << state.activeBuff << state.buffTicksRemaining << state.buffTicksTotal
+      << state.shieldActive << state.scoutHintCell << state.direction << state.score
+      << state.obstacles << state.tickCounter << state.lastRoguelikeChoiceScore
+      << state.speedDownSteps << state.anchorTickIntervalMs;
+}
+
+void readState(QDataStream& in, SessionState& state) {
+  in >> state.food >> state.powerUpPos >> state.powerUpType >> state.powerUpTicksRemaining >>
+    state.activeBuff >> state.buffTicksRemaining >> state.buffTicksTotal >> state.shieldActive >>
+    state.scoutHintCell >> state.direction >> state.score >> state.obstacles >>
+    state.tickCounter >> state.lastRoguelikeChoiceScore >> state.speedDownSteps >>
+    state.anchorTickIntervalMs;
+}
+
+void writeBody(QDataStream& out, const SnakeBody& body) {
+  out << static_cast<quint32>(body.size());
+  for (const QPoint& segment : body) {
+    out << segment;
+  }
+}
+
+void readBody(QDataStream& in, SnakeBody& body) {
+  quint32 size = 0;
+  in >> size;
+  body.clear();
+  for (quint32 i = 0; i < size && in.status() == QDataStream::Ok; ++i) {
+    QPoint segment;
+    in >> segment;
+    body.push_back(segment);
+  }
+}
+} // namespace
+
+auto keyframeIndexAtOrBefore(const QList<ReplayKeyframe>& keyframes, const int tick)
+  -> qsizetype {
+  const auto after =
+    std::ranges::upper_bound(keyframes, tick, {}, [](const ReplayKeyframe& keyframe) {
+      return keyframe.frame;
+    });
+  return std::distance(keyframes.begin(), after) - 1;
+}
+
+auto operator<<(QDataStream& out, const SessionKeyframe& session) -> QDataStream& {
+  writeState(out, session.snapshot.state);
+  writeBody(out, session.snapshot.body);
+  out << session.stallNoScoreTicks << session.stallLastScore
+      << static_cast<quint32>(session.stallHashes.size());
+  for (const std::uint64_t hash : session.stallHashes) {
+    out << static_cast<quint64>(hash);
+  }
+  out << static_cast<quint64>(session.lastObstacleSignature) << session.hasLastObstacleSignature
+      << session.dynamicObstacleConfidenceTicks << session.prevObstacleSnapshot
+      << session.currObstacleSnapshot << session.hasObstacleSnapshots
+      << session.recentSpawnPoints;
+  return out;
+}
+
+auto operator>>(QDataStream& in, SessionKeyframe& session) -> QDataStream& {
+  readState(in, session.snapshot.state);
+  readBody(in, session.snapshot.body);
+  quint32 hashCount = 0;
+  in >> session.stallNoScoreTicks >> session.stallLastScore >> hashCount;
+  session.stallHashes.clear();
+  for (quint32 i = 0; i < hashCount && in.status() == QDataStream::Ok; ++i) {
+    quint64 hash = 0;
+    in >> hash;
+    session.stallHashes.push_back(hash);
+  }
+  quint64 signature = 0;
+  in >> signature >> session.hasLastObstacleSignature >> session.dynamicObstacleConfidenceTicks >>
+    session.prevObstacleSnapshot >> session.currObstacleSnapshot >>
+    session.hasObstacleSnapshots >> session.recentSpawnPoints;
+  session.lastObstacleSignature = signature;
+  return in;
+}
+
+auto operator<<(QDataStream& out, const ReplayKeyframe& keyframe) -> QDataStream& {
+  return out << keyframe.frame << keyframe.rngDraws << keyframe.checksum
+             << keyframe.recordedFrames << keyframe.session;
+}
+
+auto operator>>(QDataStream& in, ReplayKeyframe& keyframe) -> QDataStream& {
+  return in >> keyframe.frame >> keyframe.rngDraws >> keyframe.checksum >>
+         keyframe.recordedFrames >> keyframe.session;
+}
+
+auto operator<<(QDataStream& out, const ReplayRng& rng) -> QDataStream& {
+  out << static_cast<quint32>(rng.index());
+  for (const std::uint32_t word : rng.words()) {
+    out << static_cast<quint32>(word);
+  }
+  return out;
+}
+
+auto operator>>(QDataStream& in, ReplayRng& rng) -> QDataStream& {
+  quint32 index = 0;
+  in >> index;
+  ReplayRng::Words words{};
+  for (std::uint32_t& word : words) {
+    quint32 value = 0;
+    in >> value;
+    word = value;
+  }
+  if (in.status() == QDataStream::Ok) {
+    rng.restore(words, index);
+  }
+  return in;
+}
+
+} // namespace nenoserpent::core
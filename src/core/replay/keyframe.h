@@ -0,0 +1,44 @@
+#pragma once
+
+#include <optional>
+
+#include <QDataStream>
+#include <QList>
+
+#include "core/game/random.h"
+#include "core/session/snapshot.h"
+
+namespace nenoserpent::core {
+
+// Ticks between the keyframes a live run records into its ghost.
+inline constexpr int ReplayKeyframeIntervalTicks = 256;
+
+// Everything SessionRunner needs to resume a replay at `frame` without simulating the ticks
+// before it.
+struct ReplayKeyframe {
+  int frame = 0;
+  quint64 rngDraws = 0;
+  // Rolling state checksum as of `frame`, so checking continues past the keyframe.
+  quint64 checksum = 0;
+  // Head positions recorded before `frame`.
+  int recordedFrames = 0;
+  SessionKeyframe session;
+  // Generator state at `frame`. Keyframes from files that predate it restore the generator by
+  // reseeding and skipping `rngDraws` outputs instead.
+  std::optional<ReplayRng> rng;
+};
+
+// Index of the last keyframe at or before `tick`, or -1.
+[[nodiscard]] auto keyframeIndexAtOrBefore(const QList<ReplayKeyframe>& keyframes, int tick)
+  -> qsizetype;
+
+// A SessionKeyframe alone is also what a saved session holds.
+auto operator<<(QDataStream& out, const SessionKeyframe& session) -> QDataStream&;
+auto operator>>(QDataStream& in, SessionKeyframe& session) -> QDataStream&;
+// Without the generator state, which files keep beside the keyframes.
+auto operator<<(QDataStream& out, const ReplayKeyframe& keyframe) -> QDataStream&;
+auto operator>>(QDataStream& in, ReplayKeyframe& keyframe) -> QDataStream&;
+auto operator<<(QDataStream& out, const ReplayRng& rng) -> QDataStream&;
+auto operator>>(QDataStream& in, ReplayRng& rng) -> QDataStream&;
+
+} // namespace nenoserpent::core
@@ -0,0 +1,251 @@
+#include "core/replay/rewind.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/game/zobrist.h"
+
+namespace nenoserpent::core {
+
+void RewindBuffer::configure(const std::size_t budgetBytes, const int keyframeIntervalTicks) {
+  m_budgetBytes = budgetBytes;
+  m_keyframeIntervalTicks = std::max(1, keyframeIntervalTicks);
+  clear();
+}
+
+void RewindBuffer::clear() {
+  m_segments.clear();
+  m_bytes = 0;
+  m_depth = 0;
+  m_pending = {};
+  m_hasPending = false;
+}
+
+void RewindBuffer::beginTick(const SessionCore& core,
+                             const RewindMarks& marks,
+                             const ReplayRng& rng) {
+  if (!enabled()) {
+    return;
+  }
+  // Half the budget per segment, so evicting the oldest always leaves room for the newest.
+  if (m_segments.empty() ||
+      std::cmp_greater_equal(m_segments.back().deltas.size(), m_keyframeIntervalTicks) ||
+      m_segments.back().bytes >= m_budgetBytes / 2) {
+    openSegment(core, marks, rng);
+  }
+  m_pending = {.before = core.state(), .bookkeeping = core.bookkeeping(), .marks = marks};
+  const SnakeBody& body = core.body();
+  m_headBefore = body.empty() ? QPoint() : body.front();
+  m_tailBefore = body.empty() ? QPoint() : body.back();
+  m_sizeBefore = body.size();
+  m_hashBefore = core.bodyHash();
+  m_spawnsBefore = core.rememberedSpawnCount();
+  m_hasPending = true;
+}
+
+void RewindBuffer::endTick(const SessionCore& core) {
+  if (!m_hasPending) {
+    return;
+  }
+  m_hasPending = false;
+  RewindDelta delta = std::move(m_pending);
+  m_pending = {};
+
+  // The body hash is kept per move, so one compare tells a plain step from a wholesale rewrite
+  // (a mini shrink) that no delta can undo.
+  const SnakeBody& body = core.body();
+  const QPoint head = body.empty() ? QPoint() : body.front();
+  const std::uint64_t hash = core.bodyHash();
+  const std::uint64_t pushed = m_hashBefore ^ zobristCellKey(head);
+  if (head != m_headBefore && body.size() == m_sizeBefore + 1 && hash == pushed) {
+    delta.moved = true;
+    delta.grew = true;
+  } else if (head != m_headBefore && body.size() == m_sizeBefore &&
+             hash == (pushed ^ zobristCellKey(m_tailBefore))) {
+    delta.moved = true;
+    delta.poppedTail = m_tailBefore;
+  } else if (head != m_headBefore || body.size() != m_sizeBefore || hash != m_hashBefore) {
+    clear();
+    return;
+  }
+
+  // A tick observes at most one stall hash, or clears the window; the no-score count follows
+  // the window, so it tells which.
+  const int stallTicks = core.bookkeeping().stallNoScoreTicks;
+  const int stallTicksBefore = delta.bookkeeping.stallNoScoreTicks;
+  const HashWindow& stallHashes = core.stallHashes();
+  if (stallTicks == 0) {
+    delta.stallCleared = true;
+  } else if (stallTicks == stallTicksBefore + 1) {
+    delta.stallObserved = true;
+    delta.stallHash = stallHashes.at(stallHashes.size() - 1);
+  } else if (stallTicks != stallTicksBefore) {
+    clear();
+    return;
+  }
+  const std::uint64_t spawned = core.rememberedSpawnCount() - m_spawnsBefore;
+  if (spawned > RewindDelta::MaxSpawns) {
+    clear();
+    return;
+  }
+  const RecentSpawnPoints& recentSpawns = core.recentSpawnPoints();
+  delta.spawnCount = static_cast<std::size_t>(spawned);
+  for (std::size_t i = 0; i < delta.spawnCount; ++i) {
+    delta.spawns.at(i) = recentSpawns[recentSpawns.size() - delta.spawnCount + i];
+  }
+
+  const QList<QPoint>& obstacles = core.state().obstacles;
+  if (obstacles.isSharedWith(delta.before.obstacles) || obstacles == delta.before.obstacles) {
+    delta.before.obstacles = {};
+  } else {
+    delta.obstaclesChanged = true;
+  }
+
+  Segment& segment = m_segments.back();
+  const std::size_t added = deltaBytes(delta);
+  segment.deltas.push_back(std::move(delta));
+  segment.bytes += added;
+  m_bytes += added;
+  ++m_depth;
+  enforceBudget();
+}
+
+void RewindBuffer::keepLastTickBody(const SessionCore& core) {
+  if (m_segments.empty() || m_segments.back().deltas.empty()) {
+    return;
+  }
+  Segment& segment = m_segments.back();
+  RewindDelta& delta = segment.deltas.back();
+  if (delta.body.has_value()) {
+    return;
+  }
+  SnakeBody body = core.body();
+  if (delta.moved) {
+    body.pop_front();
+    if (!delta.grew) {
+      body.push_back(delta.poppedTail);
+    }
+  }
+  const std::size_t before = deltaBytes(delta);
+  delta.body = std::move(body);
+  const std::size_t added = deltaBytes(delta) - before;
+  segment.bytes += added;
+  m_bytes += added;
+  enforceBudget();
+}
+
+auto RewindBuffer::stepBack(SessionCore& core) -> std::optional<RewindMarks> {
+  while (!m_segments.empty() && m_segments.back().deltas.empty()) {
+    popBack();
+  }
+  if (m_segments.empty()) {
+    return std::nullopt;
+  }
+  Segment& segment = m_segments.back();
+  RewindDelta delta = std::move(segment.deltas.back());
+  segment.deltas.pop_back();
+  const std::size_t removed = deltaBytes(delta);
+  segment.bytes -= removed;
+  m_bytes -= removed;
+  --m_depth;
+
+  if (delta.body.has_value()) {
+    core.setBody(*delta.body);
+  } else if (delta.moved) {
+    core.retractMovement(delta.poppedTail, delta.grew);
+  }
+  core.restoreBookkeeping(delta.bookkeeping);
+  SessionState& state = core.state();
+  if (!delta.obstaclesChanged) {
+    // Same buffer as before, so the occupancy mirror stays valid.
+    delta.before.obstacles = state.obstacles;
+  }
+  state = std::move(delta.before);
+  core.clearQueuedInput();
+  return delta.marks;
+}
+
+void RewindBuffer::settle(SessionCore& core, ReplayRng& rng, const quint64 rngDraws) {
+  if (m_segments.empty()) {
+    return;
+  }
+  const Segment& segment = m_segments.back();
+  // The board and bookkeeping are already the current tick's; only the windows come from the
+  // keyframe, carried forward through the deltas recorded since.
+  SessionKeyframe current = core.captureKeyframe();
+  current.stallHashes = segment.keyframe.stallHashes;
+  current.recentSpawnPoints = segment.keyframe.recentSpawnPoints;
+  for (const RewindDelta& delta : segment.deltas) {
+    if (delta.stallCleared) {
+      current.stallHashes.clear();
+    } else if (delta.stallObserved) {
+      current.stallHashes.push_back(delta.stallHash);
+    }
+    for (std::size_t i = 0; i < delta.spawnCount; ++i) {
+      current.recentSpawnPoints.push_back(delta.spawns.at(i));
+    }
+  }
+  // Restoring feeds both through their windows, which drop the oldest entries again. Turns
+  // queued since the step back belong to the next tick, so they survive it.
+  const DirectionQueue queued = core.inputQueue();
+  core.restoreKeyframe(current);
+  core.inputQueue() = queued;
+
+  rng = segment.rng;
+  rng.discard(rngDraws - segment.marks.rngDraws);
+}
+
+auto RewindBuffer::keyframeBytes(const SessionKeyframe& keyframe) -> std::size_t {
+  const auto& snapshot = keyframe.snapshot;
+  const auto points = static_cast<std::size_t>(
+    snapshot.state.obstacles.size() + keyframe.prevObstacleSnapshot.size() +
+    keyframe.currObstacleSnapshot.size() + keyframe.recentSpawnPoints.size());
+  // SnakeBody packs a cell into two int16s.
+  return (snapshot.body.capacity() * 2 * sizeof(std::int16_t)) +
+         (keyframe.stallHashes.capacity() * sizeof(std::uint64_t)) + (points * sizeof(QPoint));
+}
+
+auto RewindBuffer::deltaBytes(const RewindDelta& delta) -> std::size_t {
+  const std::size_t obstacles =
+    delta.obstaclesChanged
+      ? static_cast<std::size_t>(delta.before.obstacles.size()) * sizeof(QPoint)
+      : 0;
+  const std::size_t body =
+    delta.body.has_value() ? delta.body->capacity() * 2 * sizeof(std::int16_t) : 0;
+  return obstacles + body;
+}
+
+void RewindBuffer::openSegment(const SessionCore& core,
+                               const RewindMarks& marks,
+                               const ReplayRng& rng) {
+  Segment segment{.keyframe = core.captureKeyframe(), .rng = rng, .marks = marks};
+  segment.deltas.reserve(static_cast<std::size_t>(m_keyframeIntervalTicks));
+  segment.bytes = sizeof(Segment) + keyframeBytes(segment.keyframe) +
+                  (segment.deltas.capacity() * sizeof(RewindDelta));
+  m_bytes += segment.bytes;
+  m_segments.push_back(std::move(segment));
+}
+
+void RewindBuffer::popFront() {
+  m_bytes -= m_segments.front().bytes;
+  m_depth -= static_cast<int>(m_segments.front().deltas.size());
+  m_segments.pop_front();
+}
+
+void RewindBuffer::popBack() {
+  m_bytes -= m_segments.back().bytes;
+  m_depth -= static_cast<int>(m_segments.back().deltas.size());
+  m_segments.pop_back();
+}
+
+void RewindBuffer::enforceBudget() {
+  while (m_bytes > m_budgetBytes && m_segments.size() > 1) {
+    popFront();
+  }
+  // A budget that cannot hold even one keyframe keeps nothing.
+  if (m_bytes > m_budgetBytes) {
+    clear();
+  }
+}
+
+} // namespace nenoserpent::core
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include <QList>
+#include <QPoint>
+
+#include "core/game/random.h"
+#include "core/session/core.h"
+
+namespace nenoserpent::core {
+
+// Where the owner's logs and RNG stood before a tick, so a rewind can cut them back to match.
+struct RewindMarks {
+  quint64 rngDraws = 0;
+  quint64 rollingChecksum = 0;
+  int recordedFrames = 0;
+  int inputFrames = 0;
+  int choiceFrames = 0;
+  int checksumFrames = 0;
+};
+
+// One tick as what it changed: the head it pushed, the tail it popped, and the state fields and
+// bookkeeping it overwrote. Obstacles are kept only when the tick replaced them, and the whole
+// body only when a choice picked after the tick rewrote it.
+struct RewindDelta {
+  static constexpr std::size_t MaxSpawns = 4;
+
+  SessionState before;
+  SessionBookkeeping bookkeeping;
+  bool obstaclesChanged = false;
+  bool moved = false;
+  bool grew = false;
+  QPoint poppedTail;
+  std::optional<SnakeBody> body;
+  // What the tick added to the stall window and the recent spawns; settle() replays these.
+  bool stallCleared = false;
+  bool stallObserved = false;
+  std::uint64_t stallHash = 0;
+  std::array<QPoint, MaxSpawns> spawns{};
+  std::size_t spawnCount = 0;
+  RewindMarks marks;
+};
+
+// Memory-capped history of live ticks for stepping a session backwards. Every keyframe interval
+// the full SessionKeyframe and generator are kept; the ticks in between are RewindDeltas, so
+// recording costs a few fixed-size writes per tick and stepBack() costs the same to undo one.
+//
+// stepBack() restores the board and bookkeeping exactly but not the stall and spawn windows or
+// the generator, which are too large to copy every tick. Before play resumes the owner calls
+// settle(), which rebuilds those from the keyframe and the deltas up to the current tick, so the
+// rewound run carries on exactly as it first did from there and stays replayable.
+class RewindBuffer {
+public:
+  static constexpr int DefaultKeyframeIntervalTicks = 32;
+
+  // A zero budget turns recording off. The oldest keyframe and its deltas are dropped whenever
+  // the total would pass `budgetBytes`.
+  void configure(std::size_t budgetBytes,
+                 int keyframeIntervalTicks = DefaultKeyframeIntervalTicks);
+  void clear();
+
+  [[nodiscard]] auto enabled() const -> bool {
+    return m_budgetBytes > 0;
+  }
+  [[nodiscard]] auto budgetBytes() const -> std::size_t {
+    return m_budgetBytes;
+  }
+  [[nodiscard]] auto bytes() const -> std::size_t {
+    return m_bytes;
+  }
+  // Ticks stepBack() can still undo.
+  [[nodiscard]] auto depth() const -> int {
+    return m_depth;
+  }
+
+  // Bracket one tick: beginTick before the core runs it, endTick after. `rng` is the owner's
+  // generator, copied whenever the tick opens a keyframe.
+  void beginTick(const SessionCore& core, const RewindMarks& marks, const ReplayRng& rng);
+  void endTick(const SessionCore& core);
+  // A choice picked after the tick that offered it can rewrite the body (mini), which no
+  // retracted move undoes. Call this before applying the pick; the newest delta then keeps the
+  // body from before its tick in full.
+  void keepLastTickBody(const SessionCore& core);
+
+  // Undoes the newest recorded tick on `core` and returns the owner's marks from before it.
+  auto stepBack(SessionCore& core) -> std::optional<RewindMarks>;
+  // Rebuilds what stepBack() leaves behind for the current tick: the stall and spawn windows on
+  // `core`, and `rng` as it stood after `rngDraws` draws, the marks stepBack() last returned.
+  void settle(SessionCore& core, ReplayRng& rng, quint64 rngDraws);
+
+private:
+  struct Segment {
+    SessionKeyframe keyframe;
+    ReplayRng rng;
+    RewindMarks marks;
+    std::vector<RewindDelta> deltas;
+    std::size_t bytes = 0;
+  };
+
+  [[nodiscard]] static auto keyframeBytes(const SessionKeyframe& keyframe) -> std::size_t;
+  [[nodiscard]] static auto deltaBytes(const RewindDelta& delta) -> std::size_t;
+  void openSegment(const SessionCore& core, const RewindMarks& marks, const ReplayRng& rng);
+  void popFront();
+  void popBack();
+  void enforceBudget();
+
+  std::size_t m_budgetBytes = 0;
+  int m_keyframeIntervalTicks = DefaultKeyframeIntervalTicks;
+  std::deque<Segment> m_segments;
+  std::size_t m_bytes = 0;
+  int m_depth = 0;
+
+  // Filled by beginTick and finished by endTick.
+  RewindDelta m_pending;
+  bool m_hasPending = false;
+  QPoint m_headBefore;
+  QPoint m_tailBefore;
+  std::size_t m_sizeBefore = 0;
+  std::uint64_t m_hashBefore = 0;
+  std::uint64_t m_spawnsBefore = 0;
+};
+
+} // namespace nenoserpent::core
@@ -26,3 +26,16 @@ struct ChoiceRecord {
     return in >> value.frame >> value.index;
   }
 };
+
+// Rolling state checksum after the tick that brought the counter to `frame`.
+struct ChecksumRecord {
+  int frame = 0;
+  quint64 checksum = 0;
+
+  friend auto operator<<(QDataStream& out, const ChecksumRecord& value) -> QDataStream& {
+    return out << value.frame << value.checksum;
+  }
+  friend auto operator>>(QDataStream& in, ChecksumRecord& value) -> QDataStream& {
+    return in >> value.frame >> value.checksum;
+  }
+};
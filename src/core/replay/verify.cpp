@@ -0,0 +1,127 @@
+#include "core/replay/verify.h"
+
+namespace nenoserpent::core {
+
+namespace {
+// Ticks a replay may run past the recording before it counts as overrunning. The crash that
+// ended the run comes on the very next movement, so this only absorbs ticks that do not move
+// beyond the pause tick of each recorded choice, which the budget counts separately.
+constexpr int OverrunSlackTicks = 16;
+
+void startReplay(SessionRunner& runner, const ReplayVerifyInput& input) {
+  runner.setObstacleSchedule(input.obstacleSchedule);
+  runner.startReplay(input.obstacles,
+                     input.randomSeed,
+                     input.inputHistory,
+                     input.choiceHistory,
+                     input.checksumHistory,
+                     input.keyframes);
+}
+
+auto expectedMoves(const ReplayVerifyInput& input) -> qsizetype {
+  return input.expectedMoves >= 0 ? input.expectedMoves : input.recording.size();
+}
+
+// Checks the tick that just ran against the recording. Returns false once a verdict is reached.
+auto checkTick(const SessionRunner& runner,
+               const SessionTickResult& tick,
+               const ReplayVerifyInput& input,
+               ReplayVerification& result) -> bool {
+  ++result.ticks;
+  if (tick.checksumMismatch) {
+    result.verdict = ReplayVerdict::Diverged;
+    result.divergentTick = runner.firstDivergentTick();
+    return false;
+  }
+  if (!tick.advanced) {
+    return true;
+  }
+  const qsizetype frame = runner.recordingOffset() + runner.recording().size() - 1;
+  if (frame >= expectedMoves(input)) {
+    result.verdict = ReplayVerdict::Overran;
+    return false;
+  }
+  if (frame < input.recording.size()) {
+    const QPoint head = runner.recording().back();
+    const QPoint expected = input.recording.at(frame);
+    if (head != expected) {
+      result.verdict = ReplayVerdict::Diverged;
+      result.divergentTick = runner.core().tickCounter();
+      result.expectedHead = expected;
+      result.actualHead = head;
+      return false;
+    }
+  }
+  ++result.matchedFrames;
+  return true;
+}
+
+// A replay that crashed before reproducing every recorded movement ended early.
+void settleFinishedReplay(const SessionRunner& runner,
+                          const ReplayVerifyInput& input,
+                          ReplayVerification& result) {
+  const qsizetype reproduced = runner.recordingOffset() + runner.recording().size();
+  if (result.verdict == ReplayVerdict::Match && runner.mode() != SessionMode::Replaying &&
+      reproduced < expectedMoves(input)) {
+    result.verdict = ReplayVerdict::EndedEarly;
+  }
+  result.score = runner.core().state().score;
+}
+} // namespace
+
+auto replayVerdictName(const ReplayVerdict verdict) -> const char* {
+  switch (verdict) {
+  case ReplayVerdict::Match:
+    return "match";
+  case ReplayVerdict::Diverged:
+    return "diverged";
+  case ReplayVerdict::EndedEarly:
+    return "ended-early";
+  case ReplayVerdict::Overran:
+    return "overran";
+  }
+  return "unknown";
+}
+
+auto verifyReplay(SessionRunner& runner, const ReplayVerifyInput& input) -> ReplayVerification {
+  startReplay(runner, input);
+
+  ReplayVerification result;
+  const int tickBudget = static_cast<int>(expectedMoves(input) + input.choiceHistory.size()) +
+                         OverrunSlackTicks;
+  while (runner.mode() == SessionMode::Replaying && result.ticks < tickBudget) {
+    if (!checkTick(runner, runner.tick(), input, result)) {
+      break;
+    }
+  }
+  if (result.verdict == ReplayVerdict::Match && runner.mode() == SessionMode::Replaying) {
+    result.verdict = ReplayVerdict::Overran;
+  }
+  settleFinishedReplay(runner, input, result);
+  return result;
+}
+
+auto spotCheckReplay(SessionRunner& runner,
+                     const ReplayVerifyInput& input,
+                     const int fromTick,
+                     const int tickCount) -> ReplayVerification {
+  startReplay(runner, input);
+
+  ReplayVerification result;
+  if (!runner.seekToTick(fromTick)) {
+    result.verdict = runner.firstDivergentTick() >= 0 ? ReplayVerdict::Diverged
+                                                      : ReplayVerdict::EndedEarly;
+    result.divergentTick = runner.firstDivergentTick();
+    result.score = runner.core().state().score;
+    return result;
+  }
+  while (runner.mode() == SessionMode::Replaying && result.ticks < tickCount) {
+    if (!checkTick(runner, runner.tick(), input, result)) {
+      break;
+    }
+  }
+  settleFinishedReplay(runner, input, result);
+  return result;
+}
+
+} // namespace nenoserpent::core
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <optional>
+
+#include <QList>
+#include <QPoint>
+
+#include "core/replay/keyframe.h"
+#include "core/replay/types.h"
+#include "core/session/runner.h"
+
+namespace nenoserpent::core {
+
+// Everything a recorded run needs to be re-simulated and checked.
+struct ReplayVerifyInput {
+  QList<QPoint> obstacles;
+  // Set for a dynamic level; the walls then follow it instead of `obstacles`.
+  std::optional<ObstacleSchedule> obstacleSchedule;
+  uint randomSeed = 0;
+  QList<ReplayFrame> inputHistory;
+  QList<ChoiceRecord> choiceHistory;
+  // Optional; when present the replay stops at the first tick whose state checksum differs.
+  QList<ChecksumRecord> checksumHistory;
+  // Optional; only spotCheckReplay uses them.
+  QList<ReplayKeyframe> keyframes;
+  // Head position after every movement, as recorded by the original run. May be empty when the
+  // ghost was saved without it; only the movement count and checksums are checked then.
+  QList<QPoint> recording;
+  // Movements the run made; -1 means recording.size().
+  int expectedMoves = -1;
+};
+
+enum class ReplayVerdict {
+  // Every recorded head position was reproduced and the replay then crashed, as the run did.
+  Match,
+  // The replay moved the head somewhere other than the recording, or failed a state checksum.
+  Diverged,
+  // The replay crashed before reproducing the whole recording.
+  EndedEarly,
+  // The replay kept moving after the recording ended.
+  Overran,
+};
+
+struct ReplayVerification {
+  ReplayVerdict verdict = ReplayVerdict::Match;
+  int ticks = 0;
+  int matchedFrames = 0;
+  int score = 0;
+  // Set for Diverged only: the tick counter after the failing tick, and for a head mismatch the
+  // two positions.
+  int divergentTick = -1;
+  QPoint expectedHead{-1, -1};
+  QPoint actualHead{-1, -1};
+};
+
+[[nodiscard]] auto replayVerdictName(ReplayVerdict verdict) -> const char*;
+
+// Replays `input` on `runner` (whose board size is used) and compares every movement with the
+// recording. The runner is left in its final replay state and can be reused for the next run.
+[[nodiscard]] auto verifyReplay(SessionRunner& runner, const ReplayVerifyInput& input)
+  -> ReplayVerification;
+
+// Seeks to `fromTick` through the nearest keyframe and checks at most `tickCount` ticks from
+// there, so the cost is bounded by the keyframe interval plus the window rather than by the
+// replay length. Match means the window agreed with the recording.
+[[nodiscard]] auto spotCheckReplay(SessionRunner& runner,
+                                   const ReplayVerifyInput& input,
+                                   int fromTick,
+                                   int tickCount) -> ReplayVerification;
+
+} // namespace nenoserpent::core
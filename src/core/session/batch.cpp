@@ -0,0 +1,255 @@
+#include "core/session/batch.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "core/session/tick_driver.h"
+
+namespace nenoserpent::core {
+
+// Threads that each step one fixed block of lanes per tick; block 0 runs on the caller. They wait
+// on a tick generation, so a tick costs one wake-up and one join, not a thread start.
+class SessionBatch::Workers {
+public:
+  Workers(SessionBatch& batch, const int blocks)
+      : m_batch(batch),
+        m_blocks(blocks) {
+    m_threads.reserve(static_cast<std::size_t>(blocks - 1));
+    for (int block = 1; block < blocks; ++block) {
+      m_threads.emplace_back([this, block] { run(block); });
+    }
+  }
+  ~Workers() {
+    {
+      const std::lock_guard lock(m_mutex);
+      m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& thread : m_threads) {
+      thread.join();
+    }
+  }
+  Workers(const Workers&) = delete;
+  auto operator=(const Workers&) -> Workers& = delete;
+
+  [[nodiscard]] auto blocks() const -> int {
+    return m_blocks;
+  }
+
+  void tick(const std::span<const QPoint> directions) {
+    {
+      const std::lock_guard lock(m_mutex);
+      m_directions = directions;
+      m_running = m_blocks - 1;
+      ++m_generation;
+    }
+    m_wake.notify_all();
+    tickBlock(0);
+    std::unique_lock lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_running == 0; });
+  }
+
+private:
+  void run(const int block) {
+    std::uint64_t seen = 0;
+    for (;;) {
+      std::span<const QPoint> directions;
+      {
+        std::unique_lock lock(m_mutex);
+        m_wake.wait(lock, [this, seen] { return m_stopping || m_generation != seen; });
+        if (m_stopping) {
+          return;
+        }
+        seen = m_generation;
+        directions = m_directions;
+      }
+      tickBlock(block, directions);
+      {
+        const std::lock_guard lock(m_mutex);
+        --m_running;
+      }
+      m_idle.notify_one();
+    }
+  }
+
+  void tickBlock(const int block) {
+    tickBlock(block, m_directions);
+  }
+  void tickBlock(const int block, const std::span<const QPoint> directions) {
+    const std::size_t lanes = m_batch.m_cores.size();
+    const auto blocks = static_cast<std::size_t>(m_blocks);
+    const auto index = static_cast<std::size_t>(block);
+    m_batch.tickLanes((lanes * index) / blocks, (lanes * (index + 1)) / blocks, directions);
+  }
+
+  SessionBatch& m_batch;
+  int m_blocks = 1;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  std::span<const QPoint> m_directions;
+  std::uint64_t m_generation = 0;
+  int m_running = 0;
+  bool m_stopping = false;
+  std::vector<std::thread> m_threads;
+};
+
+SessionBatch::SessionBatch(const int laneCount, const SessionBatchConfig config)
+    : m_config(config) {
+  const auto lanes = static_cast<std::size_t>(std::max(laneCount, 0));
+  m_cores.resize(lanes);
+  m_rngs.resize(lanes);
+  m_choices.resize(lanes);
+  m_ticks.resize(lanes);
+  m_modes.resize(lanes, SessionMode::Idle);
+  m_done.resize(lanes, 1);
+  m_events.resize(lanes);
+  for (auto& core : m_cores) {
+    core.setFreeCellOrder(FreeCellOrder::Dense);
+  }
+  const int hardwareThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  const int workers = std::clamp(m_config.workers > 0 ? m_config.workers : hardwareThreads,
+                                 1,
+                                 std::max(1, static_cast<int>(lanes)));
+  if (workers > 1) {
+    m_workers = std::make_unique<Workers>(*this, workers);
+  }
+}
+
+SessionBatch::~SessionBatch() = default;
+
+auto SessionBatch::workerCount() const -> int {
+  return m_workers ? m_workers->blocks() : 1;
+}
+
+void SessionBatch::setObstacleSchedule(std::optional<ObstacleSchedule> schedule) {
+  m_obstacleSchedule = std::move(schedule);
+}
+
+void SessionBatch::start(const QList<QPoint>& obstacles, const std::uint64_t seed) {
+  m_obstacles = obstacles;
+  m_root.reseed(seed);
+  m_nextStream = 0;
+  for (std::size_t lane = 0; lane < m_cores.size(); ++lane) {
+    startLane(lane, m_nextStream++);
+  }
+}
+
+void SessionBatch::restartLane(const std::size_t lane) {
+  startLane(lane, m_nextStream++);
+}
+
+void SessionBatch::startLane(const std::size_t lane, const std::uint64_t stream) {
+  if (m_done[lane] == 0) {
+    --m_liveCount;
+  }
+  m_rngs[lane] = m_root.split(stream);
+  m_choices[lane].clear();
+  auto& core = m_cores[lane];
+  core.applyMetaAction(MetaAction::bootstrapForLevel(
+    m_obstacleSchedule.has_value() ? m_obstacleSchedule->obstaclesAt(0) : m_obstacles,
+    m_config.boardWidth,
+    m_config.boardHeight));
+  core.spawnFood(m_config.boardWidth, m_config.boardHeight, m_rngs[lane]);
+  m_modes[lane] = SessionMode::Playing;
+  m_done[lane] = 0;
+  m_events[lane] = 0;
+  m_ticks[lane] = 0;
+  ++m_liveCount;
+}
+
+auto SessionBatch::tick(const std::span<const QPoint> directions) -> int {
+  std::ranges::fill(m_events, std::uint8_t{0});
+  if (m_workers) {
+    m_workers->tick(directions);
+  } else {
+    tickLanes(0, m_cores.size(), directions);
+  }
+  m_liveCount = static_cast<int>(std::ranges::count(m_done, std::uint8_t{0}));
+  return m_liveCount;
+}
+
+// Touches only lanes [begin, end): their core and their slot of every per-lane array.
+void SessionBatch::tickLanes(const std::size_t begin,
+                             const std::size_t end,
+                             const std::span<const QPoint> directions) {
+  const bool hasDirections = directions.size() >= m_cores.size();
+  for (std::size_t lane = begin; lane < end; ++lane) {
+    if (m_done[lane] != 0 || m_modes[lane] != SessionMode::Playing) {
+      continue;
+    }
+    if (hasDirections && !directions[lane].isNull()) {
+      m_cores[lane].enqueueDirection(directions[lane]);
+    }
+    tickLane(lane);
+  }
+}
+
+auto SessionBatch::selectChoice(const std::size_t lane, const int index) -> bool {
+  if (m_modes[lane] != SessionMode::ChoiceSelection || index < 0 ||
+      index >= m_choices[lane].size()) {
+    return false;
+  }
+  m_cores[lane].selectChoice(m_choices[lane][index].type, ChoiceBuffDurationTicks, false);
+  m_choices[lane].clear();
+  m_modes[lane] = SessionMode::Playing;
+  return true;
+}
+
+void SessionBatch::tickLane(const std::size_t lane) {
+  struct Host {
+    SessionBatch& batch;
+    std::size_t lane;
+
+    auto drawBounded(const int bound) -> int {
+      return batch.m_rngs[lane].bounded(bound);
+    }
+    void selectReplayChoice(const int /*index*/) {
+    }
+    void applyStep(const SessionAdvanceResult& step) {
+      if (step.collision) {
+        return;
+      }
+      if (step.ateFood || step.magnetAteFood) {
+        batch.m_events[lane] |= LaneAteFood;
+      }
+      applyFoodConsumption(batch.m_cores[lane],
+                           batch.m_config.boardWidth,
+                           batch.m_config.boardHeight,
+                           step,
+                           batch.m_rngs[lane],
+                           *this);
+      if (step.appliedMovement) {
+        batch.m_events[lane] |= LaneAdvanced;
+      }
+    }
+    void applyRuntimeUpdate(const RuntimeUpdateResult& /*update*/) {
+      if (batch.m_obstacleSchedule.has_value()) {
+        applyObstacleSchedule(batch.m_cores[lane], *batch.m_obstacleSchedule);
+      }
+    }
+    void enterChoice() {
+      batch.m_choices[lane] = pickRoguelikeChoices(batch.m_rngs[lane].generate(), 3);
+      batch.m_modes[lane] = SessionMode::ChoiceSelection;
+      batch.m_events[lane] |= LaneEnteredChoice;
+    }
+  } host{.batch = *this, .lane = lane};
+  const auto outcome =
+    runSessionTick(m_cores[lane], m_config.boardWidth, m_config.boardHeight, nullptr, host);
+  ++m_ticks[lane];
+
+  if (outcome.step.collision) {
+    m_events[lane] |= LaneCollision;
+    m_modes[lane] = SessionMode::GameOver;
+    m_done[lane] = 1;
+    return;
+  }
+  if (m_config.maxTicks > 0 && m_ticks[lane] >= m_config.maxTicks) {
+    m_events[lane] |= LaneTimedOut;
+    m_done[lane] = 1;
+  }
+}
+
+} // namespace nenoserpent::core
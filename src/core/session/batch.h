@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <QList>
+#include <QPoint>
+
+#include "core/choice/runtime.h"
+#include "core/game/random.h"
+#include "core/level/schedule.h"
+#include "core/session/core.h"
+#include "core/session/runner.h"
+
+namespace nenoserpent::core {
+
+// Bits of SessionBatch::events(), cleared at the start of every batched tick.
+enum LaneEvent : std::uint8_t {
+  LaneAdvanced = 1U << 0U,
+  LaneAteFood = 1U << 1U,
+  LaneEnteredChoice = 1U << 2U,
+  LaneCollision = 1U << 3U,
+  LaneTimedOut = 1U << 4U,
+};
+
+struct SessionBatchConfig {
+  int boardWidth = StandardBoardWidth;
+  int boardHeight = StandardBoardHeight;
+  // Lanes are marked done after this many ticks; 0 never times out.
+  int maxTicks = 0;
+  // Threads a tick spreads the lanes over, the calling thread included; 0 takes one per hardware
+  // thread. Each thread steps a fixed block of lanes, and lanes share nothing they write, so the
+  // outcome does not depend on it.
+  int workers = 1;
+};
+
+// Advances many independent headless sessions in lockstep.
+// Every lane is a SessionCore ticked through runSessionTick and applyFoodConsumption, the helpers
+// SessionRunner plays by, and lane(i) is where its board lives. The per-lane state the batch owns
+// (generator, mode, done mask, events, tick count, offered choices) is stored one array per field,
+// so a trainer scans done() or events() without touching the cores.
+// Lanes draw from CounterRng streams split from one seed and use dense free-cell order: batch
+// sessions are reproducible from (seed, lane, restart count) but are not ghost-compatible.
+// With config.workers above 1 the batch keeps that many - 1 threads parked between ticks.
+class SessionBatch {
+public:
+  explicit SessionBatch(int laneCount, SessionBatchConfig config = {});
+  ~SessionBatch();
+  SessionBatch(const SessionBatch&) = delete;
+  auto operator=(const SessionBatch&) -> SessionBatch& = delete;
+
+  // Restarts every lane on `obstacles`. Lane i draws from CounterRng(seed).split(i).
+  void start(const QList<QPoint>& obstacles, std::uint64_t seed);
+  // Scripted walls, moved by each lane's tick counter as SessionRunner moves them. While one is
+  // set, start() and restartLane() begin lanes on its first layout instead of start()'s walls.
+  void setObstacleSchedule(std::optional<ObstacleSchedule> schedule);
+  // Restarts one lane on the next unused stream, keeping the batch full for continuous runs.
+  void restartLane(std::size_t lane);
+
+  // Advances every Playing lane by one tick. A non-zero directions[lane] is queued on that lane
+  // first; `directions` may be empty. Lanes in choice selection or already done are skipped.
+  // Returns the number of lanes that are not done.
+  auto tick(std::span<const QPoint> directions = {}) -> int;
+  auto selectChoice(std::size_t lane, int index) -> bool;
+
+  [[nodiscard]] auto laneCount() const -> std::size_t {
+    return m_cores.size();
+  }
+  [[nodiscard]] auto liveCount() const -> int {
+    return m_liveCount;
+  }
+  [[nodiscard]] auto workerCount() const -> int;
+  [[nodiscard]] auto lane(const std::size_t lane) const -> const SessionCore& {
+    return m_cores[lane];
+  }
+  [[nodiscard]] auto choices(const std::size_t lane) const -> const QList<ChoiceSpec>& {
+    return m_choices[lane];
+  }
+
+  // Ticks each lane has played since it last started, crashes included.
+  [[nodiscard]] auto ticks() const -> std::span<const int> {
+    return m_ticks;
+  }
+  [[nodiscard]] auto modes() const -> std::span<const SessionMode> {
+    return m_modes;
+  }
+  [[nodiscard]] auto done() const -> std::span<const std::uint8_t> {
+    return m_done;
+  }
+  [[nodiscard]] auto events() const -> std::span<const std::uint8_t> {
+    return m_events;
+  }
+
+private:
+  class Workers;
+
+  void startLane(std::size_t lane, std::uint64_t stream);
+  void tickLanes(std::size_t begin, std::size_t end, std::span<const QPoint> directions);
+  void tickLane(std::size_t lane);
+
+  SessionBatchConfig m_config;
+  QList<QPoint> m_obstacles;
+  std::optional<ObstacleSchedule> m_obstacleSchedule;
+  CounterRng m_root;
+  std::uint64_t m_nextStream = 0;
+  int m_liveCount = 0;
+
+  std::vector<SessionCore> m_cores;
+  std::vector<CounterRng> m_rngs;
+  std::vector<QList<ChoiceSpec>> m_choices;
+  std::vector<int> m_ticks;
+  std::vector<SessionMode> m_modes;
+  std::vector<std::uint8_t> m_done;
+  std::vector<std::uint8_t> m_events;
+  // Last, so the threads are parked and joined before the lanes they step go away.
+  std::unique_ptr<Workers> m_workers;
+};
+
+} // namespace nenoserpent::core
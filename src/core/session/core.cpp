@@ -3,9 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
-#include <deque>
 #include <limits>
-#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -13,13 +11,15 @@ namespace nenoserpent::core {
 
 namespace {
 constexpr int PowerUpLifetimeTicks = 100;
-constexpr int StallHashWindow = 128;
 constexpr int StallNoScoreTicksThreshold = 120;
 constexpr int StallRepeatThreshold = 6;
 constexpr int SpawnMinHeadDistance = 2;
 constexpr int SpawnMinObstacleDistance = 2;
 constexpr int SpawnTopKMin = 3;
 constexpr int SpawnTopKMax = 8;
+// Large-board spawns score a (2 * radius + 1)^2 window around a random free anchor.
+constexpr int SpawnWindowRadius = 8;
+constexpr int SpawnWindowAttempts = 4;
 constexpr int SpeedStepIntervalMs = 5;
 constexpr int MaxSpeedDownSteps = 12;
 
@@ -49,11 +49,6 @@ struct SpawnTuning {
 };
 
 auto spawnTuningForProfile(SpawnProfile profile) -> SpawnTuning;
-auto buildPredictedObstacleRisk(int boardWidth,
-                                int boardHeight,
-                                const QList<QPoint>& previousObstacles,
-                                const QList<QPoint>& currentObstacles,
-                                int horizonTicks) -> std::vector<int>;
 
 auto boardIndex(const QPoint& p, const int boardWidth) -> int {
   return p.y() * boardWidth + p.x();
@@ -67,334 +62,390 @@ auto tryBoardIndex(const QPoint& p, const int boardWidth, const int boardHeight)
   return boardIndex(p, boardWidth);
 }
 
-auto toroidalDistance(const QPoint& a, const QPoint& b, const int boardWidth, const int boardHeight)
-  -> int {
-  const int dx = std::abs(a.x() - b.x());
-  const int dy = std::abs(a.y() - b.y());
-  return std::min(dx, boardWidth - dx) + std::min(dy, boardHeight - dy);
-}
+// Spawn-time blocking: body, obstacles and the other pickup, with the head cell left open.
+struct SpawnBlockedView {
+  const OccupancyGrid& occupancy;
+  QPoint reserved;
+  QPoint head;
 
-auto buildSpawnBlockedMap(const int boardWidth,
-                          const int boardHeight,
-                          const std::function<bool(const QPoint&)>& isBlocked)
-  -> std::vector<bool> {
-  std::vector<bool> blocked(static_cast<std::size_t>(boardWidth * boardHeight), false);
-  for (int x = 0; x < boardWidth; ++x) {
-    for (int y = 0; y < boardHeight; ++y) {
-      const QPoint p{x, y};
-      blocked[static_cast<std::size_t>(boardIndex(p, boardWidth))] = isBlocked(p);
-    }
+  auto operator()(const QPoint& p) const -> bool {
+    return p != head && (p == reserved || occupancy.isOccupied(p));
   }
-  return blocked;
-}
+};
 
 auto countFreeNeighbors(const QPoint& point,
                         const int boardWidth,
                         const int boardHeight,
-                        const std::vector<bool>& blocked) -> int {
-  constexpr std::array<QPoint, 4> kDirs = {
-    QPoint{1, 0},
-    QPoint{-1, 0},
-    QPoint{0, 1},
-    QPoint{0, -1},
-  };
+                        const SpawnBlockedView& isBlocked) -> int {
   int freeNeighbors = 0;
-  for (const QPoint& d : kDirs) {
-    const QPoint next = wrapPoint(point + d, boardWidth, boardHeight);
-    const auto index = tryBoardIndex(next, boardWidth, boardHeight);
-    if (!index.has_value()) {
-      continue;
-    }
-    if (!blocked[static_cast<std::size_t>(*index)]) {
+  for (const QPoint& d : BoardSteps) {
+    if (!isBlocked(wrapPoint(point + d, boardWidth, boardHeight))) {
       ++freeNeighbors;
     }
   }
   return freeNeighbors;
 }
 
-auto bfsDistances(const QPoint& start,
-                  const int boardWidth,
-                  const int boardHeight,
-                  const std::vector<bool>& blocked) -> std::vector<int> {
-  std::vector<int> distances(blocked.size(), -1);
-  const QPoint wrappedStart = wrapPoint(start, boardWidth, boardHeight);
-  const auto startIndex = tryBoardIndex(wrappedStart, boardWidth, boardHeight);
-  if (!startIndex.has_value()) {
-    return distances;
-  }
-  std::deque<QPoint> queue;
-  queue.push_back(wrappedStart);
-  distances[static_cast<std::size_t>(*startIndex)] = 0;
-
-  constexpr std::array<QPoint, 4> kDirs = {
-    QPoint{1, 0},
-    QPoint{-1, 0},
-    QPoint{0, 1},
-    QPoint{0, -1},
-  };
-  while (!queue.empty()) {
-    const QPoint current = queue.front();
-    queue.pop_front();
-    const auto currentIndex = tryBoardIndex(current, boardWidth, boardHeight);
-    if (!currentIndex.has_value()) {
-      continue;
-    }
-    const int nextDistance = distances[static_cast<std::size_t>(*currentIndex)] + 1;
-    for (const QPoint& d : kDirs) {
-      const QPoint next = wrapPoint(current + d, boardWidth, boardHeight);
-      const auto nextIndex = tryBoardIndex(next, boardWidth, boardHeight);
-      if (!nextIndex.has_value()) {
-        continue;
-      }
-      const auto idx = static_cast<std::size_t>(*nextIndex);
-      if (blocked[idx] || distances[idx] >= 0) {
+template <typename Geometry>
+auto floodFillReachOn(const Geometry& board,
+                      const QPoint& start,
+                      const SpawnBlockedView& isBlocked,
+                      std::vector<int>& reach,
+                      std::vector<int>& queue) -> int {
+  reach.assign(board.cellCount(), -1);
+  queue.clear();
+  if (!board.contains(start)) {
+    return 0;
+  }
+  const int startIndex = board.cellIndex(start);
+  reach[static_cast<std::size_t>(startIndex)] = 0;
+  queue.push_back(startIndex);
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const int current = queue[head];
+    for (std::size_t step = 0; step < BoardSteps.size(); ++step) {
+      const int next = board.neighbor(current, step);
+      const auto idx = static_cast<std::size_t>(next);
+      if (reach[idx] >= 0 || isBlocked(board.cellPoint(next))) {
         continue;
       }
-      distances[idx] = nextDistance;
+      reach[idx] = reach[static_cast<std::size_t>(current)] + 1;
       queue.push_back(next);
     }
   }
-  return distances;
+  return static_cast<int>(queue.size());
 }
 
-auto buildConnectedComponents(const int boardWidth,
-                              const int boardHeight,
-                              const std::vector<bool>& blocked)
-  -> std::pair<std::vector<int>, std::vector<int>> {
-  std::vector<int> componentOf(blocked.size(), -1);
-  std::vector<int> componentSizes;
-  int nextComponent = 0;
-  constexpr std::array<QPoint, 4> kDirs = {
-    QPoint{1, 0},
-    QPoint{-1, 0},
-    QPoint{0, 1},
-    QPoint{0, -1},
+// Flood fill from `start` over unblocked cells; `reach` ends up >= 0 exactly on the visited
+// cells. Returns the number of visited cells.
+auto floodFillReach(const QPoint& start,
+                    const int boardWidth,
+                    const int boardHeight,
+                    const SpawnBlockedView& isBlocked,
+                    std::vector<int>& reach,
+                    std::vector<int>& queue) -> int {
+  return visitBoardGeometry(boardWidth, boardHeight, [&](const auto& board) {
+    return floodFillReachOn(board, start, isBlocked, reach, queue);
+  });
+}
+
+// Scores spawn candidates for one pick. Passes relax, in order: tail reachability, then head /
+// obstacle / risk distances, then the pocket filter. Each pass accepts a superset of the previous
+// one, so every candidate is scored once, tagged with the first pass that accepts it, and the
+// lowest non-empty pass wins.
+struct SpawnScorer {
+  const SpawnTuning& tuning;
+  const SpawnAnalysisCache& cache;
+  const SpawnBlockedView& blocked;
+  const RecentSpawnPoints& recentSpawnPoints;
+  QPoint head;
+  int boardWidth = 0;
+  int boardHeight = 0;
+  int reachableArea = 0;
+  bool tailReachable = false;
+  bool tailFilterPasses = true;
+
+  // Appends `point` to `candidates` unless an earlier pass already has candidates.
+  void consider(const QPoint& point,
+                int& bestPass,
+                std::vector<SpawnCandidate>& candidates) const {
+    const auto idx = static_cast<std::size_t>(boardIndex(point, boardWidth));
+    const int dynamicRisk = cache.predictedRisk(idx);
+    const int freeNeighbors = countFreeNeighbors(point, boardWidth, boardHeight, blocked);
+    const int obstacleDistance = cache.obstacleDistance(idx);
+    const int headDistance = toroidalDistance(point, head, boardWidth, boardHeight);
+
+    const bool distancesPass =
+      !(tuning.dynamicRiskHardLimit > 0 && dynamicRisk >= tuning.dynamicRiskHardLimit) &&
+      headDistance >= tuning.minHeadDistance &&
+      !(obstacleDistance != SpawnAnalysisCache::NoObstacleDistance &&
+        obstacleDistance < tuning.minObstacleDistance);
+    const bool pocketPasses = freeNeighbors >= 2;
+    int pass = 3;
+    if (pocketPasses) {
+      pass = !distancesPass ? 2 : (tailFilterPasses ? 0 : 1);
+    }
+    if (pass > bestPass) {
+      return;
+    }
+    bestPass = pass;
+
+    int score =
+      (reachableArea * tuning.reachableAreaWeight) + (freeNeighbors * tuning.freeNeighborWeight);
+    if (tailReachable) {
+      score += tuning.tailReachableBonus;
+    }
+    if (obstacleDistance != SpawnAnalysisCache::NoObstacleDistance) {
+      score += std::min(obstacleDistance, 6) * tuning.obstacleDistanceWeight;
+    }
+    score += std::min(headDistance, 6) * tuning.headDistanceWeight;
+
+    const int centerX2 = boardWidth - 1;
+    const int centerY2 = boardHeight - 1;
+    const int dx2 = std::abs((point.x() * 2) - centerX2);
+    const int dy2 = std::abs((point.y() * 2) - centerY2);
+    const int centerDistance2 = dx2 + dy2;
+    score += (centerX2 + centerY2 - centerDistance2) * tuning.centerBiasWeight;
+
+    const bool onEdge = point.x() == 0 || point.y() == 0 || point.x() == boardWidth - 1 ||
+                        point.y() == boardHeight - 1;
+    if (onEdge) {
+      score -= tuning.edgePenaltyWeight * 10;
+    }
+    score -= dynamicRisk * tuning.dynamicRiskWeight;
+    int recentPenalty = 0;
+    for (const QPoint& recent : recentSpawnPoints) {
+      const int d = toroidalDistance(point, recent, boardWidth, boardHeight);
+      if (d == 0) {
+        recentPenalty += 16;
+      } else if (d <= 1) {
+        recentPenalty += 10;
+      } else if (d <= 2) {
+        recentPenalty += 4;
+      }
+    }
+    score -= recentPenalty * tuning.recentSpawnPenaltyWeight;
+    candidates.push_back({.point = point, .score = score, .pass = pass});
+  }
+};
+
+// Draws one of the top-ranked candidates of `bestPass`; `candidates` must not be empty.
+template <typename Draw>
+auto pickRankedCandidate(std::vector<SpawnCandidate>& candidates,
+                         const int bestPass,
+                         const SpawnTuning& tuning,
+                         Draw& randomBounded,
+                         QPoint& pickedPoint) -> bool {
+  std::erase_if(candidates,
+                [bestPass](const SpawnCandidate& candidate) { return candidate.pass != bestPass; });
+  const int topK =
+    std::clamp(static_cast<int>(candidates.size()) / 3, tuning.topKMin, tuning.topKMax);
+  const int selected = randomBounded(topK);
+  if (selected < 0 || selected >= topK) {
+    return false;
+  }
+  // Only the first topK ranks can be drawn, so a partial sort yields the same prefix.
+  const auto ranked = std::min(static_cast<std::size_t>(topK), candidates.size());
+  std::partial_sort(candidates.begin(),
+                    candidates.begin() + static_cast<std::ptrdiff_t>(ranked),
+                    candidates.end(),
+                    [](const SpawnCandidate& a, const SpawnCandidate& b) {
+                      if (a.score != b.score) {
+                        return a.score > b.score;
+                      }
+                      if (a.point.x() != b.point.x()) {
+                        return a.point.x() < b.point.x();
+                      }
+                      return a.point.y() < b.point.y();
+                    });
+  // topK is floored at topKMin, which can exceed a small candidate set; clamp to the last rank.
+  pickedPoint = candidates[std::min(static_cast<std::size_t>(selected), ranked - 1)].point;
+  return true;
+}
+
+// Large boards: instead of flooding the whole board from the head, flood a SpawnWindowRadius
+// window around a random free anchor and score only that window. The anchor's component is
+// accepted when it holds the head, or when it shares the head's obstacle component and leaves
+// the window; only the body could still cut it off, and a body that encloses a region spanning
+// the window is rare enough to accept. Cost per spawn is bounded by the window, not the board.
+template <typename Draw>
+auto pickSpawnPointInWindow(const OccupancyGrid& occupancy,
+                            const SpawnBlockedView& blocked,
+                            const std::optional<QPoint>& tail,
+                            SpawnScorer scorer,
+                            SpawnAnalysisCache& cache,
+                            Draw& randomBounded,
+                            QPoint& pickedPoint) -> bool {
+  const int boardWidth = occupancy.width();
+  const int boardHeight = occupancy.height();
+  const BoardGeometry board(boardWidth, boardHeight);
+  const QPoint head = blocked.head;
+  const int headComponent =
+    cache.obstacleComponent(static_cast<std::size_t>(board.cellIndex(head)));
+  // Narrow boards shrink the window so that no cell appears in it twice.
+  const int radiusX = std::min(SpawnWindowRadius, (boardWidth - 1) / 2);
+  const int radiusY = std::min(SpawnWindowRadius, (boardHeight - 1) / 2);
+  const int sideX = (2 * radiusX) + 1;
+  const int sideY = (2 * radiusY) + 1;
+  auto insideWindow = [&](const QPoint& offset) -> bool {
+    return std::abs(offset.x()) <= radiusX && std::abs(offset.y()) <= radiusY;
+  };
+  auto windowIndex = [&](const QPoint& offset) -> int {
+    return ((offset.y() + radiusY) * sideX) + offset.x() + radiusX;
+  };
+  auto windowOffset = [&](const int index) -> QPoint {
+    return {(index % sideX) - radiusX, (index / sideX) - radiusY};
+  };
+  // Offset of `point` from `anchor` along the shorter way round each axis.
+  auto offsetFrom = [&](const QPoint& anchor, const QPoint& point) -> QPoint {
+    int dx = point.x() - anchor.x();
+    int dy = point.y() - anchor.y();
+    dx += dx < -boardWidth / 2 ? boardWidth : (dx > boardWidth / 2 ? -boardWidth : 0);
+    dy += dy < -boardHeight / 2 ? boardHeight : (dy > boardHeight / 2 ? -boardHeight : 0);
+    return {dx, dy};
   };
 
-  for (int x = 0; x < boardWidth; ++x) {
-    for (int y = 0; y < boardHeight; ++y) {
-      const QPoint seed{x, y};
-      const auto seedIndex = tryBoardIndex(seed, boardWidth, boardHeight);
-      if (!seedIndex.has_value()) {
-        continue;
+  auto& reach = cache.reachScratch();
+  auto& queue = cache.queueScratch();
+  auto& candidates = cache.candidateScratch();
+  // Random anchors first; the last attempt centres the window on the head, which always holds it.
+  for (int attempt = 0; attempt <= SpawnWindowAttempts; ++attempt) {
+    QPoint anchor = head;
+    if (attempt < SpawnWindowAttempts) {
+      const int freeSlots = occupancy.freeCount();
+      const int slot = randomBounded(freeSlots);
+      if (slot < 0 || slot >= freeSlots) {
+        return false;
       }
-      const auto idx = static_cast<std::size_t>(*seedIndex);
-      if (blocked[idx] || componentOf[idx] >= 0) {
+      anchor = occupancy.denseFreeCell(slot);
+      if (blocked(anchor) ||
+          (headComponent >= 0 &&
+           cache.obstacleComponent(static_cast<std::size_t>(board.cellIndex(anchor))) !=
+             headComponent)) {
         continue;
       }
-      int size = 0;
-      std::deque<QPoint> queue;
-      queue.push_back(seed);
-      componentOf[idx] = nextComponent;
-      while (!queue.empty()) {
-        const QPoint current = queue.front();
-        queue.pop_front();
-        ++size;
-        for (const QPoint& d : kDirs) {
-          const QPoint next = wrapPoint(current + d, boardWidth, boardHeight);
-          const auto nextIndex = tryBoardIndex(next, boardWidth, boardHeight);
-          if (!nextIndex.has_value()) {
-            continue;
-          }
-          const auto nextIdx = static_cast<std::size_t>(*nextIndex);
-          if (blocked[nextIdx] || componentOf[nextIdx] >= 0) {
-            continue;
-          }
-          componentOf[nextIdx] = nextComponent;
-          queue.push_back(next);
+    }
+
+    // Window cells are queued by window index.
+    const int anchorIndex = windowIndex(QPoint(0, 0));
+    reach.assign(static_cast<std::size_t>(sideX * sideY), -1);
+    queue.clear();
+    reach[static_cast<std::size_t>(anchorIndex)] = 0;
+    queue.push_back(anchorIndex);
+    bool leavesWindow = false;
+    bool holdsHead = false;
+    for (std::size_t next = 0; next < queue.size(); ++next) {
+      const QPoint offset = windowOffset(queue[next]);
+      holdsHead = holdsHead || board.wrapPoint(anchor + offset) == head;
+      for (const QPoint& step : BoardSteps) {
+        const QPoint stepped = offset + step;
+        const bool open = !blocked(board.wrapPoint(anchor + stepped));
+        if (!insideWindow(stepped)) {
+          leavesWindow = leavesWindow || open;
+          continue;
         }
+        const auto idx = static_cast<std::size_t>(windowIndex(stepped));
+        if (reach[idx] >= 0 || !open) {
+          continue;
+        }
+        reach[idx] = reach[static_cast<std::size_t>(queue[next])] + 1;
+        queue.push_back(windowIndex(stepped));
+      }
+    }
+    if (!holdsHead && !leavesWindow) {
+      continue;
+    }
+
+    scorer.reachableArea = static_cast<int>(queue.size());
+    scorer.tailReachable = false;
+    bool tailHasComponent = false;
+    if (tail.has_value()) {
+      const QPoint wrappedTail = board.wrapPoint(*tail);
+      if (!blocked(wrappedTail)) {
+        tailHasComponent = true;
+        const QPoint tailOffset = offsetFrom(anchor, wrappedTail);
+        const auto tailCell = static_cast<std::size_t>(board.cellIndex(wrappedTail));
+        scorer.tailReachable =
+          insideWindow(tailOffset)
+            ? reach[static_cast<std::size_t>(windowIndex(tailOffset))] >= 0
+            : leavesWindow && cache.obstacleComponent(tailCell) == headComponent;
       }
-      componentSizes.push_back(size);
-      ++nextComponent;
+    }
+    scorer.tailFilterPasses = !tailHasComponent || scorer.tailReachable;
+
+    candidates.clear();
+    int bestPass = std::numeric_limits<int>::max();
+    for (const int cell : queue) {
+      const QPoint point = board.wrapPoint(anchor + windowOffset(cell));
+      if (point != head) {
+        scorer.consider(point, bestPass, candidates);
+      }
+    }
+    if (!candidates.empty()) {
+      return pickRankedCandidate(candidates, bestPass, scorer.tuning, randomBounded, pickedPoint);
     }
   }
-  return {componentOf, componentSizes};
+  return false;
 }
 
-struct SpawnCandidate {
-  QPoint point{0, 0};
-  int score = std::numeric_limits<int>::min();
-};
-
-auto pickSpawnPointWithSafety(const int boardWidth,
-                              const int boardHeight,
+// `occupancy` must be sized to the spawn board; `reserved` is the other pickup's cell.
+template <typename Draw>
+auto pickSpawnPointWithSafety(const OccupancyGrid& occupancy,
+                              const QPoint& reserved,
+                              const FreeCellOrder freeCellOrder,
                               const QPoint& head,
                               const std::optional<QPoint>& tail,
                               const QList<QPoint>& obstacles,
                               const QList<QPoint>& previousObstacles,
-                              const std::deque<QPoint>& recentSpawnPoints,
+                              const RecentSpawnPoints& recentSpawnPoints,
                               const SpawnProfile profile,
-                              const std::function<bool(const QPoint&)>& isBlocked,
-                              const std::function<int(int)>& randomBounded,
+                              SpawnAnalysisCache& cache,
+                              Draw& randomBounded,
                               QPoint& pickedPoint) -> bool {
+  const int boardWidth = occupancy.width();
+  const int boardHeight = occupancy.height();
   const SpawnTuning tuning = spawnTuningForProfile(profile);
-  const auto predictedRisk = buildPredictedObstacleRisk(
-    boardWidth, boardHeight, previousObstacles, obstacles, tuning.dynamicRiskHorizon);
-  const QList<QPoint> freeSpots = collectFreeSpots(boardWidth, boardHeight, isBlocked);
-  if (freeSpots.isEmpty()) {
+  const int freeCount = occupancy.freeCount(reserved);
+  if (freeCount <= 0) {
     return false;
   }
-
-  auto blocked = buildSpawnBlockedMap(boardWidth, boardHeight, isBlocked);
-  if (const auto headIndex =
-        tryBoardIndex(wrapPoint(head, boardWidth, boardHeight), boardWidth, boardHeight);
-      headIndex.has_value()) {
-    blocked[static_cast<std::size_t>(*headIndex)] = false;
-  }
-
-  const auto distanceFromHead = bfsDistances(head, boardWidth, boardHeight, blocked);
-  const auto [componentOf, componentSizes] =
-    buildConnectedComponents(boardWidth, boardHeight, blocked);
-  int tailComponent = -1;
+  cache.prepare(boardWidth, boardHeight, obstacles, previousObstacles, tuning.dynamicRiskHorizon);
+
+  const QPoint wrappedHead = wrapPoint(head, boardWidth, boardHeight);
+  const SpawnBlockedView blocked{.occupancy = occupancy, .reserved = reserved, .head = wrappedHead};
+  SpawnScorer scorer{.tuning = tuning,
+                     .cache = cache,
+                     .blocked = blocked,
+                     .recentSpawnPoints = recentSpawnPoints,
+                     .head = head,
+                     .boardWidth = boardWidth,
+                     .boardHeight = boardHeight};
+  if (isLargeBoard(boardWidth, boardHeight)) {
+    return pickSpawnPointInWindow(
+             occupancy, blocked, tail, scorer, cache, randomBounded, pickedPoint) ||
+           pickRandomFreeSpot(occupancy, reserved, freeCellOrder, randomBounded, pickedPoint);
+  }
+
+  auto& reach = cache.reachScratch();
+  // Every candidate must be reachable from the head, so they all share the head's component:
+  // its size is the flood-fill count, and tail reachability is the same for all of them.
+  scorer.reachableArea =
+    floodFillReach(wrappedHead, boardWidth, boardHeight, blocked, reach, cache.queueScratch());
+  bool tailHasComponent = false;
   if (tail.has_value()) {
-    if (const auto tailIndex =
-          tryBoardIndex(wrapPoint(*tail, boardWidth, boardHeight), boardWidth, boardHeight);
-        tailIndex.has_value()) {
-      tailComponent = componentOf[static_cast<std::size_t>(*tailIndex)];
+    const QPoint wrappedTail = wrapPoint(*tail, boardWidth, boardHeight);
+    if (const auto tailIndex = tryBoardIndex(wrappedTail, boardWidth, boardHeight);
+        tailIndex.has_value() && !blocked(wrappedTail)) {
+      tailHasComponent = true;
+      scorer.tailReachable = reach[static_cast<std::size_t>(*tailIndex)] >= 0;
     }
   }
+  scorer.tailFilterPasses = !tailHasComponent || scorer.tailReachable;
 
-  auto minObstacleDistance = [&](const QPoint& point) -> int {
-    if (obstacles.isEmpty()) {
-      return std::numeric_limits<int>::max();
-    }
-    int minDistance = std::numeric_limits<int>::max();
-    for (const QPoint& obstacle : obstacles) {
-      minDistance =
-        std::min(minDistance, toroidalDistance(point, obstacle, boardWidth, boardHeight));
-    }
-    return minDistance;
-  };
-
-  auto gatherCandidates = [&](const bool requireDistances,
-                              const bool requirePocketFilter,
-                              const bool requireTailReachable) {
-    std::vector<SpawnCandidate> candidates;
-    candidates.reserve(static_cast<std::size_t>(freeSpots.size()));
-    for (const QPoint& point : freeSpots) {
-      const auto pointIndex = tryBoardIndex(point, boardWidth, boardHeight);
-      if (!pointIndex.has_value()) {
-        continue;
-      }
-      const auto idx = static_cast<std::size_t>(*pointIndex);
-      const int reachableDistance = distanceFromHead[idx];
-      if (reachableDistance < 0) {
-        continue;
-      }
-      const int dynamicRisk = predictedRisk[idx];
-      if (requireDistances && tuning.dynamicRiskHardLimit > 0 &&
-          dynamicRisk >= tuning.dynamicRiskHardLimit) {
-        continue;
-      }
-      const int freeNeighbors = countFreeNeighbors(point, boardWidth, boardHeight, blocked);
-      if (requirePocketFilter && freeNeighbors < 2) {
-        continue;
-      }
-      const int obstacleDistance = minObstacleDistance(point);
-      const int headDistance = toroidalDistance(point, head, boardWidth, boardHeight);
-      if (requireDistances && headDistance < tuning.minHeadDistance) {
-        continue;
-      }
-      if (requireDistances && obstacleDistance != std::numeric_limits<int>::max() &&
-          obstacleDistance < tuning.minObstacleDistance) {
-        continue;
-      }
-      const int component = componentOf[idx];
-      if (component < 0) {
-        continue;
-      }
-      const bool tailReachable = tailComponent >= 0 && component == tailComponent;
-      if (requireTailReachable && tailComponent >= 0 && !tailReachable) {
-        continue;
-      }
-
-      const int reachableArea = componentSizes[static_cast<std::size_t>(component)];
-      int score =
-        (reachableArea * tuning.reachableAreaWeight) + (freeNeighbors * tuning.freeNeighborWeight);
-      if (tailReachable) {
-        score += tuning.tailReachableBonus;
-      }
-      if (obstacleDistance != std::numeric_limits<int>::max()) {
-        score += std::min(obstacleDistance, 6) * tuning.obstacleDistanceWeight;
-      }
-      score += std::min(headDistance, 6) * tuning.headDistanceWeight;
-
-      const int centerX2 = boardWidth - 1;
-      const int centerY2 = boardHeight - 1;
-      const int dx2 = std::abs((point.x() * 2) - centerX2);
-      const int dy2 = std::abs((point.y() * 2) - centerY2);
-      const int centerDistance2 = dx2 + dy2;
-      const int maxCenterDistance2 = centerX2 + centerY2;
-      score += (maxCenterDistance2 - centerDistance2) * tuning.centerBiasWeight;
-
-      const bool onEdge = point.x() == 0 || point.y() == 0 || point.x() == boardWidth - 1 ||
-                          point.y() == boardHeight - 1;
-      if (onEdge) {
-        score -= tuning.edgePenaltyWeight * 10;
-      }
-      score -= dynamicRisk * tuning.dynamicRiskWeight;
-      int recentPenalty = 0;
-      for (const QPoint& recent : recentSpawnPoints) {
-        const int d = toroidalDistance(point, recent, boardWidth, boardHeight);
-        if (d == 0) {
-          recentPenalty += 16;
-        } else if (d <= 1) {
-          recentPenalty += 10;
-        } else if (d <= 2) {
-          recentPenalty += 4;
-        }
-      }
-      score -= recentPenalty * tuning.recentSpawnPenaltyWeight;
-      candidates.push_back({.point = point, .score = score});
-    }
-    std::sort(
-      candidates.begin(), candidates.end(), [](const SpawnCandidate& a, const SpawnCandidate& b) {
-        if (a.score != b.score) {
-          return a.score > b.score;
-        }
-        if (a.point.x() != b.point.x()) {
-          return a.point.x() < b.point.x();
-        }
-        return a.point.y() < b.point.y();
-      });
-    return candidates;
-  };
-
-  const std::array<std::tuple<bool, bool, bool>, 4> passes = {
-    std::tuple{true, true, true},
-    std::tuple{true, true, false},
-    std::tuple{false, true, false},
-    std::tuple{false, false, false},
-  };
-  for (const auto& [requireDistances, requirePocketFilter, requireTailReachable] : passes) {
-    auto candidates = gatherCandidates(requireDistances, requirePocketFilter, requireTailReachable);
-    if (candidates.empty()) {
+  auto& candidates = cache.candidateScratch();
+  candidates.clear();
+  int bestPass = std::numeric_limits<int>::max();
+  // Candidates are fully ordered by the sort below, so walking the dense free set is safe.
+  for (int slot = 0; slot < occupancy.freeCount(); ++slot) {
+    const QPoint point = occupancy.denseFreeCell(slot);
+    if (point == reserved) {
       continue;
     }
-    const int topK =
-      std::clamp(static_cast<int>(candidates.size()) / 3, tuning.topKMin, tuning.topKMax);
-    const int selected = randomBounded(topK);
-    if (selected < 0 || selected >= topK) {
-      return false;
+    if (reach[static_cast<std::size_t>(boardIndex(point, boardWidth))] < 0) {
+      continue;
     }
-    pickedPoint = candidates[static_cast<std::size_t>(selected)].point;
-    return true;
+    scorer.consider(point, bestPass, candidates);
   }
-
-  const int selected = randomBounded(freeSpots.size());
-  if (selected < 0 || selected >= freeSpots.size()) {
-    return false;
+  if (candidates.empty()) {
+    return pickRandomFreeSpot(occupancy, reserved, freeCellOrder, randomBounded, pickedPoint);
   }
-  pickedPoint = freeSpots[selected];
-  return true;
+  return pickRankedCandidate(candidates, bestPass, tuning, randomBounded, pickedPoint);
 }
 
-void rememberRecentSpawnPoint(std::deque<QPoint>& recentSpawnPoints, const QPoint point) {
-  constexpr std::size_t kRecentSpawnWindow = 18;
-  recentSpawnPoints.push_back(point);
-  while (recentSpawnPoints.size() > kRecentSpawnWindow) {
+void rememberRecentSpawnPoint(RecentSpawnPoints& recentSpawnPoints, const QPoint point) {
+  if (recentSpawnPoints.full()) {
     recentSpawnPoints.pop_front();
   }
+  recentSpawnPoints.push_back(point);
 }
 
 auto mixHash(std::uint64_t seed, const std::uint64_t value) -> std::uint64_t {
@@ -482,10 +533,11 @@ auto spawnTuningForProfile(const SpawnProfile profile) -> SpawnTuning {
   return SpawnTuning{};
 }
 
-auto obstacleSignature(const QList<QPoint>& obstacles, const int boardWidth, const int boardHeight)
-  -> std::uint64_t {
-  std::vector<QPoint> points;
-  points.reserve(static_cast<std::size_t>(obstacles.size()));
+auto obstacleSignature(const QList<QPoint>& obstacles,
+                       const int boardWidth,
+                       const int boardHeight,
+                       std::vector<QPoint>& points) -> std::uint64_t {
+  points.clear();
   for (const QPoint& obstacle : obstacles) {
     points.push_back(wrapPoint(obstacle, boardWidth, boardHeight));
   }
@@ -510,7 +562,8 @@ auto classifySpawnProfile(const QList<QPoint>& obstacles,
                           const int boardHeight,
                           std::uint64_t& lastSignature,
                           bool& hasLastSignature,
-                          int& dynamicConfidenceTicks) -> SpawnProfile {
+                          int& dynamicConfidenceTicks,
+                          SpawnAnalysisCache& cache) -> SpawnProfile {
   if (obstacles.isEmpty()) {
     hasLastSignature = false;
     lastSignature = 0;
@@ -518,7 +571,8 @@ auto classifySpawnProfile(const QList<QPoint>& obstacles,
     return SpawnProfile::NoObstacle;
   }
 
-  const auto signature = obstacleSignature(obstacles, boardWidth, boardHeight);
+  const auto signature =
+    obstacleSignature(obstacles, boardWidth, boardHeight, cache.pointScratch());
   if (hasLastSignature && signature != lastSignature) {
     dynamicConfidenceTicks = std::min(dynamicConfidenceTicks + 8, 64);
   } else {
@@ -531,18 +585,21 @@ auto classifySpawnProfile(const QList<QPoint>& obstacles,
     return SpawnProfile::DynamicObstacle;
   }
   if (obstacles.size() >= 12) {
-    std::vector<bool> usedX(static_cast<std::size_t>(boardWidth), false);
-    std::vector<bool> usedY(static_cast<std::size_t>(boardHeight), false);
+    // One flag per column followed by one per row.
+    auto& used = cache.axisScratch();
+    used.assign(static_cast<std::size_t>(boardWidth + boardHeight), 0);
     int uniqueX = 0;
     int uniqueY = 0;
     for (const QPoint& obstacle : obstacles) {
       const QPoint wrapped = wrapPoint(obstacle, boardWidth, boardHeight);
-      if (!usedX[static_cast<std::size_t>(wrapped.x())]) {
-        usedX[static_cast<std::size_t>(wrapped.x())] = true;
+      const auto column = static_cast<std::size_t>(wrapped.x());
+      const auto row = static_cast<std::size_t>(boardWidth + wrapped.y());
+      if (used[column] == 0) {
+        used[column] = 1;
         ++uniqueX;
       }
-      if (!usedY[static_cast<std::size_t>(wrapped.y())]) {
-        usedY[static_cast<std::size_t>(wrapped.y())] = true;
+      if (used[row] == 0) {
+        used[row] = 1;
         ++uniqueY;
       }
     }
@@ -552,64 +609,6 @@ auto classifySpawnProfile(const QList<QPoint>& obstacles,
   }
   return SpawnProfile::StaticObstacle;
 }
-
-auto signedToroidalDelta(const int from, const int to, const int size) -> int {
-  int delta = (to - from) % size;
-  if (delta < -size / 2) {
-    delta += size;
-  } else if (delta > size / 2) {
-    delta -= size;
-  }
-  return delta;
-}
-
-auto buildPredictedObstacleRisk(const int boardWidth,
-                                const int boardHeight,
-                                const QList<QPoint>& previousObstacles,
-                                const QList<QPoint>& currentObstacles,
-                                const int horizonTicks) -> std::vector<int> {
-  std::vector<int> risk(static_cast<std::size_t>(boardWidth * boardHeight), 0);
-  if (horizonTicks <= 0 || previousObstacles.isEmpty() || currentObstacles.isEmpty()) {
-    return risk;
-  }
-
-  std::vector<bool> prevUsed(static_cast<std::size_t>(previousObstacles.size()), false);
-  for (const QPoint& current : currentObstacles) {
-    int bestPrevIndex = -1;
-    int bestDistance = std::numeric_limits<int>::max();
-    for (int i = 0; i < previousObstacles.size(); ++i) {
-      if (prevUsed[static_cast<std::size_t>(i)]) {
-        continue;
-      }
-      const int distance = toroidalDistance(current, previousObstacles[i], boardWidth, boardHeight);
-      if (distance < bestDistance) {
-        bestDistance = distance;
-        bestPrevIndex = i;
-      }
-    }
-    if (bestPrevIndex < 0 || bestDistance > 3) {
-      continue;
-    }
-    prevUsed[static_cast<std::size_t>(bestPrevIndex)] = true;
-    const QPoint previous = previousObstacles[bestPrevIndex];
-    const int dx = signedToroidalDelta(previous.x(), current.x(), boardWidth);
-    const int dy = signedToroidalDelta(previous.y(), current.y(), boardHeight);
-    if (dx == 0 && dy == 0) {
-      continue;
-    }
-
-    for (int t = 1; t <= horizonTicks; ++t) {
-      const QPoint projected =
-        wrapPoint(QPoint(current.x() + (dx * t), current.y() + (dy * t)), boardWidth, boardHeight);
-      const auto index = tryBoardIndex(projected, boardWidth, boardHeight);
-      if (!index.has_value()) {
-        continue;
-      }
-      risk[static_cast<std::size_t>(*index)] += (horizonTicks - t + 1) * 8;
-    }
-  }
-  return risk;
-}
 } // namespace
 
 auto MetaAction::resetTransientRuntime() -> MetaAction {
@@ -715,6 +714,7 @@ auto SessionCore::computeScoutHintCell() const -> QPoint {
     return QPoint(-1, -1);
   }
 
+  syncOccupancy();
   const QPoint head = headPosition();
   const std::array<QPoint, 4> candidates{
     m_state.direction,
@@ -731,7 +731,7 @@ auto SessionCore::computeScoutHintCell() const -> QPoint {
                                                  m_boardWidth,
                                                  m_boardHeight,
                                                  m_state.obstacles,
-                                                 m_body,
+                                                 m_occupancy,
                                                  false,
                                                  false,
                                                  false,
@@ -748,7 +748,7 @@ auto SessionCore::computeScoutHintCell() const -> QPoint {
                                                         m_boardWidth,
                                                         m_boardHeight,
                                                         m_state.obstacles,
-                                                        m_body,
+                                                        m_occupancy,
                                                         false,
                                                         false,
                                                         false,
@@ -817,31 +817,24 @@ void SessionCore::applyVacuumBurst() {
 void SessionCore::resetStallGuard() {
   m_stallNoScoreTicks = 0;
   m_stallLastScore = m_state.score;
-  m_stallRecentHashes.clear();
-  m_stallHashCounts.clear();
+  m_stallHashes.clear();
 }
 
 auto SessionCore::stallStateHash() const -> std::uint64_t {
-  std::uint64_t hash = 1469598103934665603ULL;
-  hash = mixHash(hash, static_cast<std::uint64_t>(headPosition().x() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(headPosition().y() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(m_state.direction.x() + 16));
-  hash = mixHash(hash, static_cast<std::uint64_t>(m_state.direction.y() + 16));
-  hash = mixHash(hash, static_cast<std::uint64_t>(m_state.food.x() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(m_state.food.y() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(m_state.powerUpPos.x() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(m_state.powerUpPos.y() + 1024));
-  hash = mixHash(hash, static_cast<std::uint64_t>(m_state.powerUpType + 32));
-  hash = mixHash(hash, static_cast<std::uint64_t>(m_body.size()));
-  for (const QPoint& segment : m_body) {
-    hash = mixHash(hash, static_cast<std::uint64_t>(segment.x() + 1024));
-    hash = mixHash(hash, static_cast<std::uint64_t>(segment.y() + 1024));
-  }
-  return hash;
+  return loopStateHash({
+    .bodyHash = m_bodyHash,
+    .bodyLength = m_body.size(),
+    .head = headPosition(),
+    .tail = m_body.empty() ? QPoint() : m_body.back(),
+    .direction = m_state.direction,
+    .food = m_state.food,
+    .powerUpPos = m_state.powerUpPos,
+    .powerUpType = m_state.powerUpType,
+  });
 }
 
 auto SessionCore::observeStallStateAndMaybeResetTarget(const SessionAdvanceConfig& config,
-                                                       const std::function<int(int)>& randomBounded,
+                                                       const RandomBounded randomBounded,
                                                        SessionAdvanceResult& result) -> bool {
   if (!config.consumeInputQueue || m_body.empty() || m_state.score != m_stallLastScore) {
     resetStallGuard();
@@ -849,21 +842,7 @@ auto SessionCore::observeStallStateAndMaybeResetTarget(const SessionAdvanceConfi
   }
 
   ++m_stallNoScoreTicks;
-  const std::uint64_t hash = stallStateHash();
-  const int repeats = ++m_stallHashCounts[hash];
-  m_stallRecentHashes.push_back(hash);
-  while (static_cast<int>(m_stallRecentHashes.size()) > StallHashWindow) {
-    const std::uint64_t dropped = m_stallRecentHashes.front();
-    m_stallRecentHashes.pop_front();
-    auto it = m_stallHashCounts.find(dropped);
-    if (it == m_stallHashCounts.end()) {
-      continue;
-    }
-    --it->second;
-    if (it->second <= 0) {
-      m_stallHashCounts.erase(it);
-    }
-  }
+  const int repeats = m_stallHashes.observe(stallStateHash());
 
   if (m_stallNoScoreTicks < StallNoScoreTicksThreshold || repeats < StallRepeatThreshold) {
     return false;
@@ -892,7 +871,7 @@ auto SessionCore::observeStallStateAndMaybeResetTarget(const SessionAdvanceConfi
 
 auto SessionCore::enqueueDirection(const QPoint& direction, const std::size_t maxQueueSize)
   -> bool {
-  if (m_inputQueue.size() >= maxQueueSize) {
+  if (m_inputQueue.size() >= std::min(maxQueueSize, DirectionQueue::capacity())) {
     return false;
   }
 
@@ -920,33 +899,78 @@ void SessionCore::clearQueuedInput() {
   m_inputQueue.clear();
 }
 
-void SessionCore::setBody(const std::deque<QPoint>& body) {
+void SessionCore::setBody(const SnakeBody& body) {
   m_body = body;
+  rebuildBodyTracking();
 }
 
 void SessionCore::applyMovement(const QPoint& newHead, const bool grew) {
+  const bool tracked = occupancyTracksBoard(m_boardWidth, m_boardHeight);
   m_body.push_front(newHead);
+  m_bodyHash ^= zobristCellKey(newHead);
+  if (tracked) {
+    m_occupancy.addBody(newHead);
+  }
   if (!grew && !m_body.empty()) {
+    if (tracked) {
+      m_occupancy.removeBody(m_body.back());
+    }
+    m_bodyHash ^= zobristCellKey(m_body.back());
     m_body.pop_back();
   }
 }
 
+void SessionCore::retractMovement(const QPoint& tail, const bool grew) {
+  if (m_body.empty()) {
+    return;
+  }
+  const bool tracked = occupancyTracksBoard(m_boardWidth, m_boardHeight);
+  const QPoint head = m_body.front();
+  if (tracked) {
+    m_occupancy.removeBody(head);
+  }
+  m_bodyHash ^= zobristCellKey(head);
+  m_body.pop_front();
+  if (!grew) {
+    m_body.push_back(tail);
+    m_bodyHash ^= zobristCellKey(tail);
+    if (tracked) {
+      m_occupancy.addBody(tail);
+    }
+  }
+}
+
 auto SessionCore::checkCollision(const QPoint& head, const int boardWidth, const int boardHeight)
   -> CollisionOutcome {
-  const auto outcome =
-    collisionOutcomeForHead(head,
-                            boardWidth,
-                            boardHeight,
-                            m_state.obstacles,
-                            m_body,
-                            m_state.activeBuff == static_cast<int>(BuffId::Ghost),
-                            m_state.activeBuff == static_cast<int>(BuffId::Portal),
-                            m_state.activeBuff == static_cast<int>(BuffId::Laser),
-                            m_state.shieldActive);
+  const bool ghostActive = m_state.activeBuff == static_cast<int>(BuffId::Ghost);
+  const bool portalActive = m_state.activeBuff == static_cast<int>(BuffId::Portal);
+  const bool laserActive = m_state.activeBuff == static_cast<int>(BuffId::Laser);
+  syncOccupancy();
+  const bool tracked = occupancyTracksBoard(boardWidth, boardHeight);
+  const auto outcome = tracked ? collisionOutcomeForHead(head,
+                                                         boardWidth,
+                                                         boardHeight,
+                                                         m_state.obstacles,
+                                                         m_occupancy,
+                                                         ghostActive,
+                                                         portalActive,
+                                                         laserActive,
+                                                         m_state.shieldActive)
+                               : collisionOutcomeForHead(head,
+                                                         boardWidth,
+                                                         boardHeight,
+                                                         m_state.obstacles,
+                                                         m_body,
+                                                         ghostActive,
+                                                         portalActive,
+                                                         laserActive,
+                                                         m_state.shieldActive);
 
   if (outcome.consumeLaser && outcome.obstacleIndex >= 0 &&
       outcome.obstacleIndex < m_state.obstacles.size()) {
+    m_occupancy.removeObstacle(m_state.obstacles.at(outcome.obstacleIndex));
     m_state.obstacles.removeAt(outcome.obstacleIndex);
+    m_occupancyObstacles = m_state.obstacles;
     m_state.activeBuff = static_cast<int>(BuffId::None);
   }
 
@@ -965,7 +989,7 @@ auto SessionCore::checkCollision(const QPoint& head, const int boardWidth, const
 auto SessionCore::consumeFood(const QPoint& head,
                               const int boardWidth,
                               const int boardHeight,
-                              const std::function<int(int)>& randomBounded)
+                              const RandomBounded randomBounded)
   -> FoodConsumptionResult {
   const auto result = planFoodConsumption(head, m_state, boardWidth, boardHeight, randomBounded);
   if (!result.ate) {
@@ -1025,9 +1049,9 @@ auto SessionCore::tickBuffCountdown() -> bool {
   return true;
 }
 
-auto SessionCore::spawnFood(const int boardWidth,
-                            const int boardHeight,
-                            const std::function<int(int)>& randomBounded) -> bool {
+template <typename Draw>
+auto SessionCore::spawnFoodFrom(const int boardWidth, const int boardHeight, Draw& randomBounded)
+  -> bool {
   QPoint pickedPoint;
   const std::optional<QPoint> tail = m_body.empty() ? std::nullopt : std::optional{m_body.back()};
   const SpawnProfile profile = classifySpawnProfile(m_state.obstacles,
@@ -1035,31 +1059,43 @@ auto SessionCore::spawnFood(const int boardWidth,
                                                     boardHeight,
                                                     m_lastObstacleSignature,
                                                     m_hasLastObstacleSignature,
-                                                    m_dynamicObstacleConfidenceTicks);
-  const bool found = pickSpawnPointWithSafety(
-    boardWidth,
-    boardHeight,
-    headPosition(),
-    tail,
-    m_state.obstacles,
-    m_prevObstacleSnapshot,
-    m_recentSpawnPoints,
-    profile,
-    [this](const QPoint& point) -> bool {
-      return isOccupied(point) || point == m_state.powerUpPos;
-    },
-    randomBounded,
-    pickedPoint);
+                                                    m_dynamicObstacleConfidenceTicks,
+                                                    m_spawnCache);
+  OccupancyGrid scratch;
+  const bool found = pickSpawnPointWithSafety(occupancyForBoard(boardWidth, boardHeight, scratch),
+                                              m_state.powerUpPos,
+                                              m_freeCellOrder,
+                                              headPosition(),
+                                              tail,
+                                              m_state.obstacles,
+                                              m_prevObstacleSnapshot,
+                                              m_recentSpawnPoints,
+                                              profile,
+                                              m_spawnCache,
+                                              randomBounded,
+                                              pickedPoint);
   if (found) {
     m_state.food = pickedPoint;
     rememberRecentSpawnPoint(m_recentSpawnPoints, pickedPoint);
+    ++m_rememberedSpawnCount;
   }
   return found;
 }
 
-auto SessionCore::spawnPowerUp(const int boardWidth,
-                               const int boardHeight,
-                               const std::function<int(int)>& randomBounded) -> bool {
+auto SessionCore::spawnFood(const int boardWidth,
+                            const int boardHeight,
+                            const RandomBounded randomBounded) -> bool {
+  return spawnFoodFrom(boardWidth, boardHeight, randomBounded);
+}
+
+auto SessionCore::spawnFood(const int boardWidth, const int boardHeight, CounterRng& rng) -> bool {
+  return spawnFoodFrom(boardWidth, boardHeight, rng);
+}
+
+template <typename Draw>
+auto SessionCore::spawnPowerUpFrom(const int boardWidth,
+                                   const int boardHeight,
+                                   Draw& randomBounded) -> bool {
   if (m_state.activeBuff != static_cast<int>(BuffId::None) || m_state.shieldActive) {
     return false;
   }
@@ -1070,28 +1106,42 @@ auto SessionCore::spawnPowerUp(const int boardWidth,
                                                     boardHeight,
                                                     m_lastObstacleSignature,
                                                     m_hasLastObstacleSignature,
-                                                    m_dynamicObstacleConfidenceTicks);
-  const bool found = pickSpawnPointWithSafety(
-    boardWidth,
-    boardHeight,
-    headPosition(),
-    tail,
-    m_state.obstacles,
-    m_prevObstacleSnapshot,
-    m_recentSpawnPoints,
-    profile,
-    [this](const QPoint& point) -> bool { return isOccupied(point) || point == m_state.food; },
-    randomBounded,
-    pickedPoint);
+                                                    m_dynamicObstacleConfidenceTicks,
+                                                    m_spawnCache);
+  OccupancyGrid scratch;
+  const bool found = pickSpawnPointWithSafety(occupancyForBoard(boardWidth, boardHeight, scratch),
+                                              m_state.food,
+                                              m_freeCellOrder,
+                                              headPosition(),
+                                              tail,
+                                              m_state.obstacles,
+                                              m_prevObstacleSnapshot,
+                                              m_recentSpawnPoints,
+                                              profile,
+                                              m_spawnCache,
+                                              randomBounded,
+                                              pickedPoint);
   if (found) {
     m_state.powerUpPos = pickedPoint;
     m_state.powerUpType = static_cast<int>(weightedRandomBuffId(randomBounded));
     m_state.powerUpTicksRemaining = PowerUpLifetimeTicks;
     rememberRecentSpawnPoint(m_recentSpawnPoints, pickedPoint);
+    ++m_rememberedSpawnCount;
   }
   return found;
 }
 
+auto SessionCore::spawnPowerUp(const int boardWidth,
+                               const int boardHeight,
+                               const RandomBounded randomBounded) -> bool {
+  return spawnPowerUpFrom(boardWidth, boardHeight, randomBounded);
+}
+
+auto SessionCore::spawnPowerUp(const int boardWidth, const int boardHeight, CounterRng& rng)
+  -> bool {
+  return spawnPowerUpFrom(boardWidth, boardHeight, rng);
+}
+
 auto SessionCore::applyMagnetAttraction(const int boardWidth, const int boardHeight)
   -> MagnetAttractionResult {
   if (m_state.activeBuff != static_cast<int>(BuffId::Magnet) || m_state.food == QPoint(-1, -1) ||
@@ -1145,6 +1195,34 @@ auto SessionCore::applyReplayTimeline(const QList<ReplayFrame>& inputFrames,
   return result;
 }
 
+auto SessionCore::applyReplayInput(const QList<ReplayFrame>& inputFrames, int& inputHistoryIndex)
+  -> bool {
+  while (inputHistoryIndex < inputFrames.size() &&
+         inputFrames[inputHistoryIndex].frame < m_state.tickCounter) {
+    inputHistoryIndex++;
+  }
+  if (inputHistoryIndex >= inputFrames.size() ||
+      inputFrames[inputHistoryIndex].frame != m_state.tickCounter) {
+    return false;
+  }
+  const auto& frame = inputFrames[inputHistoryIndex++];
+  setDirection(QPoint(frame.dx, frame.dy));
+  return true;
+}
+
+auto SessionCore::takeReplayChoice(const QList<ChoiceRecord>& choiceFrames,
+                                   int& choiceHistoryIndex) -> std::optional<int> {
+  while (choiceHistoryIndex < choiceFrames.size() &&
+         choiceFrames[choiceHistoryIndex].frame < m_state.tickCounter) {
+    choiceHistoryIndex++;
+  }
+  if (choiceHistoryIndex >= choiceFrames.size() ||
+      choiceFrames[choiceHistoryIndex].frame != m_state.tickCounter) {
+    return std::nullopt;
+  }
+  return choiceFrames[choiceHistoryIndex++].index;
+}
+
 auto SessionCore::beginRuntimeUpdate() -> RuntimeUpdateResult {
   return {
     .buffExpired = tickBuffCountdown(),
@@ -1156,7 +1234,7 @@ void SessionCore::finishRuntimeUpdate() {
   incrementTick();
 }
 
-auto SessionCore::tick(const TickCommand& command, const std::function<int(int)>& randomBounded)
+auto SessionCore::tick(const TickCommand& command, const RandomBounded randomBounded)
   -> TickResult {
   TickResult result;
 
@@ -1205,7 +1283,7 @@ void SessionCore::applyMetaAction(const MetaAction& action) {
 }
 
 auto SessionCore::advanceSessionStep(const SessionAdvanceConfig& config,
-                                     const std::function<int(int)>& randomBounded)
+                                     const RandomBounded randomBounded)
   -> SessionAdvanceResult {
   SessionAdvanceResult result;
   m_boardWidth = config.boardWidth;
@@ -1298,12 +1376,14 @@ void SessionCore::bootstrapForLevel(QList<QPoint> obstacles,
   m_recentSpawnPoints.clear();
   m_boardWidth = boardWidth;
   m_boardHeight = boardHeight;
+  rebuildBodyTracking();
   resetStallGuard();
 }
 
 void SessionCore::restorePersistedSession(const StateSnapshot& snapshot) {
   m_state = snapshot.state;
   m_body = snapshot.body;
+  rebuildBodyTracking();
   m_inputQueue.clear();
 
   const QPoint persistedDirection = m_state.direction;
@@ -1345,6 +1425,7 @@ void SessionCore::seedPreviewState(const PreviewSeed& seed) {
   m_state.anchorTickIntervalMs = seed.anchorTickIntervalMs;
   m_state.lastRoguelikeChoiceScore = -1000;
   m_body = seed.body;
+  rebuildBodyTracking();
   m_inputQueue.clear();
   m_hasLastObstacleSignature = false;
   m_lastObstacleSignature = 0;
@@ -1385,7 +1466,7 @@ void SessionCore::resetReplayRuntimeState() {
   m_state.lastRoguelikeChoiceScore = -1000;
 }
 
-auto SessionCore::snapshot(const std::deque<QPoint>& body) const -> StateSnapshot {
+auto SessionCore::snapshot(const SnakeBody& body) const -> StateSnapshot {
   return {
     .state = m_state,
     .body = body.empty() ? m_body : body,
@@ -1395,6 +1476,7 @@ auto SessionCore::snapshot(const std::deque<QPoint>& body) const -> StateSnapsho
 void SessionCore::restoreSnapshot(const StateSnapshot& snapshot) {
   m_state = snapshot.state;
   m_body = snapshot.body;
+  rebuildBodyTracking();
   m_inputQueue.clear();
   m_hasLastObstacleSignature = false;
   m_lastObstacleSignature = 0;
@@ -1407,6 +1489,76 @@ void SessionCore::restoreSnapshot(const StateSnapshot& snapshot) {
   resetStallGuard();
 }
 
+auto SessionCore::captureKeyframe() const -> SessionKeyframe {
+  SessionKeyframe keyframe{
+    .snapshot = snapshot({}),
+    .stallNoScoreTicks = m_stallNoScoreTicks,
+    .stallLastScore = m_stallLastScore,
+    .lastObstacleSignature = m_lastObstacleSignature,
+    .hasLastObstacleSignature = m_hasLastObstacleSignature,
+    .dynamicObstacleConfidenceTicks = m_dynamicObstacleConfidenceTicks,
+    .prevObstacleSnapshot = m_prevObstacleSnapshot,
+    .currObstacleSnapshot = m_currObstacleSnapshot,
+    .hasObstacleSnapshots = m_hasObstacleSnapshots,
+  };
+  keyframe.stallHashes.reserve(static_cast<std::size_t>(m_stallHashes.size()));
+  for (int i = 0; i < m_stallHashes.size(); ++i) {
+    keyframe.stallHashes.push_back(m_stallHashes.at(i));
+  }
+  keyframe.recentSpawnPoints.reserve(static_cast<qsizetype>(m_recentSpawnPoints.size()));
+  for (const QPoint& point : m_recentSpawnPoints) {
+    keyframe.recentSpawnPoints.push_back(point);
+  }
+  return keyframe;
+}
+
+void SessionCore::restoreKeyframe(const SessionKeyframe& keyframe) {
+  m_state = keyframe.snapshot.state;
+  m_body = keyframe.snapshot.body;
+  rebuildBodyTracking();
+  m_inputQueue.clear();
+  m_stallNoScoreTicks = keyframe.stallNoScoreTicks;
+  m_stallLastScore = keyframe.stallLastScore;
+  m_stallHashes.clear();
+  for (const std::uint64_t hash : keyframe.stallHashes) {
+    m_stallHashes.observe(hash);
+  }
+  m_lastObstacleSignature = keyframe.lastObstacleSignature;
+  m_hasLastObstacleSignature = keyframe.hasLastObstacleSignature;
+  m_dynamicObstacleConfidenceTicks = keyframe.dynamicObstacleConfidenceTicks;
+  m_prevObstacleSnapshot = keyframe.prevObstacleSnapshot;
+  m_currObstacleSnapshot = keyframe.currObstacleSnapshot;
+  m_hasObstacleSnapshots = keyframe.hasObstacleSnapshots;
+  m_recentSpawnPoints.clear();
+  for (const QPoint& point : keyframe.recentSpawnPoints) {
+    rememberRecentSpawnPoint(m_recentSpawnPoints, point);
+  }
+}
+
+auto SessionCore::bookkeeping() const -> SessionBookkeeping {
+  return {
+    .stallNoScoreTicks = m_stallNoScoreTicks,
+    .stallLastScore = m_stallLastScore,
+    .lastObstacleSignature = m_lastObstacleSignature,
+    .hasLastObstacleSignature = m_hasLastObstacleSignature,
+    .dynamicObstacleConfidenceTicks = m_dynamicObstacleConfidenceTicks,
+    .prevObstacleSnapshot = m_prevObstacleSnapshot,
+    .currObstacleSnapshot = m_currObstacleSnapshot,
+    .hasObstacleSnapshots = m_hasObstacleSnapshots,
+  };
+}
+
+void SessionCore::restoreBookkeeping(const SessionBookkeeping& bookkeeping) {
+  m_stallNoScoreTicks = bookkeeping.stallNoScoreTicks;
+  m_stallLastScore = bookkeeping.stallLastScore;
+  m_lastObstacleSignature = bookkeeping.lastObstacleSignature;
+  m_hasLastObstacleSignature = bookkeeping.hasLastObstacleSignature;
+  m_dynamicObstacleConfidenceTicks = bookkeeping.dynamicObstacleConfidenceTicks;
+  m_prevObstacleSnapshot = bookkeeping.prevObstacleSnapshot;
+  m_currObstacleSnapshot = bookkeeping.currObstacleSnapshot;
+  m_hasObstacleSnapshots = bookkeeping.hasObstacleSnapshots;
+}
+
 void SessionCore::applyPowerUpResult(const PowerUpConsumptionResult& result) {
   const int currentInterval = currentTickIntervalMs();
   if (result.shieldActivated) {
@@ -1414,6 +1566,7 @@ void SessionCore::applyPowerUpResult(const PowerUpConsumptionResult& result) {
   }
   if (result.miniApplied) {
     m_body = applyMiniShrink(m_body, 3);
+    rebuildBodyTracking();
   }
   if (result.vacuumApplied) {
     applyVacuumBurst();
@@ -1446,6 +1599,13 @@ auto SessionCore::tickPowerUpCountdown() -> bool {
 }
 
 auto SessionCore::isOccupied(const QPoint& point) const -> bool {
+  syncOccupancy();
+  if (m_occupancy.contains(point)) {
+    return m_occupancy.isOccupied(point);
+  }
+  if (m_occupancy.outsideCount() == 0) {
+    return false;
+  }
   const bool inSnake =
     std::ranges::any_of(m_body, [&point](const QPoint& bodyPoint) { return bodyPoint == point; });
   if (inSnake) {
@@ -1455,4 +1615,67 @@ auto SessionCore::isOccupied(const QPoint& point) const -> bool {
     m_state.obstacles, [&point](const QPoint& obstaclePoint) { return obstaclePoint == point; });
 }
 
+auto SessionCore::occupancyTracksBoard(const int boardWidth, const int boardHeight) const -> bool {
+  return m_occupancy.width() == boardWidth && m_occupancy.height() == boardHeight;
+}
+
+void SessionCore::syncOccupancy() const {
+  if (!occupancyTracksBoard(m_boardWidth, m_boardHeight)) {
+    m_occupancy.resize(m_boardWidth, m_boardHeight);
+    for (const QPoint& segment : m_body) {
+      m_occupancy.addBody(segment);
+    }
+    for (const QPoint& obstacle : m_state.obstacles) {
+      m_occupancy.addObstacle(obstacle);
+    }
+    m_occupancyObstacles = m_state.obstacles;
+    return;
+  }
+  // Level scripts and restores replace the obstacle list wholesale; any write detaches it from
+  // the mirror, so a shared buffer means the bits are still current.
+  if (m_state.obstacles.isSharedWith(m_occupancyObstacles)) {
+    return;
+  }
+  for (const QPoint& obstacle : std::as_const(m_occupancyObstacles)) {
+    m_occupancy.removeObstacle(obstacle);
+  }
+  for (const QPoint& obstacle : m_state.obstacles) {
+    m_occupancy.addObstacle(obstacle);
+  }
+  m_occupancyObstacles = m_state.obstacles;
+}
+
+auto SessionCore::occupancyForBoard(const int boardWidth,
+                                    const int boardHeight,
+                                    OccupancyGrid& scratch) const -> const OccupancyGrid& {
+  syncOccupancy();
+  if (occupancyTracksBoard(boardWidth, boardHeight)) {
+    return m_occupancy;
+  }
+  scratch.resize(boardWidth, boardHeight);
+  for (const QPoint& segment : m_body) {
+    scratch.addBody(segment);
+  }
+  for (const QPoint& obstacle : m_state.obstacles) {
+    scratch.addObstacle(obstacle);
+  }
+  return scratch;
+}
+
+void SessionCore::rebuildBodyTracking() {
+  // A ring sized to the board keeps later head pushes allocation-free.
+  if (m_boardWidth > 0 && m_boardHeight > 0) {
+    m_body.reserve(static_cast<std::size_t>(m_boardWidth) *
+                   static_cast<std::size_t>(m_boardHeight));
+  }
+  m_bodyHash = zobristBodyHash(m_body);
+  if (!occupancyTracksBoard(m_boardWidth, m_boardHeight)) {
+    return;
+  }
+  m_occupancy.clearBody();
+  for (const QPoint& segment : m_body) {
+    m_occupancy.addBody(segment);
+  }
+}
+
 } // namespace nenoserpent::core
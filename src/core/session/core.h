@@ -2,24 +2,33 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <optional>
-#include <unordered_map>
 
 #include <QList>
 #include <QPoint>
 
+#include "core/game/body.h"
+#include "core/game/fixed_ring.h"
+#include "core/game/hash_window.h"
+#include "core/game/occupancy.h"
 #include "core/game/rules.h"
+#include "core/game/zobrist.h"
 #include "core/replay/types.h"
 #include "core/session/runtime.h"
 #include "core/session/snapshot.h"
+#include "core/session/spawn_cache.h"
 #include "core/session/step_types.h"
 
 namespace nenoserpent::core {
 
+// Queued turns; enqueueDirection caps maxQueueSize at this capacity.
+using DirectionQueue = FixedRing<QPoint, 8>;
+// Last spawn cells, penalised by the spawn scorer; the oldest is dropped once full.
+using RecentSpawnPoints = FixedRing<QPoint, 18>;
+
 struct PreviewSeed {
   QList<QPoint> obstacles;
-  std::deque<QPoint> body;
+  SnakeBody body;
   QPoint food = {0, 0};
   QPoint direction = {0, -1};
   QPoint powerUpPos = {-1, -1};
@@ -95,17 +104,14 @@ public:
   [[nodiscard]] auto state() const -> const SessionState& {
     return m_state;
   }
-  [[nodiscard]] auto body() -> std::deque<QPoint>& {
-    return m_body;
-  }
-  [[nodiscard]] auto body() const -> const std::deque<QPoint>& {
+  [[nodiscard]] auto body() const -> const SnakeBody& {
     return m_body;
   }
 
-  [[nodiscard]] auto inputQueue() -> std::deque<QPoint>& {
+  [[nodiscard]] auto inputQueue() -> DirectionQueue& {
     return m_inputQueue;
   }
-  [[nodiscard]] auto inputQueue() const -> const std::deque<QPoint>& {
+  [[nodiscard]] auto inputQueue() const -> const DirectionQueue& {
     return m_inputQueue;
   }
 
@@ -115,37 +121,57 @@ public:
   [[nodiscard]] auto tickCounter() const -> int;
   [[nodiscard]] auto currentTickIntervalMs() const -> int;
   [[nodiscard]] auto headPosition() const -> QPoint;
+  // Zobrist signature of the body cells (see zobristBodyHash), kept current on every move.
+  [[nodiscard]] auto bodyHash() const -> std::uint64_t {
+    return m_bodyHash;
+  }
 
   auto enqueueDirection(const QPoint& direction, std::size_t maxQueueSize = 2) -> bool;
   auto consumeQueuedInput(QPoint& nextInput) -> bool;
   void clearQueuedInput();
-  void setBody(const std::deque<QPoint>& body);
+  void setBody(const SnakeBody& body);
+  // Scan (the default) keeps spawn RNG draws identical to recorded replays; Dense is only for
+  // sessions that are never persisted or replayed.
+  void setFreeCellOrder(FreeCellOrder order) {
+    m_freeCellOrder = order;
+  }
+  [[nodiscard]] auto freeCellOrder() const -> FreeCellOrder {
+    return m_freeCellOrder;
+  }
   void applyMovement(const QPoint& newHead, bool grew);
+  // Exact inverse of applyMovement: drops the head and, unless the move grew, puts `tail` back.
+  void retractMovement(const QPoint& tail, bool grew);
   auto checkCollision(const QPoint& head, int boardWidth, int boardHeight) -> CollisionOutcome;
   auto consumeFood(const QPoint& head,
                    int boardWidth,
                    int boardHeight,
-                   const std::function<int(int)>& randomBounded) -> FoodConsumptionResult;
+                   RandomBounded randomBounded) -> FoodConsumptionResult;
   auto consumePowerUp(const QPoint& head, int baseDurationTicks, bool halfDurationForRich)
     -> PowerUpConsumptionResult;
   auto applyChoiceSelection(int powerUpType, int baseDurationTicks, bool halfDurationForRich)
     -> PowerUpConsumptionResult;
   auto selectChoice(int powerUpType, int baseDurationTicks, bool halfDurationForRich)
     -> PowerUpConsumptionResult;
-  auto spawnFood(int boardWidth, int boardHeight, const std::function<int(int)>& randomBounded)
-    -> bool;
-  auto spawnPowerUp(int boardWidth, int boardHeight, const std::function<int(int)>& randomBounded)
-    -> bool;
+  auto spawnFood(int boardWidth, int boardHeight, RandomBounded randomBounded) -> bool;
+  auto spawnPowerUp(int boardWidth, int boardHeight, RandomBounded randomBounded) -> bool;
+  // Same spawns drawing straight from a batch generator, without the RandomBounded indirection.
+  auto spawnFood(int boardWidth, int boardHeight, CounterRng& rng) -> bool;
+  auto spawnPowerUp(int boardWidth, int boardHeight, CounterRng& rng) -> bool;
   auto applyMagnetAttraction(int boardWidth, int boardHeight) -> MagnetAttractionResult;
   auto applyReplayTimeline(const QList<ReplayFrame>& inputFrames,
                            int& inputHistoryIndex,
                            const QList<ChoiceRecord>& choiceFrames,
                            int& choiceHistoryIndex) -> ReplayTimelineApplication;
+  // Tick-by-tick replay, as runSessionTick drives it: the next recorded turn when it belongs to
+  // this tick (a live step consumes at most one), and the choice recorded at this tick.
+  auto applyReplayInput(const QList<ReplayFrame>& inputFrames, int& inputHistoryIndex) -> bool;
+  auto takeReplayChoice(const QList<ChoiceRecord>& choiceFrames, int& choiceHistoryIndex)
+    -> std::optional<int>;
   auto beginRuntimeUpdate() -> RuntimeUpdateResult;
   void finishRuntimeUpdate();
-  auto tick(const TickCommand& command, const std::function<int(int)>& randomBounded) -> TickResult;
-  auto advanceSessionStep(const SessionAdvanceConfig& config,
-                          const std::function<int(int)>& randomBounded) -> SessionAdvanceResult;
+  auto tick(const TickCommand& command, RandomBounded randomBounded) -> TickResult;
+  auto advanceSessionStep(const SessionAdvanceConfig& config, RandomBounded randomBounded)
+    -> SessionAdvanceResult;
   void applyMetaAction(const MetaAction& action);
   void bootstrapForLevel(QList<QPoint> obstacles, int boardWidth, int boardHeight);
   void restorePersistedSession(const StateSnapshot& snapshot);
@@ -154,10 +180,28 @@ public:
   void resetTransientRuntimeState();
   void resetReplayRuntimeState();
 
-  [[nodiscard]] auto snapshot(const std::deque<QPoint>& body) const -> StateSnapshot;
+  [[nodiscard]] auto snapshot(const SnakeBody& body) const -> StateSnapshot;
   void restoreSnapshot(const StateSnapshot& snapshot);
+  [[nodiscard]] auto captureKeyframe() const -> SessionKeyframe;
+  // Board size and free-cell order are kept; they belong to the session, not the keyframe.
+  void restoreKeyframe(const SessionKeyframe& keyframe);
+  [[nodiscard]] auto bookkeeping() const -> SessionBookkeeping;
+  void restoreBookkeeping(const SessionBookkeeping& bookkeeping);
+  [[nodiscard]] auto stallHashes() const -> const HashWindow& {
+    return m_stallHashes;
+  }
+  [[nodiscard]] auto recentSpawnPoints() const -> const RecentSpawnPoints& {
+    return m_recentSpawnPoints;
+  }
+  // Spawn cells remembered over the core's lifetime; the difference across a tick is how many
+  // of recentSpawnPoints() it added.
+  [[nodiscard]] auto rememberedSpawnCount() const -> std::uint64_t {
+    return m_rememberedSpawnCount;
+  }
 
 private:
+  static constexpr int StallHashWindow = 128;
+
   void incrementTick();
   auto tickBuffCountdown() -> bool;
   auto tickPowerUpCountdown() -> bool;
@@ -165,29 +209,46 @@ private:
   void refreshScoutHint();
   void applyVacuumBurst();
   [[nodiscard]] auto isOccupied(const QPoint& point) const -> bool;
+  [[nodiscard]] auto occupancyTracksBoard(int boardWidth, int boardHeight) const -> bool;
+  void syncOccupancy() const;
+  [[nodiscard]] auto occupancyForBoard(int boardWidth,
+                                       int boardHeight,
+                                       OccupancyGrid& scratch) const -> const OccupancyGrid&;
+  void rebuildBodyTracking();
   void applyPowerUpResult(const PowerUpConsumptionResult& result);
+  template <typename Draw>
+  auto spawnFoodFrom(int boardWidth, int boardHeight, Draw& randomBounded) -> bool;
+  template <typename Draw>
+  auto spawnPowerUpFrom(int boardWidth, int boardHeight, Draw& randomBounded) -> bool;
   void resetStallGuard();
   [[nodiscard]] auto stallStateHash() const -> std::uint64_t;
   auto observeStallStateAndMaybeResetTarget(const SessionAdvanceConfig& config,
-                                            const std::function<int(int)>& randomBounded,
+                                            RandomBounded randomBounded,
                                             SessionAdvanceResult& result) -> bool;
 
   SessionState m_state;
-  std::deque<QPoint> m_body;
-  std::deque<QPoint> m_inputQueue;
+  SnakeBody m_body;
+  DirectionQueue m_inputQueue;
   int m_stallNoScoreTicks = 0;
   int m_stallLastScore = 0;
-  std::deque<std::uint64_t> m_stallRecentHashes;
-  std::unordered_map<std::uint64_t, int> m_stallHashCounts;
+  HashWindow m_stallHashes{StallHashWindow};
   std::uint64_t m_lastObstacleSignature = 0;
   bool m_hasLastObstacleSignature = false;
   int m_dynamicObstacleConfidenceTicks = 0;
   QList<QPoint> m_prevObstacleSnapshot;
   QList<QPoint> m_currObstacleSnapshot;
   bool m_hasObstacleSnapshots = false;
-  std::deque<QPoint> m_recentSpawnPoints;
+  RecentSpawnPoints m_recentSpawnPoints;
+  std::uint64_t m_rememberedSpawnCount = 0;
+  SpawnAnalysisCache m_spawnCache;
   int m_boardWidth = 20;
   int m_boardHeight = 18;
+  // Body bits follow every body write; obstacle bits are resynced lazily whenever
+  // m_state.obstacles stops sharing storage with the mirror (i.e. after any external edit).
+  std::uint64_t m_bodyHash = 0;
+  mutable OccupancyGrid m_occupancy;
+  mutable QList<QPoint> m_occupancyObstacles;
+  FreeCellOrder m_freeCellOrder = FreeCellOrder::Scan;
 };
 
 } // namespace nenoserpent::core
@@ -1,23 +1,33 @@
 #include "core/session/runner.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "core/buff/runtime.h"
+#include "core/replay/checksum.h"
+#include "core/session/tick_driver.h"
+
 namespace nenoserpent::core {
 
 namespace {
-constexpr int ChoiceBuffDurationTicks = 80;
+// Recording and input logs are reserved up front so ordinary sessions never grow them mid-tick.
+constexpr qsizetype ReservedLogTicks = 4096;
 } // namespace
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
 SessionRunner::SessionRunner(const int boardWidth, const int boardHeight)
-    : m_boardWidth(boardWidth),
-      m_boardHeight(boardHeight) {
+    : m_boardWidth(clampBoardSide(boardWidth)),
+      m_boardHeight(clampBoardSide(boardHeight)) {
 }
 
 void SessionRunner::startSession(QList<QPoint> obstacles, const uint randomSeed) {
   resetRuntimeState();
   m_randomSeed = randomSeed;
-  m_rng.seed(randomSeed);
+  m_rng.reseed(randomSeed);
+  m_rngDraws = 0;
+  if (m_obstacleSchedule.has_value()) {
+    obstacles = m_obstacleSchedule->obstaclesAt(0);
+  }
   m_core.applyMetaAction(
     MetaAction::bootstrapForLevel(std::move(obstacles), m_boardWidth, m_boardHeight));
   m_core.spawnFood(
@@ -28,9 +38,15 @@ void SessionRunner::startSession(QList<QPoint> obstacles, const uint randomSeed)
 void SessionRunner::startReplay(QList<QPoint> obstacles,
                                 const uint randomSeed,
                                 QList<ReplayFrame> inputHistory,
-                                QList<ChoiceRecord> choiceHistory) {
+                                QList<ChoiceRecord> choiceHistory,
+                                QList<ChecksumRecord> checksumHistory,
+                                QList<ReplayKeyframe> keyframes) {
+  QList<QPoint> initialObstacles = obstacles;
   startSession(std::move(obstacles), randomSeed);
   setReplayTimeline(std::move(inputHistory), std::move(choiceHistory));
+  m_replayChecksumHistory = std::move(checksumHistory);
+  m_replayKeyframes = std::move(keyframes);
+  m_replayObstacles = std::move(initialObstacles);
   m_mode = SessionMode::Replaying;
 }
 
@@ -39,7 +55,8 @@ void SessionRunner::seedPreviewState(const PreviewSeed& seed,
                                      const uint randomSeed) {
   resetRuntimeState();
   m_randomSeed = randomSeed;
-  m_rng.seed(randomSeed);
+  m_rng.reseed(randomSeed);
+  m_rngDraws = 0;
   m_core.applyMetaAction(MetaAction::seedPreviewState(seed));
   m_mode = mode;
 }
@@ -52,6 +69,65 @@ void SessionRunner::setReplayTimeline(QList<ReplayFrame> inputHistory,
   m_replayChoiceHistoryIndex = 0;
 }
 
+void SessionRunner::setChecksumInterval(const int ticks) {
+  m_checksumIntervalTicks = std::max(0, ticks);
+}
+
+void SessionRunner::setKeyframeInterval(const int ticks) {
+  m_keyframeIntervalTicks = std::max(0, ticks);
+}
+
+void SessionRunner::setObstacleSchedule(std::optional<ObstacleSchedule> schedule) {
+  m_obstacleSchedule = std::move(schedule);
+}
+
+auto SessionRunner::seekToTick(const int targetTick) -> bool {
+  if (m_mode != SessionMode::Replaying && m_mode != SessionMode::ReplayFinished) {
+    return false;
+  }
+  const int current = m_core.tickCounter();
+  const qsizetype keyframe = keyframeIndexAtOrBefore(m_replayKeyframes, targetTick);
+  const int keyframeTick = keyframe >= 0 ? m_replayKeyframes.at(keyframe).frame : 0;
+  const bool continueForward =
+    m_mode == SessionMode::Replaying && current <= targetTick && current >= keyframeTick;
+  if (!continueForward) {
+    if (keyframe >= 0) {
+      restoreReplayKeyframe(m_replayKeyframes.at(keyframe));
+    } else {
+      startReplay(m_replayObstacles,
+                  m_randomSeed,
+                  m_replayInputHistory,
+                  m_replayChoiceHistory,
+                  m_replayChecksumHistory,
+                  m_replayKeyframes);
+    }
+  }
+  while (m_mode == SessionMode::Replaying && m_core.tickCounter() < targetTick) {
+    tick();
+  }
+  return m_core.tickCounter() == targetTick;
+}
+
+void SessionRunner::setRewindBudget(const std::size_t budgetBytes,
+                                    const int keyframeIntervalTicks) {
+  m_rewind.configure(budgetBytes, keyframeIntervalTicks);
+  m_rewindUnsettled = false;
+}
+
+auto SessionRunner::stepBack() -> bool {
+  if (m_mode != SessionMode::Playing && m_mode != SessionMode::ChoiceSelection &&
+      m_mode != SessionMode::GameOver) {
+    return false;
+  }
+  const auto marks = m_rewind.stepBack(m_core);
+  if (!marks.has_value()) {
+    return false;
+  }
+  applyRewindMarks(*marks);
+  m_rewindUnsettled = true;
+  return true;
+}
+
 auto SessionRunner::enqueueDirection(const QPoint& direction, const std::size_t maxQueueSize)
   -> bool {
   return m_core.enqueueDirection(direction, maxQueueSize);
@@ -63,52 +139,53 @@ auto SessionRunner::tick() -> SessionTickResult {
     return tickResult;
   }
 
-  const int tickFrame = m_core.tickCounter();
-  const auto coreTick = m_core.tick(
-    {
-      .advanceConfig =
-        {
-          .boardWidth = m_boardWidth,
-          .boardHeight = m_boardHeight,
-          .consumeInputQueue = (m_mode == SessionMode::Playing),
-          .pauseOnChoiceTrigger = (m_mode != SessionMode::Replaying),
-        },
-      .replayInputFrames = (m_mode == SessionMode::Replaying) ? &m_replayInputHistory : nullptr,
-      .replayInputHistoryIndex =
-        (m_mode == SessionMode::Replaying) ? &m_replayInputHistoryIndex : nullptr,
-      .replayChoiceFrames = (m_mode == SessionMode::Replaying) ? &m_replayChoiceHistory : nullptr,
-      .replayChoiceHistoryIndex =
-        (m_mode == SessionMode::Replaying) ? &m_replayChoiceHistoryIndex : nullptr,
-      .applyRuntimeHooks = true,
-    },
-    [this](const int bound) { return randomBounded(bound); });
-  tickResult.buffExpired = coreTick.runtimeUpdate.buffExpired;
-
-  if (coreTick.replayTimeline.choiceIndex.has_value()) {
-    tickResult.replayChoiceApplied = selectChoice(*coreTick.replayTimeline.choiceIndex);
-  }
-
-  const auto& stepResult = coreTick.step;
-
-  if (stepResult.consumedInput && m_mode == SessionMode::Playing) {
-    m_inputHistory.append({
-      .frame = tickFrame,
-      .dx = stepResult.consumedDirection.x(),
-      .dy = stepResult.consumedDirection.y(),
-    });
-    tickResult.consumedInput = true;
+  if (m_rewindUnsettled) {
+    settleRewind();
+  }
+  const bool replaying = (m_mode == SessionMode::Replaying);
+  const bool recordRewind = !replaying && m_rewind.enabled();
+  if (recordRewind) {
+    m_rewind.beginTick(m_core, rewindMarks(), m_rng);
   }
+  const int tickFrame = m_core.tickCounter();
+  struct Host {
+    SessionRunner& runner;
+    SessionTickResult& tickResult;
+    int tickFrame;
 
-  if (stepResult.collision) {
-    tickResult.collision = true;
-    m_mode =
-      (m_mode == SessionMode::Replaying) ? SessionMode::ReplayFinished : SessionMode::GameOver;
-  } else {
-    applyConsumptionEffects(stepResult, tickResult);
-    if (stepResult.appliedMovement) {
-      appendRecordingPoint();
-      tickResult.advanced = true;
+    auto drawBounded(const int bound) -> int {
+      return runner.randomBounded(bound);
+    }
+    void selectReplayChoice(const int index) {
+      tickResult.replayChoiceApplied = runner.selectChoice(index);
     }
+    void applyStep(const SessionAdvanceResult& step) {
+      runner.applyStepResult(step, tickFrame, tickResult);
+    }
+    void applyRuntimeUpdate(const RuntimeUpdateResult& update) {
+      tickResult.buffExpired = update.buffExpired;
+      runner.applyObstacleSchedule();
+    }
+  } host{.runner = *this, .tickResult = tickResult, .tickFrame = tickFrame};
+  const ReplayCursor replay{
+    .inputFrames = &m_replayInputHistory,
+    .inputHistoryIndex = &m_replayInputHistoryIndex,
+    .choiceFrames = &m_replayChoiceHistory,
+    .choiceHistoryIndex = &m_replayChoiceHistoryIndex,
+  };
+  const auto outcome =
+    runSessionTick(m_core, m_boardWidth, m_boardHeight, replaying ? &replay : nullptr, host);
+
+  if (outcome.counted) {
+    trackChecksum(replaying, tickResult);
+    if (!replaying && m_keyframeIntervalTicks > 0 &&
+        m_core.tickCounter() % m_keyframeIntervalTicks == 0 && m_choices.isEmpty() &&
+        m_mode == SessionMode::Playing) {
+      captureKeyframe();
+    }
+  }
+  if (recordRewind) {
+    m_rewind.endTick(m_core);
   }
   tickResult.replayFinished = (m_mode == SessionMode::ReplayFinished);
   return tickResult;
@@ -121,6 +198,7 @@ auto SessionRunner::selectChoice(const int index) -> bool {
 
   if (m_mode != SessionMode::Replaying) {
     m_choiceHistory.append({.frame = m_core.tickCounter(), .index = index});
+    m_rewind.keepLastTickBody(m_core);
   }
 
   m_core.selectChoice(m_choices[index].type, ChoiceBuffDurationTicks, false);
@@ -133,6 +211,7 @@ auto SessionRunner::selectChoice(const int index) -> bool {
 }
 
 auto SessionRunner::randomBounded(const int bound) -> int {
+  ++m_rngDraws;
   return m_rng.bounded(bound);
 }
 
@@ -145,10 +224,26 @@ void SessionRunner::resetRuntimeState() {
   m_replayChoiceHistory.clear();
   m_replayInputHistoryIndex = 0;
   m_replayChoiceHistoryIndex = 0;
+  m_rollingChecksum = 0;
+  m_checksumHistory.clear();
+  m_replayChecksumHistory.clear();
+  m_replayChecksumIndex = 0;
+  m_firstDivergentTick = -1;
+  m_keyframes.clear();
+  m_replayKeyframes.clear();
+  m_recordingOffset = 0;
+  m_rewind.clear();
+  m_rewindUnsettled = false;
   m_mode = SessionMode::Idle;
+  m_recording.reserve(ReservedLogTicks);
+  m_inputHistory.reserve(ReservedLogTicks);
+  if (m_checksumIntervalTicks > 0) {
+    m_checksumHistory.reserve(ReservedLogTicks / m_checksumIntervalTicks);
+  }
 }
 
 void SessionRunner::generateChoices() {
+  ++m_rngDraws;
   m_choices = pickRoguelikeChoices(m_rng.generate(), 3);
 }
 
@@ -156,41 +251,155 @@ void SessionRunner::appendRecordingPoint() {
   m_recording.append(m_core.headPosition());
 }
 
-void SessionRunner::applyConsumptionEffects(const SessionAdvanceResult& result,
-                                            SessionTickResult& tickResult) {
-  auto spawnPowerUp = [this]() {
-    m_core.spawnPowerUp(
-      m_boardWidth, m_boardHeight, [this](const int bound) { return randomBounded(bound); });
-  };
-  auto spawnFood = [this]() {
-    m_core.spawnFood(
-      m_boardWidth, m_boardHeight, [this](const int bound) { return randomBounded(bound); });
-  };
-  auto handleChoiceTrigger = [this, &tickResult]() {
-    generateChoices();
-    if (m_mode != SessionMode::Replaying) {
-      m_mode = SessionMode::ChoiceSelection;
-      tickResult.enteredChoice = true;
-    }
-  };
+void SessionRunner::applyStepResult(const SessionAdvanceResult& step,
+                                    const int tickFrame,
+                                    SessionTickResult& tickResult) {
+  if (step.consumedInput && m_mode == SessionMode::Playing) {
+    m_inputHistory.append({
+      .frame = tickFrame,
+      .dx = step.consumedDirection.x(),
+      .dy = step.consumedDirection.y(),
+    });
+    tickResult.consumedInput = true;
+  }
 
-  if (result.ateFood) {
-    spawnFood();
-    if (result.triggerChoice) {
-      handleChoiceTrigger();
-    } else if (result.spawnPowerUp) {
-      spawnPowerUp();
-    }
+  if (step.collision) {
+    tickResult.collision = true;
+    m_mode =
+      (m_mode == SessionMode::Replaying) ? SessionMode::ReplayFinished : SessionMode::GameOver;
+    return;
+  }
+  applyConsumptionEffects(step, tickResult);
+  if (step.appliedMovement) {
+    appendRecordingPoint();
+    tickResult.advanced = true;
+  }
+}
+
+void SessionRunner::applyObstacleSchedule() {
+  if (m_obstacleSchedule.has_value()) {
+    nenoserpent::core::applyObstacleSchedule(m_core, *m_obstacleSchedule);
   }
+}
 
-  if (result.magnetAteFood) {
-    spawnFood();
-    if (result.triggerChoiceAfterMagnet) {
-      handleChoiceTrigger();
-    } else if (result.spawnPowerUpAfterMagnet) {
-      spawnPowerUp();
+void SessionRunner::trackChecksum(const bool replaying, SessionTickResult& tickResult) {
+  const int frame = m_core.tickCounter();
+  if (!replaying) {
+    if (m_checksumIntervalTicks > 0 && frame % m_checksumIntervalTicks == 0) {
+      m_rollingChecksum = rollReplayChecksum(m_rollingChecksum, sessionStateChecksum(m_core));
+      m_checksumHistory.append({.frame = frame, .checksum = m_rollingChecksum});
     }
+    return;
+  }
+
+  while (m_replayChecksumIndex < m_replayChecksumHistory.size() &&
+         m_replayChecksumHistory.at(m_replayChecksumIndex).frame < frame) {
+    ++m_replayChecksumIndex;
+  }
+  if (m_replayChecksumIndex >= m_replayChecksumHistory.size() ||
+      m_replayChecksumHistory.at(m_replayChecksumIndex).frame != frame) {
+    return;
   }
+  m_rollingChecksum = rollReplayChecksum(m_rollingChecksum, sessionStateChecksum(m_core));
+  if (m_rollingChecksum != m_replayChecksumHistory.at(m_replayChecksumIndex++).checksum) {
+    m_firstDivergentTick = frame;
+    tickResult.checksumMismatch = true;
+    m_mode = SessionMode::ReplayFinished;
+  }
+}
+
+void SessionRunner::captureKeyframe() {
+  m_keyframes.append({
+    .frame = m_core.tickCounter(),
+    .rngDraws = m_rngDraws,
+    .checksum = m_rollingChecksum,
+    .recordedFrames = m_recordingOffset + static_cast<int>(m_recording.size()),
+    .session = m_core.captureKeyframe(),
+    .rng = m_rng,
+  });
+}
+
+void SessionRunner::restoreReplayKeyframe(const ReplayKeyframe& keyframe) {
+  m_core.restoreKeyframe(keyframe.session);
+  if (keyframe.rng.has_value()) {
+    m_rng = *keyframe.rng;
+  } else {
+    m_rng.reseed(m_randomSeed);
+    m_rng.discard(keyframe.rngDraws);
+  }
+  m_rngDraws = keyframe.rngDraws;
+  m_rollingChecksum = keyframe.checksum;
+  m_firstDivergentTick = -1;
+  m_choices.clear();
+  m_recording.clear();
+  m_recordingOffset = keyframe.recordedFrames;
+
+  auto firstAtOrAfter = [frame = keyframe.frame](const auto& history) {
+    const auto it = std::ranges::lower_bound(
+      history, frame, {}, [](const auto& record) { return record.frame; });
+    return static_cast<int>(std::distance(history.begin(), it));
+  };
+  m_replayInputHistoryIndex = firstAtOrAfter(m_replayInputHistory);
+  m_replayChoiceHistoryIndex = firstAtOrAfter(m_replayChoiceHistory);
+  // Checksums up to the keyframe are already folded into keyframe.checksum.
+  m_replayChecksumIndex = firstAtOrAfter(m_replayChecksumHistory);
+  if (m_replayChecksumIndex < m_replayChecksumHistory.size() &&
+      m_replayChecksumHistory.at(m_replayChecksumIndex).frame == keyframe.frame) {
+    ++m_replayChecksumIndex;
+  }
+  m_mode = SessionMode::Replaying;
+}
+
+auto SessionRunner::rewindMarks() const -> RewindMarks {
+  return {
+    .rngDraws = m_rngDraws,
+    .rollingChecksum = m_rollingChecksum,
+    .recordedFrames = m_recordingOffset + static_cast<int>(m_recording.size()),
+    .inputFrames = static_cast<int>(m_inputHistory.size()),
+    .choiceFrames = static_cast<int>(m_choiceHistory.size()),
+    .checksumFrames = static_cast<int>(m_checksumHistory.size()),
+  };
+}
+
+// Rewinding only ever cuts the logs short; they never grow back from a mark.
+void SessionRunner::applyRewindMarks(const RewindMarks& marks) {
+  m_rngDraws = marks.rngDraws;
+  m_rollingChecksum = marks.rollingChecksum;
+  m_recording.resize(std::min<qsizetype>(m_recording.size(),
+                                         std::max(0, marks.recordedFrames - m_recordingOffset)));
+  m_inputHistory.resize(std::min<qsizetype>(m_inputHistory.size(), marks.inputFrames));
+  m_choiceHistory.resize(std::min<qsizetype>(m_choiceHistory.size(), marks.choiceFrames));
+  m_checksumHistory.resize(std::min<qsizetype>(m_checksumHistory.size(), marks.checksumFrames));
+  const auto firstAfter = std::ranges::upper_bound(
+    m_keyframes, m_core.tickCounter(), {}, [](const ReplayKeyframe& keyframe) {
+      return keyframe.frame;
+    });
+  m_keyframes.resize(std::distance(m_keyframes.begin(), firstAfter));
+  m_choices.clear();
+  m_mode = SessionMode::Playing;
+}
+
+void SessionRunner::settleRewind() {
+  m_rewindUnsettled = false;
+  m_rewind.settle(m_core, m_rng, m_rngDraws);
+}
+
+void SessionRunner::applyConsumptionEffects(const SessionAdvanceResult& result,
+                                            SessionTickResult& tickResult) {
+  struct Host {
+    SessionRunner& runner;
+    SessionTickResult& tickResult;
+
+    void enterChoice() {
+      runner.generateChoices();
+      if (runner.m_mode != SessionMode::Replaying) {
+        runner.m_mode = SessionMode::ChoiceSelection;
+        tickResult.enteredChoice = true;
+      }
+    }
+  } host{.runner = *this, .tickResult = tickResult};
+  auto draw = [this](const int bound) { return randomBounded(bound); };
+  applyFoodConsumption(m_core, m_boardWidth, m_boardHeight, result, draw, host);
 }
 
 } // namespace nenoserpent::core
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
+
 #include <QList>
 #include <QPoint>
-#include <QRandomGenerator>
 
 #include "core/choice/runtime.h"
+#include "core/level/schedule.h"
+#include "core/replay/keyframe.h"
+#include "core/replay/rewind.h"
 #include "core/replay/types.h"
 #include "core/session/core.h"
 
@@ -27,19 +32,43 @@ struct SessionTickResult {
   bool replayChoiceApplied = false;
   bool replayFinished = false;
   bool buffExpired = false;
+  bool checksumMismatch = false;
 };
 
 class SessionRunner {
 public:
-  SessionRunner(int boardWidth = 20, int boardHeight = 18);
+  // Each side is clamped to [MinBoardSide, MaxBoardSide].
+  SessionRunner(int boardWidth = StandardBoardWidth, int boardHeight = StandardBoardHeight);
 
   void startSession(QList<QPoint> obstacles, uint randomSeed);
   void startReplay(QList<QPoint> obstacles,
                    uint randomSeed,
                    QList<ReplayFrame> inputHistory,
-                   QList<ChoiceRecord> choiceHistory);
+                   QList<ChoiceRecord> choiceHistory,
+                   QList<ChecksumRecord> checksumHistory = {},
+                   QList<ReplayKeyframe> keyframes = {});
   void seedPreviewState(const PreviewSeed& seed, SessionMode mode, uint randomSeed);
   void setReplayTimeline(QList<ReplayFrame> inputHistory, QList<ChoiceRecord> choiceHistory);
+  // Live sessions sample a rolling state checksum every `ticks` ticks; 0 turns it off. Replays
+  // sample wherever the recorded checksums are and end at the first mismatch.
+  void setChecksumInterval(int ticks);
+  // Live sessions capture a ReplayKeyframe every `ticks` ticks (skipping ticks that leave a
+  // choice pending); 0 turns it off.
+  void setKeyframeInterval(int ticks);
+  // Walls of a dynamic level. While set, sessions start from the layout at tick 0 instead of the
+  // obstacles they are given and every tick moves the walls on, outside Freeze, the way
+  // EngineAdapter::runLevelScript does. Kept across sessions until replaced.
+  void setObstacleSchedule(std::optional<ObstacleSchedule> schedule);
+  // Moves a replay to the moment the tick counter reads `targetTick`: continues forward when that
+  // is closest, otherwise restores the nearest keyframe at or before it (or restarts the replay)
+  // and simulates from there. Returns false when the replay ends before reaching the target.
+  auto seekToTick(int targetTick) -> bool;
+  // Live ticks are kept in a rewind ring of at most `budgetBytes`; 0 (the default) turns it off.
+  void setRewindBudget(std::size_t budgetBytes,
+                       int keyframeIntervalTicks = RewindBuffer::DefaultKeyframeIntervalTicks);
+  // Undoes the last live tick, including a crash, and cuts the logs back to match. The next
+  // tick() first settles the stall guard, recent spawns and generator onto this point.
+  auto stepBack() -> bool;
 
   [[nodiscard]] auto core() -> SessionCore& {
     return m_core;
@@ -47,6 +76,12 @@ public:
   [[nodiscard]] auto core() const -> const SessionCore& {
     return m_core;
   }
+  [[nodiscard]] auto boardWidth() const -> int {
+    return m_boardWidth;
+  }
+  [[nodiscard]] auto boardHeight() const -> int {
+    return m_boardHeight;
+  }
   [[nodiscard]] auto mode() const -> SessionMode {
     return m_mode;
   }
@@ -65,6 +100,24 @@ public:
   [[nodiscard]] auto choiceHistory() const -> const QList<ChoiceRecord>& {
     return m_choiceHistory;
   }
+  [[nodiscard]] auto checksumHistory() const -> const QList<ChecksumRecord>& {
+    return m_checksumHistory;
+  }
+  [[nodiscard]] auto keyframes() const -> const QList<ReplayKeyframe>& {
+    return m_keyframes;
+  }
+  // Number of recorded head positions that precede recording()[0]; non-zero after a seek
+  // restored a keyframe.
+  [[nodiscard]] auto recordingOffset() const -> int {
+    return m_recordingOffset;
+  }
+  [[nodiscard]] auto rewind() const -> const RewindBuffer& {
+    return m_rewind;
+  }
+  // Tick whose recorded checksum the replay failed to reproduce, or -1.
+  [[nodiscard]] auto firstDivergentTick() const -> int {
+    return m_firstDivergentTick;
+  }
 
   auto enqueueDirection(const QPoint& direction, std::size_t maxQueueSize = 2) -> bool;
   auto tick() -> SessionTickResult;
@@ -75,14 +128,26 @@ private:
   void resetRuntimeState();
   void generateChoices();
   void appendRecordingPoint();
+  void applyStepResult(const SessionAdvanceResult& step,
+                       int tickFrame,
+                       SessionTickResult& tickResult);
+  void applyObstacleSchedule();
+  void trackChecksum(bool replaying, SessionTickResult& tickResult);
+  void captureKeyframe();
+  void restoreReplayKeyframe(const ReplayKeyframe& keyframe);
+  [[nodiscard]] auto rewindMarks() const -> RewindMarks;
+  void applyRewindMarks(const RewindMarks& marks);
+  void settleRewind();
   void applyConsumptionEffects(const SessionAdvanceResult& result, SessionTickResult& tickResult);
 
   SessionCore m_core;
-  int m_boardWidth = 20;
-  int m_boardHeight = 18;
+  int m_boardWidth = StandardBoardWidth;
+  int m_boardHeight = StandardBoardHeight;
   SessionMode m_mode = SessionMode::Idle;
   uint m_randomSeed = 0;
-  QRandomGenerator m_rng;
+  ReplayRng m_rng;
+  // Outputs drawn from m_rng since it was seeded; a rewind settles the generator back to it.
+  quint64 m_rngDraws = 0;
   QList<ChoiceSpec> m_choices;
   QList<QPoint> m_recording;
   QList<ReplayFrame> m_inputHistory;
@@ -91,6 +156,21 @@ private:
   QList<ChoiceRecord> m_replayChoiceHistory;
   int m_replayInputHistoryIndex = 0;
   int m_replayChoiceHistoryIndex = 0;
+  int m_checksumIntervalTicks = 0;
+  std::uint64_t m_rollingChecksum = 0;
+  QList<ChecksumRecord> m_checksumHistory;
+  QList<ChecksumRecord> m_replayChecksumHistory;
+  int m_replayChecksumIndex = 0;
+  int m_firstDivergentTick = -1;
+  int m_keyframeIntervalTicks = 0;
+  QList<ReplayKeyframe> m_keyframes;
+  QList<ReplayKeyframe> m_replayKeyframes;
+  QList<QPoint> m_replayObstacles;
+  std::optional<ObstacleSchedule> m_obstacleSchedule;
+  int m_recordingOffset = 0;
+  RewindBuffer m_rewind;
+  // Set by stepBack: the board is rewound but the RNG and stall bookkeeping are not yet.
+  bool m_rewindUnsettled = false;
 };
 
 } // namespace nenoserpent::core
@@ -68,7 +68,7 @@ auto planFoodConsumption(const QPoint& head,
                          const int currentScore,
                          const int lastChoiceScore,
                          const QPoint& powerUpPos,
-                         const std::function<int(int)>& randomBounded) -> FoodConsumptionResult {
+                         const RandomBounded randomBounded) -> FoodConsumptionResult {
   FoodConsumptionResult result;
   const QPoint wrapped = wrapPoint(head, boardWidth, boardHeight);
   if (wrapped != food) {
@@ -111,7 +111,7 @@ auto planFoodConsumption(const QPoint& head,
                          const SessionState& state,
                          const int boardWidth,
                          const int boardHeight,
-                         const std::function<int(int)>& randomBounded) -> FoodConsumptionResult {
+                         const RandomBounded randomBounded) -> FoodConsumptionResult {
   return planFoodConsumption(head,
                              state.food,
                              boardWidth,
@@ -157,13 +157,13 @@ auto planPowerUpAcquisition(const int powerUpType,
   return result;
 }
 
-auto applyMiniShrink(const std::deque<QPoint>& body, const std::size_t minimumLength)
-  -> std::deque<QPoint> {
+auto applyMiniShrink(const SnakeBody& body, const std::size_t minimumLength) -> SnakeBody {
   if (body.size() <= minimumLength) {
     return body;
   }
-  std::deque<QPoint> nextBody;
+  SnakeBody nextBody;
   const std::size_t targetLength = miniShrinkTargetLength(body.size(), minimumLength);
+  nextBody.reserve(body.capacity());
   for (std::size_t i = 0; i < targetLength && i < body.size(); ++i) {
     nextBody.push_back(body[i]);
   }
@@ -183,7 +183,7 @@ auto applyMagnetAttraction(const QPoint& food,
     return result;
   }
 
-  const QList<QPoint> candidates = magnetCandidateSpots(food, head, boardWidth, boardHeight);
+  const MagnetCandidates candidates = magnetCandidates(food, head, boardWidth, boardHeight);
   for (const QPoint& candidate : candidates) {
     if (candidate == food) {
       continue;
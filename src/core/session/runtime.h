@@ -1,12 +1,12 @@
 #pragma once
 
-#include <deque>
 #include <functional>
 
 #include <QList>
 #include <QPoint>
 
 #include "core/buff/runtime.h"
+#include "core/game/body.h"
 #include "core/game/rules.h"
 #include "core/session/state.h"
 
@@ -47,13 +47,13 @@ auto planFoodConsumption(const QPoint& head,
                          int currentScore,
                          int lastChoiceScore,
                          const QPoint& powerUpPos,
-                         const std::function<int(int)>& randomBounded) -> FoodConsumptionResult;
+                         RandomBounded randomBounded) -> FoodConsumptionResult;
 
 auto planFoodConsumption(const QPoint& head,
                          const SessionState& state,
                          int boardWidth,
                          int boardHeight,
-                         const std::function<int(int)>& randomBounded) -> FoodConsumptionResult;
+                         RandomBounded randomBounded) -> FoodConsumptionResult;
 
 auto planPowerUpConsumption(const QPoint& head,
                             const QPoint& powerUpPos,
@@ -69,8 +69,7 @@ auto planPowerUpConsumption(const QPoint& head,
 auto planPowerUpAcquisition(int powerUpType, int baseDurationTicks, bool halfDurationForRich)
   -> PowerUpConsumptionResult;
 
-auto applyMiniShrink(const std::deque<QPoint>& body, std::size_t minimumLength = 3)
-  -> std::deque<QPoint>;
+auto applyMiniShrink(const SnakeBody& body, std::size_t minimumLength = 3) -> SnakeBody;
 
 auto applyMagnetAttraction(const QPoint& food,
                            const QPoint& head,
@@ -1,16 +1,49 @@
 #pragma once
 
-#include <deque>
+#include <cstdint>
+#include <vector>
 
+#include <QList>
 #include <QPoint>
 
+#include "core/game/body.h"
 #include "core/session/state.h"
 
 namespace nenoserpent::core {
 
 struct StateSnapshot {
   SessionState state;
-  std::deque<QPoint> body;
+  SnakeBody body;
+};
+
+// A StateSnapshot plus the bookkeeping that steers later spawns and stall resets. Restoring one
+// resumes the run bit-exactly, which a plain StateSnapshot does not promise.
+struct SessionKeyframe {
+  StateSnapshot snapshot;
+  int stallNoScoreTicks = 0;
+  int stallLastScore = 0;
+  // Oldest first.
+  std::vector<std::uint64_t> stallHashes;
+  std::uint64_t lastObstacleSignature = 0;
+  bool hasLastObstacleSignature = false;
+  int dynamicObstacleConfidenceTicks = 0;
+  QList<QPoint> prevObstacleSnapshot;
+  QList<QPoint> currObstacleSnapshot;
+  bool hasObstacleSnapshots = false;
+  QList<QPoint> recentSpawnPoints;
+};
+
+// The keyframe bookkeeping short of its two windows (stall hashes and recent spawns): small
+// enough for RewindBuffer to keep one per tick.
+struct SessionBookkeeping {
+  int stallNoScoreTicks = 0;
+  int stallLastScore = 0;
+  std::uint64_t lastObstacleSignature = 0;
+  bool hasLastObstacleSignature = false;
+  int dynamicObstacleConfidenceTicks = 0;
+  QList<QPoint> prevObstacleSnapshot;
+  QList<QPoint> currObstacleSnapshot;
+  bool hasObstacleSnapshots = false;
 };
 
 } // namespace nenoserpent::core
@@ -0,0 +1,271 @@
+#include "core/session/spawn_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "core/game/rules.h"
+
+namespace nenoserpent::core {
+
+namespace {
+constexpr int RiskMatchRadius = 3;
+
+auto insideBoard(const QPoint& p, const int boardWidth, const int boardHeight) -> bool {
+  return p.x() >= 0 && p.y() >= 0 && p.x() < boardWidth && p.y() < boardHeight;
+}
+
+// Unblocked multi-source BFS on the torus yields exactly the toroidal Manhattan distance.
+// `queue` holds the seeded source cells, which are already at distance 0.
+template <typename Geometry>
+void spreadObstacleDistance(const Geometry& board,
+                            std::vector<int>& distance,
+                            std::vector<int>& queue) {
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const int current = queue[head];
+    const int nextDistance = distance[static_cast<std::size_t>(current)] + 1;
+    for (std::size_t step = 0; step < BoardSteps.size(); ++step) {
+      const int next = board.neighbor(current, step);
+      const auto nextIndex = static_cast<std::size_t>(next);
+      if (distance[nextIndex] != SpawnAnalysisCache::NoObstacleDistance) {
+        continue;
+      }
+      distance[nextIndex] = nextDistance;
+      queue.push_back(next);
+    }
+  }
+}
+
+auto allInsideBoard(const QList<QPoint>& points, const int boardWidth, const int boardHeight)
+  -> bool {
+  return std::ranges::all_of(points, [&](const QPoint& p) {
+    return insideBoard(p, boardWidth, boardHeight);
+  });
+}
+
+auto signedToroidalDelta(const int from, const int to, const int size) -> int {
+  int delta = (to - from) % size;
+  if (delta < -size / 2) {
+    delta += size;
+  } else if (delta > size / 2) {
+    delta -= size;
+  }
+  return delta;
+}
+
+// Re-shares `cached` with `current` and reports whether the contents were already equal.
+auto refreshShared(QList<QPoint>& cached, const QList<QPoint>& current) -> bool {
+  if (cached.isSharedWith(current)) {
+    return true;
+  }
+  const bool same = cached == current;
+  cached = current;
+  return same;
+}
+} // namespace
+
+void SpawnAnalysisCache::invalidate() {
+  m_valid = false;
+}
+
+void SpawnAnalysisCache::prepare(const int boardWidth,
+                                 const int boardHeight,
+                                 const QList<QPoint>& obstacles,
+                                 const QList<QPoint>& previousObstacles,
+                                 const int riskHorizonTicks) {
+  const bool boardChanged = !m_valid || boardWidth != m_boardWidth || boardHeight != m_boardHeight;
+  const bool obstaclesSame = refreshShared(m_obstacles, obstacles);
+  const bool previousSame = refreshShared(m_previousObstacles, previousObstacles);
+  m_boardWidth = boardWidth;
+  m_boardHeight = boardHeight;
+  m_valid = true;
+
+  if (boardChanged) {
+    reserveScratch();
+  }
+  if (boardChanged || !obstaclesSame) {
+    rebuildObstacleDistance();
+    rebuildObstacleComponents();
+  }
+  if (boardChanged || !obstaclesSame || !previousSame || riskHorizonTicks != m_riskHorizonTicks) {
+    m_riskHorizonTicks = riskHorizonTicks;
+    rebuildPredictedRisk();
+  }
+}
+
+void SpawnAnalysisCache::reserveScratch() {
+  const auto cells = static_cast<std::size_t>(m_boardWidth * m_boardHeight);
+  m_obstacleDistance.reserve(cells);
+  m_obstacleComponent.reserve(isLargeBoard(m_boardWidth, m_boardHeight) ? cells : 0);
+  m_predictedRisk.reserve(cells);
+  m_reach.reserve(cells);
+  m_queue.reserve(cells);
+  m_candidates.reserve(cells);
+  m_points.reserve(cells);
+  m_axes.reserve(static_cast<std::size_t>(m_boardWidth + m_boardHeight));
+  m_prevUsed.reserve(cells);
+  m_bucketHead.reserve(cells);
+  m_bucketNext.reserve(cells);
+}
+
+void SpawnAnalysisCache::rebuildObstacleDistance() {
+  m_obstacleDistance.clear();
+  if (m_obstacles.isEmpty()) {
+    return;
+  }
+  const auto cells = static_cast<std::size_t>(m_boardWidth * m_boardHeight);
+  m_obstacleDistance.assign(cells, NoObstacleDistance);
+
+  if (!allInsideBoard(m_obstacles, m_boardWidth, m_boardHeight)) {
+    for (std::size_t index = 0; index < cells; ++index) {
+      const QPoint point(static_cast<int>(index) % m_boardWidth,
+                         static_cast<int>(index) / m_boardWidth);
+      for (const QPoint& obstacle : std::as_const(m_obstacles)) {
+        m_obstacleDistance[index] =
+          std::min(m_obstacleDistance[index],
+                   toroidalDistance(point, obstacle, m_boardWidth, m_boardHeight));
+      }
+    }
+    return;
+  }
+
+  m_queue.clear();
+  for (const QPoint& obstacle : std::as_const(m_obstacles)) {
+    const int index = (obstacle.y() * m_boardWidth) + obstacle.x();
+    if (m_obstacleDistance[static_cast<std::size_t>(index)] != 0) {
+      m_obstacleDistance[static_cast<std::size_t>(index)] = 0;
+      m_queue.push_back(index);
+    }
+  }
+  visitBoardGeometry(m_boardWidth, m_boardHeight, [this](const auto& board) {
+    spreadObstacleDistance(board, m_obstacleDistance, m_queue);
+  });
+}
+
+// Labels the obstacle-free components with one BFS per component. Like the distance field this
+// only reruns when the obstacles change, so windowed spawns can reject a disconnected anchor in
+// O(1) instead of flooding the board.
+void SpawnAnalysisCache::rebuildObstacleComponents() {
+  m_obstacleComponent.clear();
+  if (!isLargeBoard(m_boardWidth, m_boardHeight) || m_obstacles.isEmpty() ||
+      !allInsideBoard(m_obstacles, m_boardWidth, m_boardHeight)) {
+    return;
+  }
+  const auto cells = static_cast<std::size_t>(m_boardWidth * m_boardHeight);
+  constexpr int Unlabelled = -1;
+  constexpr int ObstacleCell = -2;
+  m_obstacleComponent.assign(cells, Unlabelled);
+  for (const QPoint& obstacle : std::as_const(m_obstacles)) {
+    m_obstacleComponent[static_cast<std::size_t>((obstacle.y() * m_boardWidth) + obstacle.x())] =
+      ObstacleCell;
+  }
+  const BoardGeometry board(m_boardWidth, m_boardHeight);
+  int label = 0;
+  for (std::size_t seed = 0; seed < cells; ++seed) {
+    if (m_obstacleComponent[seed] != Unlabelled) {
+      continue;
+    }
+    m_queue.clear();
+    m_queue.push_back(static_cast<int>(seed));
+    m_obstacleComponent[seed] = label;
+    for (std::size_t head = 0; head < m_queue.size(); ++head) {
+      const int current = m_queue[head];
+      for (std::size_t step = 0; step < BoardSteps.size(); ++step) {
+        const int next = board.neighbor(current, step);
+        auto& component = m_obstacleComponent[static_cast<std::size_t>(next)];
+        if (component != Unlabelled) {
+          continue;
+        }
+        component = label;
+        m_queue.push_back(next);
+      }
+    }
+    ++label;
+  }
+}
+
+// Projects each obstacle that moved since the previous snapshot along its last step.
+// Every current obstacle claims the nearest unclaimed previous one within RiskMatchRadius
+// (lowest index on ties); a per-cell bucket of previous obstacles keeps that match local.
+void SpawnAnalysisCache::rebuildPredictedRisk() {
+  const auto cells = static_cast<std::size_t>(m_boardWidth * m_boardHeight);
+  m_predictedRisk.assign(cells, 0);
+  const int horizonTicks = m_riskHorizonTicks;
+  if (horizonTicks <= 0 || m_previousObstacles.isEmpty() || m_obstacles.isEmpty()) {
+    return;
+  }
+
+  const auto previousCount = static_cast<std::size_t>(m_previousObstacles.size());
+  auto& prevUsed = m_prevUsed;
+  prevUsed.assign(previousCount, 0);
+  const bool bucketed = allInsideBoard(m_obstacles, m_boardWidth, m_boardHeight) &&
+                        allInsideBoard(m_previousObstacles, m_boardWidth, m_boardHeight);
+  auto& bucketHead = m_bucketHead;
+  auto& bucketNext = m_bucketNext;
+  if (bucketed) {
+    bucketHead.assign(cells, -1);
+    bucketNext.assign(previousCount, -1);
+    // Inserting in reverse leaves each bucket in ascending index order.
+    for (auto i = static_cast<int>(previousCount) - 1; i >= 0; --i) {
+      const QPoint previous = m_previousObstacles.at(i);
+      const auto cell = static_cast<std::size_t>((previous.y() * m_boardWidth) + previous.x());
+      bucketNext[static_cast<std::size_t>(i)] = bucketHead[cell];
+      bucketHead[cell] = i;
+    }
+  }
+
+  for (const QPoint& current : std::as_const(m_obstacles)) {
+    int bestPrevIndex = -1;
+    int bestDistance = std::numeric_limits<int>::max();
+    auto consider = [&](const int i) {
+      if (prevUsed[static_cast<std::size_t>(i)] != 0) {
+        return;
+      }
+      const int distance =
+        toroidalDistance(current, m_previousObstacles.at(i), m_boardWidth, m_boardHeight);
+      if (distance < bestDistance || (distance == bestDistance && i < bestPrevIndex)) {
+        bestDistance = distance;
+        bestPrevIndex = i;
+      }
+    };
+    if (bucketed) {
+      for (int dy = -RiskMatchRadius; dy <= RiskMatchRadius; ++dy) {
+        const int span = RiskMatchRadius - std::abs(dy);
+        for (int dx = -span; dx <= span; ++dx) {
+          const QPoint cell =
+            wrapPoint(QPoint(current.x() + dx, current.y() + dy), m_boardWidth, m_boardHeight);
+          for (int i = bucketHead[static_cast<std::size_t>((cell.y() * m_boardWidth) + cell.x())];
+               i >= 0;
+               i = bucketNext[static_cast<std::size_t>(i)]) {
+            consider(i);
+          }
+        }
+      }
+    } else {
+      for (int i = 0; i < m_previousObstacles.size(); ++i) {
+        consider(i);
+      }
+    }
+    if (bestPrevIndex < 0 || bestDistance > RiskMatchRadius) {
+      continue;
+    }
+    prevUsed[static_cast<std::size_t>(bestPrevIndex)] = 1;
+    const QPoint previous = m_previousObstacles.at(bestPrevIndex);
+    const int dx = signedToroidalDelta(previous.x(), current.x(), m_boardWidth);
+    const int dy = signedToroidalDelta(previous.y(), current.y(), m_boardHeight);
+    if (dx == 0 && dy == 0) {
+      continue;
+    }
+
+    for (int t = 1; t <= horizonTicks; ++t) {
+      const QPoint projected = wrapPoint(
+        QPoint(current.x() + (dx * t), current.y() + (dy * t)), m_boardWidth, m_boardHeight);
+      if (!insideBoard(projected, m_boardWidth, m_boardHeight)) {
+        continue;
+      }
+      m_predictedRisk[static_cast<std::size_t>((projected.y() * m_boardWidth) + projected.x())] +=
+        (horizonTicks - t + 1) * 8;
+    }
+  }
+}
+
+} // namespace nenoserpent::core
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <QList>
+#include <QPoint>
+
+namespace nenoserpent::core {
+
+struct SpawnCandidate {
+  QPoint point{0, 0};
+  int score = std::numeric_limits<int>::min();
+  // Index of the first fallback pass that accepts this cell; see pickSpawnPointWithSafety.
+  int pass = 0;
+};
+
+// Obstacle-derived spawn fields, rebuilt only when the obstacle lists, board size or risk horizon
+// change. Also owns the per-spawn scratch buffers, reserved for the whole board whenever its size
+// changes, so spawns on an unchanged board never allocate.
+class SpawnAnalysisCache {
+public:
+  static constexpr int NoObstacleDistance = std::numeric_limits<int>::max();
+
+  void invalidate();
+  void prepare(int boardWidth,
+               int boardHeight,
+               const QList<QPoint>& obstacles,
+               const QList<QPoint>& previousObstacles,
+               int riskHorizonTicks);
+
+  // Toroidal Manhattan distance from board cell `index` to the nearest obstacle,
+  // or NoObstacleDistance on an obstacle-free board.
+  [[nodiscard]] auto obstacleDistance(const std::size_t index) const -> int {
+    return m_obstacleDistance.empty() ? NoObstacleDistance : m_obstacleDistance[index];
+  }
+  // Connected component of board cell `index` with only the obstacles blocking, so two cells with
+  // different labels can never reach each other. Tracked on large boards only; elsewhere (and on
+  // obstacle-free boards) every cell reports component 0.
+  [[nodiscard]] auto obstacleComponent(const std::size_t index) const -> int {
+    return m_obstacleComponent.empty() ? 0 : m_obstacleComponent[index];
+  }
+  [[nodiscard]] auto predictedRisk(const std::size_t index) const -> int {
+    return m_predictedRisk[index];
+  }
+
+  [[nodiscard]] auto reachScratch() -> std::vector<int>& {
+    return m_reach;
+  }
+  [[nodiscard]] auto queueScratch() -> std::vector<int>& {
+    return m_queue;
+  }
+  [[nodiscard]] auto candidateScratch() -> std::vector<SpawnCandidate>& {
+    return m_candidates;
+  }
+  [[nodiscard]] auto pointScratch() -> std::vector<QPoint>& {
+    return m_points;
+  }
+  [[nodiscard]] auto axisScratch() -> std::vector<std::uint8_t>& {
+    return m_axes;
+  }
+
+private:
+  void reserveScratch();
+  void rebuildObstacleDistance();
+  void rebuildObstacleComponents();
+  void rebuildPredictedRisk();
+
+  int m_boardWidth = 0;
+  int m_boardHeight = 0;
+  int m_riskHorizonTicks = -1;
+  bool m_valid = false;
+  QList<QPoint> m_obstacles;
+  QList<QPoint> m_previousObstacles;
+  std::vector<int> m_obstacleDistance;
+  std::vector<int> m_obstacleComponent;
+  std::vector<int> m_predictedRisk;
+  std::vector<int> m_reach;
+  std::vector<int> m_queue;
+  std::vector<SpawnCandidate> m_candidates;
+  std::vector<QPoint> m_points;
+  std::vector<std::uint8_t> m_axes;
+  std::vector<std::uint8_t> m_prevUsed;
+  std::vector<int> m_bucketHead;
+  std::vector<int> m_bucketNext;
+};
+
+} // namespace nenoserpent::core
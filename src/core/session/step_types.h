@@ -2,11 +2,13 @@
 
 #include <QPoint>
 
+#include "core/game/board_geometry.h"
+
 namespace nenoserpent::core {
 
 struct SessionAdvanceConfig {
-  int boardWidth = 20;
-  int boardHeight = 18;
+  int boardWidth = StandardBoardWidth;
+  int boardHeight = StandardBoardHeight;
   bool consumeInputQueue = true;
   bool pauseOnChoiceTrigger = true;
 };
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <QList>
+
+#include "core/buff/runtime.h"
+#include "core/level/schedule.h"
+#include "core/replay/types.h"
+#include "core/session/core.h"
+
+namespace nenoserpent::core {
+
+// Where a replay reads its recorded turns and choices; ticks advance the indices as they go.
+struct ReplayCursor {
+  const QList<ReplayFrame>* inputFrames = nullptr;
+  int* inputHistoryIndex = nullptr;
+  const QList<ChoiceRecord>* choiceFrames = nullptr;
+  int* choiceHistoryIndex = nullptr;
+};
+
+// Base duration of a buff picked from a roguelike choice, before buffDurationTicks scales it.
+inline constexpr int ChoiceBuffDurationTicks = 80;
+
+struct SessionTickOutcome {
+  SessionAdvanceResult step;
+  RuntimeUpdateResult runtimeUpdate;
+  // False when the tick crashed; the tick counter then stays where it was.
+  bool counted = false;
+};
+
+// One gameplay tick, in the order the game plays it. EngineAdapter (live play and in-game
+// playback) and SessionRunner (headless play and replay verification) both tick through here, so
+// a ghost plays back the same in either:
+// 1. a replay applies the choice and the turn recorded for this tick; a live step reads the input
+//    queue instead, and the choice was picked while paused;
+// 2. the step; eating a choice food stops it before the move;
+// 3. host.applyStep(step): spawns, choice generation, crash handling;
+// 4. a crash ends the tick there; a choice trigger does too, but still moves the counter on, so the
+//    choice picked while paused is recorded against the tick that resumes play;
+// 5. otherwise buff and power-up countdowns, host.applyRuntimeUpdate(update) (moving walls), and
+//    the counter moves on.
+// The host also provides drawBounded(bound), the session's random source, and
+// selectReplayChoice(index).
+template <typename Host>
+auto runSessionTick(SessionCore& core,
+                    const int boardWidth,
+                    const int boardHeight,
+                    const ReplayCursor* replay,
+                    Host& host) -> SessionTickOutcome {
+  SessionTickOutcome outcome;
+  if (replay != nullptr) {
+    if (const auto choice =
+          core.takeReplayChoice(*replay->choiceFrames, *replay->choiceHistoryIndex);
+        choice.has_value()) {
+      host.selectReplayChoice(*choice);
+    }
+    core.applyReplayInput(*replay->inputFrames, *replay->inputHistoryIndex);
+  }
+
+  outcome.step = core.advanceSessionStep(
+    {
+      .boardWidth = boardWidth,
+      .boardHeight = boardHeight,
+      .consumeInputQueue = (replay == nullptr),
+      .pauseOnChoiceTrigger = true,
+    },
+    [&host](const int bound) { return host.drawBounded(bound); });
+  host.applyStep(outcome.step);
+  if (outcome.step.collision) {
+    return outcome;
+  }
+  if (outcome.step.triggerChoice || outcome.step.triggerChoiceAfterMagnet) {
+    core.finishRuntimeUpdate();
+    outcome.counted = true;
+    return outcome;
+  }
+
+  outcome.runtimeUpdate = core.beginRuntimeUpdate();
+  host.applyRuntimeUpdate(outcome.runtimeUpdate);
+  core.finishRuntimeUpdate();
+  outcome.counted = true;
+  return outcome;
+}
+
+// What eating sets off in a headless session: a fresh food, then either a choice
+// (host.enterChoice()) or a power-up. Food the magnet pulls in counts as a second meal. Spawns
+// draw from `random`, a bounded source or a CounterRng; the latter takes SessionCore's direct
+// spawn overloads.
+template <typename Random, typename Host>
+void applyFoodConsumption(SessionCore& core,
+                          const int boardWidth,
+                          const int boardHeight,
+                          const SessionAdvanceResult& step,
+                          Random& random,
+                          Host& host) {
+  auto consume = [&](const bool triggerChoice, const bool spawnPowerUp) {
+    core.spawnFood(boardWidth, boardHeight, random);
+    if (triggerChoice) {
+      host.enterChoice();
+    } else if (spawnPowerUp) {
+      core.spawnPowerUp(boardWidth, boardHeight, random);
+    }
+  };
+  if (step.ateFood) {
+    consume(step.triggerChoice, step.spawnPowerUp);
+  }
+  if (step.magnetAteFood) {
+    consume(step.triggerChoiceAfterMagnet, step.spawnPowerUpAfterMagnet);
+  }
+}
+
+// Scripted walls move keyed by the tick counter before it counts the tick, as in the adapter;
+// Freeze holds them. A layout the walls already share is left alone, so the core keeps its
+// occupancy as it is.
+inline void applyObstacleSchedule(SessionCore& core, const ObstacleSchedule& schedule) {
+  if (core.state().activeBuff == static_cast<int>(BuffId::Freeze)) {
+    return;
+  }
+  const QList<QPoint>& layout = schedule.obstaclesAt(core.tickCounter());
+  QList<QPoint>& obstacles = core.state().obstacles;
+  if (!obstacles.isSharedWith(layout)) {
+    obstacles = layout;
+  }
+}
+
+} // namespace nenoserpent::core
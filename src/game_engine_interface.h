@@ -6,7 +6,6 @@
 #include "app_state.h"
 #include "audio/event.h"
 #include "core/replay/types.h"
-#include "core/session/step_types.h"
 
 class SnakeModel;
 
@@ -38,10 +37,6 @@ public:
   [[nodiscard]] virtual auto hasSave() const -> bool = 0;
   [[nodiscard]] virtual auto hasReplay() const -> bool = 0;
 
-  // --- Logic & Physics ---
-  virtual auto advanceSessionStep(const nenoserpent::core::SessionAdvanceConfig& config)
-    -> nenoserpent::core::SessionAdvanceResult = 0;
-
   // --- Game Actions ---
   virtual void restart() = 0;
   virtual void startReplay() = 0;
@@ -18,6 +18,14 @@ ProfileManager::ProfileManager(QObject* parent)
   QVariantList fruitList = m_settings.value(u"discoveredFruits"_s).toList();
   for (const auto& v : fruitList)
     m_discoveredFruits << v.toInt();
+
+  m_flushTimer.setSingleShot(true);
+  m_flushTimer.setInterval(WriteBehindIntervalMs);
+  connect(&m_flushTimer, &QTimer::timeout, this, &ProfileManager::flushPendingWrites);
+}
+
+ProfileManager::~ProfileManager() {
+  flushPendingWrites();
 }
 
 void ProfileManager::setPaletteIndex(int i) {
@@ -38,14 +46,14 @@ void ProfileManager::setVolume(float v) {
 }
 void ProfileManager::updateHighScore(int s) {
   m_highScore = s;
-  m_settings.setValue(u"highScore"_s, s);
+  markDirty(DirtyHighScore);
 }
 
 auto ProfileManager::unlockMedal(const QString& t) -> bool {
   if (m_unlockedMedals.contains(t))
     return false;
   m_unlockedMedals << t;
-  m_settings.setValue(u"achievements"_s, m_unlockedMedals);
+  markDirty(DirtyMedals);
   emit medalUnlocked(t);
   return true;
 }
@@ -55,38 +63,38 @@ auto ProfileManager::discoverFruit(const int t) -> bool {
     return false;
   }
   m_discoveredFruits << t;
-  QVariantList list;
-  for (int type : m_discoveredFruits)
-    list << type;
-  m_settings.setValue(u"discoveredFruits"_s, list);
+  markDirty(DirtyFruits);
   emit fruitDiscovered(t);
   return true;
 }
 
-void ProfileManager::saveStats() {
-  m_settings.setValue(u"stats/crashes"_s, m_totalCrashes);
-  m_settings.setValue(u"stats/food"_s, m_totalFoodEaten);
+void ProfileManager::markDirty(const DirtyField field) {
+  m_dirty = static_cast<quint8>(m_dirty | field);
+  // Not restarted by later changes, so a steady stream of them cannot postpone the flush.
+  if (!m_flushTimer.isActive()) {
+    m_flushTimer.start();
+  }
 }
 
-void ProfileManager::saveSession(int score,
-                                 const std::deque<QPoint>& body,
-                                 const QList<QPoint>& obstacles,
-                                 QPoint food,
-                                 QPoint dir) {
-  m_settings.beginGroup(u"session"_s);
-  m_settings.setValue(u"active"_s, true);
-  m_settings.setValue(u"score"_s, score);
-  m_settings.setValue(u"food"_s, food);
-  m_settings.setValue(u"dir"_s, dir);
-  QVariantList bodyList;
-  for (const auto& p : body)
-    bodyList << p;
-  m_settings.setValue(u"body"_s, bodyList);
-  QVariantList obsList;
-  for (const auto& p : obstacles)
-    obsList << p;
-  m_settings.setValue(u"obstacles"_s, obsList);
-  m_settings.endGroup();
+void ProfileManager::flushPendingWrites() {
+  m_flushTimer.stop();
+  if ((m_dirty & DirtyStats) != 0) {
+    m_settings.setValue(u"stats/crashes"_s, m_totalCrashes);
+    m_settings.setValue(u"stats/food"_s, m_totalFoodEaten);
+  }
+  if ((m_dirty & DirtyHighScore) != 0) {
+    m_settings.setValue(u"highScore"_s, m_highScore);
+  }
+  if ((m_dirty & DirtyMedals) != 0) {
+    m_settings.setValue(u"achievements"_s, m_unlockedMedals);
+  }
+  if ((m_dirty & DirtyFruits) != 0) {
+    QVariantList list;
+    for (int type : m_discoveredFruits)
+      list << type;
+    m_settings.setValue(u"discoveredFruits"_s, list);
+  }
+  m_dirty = 0;
 }
 
 void ProfileManager::clearSession() {
@@ -1,17 +1,23 @@
 #pragma once
 
-#include <deque>
-
 #include <QObject>
 #include <QPoint>
 #include <QSettings>
 #include <QStringList>
+#include <QTimer>
 #include <QVariantList>
 
+#include "core/game/body.h"
+
 class ProfileManager : public QObject {
   Q_OBJECT
 public:
+  // Lifetime stats, the high score, medals and discovered fruits are written behind: the first
+  // change arms a flush that runs at most this long later, which bounds what a crash can lose.
+  static constexpr int WriteBehindIntervalMs = 5000;
+
   explicit ProfileManager(QObject* parent = nullptr);
+  ~ProfileManager() override;
 
   [[nodiscard]] auto paletteIndex() const -> int {
     return m_paletteIndex;
@@ -37,11 +43,11 @@ public:
 
   void incrementCrashes() {
     m_totalCrashes++;
-    saveStats();
+    markDirty(DirtyStats);
   }
   void logFoodEaten() {
     m_totalFoodEaten++;
-    saveStats();
+    markDirty(DirtyStats);
   }
 
   [[nodiscard]] auto unlockedMedals() const -> QStringList {
@@ -54,11 +60,8 @@ public:
     return m_discoveredFruits;
   }
 
-  void saveSession(int score,
-                   const std::deque<QPoint>& body,
-                   const QList<QPoint>& obstacles,
-                   QPoint food,
-                   QPoint dir);
+  // Sessions are saved to session.dat now; the settings group is only read to migrate a session
+  // left by an older build, then cleared.
   void clearSession();
   [[nodiscard]] auto hasSession() const -> bool;
   auto loadSession() -> QVariantMap;
@@ -70,13 +73,28 @@ public:
     return m_totalFoodEaten;
   }
 
+  // Writes every pending write-behind value now. Cheap when nothing is pending.
+  void flushPendingWrites();
+  [[nodiscard]] auto hasPendingWrites() const -> bool {
+    return m_dirty != 0;
+  }
+
 signals:
   void medalUnlocked(const QString& title);
   void fruitDiscovered(int type);
 
 private:
-  void saveStats();
+  enum DirtyField : quint8 {
+    DirtyStats = 1U << 0U,
+    DirtyHighScore = 1U << 1U,
+    DirtyMedals = 1U << 2U,
+    DirtyFruits = 1U << 3U,
+  };
+
+  void markDirty(DirtyField field);
   QSettings m_settings;
+  QTimer m_flushTimer;
+  quint8 m_dirty = 0;
   int m_paletteIndex = 0;
   int m_shellIndex = 0;
   int m_levelIndex = 0;
@@ -5,6 +5,7 @@ Item {
     id: overlays
     property int currentState: AppState.Splash
     property int currentScore: 0
+    property int replaySpeed: 1
     property var choices: []
     property int choiceIndex: 0
     property var menuColor
@@ -109,6 +110,7 @@ Item {
         anchors.horizontalCenter: parent.horizontalCenter
         anchors.topMargin: overlays.safeInsetTop + 4
         active: showReplayAndChoice && overlays.currentState === AppState.Replaying
+        titleText: overlays.replaySpeed === 1 ? "REPLAY" : (overlays.replaySpeed === 0 ? "REPLAY MAX" : `REPLAY ${overlays.replaySpeed}X`)
         menuColor: overlays.menuColor
         gameFont: overlays.gameFont
         hintText: "START MENU   SELECT MENU"
@@ -346,6 +346,7 @@ Item {
                 blurSourceItem: preOverlayContent
                 currentState: sessionRender.state
                 currentScore: sessionRender.score
+                replaySpeed: sessionStatusViewModel.replaySpeed
                 choices: selectionViewModel.choices
                 choiceIndex: selectionViewModel.choiceIndex
                 menuColor: root.menuColor
@@ -2,6 +2,8 @@
 
 #include <QFile>
 
+#include "logging/categories.h"
+
 namespace nenoserpent::services {
 
 LevelRepository::LevelRepository(QString resourcePath, const int fallbackCount)
@@ -11,19 +13,52 @@ LevelRepository::LevelRepository(QString resourcePath, const int fallbackCount)
 
 auto LevelRepository::loadResolvedLevel(const int levelIndex) const
   -> std::optional<nenoserpent::core::ResolvedLevelData> {
-  QFile file(m_resourcePath);
-  if (!file.open(QIODevice::ReadOnly)) {
+  const auto table = levels();
+  if (table->isEmpty()) {
     return std::nullopt;
   }
-  return nenoserpent::core::resolvedLevelDataFromJsonBytes(file.readAll(), levelIndex);
+  const auto count = static_cast<int>(table->size());
+  return table->at(((levelIndex % count) + count) % count);
 }
 
 auto LevelRepository::levelCount() const -> int {
-  QFile file(m_resourcePath);
-  if (!file.open(QIODevice::ReadOnly)) {
-    return m_fallbackCount;
+  const auto table = levels();
+  return table->isEmpty() ? m_fallbackCount : static_cast<int>(table->size());
+}
+
+auto LevelRepository::levels() const
+  -> std::shared_ptr<const nenoserpent::core::ResolvedLevelTable> {
+  if (m_levels) {
+    return m_levels;
+  }
+  if (m_resourcePath.isEmpty()) {
+    static const auto builtIn = std::make_shared<const nenoserpent::core::ResolvedLevelTable>(
+      nenoserpent::core::builtInLevels());
+    m_levels = builtIn;
+    return m_levels;
+  }
+  // A missing or broken file is cached too, as an empty table, until invalidated.
+  nenoserpent::core::ResolvedLevelTable table;
+  if (QFile file(m_resourcePath); file.open(QIODevice::ReadOnly)) {
+    QList<int> replacedLevels;
+    table = nenoserpent::core::resolvedLevelTableFromJsonBytes(file.readAll(), &replacedLevels);
+    for (const int levelIndex : replacedLevels) {
+      qCWarning(nenoserpentLevelLog).noquote()
+        << "level" << levelIndex << "in" << m_resourcePath
+        << "has a malformed animation; using the built-in level instead";
+    }
   }
-  return nenoserpent::core::levelCountFromJsonBytes(file.readAll(), m_fallbackCount);
+  m_levels = std::make_shared<const nenoserpent::core::ResolvedLevelTable>(std::move(table));
+  return m_levels;
+}
+
+void LevelRepository::setResourcePath(QString resourcePath) {
+  m_resourcePath = std::move(resourcePath);
+  invalidate();
+}
+
+void LevelRepository::invalidate() {
+  m_levels.reset();
 }
 
 } // namespace nenoserpent::services
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <optional>
 
 #include <QString>
@@ -8,18 +9,28 @@
 
 namespace nenoserpent::services {
 
+// Serves the built-in levels compiled in from src/levels/levels.json, or, given a path, an
+// override levels file. The file is read once, on first use, into an immutable table; copies of
+// the repository taken after that share it. Lookups never touch the file again until
+// invalidate() or setResourcePath() drop the table, so an edited file is read on the next lookup.
 class LevelRepository {
 public:
-  explicit LevelRepository(QString resourcePath = QStringLiteral("qrc:/src/levels/levels.json"),
-                           int fallbackCount = 6);
+  // An empty `resourcePath` selects the built-in levels.
+  explicit LevelRepository(QString resourcePath = {}, int fallbackCount = 6);
 
   [[nodiscard]] auto loadResolvedLevel(int levelIndex) const
     -> std::optional<nenoserpent::core::ResolvedLevelData>;
   [[nodiscard]] auto levelCount() const -> int;
+  // Empty when the override file is missing or invalid.
+  [[nodiscard]] auto levels() const -> std::shared_ptr<const nenoserpent::core::ResolvedLevelTable>;
+
+  void setResourcePath(QString resourcePath);
+  void invalidate();
 
 private:
   QString m_resourcePath;
   int m_fallbackCount = 6;
+  mutable std::shared_ptr<const nenoserpent::core::ResolvedLevelTable> m_levels;
 };
 
 } // namespace nenoserpent::services
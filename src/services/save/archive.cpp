@@ -0,0 +1,229 @@
+#include "services/save/archive.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <QDir>
+#include <QtEndian>
+
+#include "adapter/ghost/codec.h"
+
+using namespace Qt::StringLiterals;
+
+namespace nenoserpent::services {
+
+namespace {
+constexpr quint32 IndexMagic = 0x534E4B49;
+constexpr quint32 IndexVersion = 1;
+constexpr qsizetype IndexHeaderSize = 8;
+// offset u64, size u32, level i32, score i32, seed u32, timestamp i64; all little-endian.
+constexpr qsizetype IndexRecordSize = 32;
+
+auto encodeRecord(const ReplayArchiveEntry& entry) -> QByteArray {
+  QByteArray record(IndexRecordSize, Qt::Uninitialized);
+  auto* out = reinterpret_cast<uchar*>(record.data());
+  qToLittleEndian(entry.offset, out);
+  qToLittleEndian(entry.size, out + 8);
+  qToLittleEndian(static_cast<qint32>(entry.levelIndex), out + 12);
+  qToLittleEndian(static_cast<qint32>(entry.score), out + 16);
+  qToLittleEndian(static_cast<quint32>(entry.randomSeed), out + 20);
+  qToLittleEndian(entry.timestampMs, out + 24);
+  return record;
+}
+
+auto recordScore(const uchar* record) -> int {
+  return qFromLittleEndian<qint32>(record + 16);
+}
+
+auto recordLevel(const uchar* record) -> int {
+  return qFromLittleEndian<qint32>(record + 12);
+}
+} // namespace
+
+ReplayArchive::ReplayArchive(QString directory) {
+  const QDir dir(std::move(directory));
+  m_dataPath = dir.filePath(u"replays.dat"_s);
+  m_indexPath = dir.filePath(u"replays.idx"_s);
+}
+
+auto ReplayArchive::directoryForAppData(const QStringView appDataDirectory) -> QString {
+  QDir dir(appDataDirectory.toString());
+  if (!dir.exists(u"replays"_s)) {
+    dir.mkpath(u"replays"_s);
+  }
+  return dir.filePath(u"replays"_s);
+}
+
+auto ReplayArchive::append(const nenoserpent::adapter::GhostSnapshot& snapshot,
+                           const int score,
+                           const qint64 timestampMs) const -> bool {
+  QFile index(m_indexPath);
+  if (!index.open(QIODevice::ReadWrite)) {
+    return false;
+  }
+  if (index.size() < IndexHeaderSize) {
+    QByteArray header(IndexHeaderSize, Qt::Uninitialized);
+    qToLittleEndian(IndexMagic, header.data());
+    qToLittleEndian(IndexVersion, header.data() + 4);
+    if (!index.resize(0) || index.write(header) != IndexHeaderSize) {
+      return false;
+    }
+  }
+  QFile data(m_dataPath);
+  if (!data.open(QIODevice::WriteOnly | QIODevice::Append)) {
+    return false;
+  }
+  // Drop what an interrupted append left behind: a torn record, or a record whose payload never
+  // reached the data file. Only the tail can be damaged, so this stays O(1).
+  qsizetype records = (index.size() - IndexHeaderSize) / IndexRecordSize;
+  while (records > 0) {
+    if (!index.seek(IndexHeaderSize + ((records - 1) * IndexRecordSize))) {
+      return false;
+    }
+    const QByteArray last = index.read(IndexRecordSize);
+    const auto* record = reinterpret_cast<const uchar*>(last.constData());
+    if (last.size() == IndexRecordSize &&
+        qFromLittleEndian<quint64>(record) + qFromLittleEndian<quint32>(record + 8) <=
+          static_cast<quint64>(data.size())) {
+      break;
+    }
+    --records;
+  }
+  const qint64 indexEnd = IndexHeaderSize + (records * IndexRecordSize);
+  if (index.size() != indexEnd && !index.resize(indexEnd)) {
+    return false;
+  }
+
+  const QByteArray payload = nenoserpent::adapter::encodeGhostV5(snapshot, false);
+  const ReplayArchiveEntry entry{
+    .offset = static_cast<quint64>(data.size()),
+    .size = static_cast<quint32>(payload.size()),
+    .levelIndex = snapshot.levelIndex,
+    .score = score,
+    .randomSeed = snapshot.randomSeed,
+    .timestampMs = timestampMs,
+  };
+  if (data.write(payload) != payload.size() || !data.flush()) {
+    return false;
+  }
+
+  const QByteArray record = encodeRecord(entry);
+  return index.seek(indexEnd) && index.write(record) == IndexRecordSize;
+}
+
+auto ReplayArchive::mapWhole(QFile& file, QByteArray& fallback) -> const uchar* {
+  if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+    return nullptr;
+  }
+  if (const uchar* mapped = file.map(0, file.size()); mapped != nullptr) {
+    return mapped;
+  }
+  fallback = file.readAll();
+  return reinterpret_cast<const uchar*>(fallback.constData());
+}
+
+auto ReplayArchive::refresh() -> bool {
+  m_dataFile.close();
+  m_indexFile.close();
+  m_dataFallback.clear();
+  m_indexFallback.clear();
+  m_data = nullptr;
+  m_index = nullptr;
+  m_dataSize = 0;
+  m_entryCount = 0;
+
+  m_indexFile.setFileName(m_indexPath);
+  const uchar* index = mapWhole(m_indexFile, m_indexFallback);
+  if (index == nullptr) {
+    // No archive yet is an empty archive.
+    return !m_indexFile.exists() || m_indexFile.size() == 0;
+  }
+  const qsizetype indexSize = m_indexFile.size();
+  if (indexSize < IndexHeaderSize || qFromLittleEndian<quint32>(index) != IndexMagic ||
+      qFromLittleEndian<quint32>(index + 4) != IndexVersion) {
+    return false;
+  }
+  m_dataFile.setFileName(m_dataPath);
+  m_data = mapWhole(m_dataFile, m_dataFallback);
+  m_dataSize = m_data != nullptr ? m_dataFile.size() : 0;
+  m_index = index + IndexHeaderSize;
+
+  // Records are only appended after their payload, but a record cut short by a crash, or one
+  // pointing past the data file, ends the usable archive.
+  const qsizetype records = (indexSize - IndexHeaderSize) / IndexRecordSize;
+  m_entryCount = 0;
+  while (m_entryCount < records) {
+    const ReplayArchiveEntry candidate = entry(m_entryCount);
+    if (candidate.offset + candidate.size > static_cast<quint64>(m_dataSize)) {
+      break;
+    }
+    ++m_entryCount;
+  }
+  return true;
+}
+
+auto ReplayArchive::entry(const qsizetype index) const -> ReplayArchiveEntry {
+  const uchar* record = m_index + (index * IndexRecordSize);
+  return {
+    .index = index,
+    .offset = qFromLittleEndian<quint64>(record),
+    .size = qFromLittleEndian<quint32>(record + 8),
+    .levelIndex = recordLevel(record),
+    .score = recordScore(record),
+    .randomSeed = qFromLittleEndian<quint32>(record + 20),
+    .timestampMs = qFromLittleEndian<qint64>(record + 24),
+  };
+}
+
+auto ReplayArchive::topByScore(const int levelIndex, const int count) const
+  -> QList<ReplayArchiveEntry> {
+  if (count <= 0) {
+    return {};
+  }
+  // Bounded min-heap of (score, -index): the worst kept run sits on top.
+  using Ranked = std::pair<int, qsizetype>;
+  auto better = [](const Ranked& lhs, const Ranked& rhs) -> bool {
+    return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+  };
+  std::vector<Ranked> heap;
+  heap.reserve(static_cast<std::size_t>(count) + 1);
+  for (qsizetype i = 0; i < m_entryCount; ++i) {
+    const uchar* record = m_index + (i * IndexRecordSize);
+    if (recordLevel(record) != levelIndex) {
+      continue;
+    }
+    const Ranked ranked{recordScore(record), i};
+    if (std::cmp_less(heap.size(), count)) {
+      heap.push_back(ranked);
+      std::ranges::push_heap(heap, better);
+    } else if (better(ranked, heap.front())) {
+      std::ranges::pop_heap(heap, better);
+      heap.back() = ranked;
+      std::ranges::push_heap(heap, better);
+    }
+  }
+  std::ranges::sort_heap(heap, better);
+
+  QList<ReplayArchiveEntry> top;
+  top.reserve(static_cast<qsizetype>(heap.size()));
+  for (const auto& [score, index] : heap) {
+    top.push_back(entry(index));
+  }
+  return top;
+}
+
+auto ReplayArchive::load(const ReplayArchiveEntry& entry,
+                         nenoserpent::adapter::GhostSnapshot& snapshot) const -> bool {
+  if (entry.index < 0 || entry.index >= m_entryCount) {
+    return false;
+  }
+  // Trust the mapped record, which refresh() bounds-checked, over the caller's copy.
+  const ReplayArchiveEntry stored = this->entry(entry.index);
+  const QByteArray payload = QByteArray::fromRawData(
+    reinterpret_cast<const char*>(m_data + stored.offset), static_cast<qsizetype>(stored.size));
+  nenoserpent::adapter::GhostFileView view;
+  return view.openBytes(payload) && view.decode(snapshot);
+}
+
+} // namespace nenoserpent::services
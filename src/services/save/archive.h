@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QStringView>
+
+#include "adapter/ghost/store.h"
+
+namespace nenoserpent::services {
+
+// One finished run, as described by the archive index.
+struct ReplayArchiveEntry {
+  qsizetype index = -1;
+  quint64 offset = 0;
+  quint32 size = 0;
+  int levelIndex = 0;
+  int score = 0;
+  uint randomSeed = 0;
+  qint64 timestampMs = 0;
+};
+
+// Every finished run, kept in two append-only files: replays.dat holds v5 ghost payloads back to
+// back, replays.idx a fixed-size {offset, size, level, score, seed, timestamp} record per run.
+// An append writes one payload and one record, so it costs the same however large the archive
+// is. Reads go through memory mappings of both files; queries scan the index records only.
+class ReplayArchive {
+public:
+  explicit ReplayArchive(QString directory);
+
+  [[nodiscard]] static auto directoryForAppData(QStringView appDataDirectory) -> QString;
+
+  // Appends a run without its head recording, which replay-verify re-derives. The payload is
+  // written before its index record, so a crash in between leaves only unreferenced bytes.
+  [[nodiscard]] auto append(const nenoserpent::adapter::GhostSnapshot& snapshot,
+                            int score,
+                            qint64 timestampMs) const -> bool;
+
+  // Maps the archive as it is now. Later appends become visible after the next refresh().
+  auto refresh() -> bool;
+
+  [[nodiscard]] auto size() const -> qsizetype {
+    return m_entryCount;
+  }
+  [[nodiscard]] auto entry(qsizetype index) const -> ReplayArchiveEntry;
+  // Best `count` runs on `levelIndex`, highest score first; ties go to the earlier run.
+  [[nodiscard]] auto topByScore(int levelIndex, int count) const -> QList<ReplayArchiveEntry>;
+  [[nodiscard]] auto load(const ReplayArchiveEntry& entry,
+                          nenoserpent::adapter::GhostSnapshot& snapshot) const -> bool;
+
+private:
+  // Maps `file`, or reads it into `fallback` where mapping is not available.
+  static auto mapWhole(QFile& file, QByteArray& fallback) -> const uchar*;
+
+  QString m_dataPath;
+  QString m_indexPath;
+  QFile m_dataFile;
+  QFile m_indexFile;
+  QByteArray m_dataFallback;
+  QByteArray m_indexFallback;
+  const uchar* m_data = nullptr;
+  qsizetype m_dataSize = 0;
+  const uchar* m_index = nullptr;
+  qsizetype m_entryCount = 0;
+};
+
+} // namespace nenoserpent::services
@@ -1,37 +1,74 @@
 #include "services/save/repository.h"
 
+#include <utility>
+
+#include <QDateTime>
+#include <QFile>
+#include <QStandardPaths>
+
+#include "adapter/session/state.h"
 #include "profile_manager.h"
+#include "services/save/archive.h"
+#include "services/save/worker.h"
 
 namespace nenoserpent::services {
 
-SaveRepository::SaveRepository(ProfileManager* profile)
-    : m_profile(profile) {
+namespace {
+auto sessionFilePath() -> QString {
+  return nenoserpent::adapter::sessionFilePathForDirectory(
+    QStandardPaths::writableLocation(QStandardPaths::AppDataLocation));
+}
+} // namespace
+
+SaveRepository::SaveRepository(ProfileManager* profile, PersistenceWorker* worker)
+    : m_profile(profile),
+      m_worker(worker) {
 }
 
 auto SaveRepository::hasSession() const -> bool {
-  return m_profile != nullptr && m_profile->hasSession();
+  return QFile::exists(sessionFilePath()) ||
+         (m_profile != nullptr && m_profile->hasSession());
 }
 
-auto SaveRepository::loadSessionSnapshot() const
-  -> std::optional<nenoserpent::adapter::SessionSnapshot> {
-  if (!hasSession()) {
+auto SaveRepository::loadSession() const -> std::optional<nenoserpent::adapter::PersistedSession> {
+  if (auto session = nenoserpent::adapter::loadPersistedSessionFromFile(sessionFilePath());
+      session.has_value()) {
+    return session;
+  }
+  if (m_profile == nullptr || !m_profile->hasSession()) {
+    return std::nullopt;
+  }
+  const auto legacy = nenoserpent::adapter::decodeSessionSnapshot(m_profile->loadSession());
+  if (!legacy.has_value()) {
     return std::nullopt;
   }
-  return nenoserpent::adapter::decodeSessionSnapshot(m_profile->loadSession());
+  nenoserpent::adapter::PersistedSession session{.exact = false};
+  session.session.snapshot = nenoserpent::adapter::toCoreStateSnapshot(*legacy);
+  return session;
 }
 
-void SaveRepository::saveSession(const nenoserpent::core::StateSnapshot& snapshot) const {
-  if (m_profile == nullptr) {
+void SaveRepository::saveSession(const nenoserpent::adapter::PersistedSession& session) const {
+  auto write = [session, path = sessionFilePath()]() {
+    return nenoserpent::adapter::savePersistedSessionToFile(path, session);
+  };
+  if (m_worker == nullptr) {
+    static_cast<void>(write());
     return;
   }
-
-  const auto persisted = nenoserpent::adapter::fromCoreStateSnapshot(snapshot);
-  m_profile->saveSession(
-    persisted.score, persisted.body, persisted.obstacles, persisted.food, persisted.direction);
+  m_worker->submit(QStringLiteral("session"), std::move(write));
 }
 
 void SaveRepository::clearSession() const {
-  if (m_profile != nullptr) {
+  // Queued under the same key as saveSession, so a clear always wins over a pending save.
+  auto remove = [path = sessionFilePath()]() {
+    return !QFile::exists(path) || QFile::remove(path);
+  };
+  if (m_worker == nullptr) {
+    static_cast<void>(remove());
+  } else {
+    m_worker->submit(QStringLiteral("session"), std::move(remove));
+  }
+  if (m_profile != nullptr && m_profile->hasSession()) {
     m_profile->clearSession();
   }
 }
@@ -42,7 +79,27 @@ auto SaveRepository::loadGhostSnapshot(nenoserpent::adapter::GhostSnapshot& snap
 
 auto SaveRepository::saveGhostSnapshot(const nenoserpent::adapter::GhostSnapshot& snapshot) const
   -> bool {
-  return nenoserpent::adapter::saveGhostSnapshot(snapshot);
+  if (m_worker == nullptr) {
+    return nenoserpent::adapter::saveGhostSnapshot(snapshot);
+  }
+  m_worker->submit(QStringLiteral("ghost"),
+                   [snapshot]() { return nenoserpent::adapter::saveGhostSnapshot(snapshot); });
+  return true;
+}
+
+auto SaveRepository::archiveReplay(const nenoserpent::adapter::GhostSnapshot& snapshot,
+                                   const int score) const -> bool {
+  auto append = [snapshot, score, timestampMs = QDateTime::currentMSecsSinceEpoch()]() {
+    const ReplayArchive archive(ReplayArchive::directoryForAppData(
+      QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)));
+    return archive.append(snapshot, score, timestampMs);
+  };
+  if (m_worker == nullptr) {
+    return append();
+  }
+  // Every run is kept, so archive appends are never coalesced.
+  m_worker->post(QStringLiteral("replay-archive"), std::move(append));
+  return true;
 }
 
 } // namespace nenoserpent::services
@@ -3,29 +3,37 @@
 #include <optional>
 
 #include "adapter/ghost/store.h"
-#include "adapter/session/state.h"
-#include "core/session/snapshot.h"
+#include "adapter/session/store.h"
 
 class ProfileManager;
 
 namespace nenoserpent::services {
 
+class PersistenceWorker;
+
 class SaveRepository {
 public:
-  explicit SaveRepository(ProfileManager* profile);
+  // With a worker, session, ghost and archive writes are queued on it and the save calls only
+  // report whether the write was handed off; without one they write inline.
+  explicit SaveRepository(ProfileManager* profile, PersistenceWorker* worker = nullptr);
 
   [[nodiscard]] auto hasSession() const -> bool;
-  [[nodiscard]] auto loadSessionSnapshot() const
-    -> std::optional<nenoserpent::adapter::SessionSnapshot>;
-  void saveSession(const nenoserpent::core::StateSnapshot& snapshot) const;
+  // Reads session.dat; failing that, migrates a session left in the profile settings by older
+  // builds, which comes back with exact == false.
+  [[nodiscard]] auto loadSession() const -> std::optional<nenoserpent::adapter::PersistedSession>;
+  void saveSession(const nenoserpent::adapter::PersistedSession& session) const;
   void clearSession() const;
 
   [[nodiscard]] auto loadGhostSnapshot(nenoserpent::adapter::GhostSnapshot& snapshot) const -> bool;
   [[nodiscard]] auto saveGhostSnapshot(const nenoserpent::adapter::GhostSnapshot& snapshot) const
     -> bool;
+  // Adds a finished run to the replay archive, next to the single best-run ghost.
+  [[nodiscard]] auto archiveReplay(const nenoserpent::adapter::GhostSnapshot& snapshot,
+                                   int score) const -> bool;
 
 private:
   ProfileManager* m_profile = nullptr;
+  PersistenceWorker* m_worker = nullptr;
 };
 
 } // namespace nenoserpent::services
@@ -0,0 +1,78 @@
+#include "services/save/worker.h"
+
+#include <algorithm>
+
+#include "logging/categories.h"
+
+namespace nenoserpent::services {
+
+PersistenceWorker::PersistenceWorker()
+    : m_thread([this]() { run(); }) {
+}
+
+PersistenceWorker::~PersistenceWorker() {
+  {
+    const std::lock_guard lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+void PersistenceWorker::submit(const QString& key, Job job) {
+  {
+    const std::lock_guard lock(m_mutex);
+    const auto queued = std::ranges::find_if(
+      m_queue, [&key](const Pending& pending) { return pending.coalesce && pending.key == key; });
+    if (queued != m_queue.end()) {
+      queued->job = std::move(job);
+      ++m_coalescedJobs;
+      return;
+    }
+    m_queue.push_back({.key = key, .coalesce = true, .job = std::move(job)});
+  }
+  m_wake.notify_one();
+}
+
+void PersistenceWorker::post(const QString& label, Job job) {
+  {
+    const std::lock_guard lock(m_mutex);
+    m_queue.push_back({.key = label, .coalesce = false, .job = std::move(job)});
+  }
+  m_wake.notify_one();
+}
+
+void PersistenceWorker::flush() {
+  std::unique_lock lock(m_mutex);
+  m_idle.wait(lock, [this]() { return m_queue.empty() && !m_running; });
+}
+
+auto PersistenceWorker::coalescedJobs() const -> int {
+  const std::lock_guard lock(m_mutex);
+  return m_coalescedJobs;
+}
+
+void PersistenceWorker::run() {
+  std::unique_lock lock(m_mutex);
+  while (true) {
+    m_wake.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      return;
+    }
+    Pending pending = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_running = true;
+    lock.unlock();
+    const bool succeeded = pending.job();
+    if (!succeeded) {
+      qCWarning(nenoserpentStateLog).noquote() << "persistence job failed:" << pending.key;
+    }
+    lock.lock();
+    m_running = false;
+    if (m_queue.empty()) {
+      m_idle.notify_all();
+    }
+  }
+}
+
+} // namespace nenoserpent::services
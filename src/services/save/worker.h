@@ -0,0 +1,55 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <QString>
+
+namespace nenoserpent::services {
+
+// Runs persistence jobs on one background thread so the GUI thread never waits on storage.
+// Jobs capture immutable copies of what they write. A keyed job that is still queued when a newer
+// one with the same key arrives is replaced by it, so a burst of saves costs one write.
+class PersistenceWorker {
+public:
+  // Returns false on failure; the worker logs it and moves on.
+  using Job = std::function<bool()>;
+
+  PersistenceWorker();
+  // Runs every job still queued, then stops the thread.
+  ~PersistenceWorker();
+  PersistenceWorker(const PersistenceWorker&) = delete;
+  auto operator=(const PersistenceWorker&) -> PersistenceWorker& = delete;
+
+  // Queues `job`, replacing a queued job with the same key: the newest snapshot wins.
+  void submit(const QString& key, Job job);
+  // Queues `job` behind everything already queued; never coalesced.
+  void post(const QString& label, Job job);
+  // Blocks until the queue is empty and no job is running.
+  void flush();
+
+  [[nodiscard]] auto coalescedJobs() const -> int;
+
+private:
+  struct Pending {
+    QString key;
+    bool coalesce = false;
+    Job job;
+  };
+
+  void run();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_idle;
+  std::deque<Pending> m_queue;
+  bool m_running = false;
+  bool m_stopping = false;
+  int m_coalescedJobs = 0;
+  std::thread m_thread;
+};
+
+} // namespace nenoserpent::services
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <limits>
 #include <numeric>
+#include <optional>
 #include <unordered_map>
 #include <ranges>
 #include <tuple>
@@ -20,8 +21,9 @@
 #include "adapter/bot/features.h"
 #include "adapter/bot/ml_backend.h"
 #include "adapter/bot/runtime.h"
+#include "adapter/level/script_runtime.h"
 #include "core/buff/runtime.h"
-#include "core/session/runner.h"
+#include "core/session/batch.h"
 #include "services/level/repository.h"
 
 namespace {
@@ -425,10 +427,51 @@ auto powerActionRank(const nenoserpent::adapter::bot::Snapshot& snapshot, const
   return {rank, oracleClass};
 }
 
+auto laneSnapshot(const nenoserpent::core::SessionCore& core,
+                  const int levelIndex,
+                  const int boardWidth,
+                  const int boardHeight) -> nenoserpent::adapter::bot::Snapshot {
+  const auto& state = core.state();
+  return {
+    .head = core.headPosition(),
+    .direction = core.direction(),
+    .food = state.food,
+    .powerUpPos = state.powerUpPos,
+    .powerUpType = state.powerUpType,
+    .score = state.score,
+    .levelIndex = levelIndex,
+    .ghostActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Ghost),
+    .shieldActive = state.shieldActive,
+    .portalActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Portal),
+    .laserActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Laser),
+    .boardWidth = boardWidth,
+    .boardHeight = boardHeight,
+    .obstacles = state.obstacles,
+    .body = core.body(),
+    .bodyHash = core.bodyHash(),
+  };
+}
+
+// Bot bookkeeping of the game a batch lane is playing.
+struct LaneGame {
+  bool active = false;
+  int cooldown = 0;
+  int decisions = 0;
+  std::unordered_map<std::uint64_t, int> seenStates;
+};
+
+// Games run as SessionBatch lanes: the bot decides for every lane on this thread (backends keep
+// search scratch), then one batched tick steps them all, across `workers` threads. Game g plays
+// the batch's stream g, so results depend on the seed but not on the lane or worker count.
 auto runBenchmark(const int games,
+                  const int lanes,
+                  const int workers,
                   const int maxTicks,
                   const uint32_t seedBase,
+                  const int boardWidth,
+                  const int boardHeight,
                   const QList<QPoint>& obstacles,
+                  const std::optional<nenoserpent::core::ObstacleSchedule>& obstacleSchedule,
                   const nenoserpent::adapter::bot::StrategyConfig& strategy,
                   const int levelIndex,
                   const nenoserpent::adapter::bot::BotBackend* primaryBackend,
@@ -447,95 +490,90 @@ auto runBenchmark(const int games,
   int loopSamples = 0;
   int loopRepeats = 0;
 
-  for (int gameIndex = 0; gameIndex < games; ++gameIndex) {
-    const uint32_t gameSeed = seedBase + static_cast<uint32_t>(gameIndex * 37);
-    nenoserpent::core::SessionRunner runner;
-    runner.startSession(obstacles, gameSeed);
-
-    int cooldown = 0;
-    int tickCount = 0;
-    int decisions = 0;
-    const int maxDecisions = maxTicks * 4;
-    std::unordered_map<std::uint64_t, int> seenStates;
-
-    while (decisions < maxDecisions) {
-      if ((datasetWriter != nullptr && datasetWriter->shouldStop()) ||
-          (choiceDatasetWriter != nullptr && choiceDatasetWriter->shouldStop()) ||
-          (powerDatasetWriter != nullptr && powerDatasetWriter->shouldStop())) {
-        break;
-      }
-      const auto mode = runner.mode();
-      if (mode == nenoserpent::core::SessionMode::GameOver) {
-        ++gameOvers;
-        break;
-      }
+  const int maxDecisions = maxTicks * 4;
+  nenoserpent::core::SessionBatch batch(std::clamp(lanes, 1, games),
+                                        {
+                                          .boardWidth = boardWidth,
+                                          .boardHeight = boardHeight,
+                                          .maxTicks = maxTicks,
+                                          .workers = workers,
+                                        });
+  batch.setObstacleSchedule(obstacleSchedule);
+  batch.start(obstacles, seedBase);
+  std::vector<LaneGame> laneGames(batch.laneCount());
+  for (auto& game : laneGames) {
+    game.active = true;
+  }
+  int gamesStarted = static_cast<int>(batch.laneCount());
+  int activeLanes = gamesStarted;
+  std::vector<QPoint> directions(batch.laneCount());
+
+  auto finishGame = [&](const std::size_t lane) {
+    scores.push_back(batch.lane(lane).state().score);
+    if (gamesStarted < games) {
+      ++gamesStarted;
+      batch.restartLane(lane);
+      laneGames[lane] = {.active = true};
+      return;
+    }
+    laneGames[lane].active = false;
+    --activeLanes;
+  };
+  auto datasetsFull = [&]() {
+    return (datasetWriter != nullptr && datasetWriter->shouldStop()) ||
+           (choiceDatasetWriter != nullptr && choiceDatasetWriter->shouldStop()) ||
+           (powerDatasetWriter != nullptr && powerDatasetWriter->shouldStop());
+  };
 
-      if (mode != nenoserpent::core::SessionMode::Playing &&
-          mode != nenoserpent::core::SessionMode::ChoiceSelection) {
-        break;
-      }
+  bool stopped = false;
+  while (activeLanes > 0 && !stopped) {
+    std::ranges::fill(directions, QPoint(0, 0));
+    for (std::size_t lane = 0; lane < batch.laneCount() && !stopped; ++lane) {
+      LaneGame& game = laneGames[lane];
+      while (game.active) {
+        if (datasetsFull()) {
+          stopped = true;
+          break;
+        }
+        if (game.decisions >= maxDecisions) {
+          finishGame(lane);
+          continue;
+        }
+        const auto mode = batch.modes()[lane];
+        if (mode != nenoserpent::core::SessionMode::Playing &&
+            mode != nenoserpent::core::SessionMode::ChoiceSelection) {
+          finishGame(lane);
+          continue;
+        }
+
+        const auto& core = batch.lane(lane);
+        const auto& state = core.state();
+        const auto snapshot = laneSnapshot(core, levelIndex, boardWidth, boardHeight);
+        const auto decision = nenoserpent::adapter::bot::step({
+          .enabled = true,
+          .cooldownTicks = game.cooldown,
+          .state = modeToAppState(mode),
+          .snapshot = snapshot,
+          .choices = toChoiceModel(batch.choices(lane)),
+          .strategy = &strategy,
+          .backend = primaryBackend,
+          .fallbackBackend = fallbackBackend,
+        });
+        game.cooldown = decision.nextCooldownTicks;
+        ++game.decisions;
 
-      const auto& core = runner.core();
-      const auto& state = core.state();
-      const auto decision = nenoserpent::adapter::bot::step({
-        .enabled = true,
-        .cooldownTicks = cooldown,
-        .state = modeToAppState(mode),
-        .snapshot =
-          {
-            .head = core.headPosition(),
-            .direction = core.direction(),
-            .food = state.food,
-            .powerUpPos = state.powerUpPos,
-            .powerUpType = state.powerUpType,
-            .score = state.score,
-            .levelIndex = levelIndex,
-            .ghostActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Ghost),
-            .shieldActive = state.shieldActive,
-            .portalActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Portal),
-            .laserActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Laser),
-            .boardWidth = 20,
-            .boardHeight = 18,
-            .obstacles = state.obstacles,
-            .body = core.body(),
-          },
-        .choices = toChoiceModel(runner.choices()),
-        .strategy = &strategy,
-        .backend = primaryBackend,
-        .fallbackBackend = fallbackBackend,
-      });
-      cooldown = decision.nextCooldownTicks;
-
-      {
-        const nenoserpent::adapter::bot::Snapshot snapshot{
-          .head = core.headPosition(),
-          .direction = core.direction(),
-          .food = state.food,
-          .powerUpPos = state.powerUpPos,
-          .powerUpType = state.powerUpType,
-          .score = state.score,
-          .levelIndex = levelIndex,
-          .ghostActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Ghost),
-          .shieldActive = state.shieldActive,
-          .portalActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Portal),
-          .laserActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Laser),
-          .boardWidth = 20,
-          .boardHeight = 18,
-          .obstacles = state.obstacles,
-          .body = core.body(),
-        };
-        const std::uint64_t stateKey = snapshotHash(snapshot);
         ++loopSamples;
-        if (++seenStates[stateKey] > 1) {
+        if (++game.seenStates[snapshotHash(snapshot)] > 1) {
           ++loopRepeats;
         }
-      }
 
-      if (mode == nenoserpent::core::SessionMode::ChoiceSelection) {
-        const auto choiceModel = toChoiceModel(runner.choices());
-        int bestPriority = std::numeric_limits<int>::min();
-        int selectedPriority = std::numeric_limits<int>::min();
-        if (decision.triggerStart && decision.setChoiceIndex.has_value()) {
+        if (mode == nenoserpent::core::SessionMode::ChoiceSelection) {
+          if (!decision.triggerStart || !decision.setChoiceIndex.has_value()) {
+            continue;
+          }
+          const auto choiceModel = toChoiceModel(batch.choices(lane));
+          int bestPriority = std::numeric_limits<int>::min();
+          int selectedPriority = std::numeric_limits<int>::min();
           int oracleIndex = -1;
           int oraclePriority = std::numeric_limits<int>::min();
           std::vector<std::pair<int, int>> ranking;
@@ -589,59 +627,54 @@ auto runBenchmark(const int games,
                                              selectedPriority,
                                              bestPriority);
           }
-          runner.selectChoice(*decision.setChoiceIndex);
+          batch.selectChoice(lane, *decision.setChoiceIndex);
+          continue;
         }
-        ++decisions;
-        continue;
-      }
 
-      if (decision.enqueueDirection.has_value()) {
-        const nenoserpent::adapter::bot::Snapshot snapshot{
-          .head = core.headPosition(),
-          .direction = core.direction(),
-          .food = state.food,
-          .powerUpPos = state.powerUpPos,
-          .powerUpType = state.powerUpType,
-          .score = state.score,
-          .levelIndex = levelIndex,
-          .ghostActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Ghost),
-          .shieldActive = state.shieldActive,
-          .portalActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Portal),
-          .laserActive = state.activeBuff == static_cast<int>(nenoserpent::core::BuffId::Laser),
-          .boardWidth = 20,
-          .boardHeight = 18,
-          .obstacles = state.obstacles,
-          .body = core.body(),
-        };
-        if (datasetWriter != nullptr) {
-          datasetWriter->writeSample(snapshot, *decision.enqueueDirection);
-        }
-        if (powerDatasetWriter != nullptr && snapshot.powerUpPos.x() >= 0 &&
-            snapshot.powerUpPos.y() >= 0) {
-          const auto [rank, oracleClass] = powerActionRank(snapshot, *decision.enqueueDirection);
-          const int chosenClass =
-            nenoserpent::adapter::bot::directionClass(*decision.enqueueDirection);
-          if (rank > 0 && oracleClass >= 0 && chosenClass >= 0) {
-            powerDatasetWriter->writeDecision(snapshot, chosenClass, rank, oracleClass);
+        if (decision.enqueueDirection.has_value()) {
+          if (datasetWriter != nullptr) {
+            datasetWriter->writeSample(snapshot, *decision.enqueueDirection);
           }
+          if (powerDatasetWriter != nullptr && snapshot.powerUpPos.x() >= 0 &&
+              snapshot.powerUpPos.y() >= 0) {
+            const auto [rank, oracleClass] =
+              powerActionRank(snapshot, *decision.enqueueDirection);
+            const int chosenClass =
+              nenoserpent::adapter::bot::directionClass(*decision.enqueueDirection);
+            if (rank > 0 && oracleClass >= 0 && chosenClass >= 0) {
+              powerDatasetWriter->writeDecision(snapshot, chosenClass, rank, oracleClass);
+            }
+          }
+          directions[lane] = *decision.enqueueDirection;
         }
-        runner.enqueueDirection(*decision.enqueueDirection);
+        // This lane's move for the tick is decided.
+        break;
       }
+    }
+    if (stopped) {
+      break;
+    }
 
-      const auto tickResult = runner.tick();
-      ++tickCount;
-      ++decisions;
-      if (tickResult.collision) {
-        ++gameOvers;
-        break;
+    batch.tick(directions);
+    for (std::size_t lane = 0; lane < batch.laneCount(); ++lane) {
+      const std::uint8_t events = batch.events()[lane];
+      if (!laneGames[lane].active || batch.done()[lane] == 0) {
+        continue;
       }
-      if (tickCount >= maxTicks) {
+      if ((events & nenoserpent::core::LaneCollision) != 0) {
+        ++gameOvers;
+      } else if ((events & nenoserpent::core::LaneTimedOut) != 0) {
         ++timeouts;
-        break;
+      }
+      finishGame(lane);
+    }
+  }
+  if (stopped) {
+    for (std::size_t lane = 0; lane < batch.laneCount(); ++lane) {
+      if (laneGames[lane].active) {
+        scores.push_back(batch.lane(lane).state().score);
       }
     }
-
-    scores.push_back(runner.core().state().score);
   }
 
   std::ranges::sort(scores);
@@ -691,10 +724,33 @@ auto main(int argc, char* argv[]) -> int {
                                  QStringLiteral("Max ticks per game."),
                                  QStringLiteral("count"),
                                  QStringLiteral("4000"));
+  QCommandLineOption lanesOption(QStringList{QStringLiteral("lanes")},
+                                 QStringLiteral("Games played side by side as batch lanes."),
+                                 QStringLiteral("count"),
+                                 QStringLiteral("32"));
+  QCommandLineOption workersOption(
+    QStringList{QStringLiteral("workers")},
+    QStringLiteral("Threads a batched tick uses; 0 takes one per hardware thread."),
+    QStringLiteral("count"),
+    QStringLiteral("0"));
   QCommandLineOption seedOption(QStringList{QStringLiteral("s"), QStringLiteral("seed")},
                                 QStringLiteral("Base random seed."),
                                 QStringLiteral("seed"),
                                 QStringLiteral("1337"));
+  QCommandLineOption boardWidthOption(
+    QStringList{QStringLiteral("board-width")},
+    QStringLiteral("Board width in cells (%1-%2).")
+      .arg(nenoserpent::core::MinBoardSide)
+      .arg(nenoserpent::core::MaxBoardSide),
+    QStringLiteral("cells"),
+    QString::number(nenoserpent::core::StandardBoardWidth));
+  QCommandLineOption boardHeightOption(
+    QStringList{QStringLiteral("board-height")},
+    QStringLiteral("Board height in cells (%1-%2).")
+      .arg(nenoserpent::core::MinBoardSide)
+      .arg(nenoserpent::core::MaxBoardSide),
+    QStringLiteral("cells"),
+    QString::number(nenoserpent::core::StandardBoardHeight));
   QCommandLineOption levelOption(QStringList{QStringLiteral("l"), QStringLiteral("level")},
                                  QStringLiteral("Level index."),
                                  QStringLiteral("index"),
@@ -765,7 +821,11 @@ auto main(int argc, char* argv[]) -> int {
 
   parser.addOption(gamesOption);
   parser.addOption(ticksOption);
+  parser.addOption(lanesOption);
+  parser.addOption(workersOption);
   parser.addOption(seedOption);
+  parser.addOption(boardWidthOption);
+  parser.addOption(boardHeightOption);
   parser.addOption(levelOption);
   parser.addOption(profileOption);
   parser.addOption(modeOption);
@@ -786,7 +846,12 @@ auto main(int argc, char* argv[]) -> int {
 
   const int games = std::max(1, parser.value(gamesOption).toInt());
   const int maxTicks = std::max(200, parser.value(ticksOption).toInt());
+  const int lanes = std::max(1, parser.value(lanesOption).toInt());
+  const int workers = std::max(0, parser.value(workersOption).toInt());
   const uint32_t seedBase = static_cast<uint32_t>(parser.value(seedOption).toUInt());
+  const int boardWidth = nenoserpent::core::clampBoardSide(parser.value(boardWidthOption).toInt());
+  const int boardHeight =
+    nenoserpent::core::clampBoardSide(parser.value(boardHeightOption).toInt());
   const int levelIndex = std::max(0, parser.value(levelOption).toInt());
   const QString profile = parser.value(profileOption).trimmed().toLower();
   const QString mode = parser.value(modeOption).trimmed().toLower();
@@ -828,8 +893,21 @@ auto main(int argc, char* argv[]) -> int {
 
   nenoserpent::services::LevelRepository levels;
   QList<QPoint> obstacles;
+  // Moving walls are laid out once here, so each tick only swaps in a shared layout.
+  std::optional<nenoserpent::core::ObstacleSchedule> obstacleSchedule;
   if (const auto level = levels.loadResolvedLevel(levelIndex); level.has_value()) {
     obstacles = level->walls;
+    obstacleSchedule = nenoserpent::adapter::levelObstacleSchedule(*level);
+    if (!obstacleSchedule.has_value() && !level->script.isEmpty()) {
+      std::cerr << "[bot-benchmark] level script has no schedule, walls stay static\n";
+    }
+  }
+  // Levels are authored for the standard board; a smaller board drops the walls that fall off it.
+  obstacles.removeIf([boardWidth, boardHeight](const QPoint& wall) {
+    return wall.x() >= boardWidth || wall.y() >= boardHeight;
+  });
+  if (obstacleSchedule.has_value()) {
+    obstacleSchedule = obstacleSchedule->clippedTo(boardWidth, boardHeight);
   }
 
   DatasetWriter datasetWriter(dumpDatasetPath, datasetContext);
@@ -890,9 +968,14 @@ auto main(int argc, char* argv[]) -> int {
   }
 
   const auto stats = runBenchmark(games,
+                                  lanes,
+                                  workers,
                                   maxTicks,
                                   seedBase,
+                                  boardWidth,
+                                  boardHeight,
                                   obstacles,
+                                  obstacleSchedule,
                                   strategy,
                                   levelIndex,
                                   primaryBackend,
@@ -904,8 +987,10 @@ auto main(int argc, char* argv[]) -> int {
   choiceDatasetWriter.close();
   powerDatasetWriter.close();
   std::cout << "[bot-benchmark] games=" << stats.games << " level=" << levelIndex
+            << " board=" << boardWidth << 'x' << boardHeight
+            << " walls=" << (obstacleSchedule.has_value() ? "dynamic" : "static")
             << " profile=" << profile.toStdString() << " mode=" << mode.toStdString()
-            << " backend=" << backendValue.toStdString() << '\n';
+            << " backend=" << backendValue.toStdString() << " lanes=" << lanes << '\n';
   std::cout << "[bot-benchmark] score.max=" << stats.maxScore << " score.avg=" << stats.avgScore
             << " score.median=" << stats.medianScore << " score.p95=" << stats.p95Score << '\n';
   std::cout << "[bot-benchmark] outcomes.gameOver=" << stats.gameOvers
@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "adapter/ghost/store.h"
+#include "adapter/level/script_runtime.h"
+#include "core/level/runtime.h"
+#include "core/replay/verify.h"
+#include "services/level/repository.h"
+
+namespace {
+
+// Walls of one level: static, or moved every tick by a schedule. Levels whose script only runs
+// live, on QJSEngine from the adapter tick, cannot be re-simulated headlessly.
+struct LevelWalls {
+  QList<QPoint> walls;
+  std::optional<nenoserpent::core::ObstacleSchedule> schedule;
+  bool liveScript = false;
+};
+
+// Mirrors EngineAdapter::loadLevelData.
+auto resolveLevelWalls(const nenoserpent::services::LevelRepository& levels, const int levelIndex)
+  -> LevelWalls {
+  if (const auto resolved = levels.loadResolvedLevel(levelIndex); resolved.has_value()) {
+    if (resolved->animation.has_value() || !resolved->script.isEmpty()) {
+      auto schedule = nenoserpent::adapter::levelObstacleSchedule(*resolved);
+      if (schedule.has_value() && !schedule->obstaclesAt(0).isEmpty()) {
+        return {.schedule = std::move(schedule)};
+      }
+      if (!resolved->script.isEmpty()) {
+        return {.liveScript = true};
+      }
+    } else if (!resolved->walls.isEmpty()) {
+      return {.walls = resolved->walls};
+    }
+  }
+  const auto fallback = nenoserpent::core::fallbackLevelData(
+    nenoserpent::core::normalizedFallbackLevelIndex(levelIndex));
+  if (fallback.animation.has_value() || !fallback.script.isEmpty()) {
+    if (auto schedule = nenoserpent::adapter::levelObstacleSchedule(fallback);
+        schedule.has_value()) {
+      return {.schedule = std::move(schedule)};
+    }
+    if (!fallback.script.isEmpty()) {
+      return {.liveScript = true};
+    }
+  }
+  return {.walls = fallback.walls};
+}
+
+enum class FileStatus {
+  Verified,
+  LoadError,
+  Unsupported,
+};
+
+struct FileResult {
+  FileStatus status = FileStatus::LoadError;
+  int levelIndex = 0;
+  uint randomSeed = 0;
+  int recordedFrames = 0;
+  int recordedChecksums = 0;
+  nenoserpent::core::ReplayVerification verification;
+};
+
+auto statusName(const FileResult& result) -> const char* {
+  switch (result.status) {
+  case FileStatus::LoadError:
+    return "load-error";
+  case FileStatus::Unsupported:
+    return "unsupported";
+  case FileStatus::Verified:
+    break;
+  }
+  return nenoserpent::core::replayVerdictName(result.verification.verdict);
+}
+
+auto toJsonLine(const QString& filePath, const FileResult& result) -> QByteArray {
+  QJsonObject line{
+    {QStringLiteral("file"), filePath},
+    {QStringLiteral("verdict"), QString::fromLatin1(statusName(result))},
+  };
+  if (result.status != FileStatus::LoadError) {
+    line.insert(QStringLiteral("level"), result.levelIndex);
+    line.insert(QStringLiteral("seed"), static_cast<qint64>(result.randomSeed));
+    line.insert(QStringLiteral("frames"), result.recordedFrames);
+    line.insert(QStringLiteral("checksums"), result.recordedChecksums);
+  }
+  if (result.status == FileStatus::Verified) {
+    const auto& verification = result.verification;
+    line.insert(QStringLiteral("matched"), verification.matchedFrames);
+    line.insert(QStringLiteral("ticks"), verification.ticks);
+    line.insert(QStringLiteral("score"), verification.score);
+    if (verification.verdict == nenoserpent::core::ReplayVerdict::Diverged) {
+      line.insert(QStringLiteral("tick"), verification.divergentTick);
+    }
+    if (verification.expectedHead != QPoint(-1, -1)) {
+      line.insert(QStringLiteral("expected"),
+                  QStringLiteral("%1,%2")
+                    .arg(verification.expectedHead.x())
+                    .arg(verification.expectedHead.y()));
+      line.insert(QStringLiteral("actual"),
+                  QStringLiteral("%1,%2")
+                    .arg(verification.actualHead.x())
+                    .arg(verification.actualHead.y()));
+    }
+  }
+  return QJsonDocument(line).toJson(QJsonDocument::Compact);
+}
+
+// Ghost files named on the command line, plus every *.dat below any named directory.
+auto collectGhostFiles(const QStringList& paths) -> QStringList {
+  QStringList files;
+  for (const QString& path : paths) {
+    if (!QFileInfo(path).isDir()) {
+      files.append(path);
+      continue;
+    }
+    QDirIterator it(path, {QStringLiteral("*.dat")}, QDir::Files, QDirIterator::Subdirectories);
+    QStringList found;
+    while (it.hasNext()) {
+      found.append(it.next());
+    }
+    found.sort();
+    files.append(found);
+  }
+  return files;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  QCoreApplication app(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+    QStringLiteral("NenoSerpent replay verifier: re-simulates ghost.dat files headlessly"));
+  parser.addHelpOption();
+  parser.addPositionalArgument(QStringLiteral("paths"),
+                               QStringLiteral("Ghost files, or directories searched for *.dat."),
+                               QStringLiteral("paths..."));
+
+  QCommandLineOption jobsOption(QStringList{QStringLiteral("j"), QStringLiteral("jobs")},
+                                QStringLiteral("Worker threads (0 = one per core)."),
+                                QStringLiteral("count"),
+                                QStringLiteral("0"));
+  QCommandLineOption outputOption(QStringList{QStringLiteral("o"), QStringLiteral("output")},
+                                  QStringLiteral("Write verdict lines here instead of stdout."),
+                                  QStringLiteral("path"));
+  parser.addOption(jobsOption);
+  parser.addOption(outputOption);
+  parser.process(app);
+
+  const QStringList files = collectGhostFiles(parser.positionalArguments());
+  if (files.isEmpty()) {
+    std::cerr << "[replay-verify] no ghost files given\n";
+    return 2;
+  }
+  const int requestedJobs = std::max(0, parser.value(jobsOption).toInt());
+  const int hardwareJobs = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  const int jobs = std::clamp(
+    requestedJobs > 0 ? requestedJobs : hardwareJobs, 1, static_cast<int>(files.size()));
+
+  // Levels are resolved once up front; workers only read the table.
+  const nenoserpent::services::LevelRepository levels;
+  const int levelCount = std::max(1, levels.levelCount());
+  std::vector<LevelWalls> levelWalls;
+  levelWalls.reserve(static_cast<std::size_t>(levelCount));
+  for (int i = 0; i < levelCount; ++i) {
+    levelWalls.push_back(resolveLevelWalls(levels, i));
+  }
+
+  std::vector<FileResult> results(static_cast<std::size_t>(files.size()));
+  std::atomic<qsizetype> nextFile{0};
+  auto worker = [&]() {
+    nenoserpent::core::SessionRunner runner;
+    nenoserpent::adapter::GhostSnapshot ghost;
+    for (qsizetype index = nextFile.fetch_add(1); index < files.size();
+         index = nextFile.fetch_add(1)) {
+      FileResult& result = results[static_cast<std::size_t>(index)];
+      ghost = {};
+      if (!nenoserpent::adapter::loadGhostSnapshotFromFile(files.at(index), ghost)) {
+        result.status = FileStatus::LoadError;
+        continue;
+      }
+      result.levelIndex = ghost.levelIndex;
+      result.randomSeed = ghost.randomSeed;
+      result.recordedFrames = ghost.recordedMoves;
+      result.recordedChecksums = static_cast<int>(ghost.checksumHistory.size());
+      const LevelWalls& level = levelWalls[static_cast<std::size_t>(
+        ((ghost.levelIndex % levelCount) + levelCount) % levelCount)];
+      if (level.liveScript) {
+        result.status = FileStatus::Unsupported;
+        continue;
+      }
+      result.status = FileStatus::Verified;
+      const nenoserpent::core::ReplayVerifyInput input{
+        .obstacles = level.walls,
+        .obstacleSchedule = level.schedule,
+        .randomSeed = ghost.randomSeed,
+        .inputHistory = ghost.inputHistory,
+        .choiceHistory = ghost.choiceHistory,
+        .checksumHistory = ghost.checksumHistory,
+        .recording = ghost.recording,
+        .expectedMoves = ghost.recordedMoves,
+      };
+      result.verification = nenoserpent::core::verifyReplay(runner, input);
+    }
+  };
+
+  const auto started = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  threads.reserve(static_cast<std::size_t>(jobs - 1));
+  for (int i = 1; i < jobs; ++i) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const double elapsedSeconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  QFile output;
+  const QString outputPath = parser.value(outputOption).trimmed();
+  bool opened = false;
+  if (outputPath.isEmpty()) {
+    opened = output.open(stdout, QIODevice::WriteOnly);
+  } else {
+    output.setFileName(outputPath);
+    opened = output.open(QIODevice::WriteOnly | QIODevice::Text);
+  }
+  if (!opened) {
+    std::cerr << "[replay-verify] cannot open output path=" << outputPath.toStdString() << '\n';
+    return 2;
+  }
+
+  int matched = 0;
+  int diverged = 0;
+  int endedEarly = 0;
+  int overran = 0;
+  int loadErrors = 0;
+  int unsupported = 0;
+  for (qsizetype i = 0; i < files.size(); ++i) {
+    const FileResult& result = results[static_cast<std::size_t>(i)];
+    output.write(toJsonLine(files.at(i), result));
+    output.write("\n");
+    if (result.status == FileStatus::LoadError) {
+      ++loadErrors;
+      continue;
+    }
+    if (result.status == FileStatus::Unsupported) {
+      ++unsupported;
+      continue;
+    }
+    switch (result.verification.verdict) {
+    case nenoserpent::core::ReplayVerdict::Match:
+      ++matched;
+      break;
+    case nenoserpent::core::ReplayVerdict::Diverged:
+      ++diverged;
+      break;
+    case nenoserpent::core::ReplayVerdict::EndedEarly:
+      ++endedEarly;
+      break;
+    case nenoserpent::core::ReplayVerdict::Overran:
+      ++overran;
+      break;
+    }
+  }
+  output.close();
+
+  const double replaysPerSecond =
+    elapsedSeconds > 0.0 ? static_cast<double>(files.size()) / elapsedSeconds : 0.0;
+  std::cerr << "[replay-verify] files=" << files.size() << " jobs=" << jobs
+            << " match=" << matched << " diverged=" << diverged << " ended_early=" << endedEarly
+            << " overran=" << overran << " load_error=" << loadErrors
+            << " unsupported=" << unsupported << '\n';
+  std::cerr << "[replay-verify] elapsed_ms=" << static_cast<std::int64_t>(elapsedSeconds * 1000.0)
+            << " replays_per_sec=" << replaysPerSecond << '\n';
+  return matched == files.size() ? 0 : 1;
+}
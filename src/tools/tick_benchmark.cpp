@@ -0,0 +1,245 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <QCommandLineOption>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QStringList>
+
+#include "core/session/batch.h"
+#include "core/session/runner.h"
+
+namespace {
+
+// A sparse lattice of single-cell pillars, leaving the start area open.
+auto buildPillars(const int boardWidth, const int boardHeight) -> QList<QPoint> {
+  QList<QPoint> obstacles;
+  for (int y = 3; y < boardHeight; y += 7) {
+    for (int x = 2; x < boardWidth; x += 9) {
+      if (x >= 8 && x <= 12 && y >= 5 && y <= 14) {
+        continue;
+      }
+      obstacles.push_back(QPoint(x, y));
+    }
+  }
+  return obstacles;
+}
+
+// Greedy step toward the food that avoids walls and the body.
+auto safeStepTowardFood(const nenoserpent::core::SessionCore& core,
+                        const int boardWidth,
+                        const int boardHeight) -> QPoint {
+  const QPoint head = core.headPosition();
+  const QPoint food = core.state().food;
+  QPoint best(0, 0);
+  int bestDistance = std::numeric_limits<int>::max();
+  for (const QPoint& step : nenoserpent::core::BoardSteps) {
+    if (step == -core.direction()) {
+      continue;
+    }
+    const QPoint next = nenoserpent::core::wrapPoint(head + step, boardWidth, boardHeight);
+    if (core.state().obstacles.contains(next) ||
+        std::ranges::find(core.body(), next) != core.body().end()) {
+      continue;
+    }
+    const int distance = nenoserpent::core::toroidalDistance(next, food, boardWidth, boardHeight);
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = step;
+    }
+  }
+  return best;
+}
+
+struct TickCost {
+  double nanosPerTick = std::numeric_limits<double>::max();
+  int ticks = 0;
+};
+
+// Average wall time of a tick that also respawns the food, so every measured tick pays for a
+// spawn. The best round is kept to shrug off scheduler noise.
+auto measureTickCost(const int boardSide, const int rounds, const int ticksPerRound) -> TickCost {
+  TickCost best;
+  for (int round = 0; round < rounds; ++round) {
+    nenoserpent::core::SessionRunner runner(boardSide, boardSide);
+    runner.startSession(buildPillars(boardSide, boardSide), 4242U + static_cast<uint>(round));
+    std::mt19937 rng(91U + static_cast<unsigned>(round));
+    auto randomBounded = [&rng](const int upperBound) -> int {
+      if (upperBound <= 1) {
+        return 0;
+      }
+      return std::uniform_int_distribution<int>(0, upperBound - 1)(rng);
+    };
+    int ticks = 0;
+    std::chrono::nanoseconds elapsed{0};
+    while (ticks < ticksPerRound && runner.mode() == nenoserpent::core::SessionMode::Playing) {
+      const QPoint step = safeStepTowardFood(runner.core(), boardSide, boardSide);
+      const auto start = std::chrono::steady_clock::now();
+      if (!step.isNull()) {
+        runner.enqueueDirection(step);
+      }
+      runner.tick();
+      runner.core().spawnFood(boardSide, boardSide, randomBounded);
+      elapsed += std::chrono::steady_clock::now() - start;
+      ++ticks;
+      if (runner.mode() == nenoserpent::core::SessionMode::ChoiceSelection) {
+        runner.selectChoice(0);
+      }
+    }
+    if (ticks > 0) {
+      const double perTick = static_cast<double>(elapsed.count()) / ticks;
+      if (perTick < best.nanosPerTick) {
+        best = {.nanosPerTick = perTick, .ticks = ticks};
+      }
+    }
+  }
+  return best;
+}
+
+struct BatchCost {
+  double batchNanosPerLaneTick = 0.0;
+  double runnerNanosPerLaneTick = 0.0;
+  std::int64_t laneTicks = 0;
+  int workers = 1;
+};
+
+// Wall time per lane-tick of a SessionBatch against as many SessionRunners ticked one after
+// another, all chasing food on the same walls. Steering, choices and restarts stay untimed.
+auto measureBatchThroughput(const int boardSide,
+                            const int lanes,
+                            const int workers,
+                            const int ticks) -> BatchCost {
+  const QList<QPoint> pillars = buildPillars(boardSide, boardSide);
+  BatchCost cost;
+
+  nenoserpent::core::SessionBatch batch(
+    lanes, {.boardWidth = boardSide, .boardHeight = boardSide, .workers = workers});
+  batch.start(pillars, 4242U);
+  cost.workers = batch.workerCount();
+  std::vector<QPoint> directions(batch.laneCount());
+  std::chrono::nanoseconds batchElapsed{0};
+  for (int tick = 0; tick < ticks; ++tick) {
+    for (std::size_t lane = 0; lane < batch.laneCount(); ++lane) {
+      if (batch.done()[lane] != 0) {
+        batch.restartLane(lane);
+      } else if (batch.modes()[lane] == nenoserpent::core::SessionMode::ChoiceSelection) {
+        batch.selectChoice(lane, 0);
+      }
+      directions[lane] = safeStepTowardFood(batch.lane(lane), boardSide, boardSide);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    batch.tick(directions);
+    batchElapsed += std::chrono::steady_clock::now() - start;
+    cost.laneTicks += static_cast<std::int64_t>(batch.laneCount());
+  }
+
+  std::vector<nenoserpent::core::SessionRunner> runners;
+  runners.reserve(static_cast<std::size_t>(lanes));
+  for (int lane = 0; lane < lanes; ++lane) {
+    runners.emplace_back(boardSide, boardSide);
+    runners.back().startSession(pillars, 4242U + static_cast<uint>(lane));
+  }
+  std::chrono::nanoseconds runnerElapsed{0};
+  std::int64_t runnerTicks = 0;
+  for (int tick = 0; tick < ticks; ++tick) {
+    for (std::size_t lane = 0; lane < runners.size(); ++lane) {
+      auto& runner = runners[lane];
+      if (runner.mode() == nenoserpent::core::SessionMode::GameOver) {
+        runner.startSession(pillars, 4242U + static_cast<uint>(lane));
+      } else if (runner.mode() == nenoserpent::core::SessionMode::ChoiceSelection) {
+        runner.selectChoice(0);
+      }
+      directions[lane] = safeStepTowardFood(runner.core(), boardSide, boardSide);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t lane = 0; lane < runners.size(); ++lane) {
+      if (!directions[lane].isNull()) {
+        runners[lane].enqueueDirection(directions[lane]);
+      }
+      runners[lane].tick();
+    }
+    runnerElapsed += std::chrono::steady_clock::now() - start;
+    runnerTicks += static_cast<std::int64_t>(runners.size());
+  }
+
+  if (cost.laneTicks > 0) {
+    cost.batchNanosPerLaneTick = static_cast<double>(batchElapsed.count()) / cost.laneTicks;
+  }
+  if (runnerTicks > 0) {
+    cost.runnerNanosPerLaneTick = static_cast<double>(runnerElapsed.count()) / runnerTicks;
+  }
+  return cost;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+  QCoreApplication app(argc, argv);
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+    QStringLiteral("NenoSerpent tick benchmark: per-tick cost, spawn included, by board size"));
+  parser.addHelpOption();
+
+  QCommandLineOption sidesOption(
+    QStringList{QStringLiteral("s"), QStringLiteral("sides")},
+    QStringLiteral("Comma-separated board sides; ratios are against the first."),
+    QStringLiteral("list"),
+    QStringLiteral("32,%1").arg(nenoserpent::core::MaxBoardSide));
+  QCommandLineOption roundsOption(QStringList{QStringLiteral("r"), QStringLiteral("rounds")},
+                                  QStringLiteral("Rounds per side; the fastest is reported."),
+                                  QStringLiteral("count"),
+                                  QStringLiteral("3"));
+  QCommandLineOption ticksOption(QStringList{QStringLiteral("t"), QStringLiteral("ticks")},
+                                 QStringLiteral("Ticks per round."),
+                                 QStringLiteral("count"),
+                                 QStringLiteral("300"));
+  QCommandLineOption lanesOption(
+    QStringList{QStringLiteral("lanes")},
+    QStringLiteral("Also time a SessionBatch of this many lanes against as many runners."),
+    QStringLiteral("count"),
+    QStringLiteral("0"));
+  QCommandLineOption workersOption(
+    QStringList{QStringLiteral("workers")},
+    QStringLiteral("Batch worker threads; 0 takes one per hardware thread."),
+    QStringLiteral("count"),
+    QStringLiteral("0"));
+  parser.addOption(sidesOption);
+  parser.addOption(roundsOption);
+  parser.addOption(ticksOption);
+  parser.addOption(lanesOption);
+  parser.addOption(workersOption);
+  parser.process(app);
+
+  const int rounds = std::max(1, parser.value(roundsOption).toInt());
+  const int ticks = std::max(1, parser.value(ticksOption).toInt());
+  double baseline = 0.0;
+  for (const QString& value : parser.value(sidesOption).split(u',', Qt::SkipEmptyParts)) {
+    const int side = nenoserpent::core::clampBoardSide(value.trimmed().toInt());
+    const TickCost cost = measureTickCost(side, rounds, ticks);
+    if (cost.ticks == 0) {
+      std::cerr << "[tick-benchmark] " << side << "x" << side << ": no ticks ran\n";
+      return 1;
+    }
+    if (baseline == 0.0) {
+      baseline = cost.nanosPerTick;
+    }
+    std::cout << "[tick-benchmark] " << side << "x" << side << ": " << cost.nanosPerTick
+              << " ns/tick over " << cost.ticks << " ticks, ratio "
+              << (cost.nanosPerTick / baseline) << '\n';
+    if (const int lanes = parser.value(lanesOption).toInt(); lanes > 0) {
+      const int workers = std::max(0, parser.value(workersOption).toInt());
+      const BatchCost batch = measureBatchThroughput(side, lanes, workers, ticks);
+      std::cout << "[tick-benchmark] " << side << "x" << side << " batch lanes=" << lanes
+                << " workers=" << batch.workers << ": " << batch.batchNanosPerLaneTick
+                << " ns/lane-tick, runners " << batch.runnerNanosPerLaneTick
+                << " ns/lane-tick over " << batch.laneTicks << " lane-ticks, speedup "
+                << (batch.runnerNanosPerLaneTick / batch.batchNanosPerLaneTick) << '\n';
+    }
+  }
+  return 0;
+}
@@ -8,6 +8,7 @@ class BotConfigAdapterTest final : public QObject {
 private slots:
   void parsesProfileOverridesFromJson();
   void fallsBackWhenProfileMissing();
+  void loadsBuiltInProfilesWithoutResourceFile();
   void cyclesStrategyModesInExpectedOrder();
   void cyclesBackendModesInExpectedOrder();
   void parsesDecisionPolicyModes();
@@ -61,6 +62,23 @@ void BotConfigAdapterTest::fallsBackWhenProfileMissing() {
   QCOMPARE(result.config.safeNeighborWeight, 10);
 }
 
+void BotConfigAdapterTest::loadsBuiltInProfilesWithoutResourceFile() {
+  const auto result = nenoserpent::adapter::bot::loadStrategyConfig(QStringLiteral("release"));
+  QVERIFY(result.loaded);
+  QCOMPARE(result.source, QStringLiteral("built-in"));
+  QCOMPARE(result.config.trapPenalty, 44);
+  QCOMPARE(result.config.modeWeights.trapPenalty, 44);
+  QCOMPARE(result.config.targetDistanceWeight, 9);
+  QCOMPARE(result.config.powerTargetPriorityThreshold, 30);
+  QCOMPARE(nenoserpent::adapter::bot::powerPriority(result.config, 4), 90);
+
+  const auto missing =
+    nenoserpent::adapter::bot::loadBuiltInStrategyConfig(QStringLiteral("no-such-profile"));
+  QVERIFY(!missing.loaded);
+  QVERIFY(!missing.error.isEmpty());
+  QCOMPARE(missing.config.powerTargetDistanceSlack, 4);
+}
+
 void BotConfigAdapterTest::cyclesStrategyModesInExpectedOrder() {
   using nenoserpent::adapter::bot::BotMode;
   QCOMPARE(nenoserpent::adapter::bot::modeName(BotMode::Safe), QStringLiteral("safe"));
@@ -8,6 +8,7 @@ class TestLevelApplierAdapter : public QObject {
 private slots:
   void testApplyStaticLevelUsesWalls();
   void testApplyScriptedLevelRequiresScriptSuccessAndObstacles();
+  void testApplyAnimatedLevelStartsAnimationWithoutScript();
 };
 
 void TestLevelApplierAdapter::testApplyStaticLevelUsesWalls() {
@@ -55,5 +56,40 @@ void TestLevelApplierAdapter::testApplyScriptedLevelRequiresScriptSuccessAndObst
   QCOMPARE(obstacles.first(), QPoint(7, 8));
 }
 
+void TestLevelApplierAdapter::testApplyAnimatedLevelStartsAnimationWithoutScript() {
+  const nenoserpent::core::ObstacleAnimation animation{
+    .phaseTicks = 4, .phases = {0, 1}, .groups = {{.walls = {QPoint(2, 2)}, .step = QPoint(1, 0)}}};
+  nenoserpent::core::ResolvedLevelData resolved{.name = QStringLiteral("Animated"),
+                                            .script = QStringLiteral("function onTick(t){}"),
+                                            .walls = {},
+                                            .animation = animation};
+  QString levelName;
+  QString script;
+  QList<QPoint> obstacles;
+  bool scriptRan = false;
+  const auto evaluateAndRunScript = [&scriptRan](const QString&) -> bool {
+    scriptRan = true;
+    return true;
+  };
+
+  QVERIFY(!nenoserpent::adapter::applyResolvedLevelData(
+    resolved, levelName, script, obstacles, evaluateAndRunScript));
+
+  const bool ok = nenoserpent::adapter::applyResolvedLevelData(
+    resolved,
+    levelName,
+    script,
+    obstacles,
+    evaluateAndRunScript,
+    [&obstacles](const nenoserpent::core::ObstacleAnimation& started) -> bool {
+      obstacles = started.obstaclesAt(0);
+      return true;
+    });
+  QVERIFY(ok);
+  QVERIFY(!scriptRan);
+  QVERIFY(script.isEmpty());
+  QCOMPARE(obstacles, (QList<QPoint>{QPoint(2, 2)}));
+}
+
 QTEST_MAIN(TestLevelApplierAdapter)
 #include "test_level_applier_adapter.moc"
@@ -1,6 +1,9 @@
+#include <utility>
+
 #include <QtTest/QtTest>
 
 #include "adapter/level/script_runtime.h"
+#include "core/level/runtime.h"
 
 class TestLevelScriptRuntimeAdapter : public QObject {
   Q_OBJECT
@@ -9,6 +12,9 @@ private slots:
   void testTryApplyOnTickScriptParsesObstacleArray();
   void testTryApplyOnTickScriptRejectsMissingOrInvalidOnTick();
   void testApplyDynamicLevelFallbackDelegatesToCoreDynamicLevels();
+  void testCompiledScheduleMatchesLiveScriptForBuiltInLevels();
+  void testCompileObstacleScheduleRejectsImpureOrAperiodicScripts();
+  void testApplyObstacleScheduleSharesLayoutWithinPhase();
 };
 
 void TestLevelScriptRuntimeAdapter::testTryApplyOnTickScriptParsesObstacleArray() {
@@ -43,5 +49,77 @@ void TestLevelScriptRuntimeAdapter::testApplyDynamicLevelFallbackDelegatesToCore
   QVERIFY(obstacles.isEmpty());
 }
 
+namespace {
+// The scripts the dynamic built-in levels shipped with before they became declarative animations.
+const QString PulseScript = QStringLiteral(
+  "function onTick(tick) { var phases = [0,1,2,3,2,1]; "
+  "var offset = phases[Math.floor(tick / 12) % phases.length]; var x1 = 5 + offset; "
+  "var x2 = 15 - offset; return [{x: x1, y: 5}, {x: x1, y: 6}, {x: x2, y: 12}, {x: x2, y: 13}]; }");
+const QString CrossfireScript = QStringLiteral(
+  "function onTick(tick) { var phases = [0,1,2,1]; "
+  "var offset = phases[Math.floor(tick / 10) % phases.length]; var left = 5 + offset; "
+  "var right = 14 - offset; var top = 5 + offset; var bottom = 12 - offset; "
+  "return [{x:left,y:8},{x:left,y:9},{x:right,y:8},{x:right,y:9},{x:9,y:top},{x:10,y:bottom}]; }");
+} // namespace
+
+void TestLevelScriptRuntimeAdapter::testCompiledScheduleMatchesLiveScriptForBuiltInLevels() {
+  const QList<std::pair<int, QString>> levels{{2, PulseScript}, {4, CrossfireScript}};
+  for (const auto& [levelIndex, script] : levels) {
+    const auto level = nenoserpent::core::fallbackLevelData(levelIndex);
+    QVERIFY2(level.animation.has_value(), qPrintable(level.name));
+    const int periodTicks = level.animation->periodTicks();
+    const auto declared = nenoserpent::adapter::compileObstacleSchedule(script, periodTicks);
+    QVERIFY2(declared.has_value(), qPrintable(level.name));
+    QCOMPARE(declared->periodTicks(), periodTicks);
+    const auto detected = nenoserpent::adapter::compileObstacleSchedule(script, 0);
+    QVERIFY(detected.has_value());
+    QCOMPARE(detected->periodTicks(), periodTicks);
+
+    QJSEngine engine;
+    engine.evaluate(script);
+    for (int tick = 0; tick < 3 * periodTicks; ++tick) {
+      QList<QPoint> live;
+      QVERIFY(nenoserpent::adapter::tryApplyOnTickScript(engine, tick, live));
+      QCOMPARE(declared->obstaclesAt(tick), live);
+      QCOMPARE(*nenoserpent::core::dynamicObstaclesForLevel(level.name, tick), live);
+    }
+  }
+}
+
+void TestLevelScriptRuntimeAdapter::testCompileObstacleScheduleRejectsImpureOrAperiodicScripts() {
+  const QString counting = QStringLiteral(
+    "var calls = 0; function onTick(t){ calls++; return [{x: Math.floor(calls / 4) % 3, y: 1}]; }");
+  QVERIFY(!nenoserpent::adapter::compileObstacleSchedule(counting, 12).has_value());
+  QVERIFY(!nenoserpent::adapter::compileObstacleSchedule(counting, 0).has_value());
+
+  const QString aperiodic = QStringLiteral("function onTick(t){ return [{x: t, y: 1}]; }");
+  QVERIFY(!nenoserpent::adapter::compileObstacleSchedule(aperiodic, 0).has_value());
+
+  const QString wrongPeriod =
+    QStringLiteral("function onTick(t){ return [{x: Math.floor(t / 5) % 2, y: 1}]; }");
+  QVERIFY(!nenoserpent::adapter::compileObstacleSchedule(wrongPeriod, 7).has_value());
+  QCOMPARE(nenoserpent::adapter::compileObstacleSchedule(wrongPeriod, 20)->periodTicks(), 10);
+
+  QVERIFY(!nenoserpent::adapter::compileObstacleSchedule(QStringLiteral("var x = 1;"), 0));
+}
+
+void TestLevelScriptRuntimeAdapter::testApplyObstacleScheduleSharesLayoutWithinPhase() {
+  const auto schedule = nenoserpent::adapter::compileObstacleSchedule(PulseScript, 72);
+  QVERIFY(schedule.has_value());
+  QCOMPARE(schedule->phaseCount(), 4);
+
+  QList<QPoint> obstacles;
+  QVERIFY(nenoserpent::adapter::applyObstacleSchedule(*schedule, 0, obstacles));
+  QVERIFY(!nenoserpent::adapter::applyObstacleSchedule(*schedule, 11, obstacles));
+  QVERIFY(nenoserpent::adapter::applyObstacleSchedule(*schedule, 12, obstacles));
+  QCOMPARE(obstacles,
+           *nenoserpent::core::dynamicObstaclesForLevel(QStringLiteral("Dynamic Pulse"), 12));
+
+  // A layout edited in place (a laser removing a wall) is put back on the next tick.
+  obstacles.removeLast();
+  QVERIFY(nenoserpent::adapter::applyObstacleSchedule(*schedule, 13, obstacles));
+  QCOMPARE(obstacles.size(), 4);
+}
+
 QTEST_MAIN(TestLevelScriptRuntimeAdapter)
 #include "test_level_script_runtime_adapter.moc"
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
 #include <QCoreApplication>
 #include <QDir>
 #include <QFile>
@@ -11,6 +15,7 @@
 #include "adapter/engine.h"
 #include "adapter/ghost/store.h"
 #include "app_state.h"
+#include "core/replay/verify.h"
 #include "power_up_id.h"
 
 class TestEngineAdapter : public QObject {
@@ -85,7 +90,7 @@ private:
       const QPoint food = game.food();
 
       QPoint direction;
-      std::deque<QPoint> body;
+      nenoserpent::core::SnakeBody body;
       if ((attempt % 2) == 0) {
         if (food.x() >= 3) {
           direction = QPoint(1, 0);
@@ -132,6 +137,32 @@ private:
     QFAIL("Failed to consume the current food through the active session-step path");
   }
 
+  // A step toward the food that keeps off the body, or `direction` when none is free.
+  static auto stepTowardFood(const EngineAdapter& game, const QPoint& direction) -> QPoint {
+    const QPoint head = game.headPosition();
+    const auto& body = game.snakeModelPtr()->body();
+    QPoint best = direction;
+    int bestDistance = std::numeric_limits<int>::max();
+    for (const QPoint& step : nenoserpent::core::BoardSteps) {
+      if (step == -direction) {
+        continue;
+      }
+      const QPoint next =
+        nenoserpent::core::wrapPoint(head + step, game.boardWidth(), game.boardHeight());
+      if (std::ranges::find(body, next) != body.end() ||
+          game.obstacles().contains(QVariant::fromValue(next))) {
+        continue;
+      }
+      const int distance =
+        std::abs(next.x() - game.food().x()) + std::abs(next.y() - game.food().y());
+      if (distance < bestDistance) {
+        bestDistance = distance;
+        best = step;
+      }
+    }
+    return best;
+  }
+
 private slots:
   void initTestCase() {
     QStandardPaths::setTestModeEnabled(true);
@@ -436,6 +467,113 @@ private slots:
     QCOMPARE(game.snakeModelPtr()->body().front(), QPoint(11, 10));
   }
 
+  void testTurboReplayBatchesTicksIntoOneFrame() {
+    EngineAdapter game;
+    game.startGame();
+    game.move(1, 0);
+    game.forceUpdate();
+    consumeCurrentFood(game);
+    game.snakeModelPtr()->reset({QPoint(10, 10), QPoint(11, 10), QPoint(12, 10)});
+    game.setDirection(QPoint(1, 0));
+    game.forceUpdate();
+    QCOMPARE(game.state(), AppState::GameOver);
+
+    game.requestStateChange(AppState::StartMenu);
+    game.setReplaySpeed(8);
+    QCOMPARE(game.replaySpeed(), 1);
+    game.startReplay();
+    game.move(1, 0);
+    game.move(1, 0);
+    QCOMPARE(game.replaySpeed(), 8);
+
+    // qSleep keeps the event loop, and so the timer, out of the frame being measured.
+    QTest::qSleep(150);
+    QSignalSpy ghostSpy(&game, &EngineAdapter::ghostChanged);
+    QSignalSpy scoreSpy(&game, &EngineAdapter::scoreChanged);
+    QSignalSpy foodSpy(&game, &EngineAdapter::foodChanged);
+    QSignalSpy resetSpy(game.snakeModelPtr(), &QAbstractItemModel::modelReset);
+    const int before = game.currentTick();
+    game.forceUpdate();
+    QVERIFY(game.currentTick() >= before + 3);
+    QCOMPARE(ghostSpy.count(), 1);
+    QVERIFY(scoreSpy.count() <= 1);
+    QVERIFY(foodSpy.count() <= 1);
+    QCOMPARE(resetSpy.count(), 1);
+    QCOMPARE(game.snakeModelPtr()->body().front(), game.headPosition());
+
+    game.setReplaySpeed(EngineAdapter::UnlimitedReplaySpeed);
+    const int beforeUnlimited = game.currentTick();
+    scoreSpy.clear();
+    foodSpy.clear();
+    game.forceUpdate();
+    QVERIFY(game.currentTick() > beforeUnlimited + 1 || game.state() != AppState::Replaying);
+    // Eating inside a turbo frame is reported once, when the frame ends.
+    QVERIFY(scoreSpy.count() <= 1);
+    QVERIFY(foodSpy.count() <= 1);
+
+    game.requestStateChange(AppState::StartMenu);
+    QCOMPARE(game.replaySpeed(), 1);
+  }
+
+  void testInGameReplayMatchesHeadlessReplay() {
+    int liveScore = 0;
+    int replayScore = -1;
+    int replayTick = -1;
+    QList<QPoint> obstacles;
+    {
+      EngineAdapter game;
+      game.startGame();
+      QPoint direction(0, -1);
+      int choicesTaken = 0;
+      for (int tick = 0; tick < 4000 && game.state() != AppState::GameOver; ++tick) {
+        if (game.state() == AppState::ChoiceSelection) {
+          game.selectChoice(tick % 3);
+          ++choicesTaken;
+          continue;
+        }
+        // Chase food through two choices, then turn every tick until the snake bites itself.
+        direction = choicesTaken < 2 ? stepTowardFood(game, direction)
+                                     : QPoint(-direction.y(), direction.x());
+        game.move(direction.x(), direction.y());
+        game.forceUpdate();
+      }
+      QCOMPARE(game.state(), AppState::GameOver);
+      QVERIFY(choicesTaken > 0);
+      QVERIFY(game.hasReplay());
+      liveScore = game.score();
+      for (const QVariant& point : game.obstacles()) {
+        obstacles.append(point.toPoint());
+      }
+
+      game.requestStateChange(AppState::StartMenu);
+      game.startReplay();
+      for (int tick = 0; tick < 8000 && game.state() == AppState::Replaying; ++tick) {
+        replayScore = game.score();
+        replayTick = game.currentTick();
+        game.forceUpdate();
+      }
+      QCOMPARE(game.state(), AppState::StartMenu);
+    }
+
+    nenoserpent::adapter::GhostSnapshot ghost;
+    QVERIFY(nenoserpent::adapter::loadGhostSnapshot(ghost));
+    QVERIFY(!ghost.choiceHistory.isEmpty());
+    const nenoserpent::core::ReplayVerifyInput input{
+      .obstacles = obstacles,
+      .randomSeed = ghost.randomSeed,
+      .inputHistory = ghost.inputHistory,
+      .choiceHistory = ghost.choiceHistory,
+      .checksumHistory = ghost.checksumHistory,
+      .recording = ghost.recording,
+    };
+    nenoserpent::core::SessionRunner runner;
+    const auto verification = nenoserpent::core::verifyReplay(runner, input);
+    QCOMPARE(verification.verdict, nenoserpent::core::ReplayVerdict::Match);
+    QCOMPARE(verification.score, liveScore);
+    QCOMPARE(replayScore, liveScore);
+    QCOMPARE(replayTick, runner.core().tickCounter());
+  }
+
   void testCycleBotStrategyModeUpdatesStatusWithoutChangingBackend() {
     EngineAdapter game;
     const auto before = game.botStatus();
@@ -1,8 +1,12 @@
+#include <cstdint>
+#include <vector>
+
 #include <QDataStream>
 #include <QFile>
 #include <QTemporaryDir>
 #include <QtTest/QtTest>
 
+#include "adapter/ghost/codec.h"
 #include "adapter/ghost/store.h"
 
 using namespace Qt::StringLiterals;
@@ -13,31 +17,103 @@ class TestGhostStoreAdapter : public QObject {
 private slots:
   void testSaveAndLoadRoundTrip();
   void testLoadLegacyV2WithoutChoiceHistory();
+  void testLoadV4WithoutChecksumHistory();
+  void testLoadRejectsUnknownNewerMagic();
+  void testSaveWithoutRecordingKeepsMoveCount();
+  void testV5IsSmallerThanV4();
+  void testFileViewReadsHeaderAndRejectsTruncatedFiles();
+  void testDecodesCheckedInV5Fixture();
 };
 
+namespace {
+// A long straight run with a turn every few frames, shaped like a real recording.
+auto makeLongSnapshot() -> nenoserpent::adapter::GhostSnapshot {
+  nenoserpent::adapter::GhostSnapshot snapshot{.randomSeed = 0x9E3779B9U, .levelIndex = 4};
+  QPoint head(10, 10);
+  for (int frame = 0; frame < 2000; ++frame) {
+    const QPoint step = (frame / 6) % 2 == 0 ? QPoint(1, 0) : QPoint(0, 1);
+    head = QPoint((head.x() + step.x()) % 20, (head.y() + step.y()) % 18);
+    snapshot.recording.push_back(head);
+    if (frame % 6 == 0) {
+      snapshot.inputHistory.push_back({.frame = frame, .dx = step.x(), .dy = step.y()});
+    }
+    if (frame % 8 == 0) {
+      snapshot.checksumHistory.push_back(
+        {.frame = frame, .checksum = 0x9E3779B97F4A7C15ULL * static_cast<quint64>(frame + 1)});
+    }
+  }
+  snapshot.choiceHistory = {{.frame = 120, .index = 2}, {.frame = 900, .index = 0}};
+  return snapshot;
+}
+} // namespace
+
 void TestGhostStoreAdapter::testSaveAndLoadRoundTrip() {
   QTemporaryDir temporaryDir;
   QVERIFY(temporaryDir.isValid());
   const QString filePath = nenoserpent::adapter::ghostFilePathForDirectory(temporaryDir.path());
 
+  nenoserpent::core::ReplayKeyframe keyframe{
+    .frame = 16,
+    .rngDraws = 9,
+    .checksum = 0x1234ULL,
+    .recordedFrames = 15,
+  };
+  keyframe.session.snapshot.state.score = 5;
+  keyframe.session.snapshot.state.tickCounter = 16;
+  keyframe.session.snapshot.state.obstacles = {QPoint(0, 0)};
+  keyframe.session.snapshot.body = {QPoint(5, 5), QPoint(5, 6), QPoint(5, 7)};
+  keyframe.session.stallHashes = {3U, 1U, 2U};
+  keyframe.session.recentSpawnPoints = {QPoint(2, 2)};
+  keyframe.rng = nenoserpent::core::ReplayRng(42U);
+  keyframe.rng->discard(keyframe.rngDraws);
+
   const nenoserpent::adapter::GhostSnapshot input{
     .recording = {QPoint(1, 2), QPoint(3, 4)},
     .randomSeed = 42U,
     .inputHistory = {{.frame = 2, .dx = 1, .dy = 0}, {.frame = 5, .dx = 0, .dy = -1}},
     .levelIndex = 3,
     .choiceHistory = {{.frame = 8, .index = 1}},
+    .checksumHistory = {{.frame = 8, .checksum = 0xfeedfacecafebeefULL}},
+    .keyframes = {keyframe},
   };
   QVERIFY(nenoserpent::adapter::saveGhostSnapshotToFile(filePath, input));
 
+  QFile file(filePath);
+  QVERIFY(file.open(QIODevice::ReadOnly));
+  QDataStream magicStream(&file);
+  quint32 magic = 0;
+  magicStream >> magic;
+  QCOMPARE(magic, nenoserpent::adapter::GhostFileMagicV5);
+  file.close();
+
   nenoserpent::adapter::GhostSnapshot output;
   QVERIFY(nenoserpent::adapter::loadGhostSnapshotFromFile(filePath, output));
   QCOMPARE(output.recording, input.recording);
+  QCOMPARE(output.recordedMoves, 2);
   QCOMPARE(output.randomSeed, input.randomSeed);
   QCOMPARE(output.inputHistory.size(), input.inputHistory.size());
   QCOMPARE(output.inputHistory[0].frame, input.inputHistory[0].frame);
+  QCOMPARE(output.inputHistory[1].frame, input.inputHistory[1].frame);
+  QCOMPARE(output.inputHistory[1].dy, -1);
   QCOMPARE(output.levelIndex, input.levelIndex);
   QCOMPARE(output.choiceHistory.size(), input.choiceHistory.size());
   QCOMPARE(output.choiceHistory[0].index, input.choiceHistory[0].index);
+  QCOMPARE(output.checksumHistory.size(), 1);
+  QCOMPARE(output.checksumHistory[0].frame, 8);
+  QCOMPARE(output.checksumHistory[0].checksum, input.checksumHistory[0].checksum);
+  QCOMPARE(output.keyframes.size(), 1);
+  const auto& loaded = output.keyframes[0];
+  QCOMPARE(loaded.frame, keyframe.frame);
+  QCOMPARE(loaded.rngDraws, keyframe.rngDraws);
+  QCOMPARE(loaded.recordedFrames, keyframe.recordedFrames);
+  QCOMPARE(loaded.session.snapshot.state.score, 5);
+  QCOMPARE(loaded.session.snapshot.state.obstacles, keyframe.session.snapshot.state.obstacles);
+  QCOMPARE(loaded.session.snapshot.body.size(), std::size_t{3});
+  QCOMPARE(loaded.session.snapshot.body.back(), QPoint(5, 7));
+  QVERIFY(loaded.session.stallHashes == keyframe.session.stallHashes);
+  QCOMPARE(loaded.session.recentSpawnPoints, keyframe.session.recentSpawnPoints);
+  QVERIFY(loaded.rng.has_value());
+  QVERIFY(*loaded.rng == *keyframe.rng);
 }
 
 void TestGhostStoreAdapter::testLoadLegacyV2WithoutChoiceHistory() {
@@ -63,6 +139,178 @@ void TestGhostStoreAdapter::testLoadLegacyV2WithoutChoiceHistory() {
   QCOMPARE(output.inputHistory.size(), 1);
   QCOMPARE(output.levelIndex, levelIndex);
   QVERIFY(output.choiceHistory.isEmpty());
+  QCOMPARE(output.recordedMoves, 1);
+}
+
+void TestGhostStoreAdapter::testLoadV4WithoutChecksumHistory() {
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  const QString filePath = nenoserpent::adapter::ghostFilePathForDirectory(temporaryDir.path());
+
+  QFile file(filePath);
+  QVERIFY(file.open(QIODevice::WriteOnly));
+  QDataStream out(&file);
+  const quint32 magic = 0x534E4B04;
+  const QList<QPoint> recording{QPoint(4, 5)};
+  const uint randomSeed = 11U;
+  const QList<ReplayFrame> inputHistory{{.frame = 1, .dx = 0, .dy = 1}};
+  const int levelIndex = 1;
+  const QList<ChoiceRecord> choiceHistory{{.frame = 6, .index = 2}};
+  out << magic << recording << randomSeed << inputHistory << levelIndex << choiceHistory;
+  file.close();
+
+  nenoserpent::adapter::GhostSnapshot output;
+  output.checksumHistory = {{.frame = 1, .checksum = 1}};
+  QVERIFY(nenoserpent::adapter::loadGhostSnapshotFromFile(filePath, output));
+  QCOMPARE(output.recording, recording);
+  QCOMPARE(output.choiceHistory.size(), 1);
+  QVERIFY(output.checksumHistory.isEmpty());
+  QVERIFY(output.keyframes.isEmpty());
+  QCOMPARE(output.recordedMoves, 1);
+}
+
+void TestGhostStoreAdapter::testLoadRejectsUnknownNewerMagic() {
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  const QString filePath = nenoserpent::adapter::ghostFilePathForDirectory(temporaryDir.path());
+
+  // Laid out like a v2 file, but under a magic past v5: it must not load as v2.
+  QFile file(filePath);
+  QVERIFY(file.open(QIODevice::WriteOnly));
+  QDataStream out(&file);
+  out << quint32{0x534E4B06} << QList<QPoint>{QPoint(9, 9)} << 7U << QList<ReplayFrame>{} << 2;
+  file.close();
+
+  nenoserpent::adapter::GhostSnapshot output;
+  QVERIFY(!nenoserpent::adapter::loadGhostSnapshotFromFile(filePath, output));
+}
+
+void TestGhostStoreAdapter::testSaveWithoutRecordingKeepsMoveCount() {
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  const QString filePath = nenoserpent::adapter::ghostFilePathForDirectory(temporaryDir.path());
+
+  const nenoserpent::adapter::GhostSnapshot input = makeLongSnapshot();
+  QVERIFY(nenoserpent::adapter::saveGhostSnapshotToFile(
+    filePath, input, {.includeRecording = false}));
+
+  nenoserpent::adapter::GhostSnapshot output;
+  QVERIFY(nenoserpent::adapter::loadGhostSnapshotFromFile(filePath, output));
+  QVERIFY(output.recording.isEmpty());
+  QCOMPARE(output.recordedMoves, static_cast<int>(input.recording.size()));
+  QCOMPARE(output.randomSeed, input.randomSeed);
+  QCOMPARE(output.levelIndex, input.levelIndex);
+  QCOMPARE(output.inputHistory.size(), input.inputHistory.size());
+  for (qsizetype i = 0; i < input.inputHistory.size(); ++i) {
+    QCOMPARE(output.inputHistory[i].frame, input.inputHistory[i].frame);
+    QCOMPARE(output.inputHistory[i].dx, input.inputHistory[i].dx);
+    QCOMPARE(output.inputHistory[i].dy, input.inputHistory[i].dy);
+  }
+  QCOMPARE(output.choiceHistory.size(), 2);
+  QCOMPARE(output.choiceHistory[1].frame, 900);
+  QCOMPARE(output.checksumHistory.size(), input.checksumHistory.size());
+  QCOMPARE(output.checksumHistory.back().checksum, input.checksumHistory.back().checksum);
+}
+
+void TestGhostStoreAdapter::testV5IsSmallerThanV4() {
+  const nenoserpent::adapter::GhostSnapshot input = makeLongSnapshot();
+
+  QByteArray v4;
+  QDataStream out(&v4, QIODevice::WriteOnly);
+  out << quint32{0x534E4B04} << input.recording << input.randomSeed << input.inputHistory
+      << input.levelIndex << input.choiceHistory << input.checksumHistory << input.keyframes;
+
+  const QByteArray v5 = nenoserpent::adapter::encodeGhostV5(input, true);
+  const QByteArray v5Lean = nenoserpent::adapter::encodeGhostV5(input, false);
+  qInfo("ghost bytes v4=%lld v5=%lld v5-without-recording=%lld",
+        static_cast<long long>(v4.size()),
+        static_cast<long long>(v5.size()),
+        static_cast<long long>(v5Lean.size()));
+  QVERIFY(v5.size() * 2 < v4.size());
+  QVERIFY(v5Lean.size() < v5.size());
+
+  nenoserpent::adapter::GhostFileView view;
+  QVERIFY(view.openBytes(v5));
+  nenoserpent::adapter::GhostSnapshot output;
+  QVERIFY(view.decode(output));
+  QCOMPARE(output.recording, input.recording);
+}
+
+void TestGhostStoreAdapter::testFileViewReadsHeaderAndRejectsTruncatedFiles() {
+  using Section = nenoserpent::adapter::GhostFileView::Section;
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  const QString filePath = nenoserpent::adapter::ghostFilePathForDirectory(temporaryDir.path());
+  const nenoserpent::adapter::GhostSnapshot input = makeLongSnapshot();
+  QVERIFY(nenoserpent::adapter::saveGhostSnapshotToFile(filePath, input));
+
+  nenoserpent::adapter::GhostFileView view;
+  QVERIFY(view.open(filePath));
+  QCOMPARE(view.randomSeed(), input.randomSeed);
+  QCOMPARE(view.levelIndex(), input.levelIndex);
+  QCOMPARE(view.recordedMoves(), static_cast<int>(input.recording.size()));
+  QVERIFY(view.hasSection(Section::Recording));
+  QVERIFY(view.hasSection(Section::Checksums));
+  QVERIFY(!view.hasSection(Section::Keyframes));
+  QVERIFY(!view.hasSection(Section::KeyframeRng));
+
+  const QByteArray bytes = nenoserpent::adapter::encodeGhostV5(input, true);
+  const QByteArray truncated = bytes.left(bytes.size() - 5);
+  QVERIFY(!view.openBytes(truncated));
+  QVERIFY(!view.openBytes(bytes.left(6)));
+
+  // A section index that still fits but a payload cut short inside a varint fails to decode.
+  QByteArray corrupt = bytes;
+  corrupt[corrupt.size() - 1] = static_cast<char>(0x80);
+  QVERIFY(view.openBytes(corrupt));
+  nenoserpent::adapter::GhostSnapshot output;
+  QVERIFY(!view.decode(output));
+}
+
+// ghost_v5.bin holds the snapshot of testSaveAndLoadRoundTrip as written with its keyframe sections
+// at QDataStream::Qt_6_7; decoding and re-encoding it must reproduce the file byte for byte.
+void TestGhostStoreAdapter::testDecodesCheckedInV5Fixture() {
+  QFile fixture(QStringLiteral(NENOSERPENT_GHOST_FIXTURE_DIR "/ghost_v5.bin"));
+  QVERIFY(fixture.open(QIODevice::ReadOnly));
+  const QByteArray bytes = fixture.readAll();
+
+  nenoserpent::adapter::GhostFileView view;
+  QVERIFY(view.openBytes(bytes));
+  QVERIFY(view.hasSection(nenoserpent::adapter::GhostFileView::Section::Keyframes));
+  QVERIFY(view.hasSection(nenoserpent::adapter::GhostFileView::Section::KeyframeRng));
+  nenoserpent::adapter::GhostSnapshot output;
+  QVERIFY(view.decode(output));
+  QCOMPARE(output.randomSeed, 42U);
+  QCOMPARE(output.levelIndex, 3);
+  QCOMPARE(output.recording, (QList<QPoint>{QPoint(1, 2), QPoint(3, 4)}));
+  QCOMPARE(output.inputHistory.size(), 2);
+  QCOMPARE(output.inputHistory[1].frame, 5);
+  QCOMPARE(output.inputHistory[1].dy, -1);
+  QCOMPARE(output.choiceHistory.size(), 1);
+  QCOMPARE(output.choiceHistory[0].index, 1);
+  QCOMPARE(output.checksumHistory.size(), 1);
+  QCOMPARE(output.checksumHistory[0].checksum, 0xfeedfacecafebeefULL);
+
+  QCOMPARE(output.keyframes.size(), 1);
+  const auto& keyframe = output.keyframes[0];
+  QCOMPARE(keyframe.frame, 16);
+  QCOMPARE(keyframe.rngDraws, quint64{9});
+  QCOMPARE(keyframe.checksum, quint64{0x1234});
+  QCOMPARE(keyframe.recordedFrames, 15);
+  QCOMPARE(keyframe.session.snapshot.state.score, 5);
+  QCOMPARE(keyframe.session.snapshot.state.tickCounter, 16);
+  QCOMPARE(keyframe.session.snapshot.state.lastRoguelikeChoiceScore, -1000);
+  QCOMPARE(keyframe.session.snapshot.state.obstacles, QList<QPoint>{QPoint(0, 0)});
+  QCOMPARE(keyframe.session.snapshot.body.size(), std::size_t{3});
+  QCOMPARE(keyframe.session.snapshot.body.back(), QPoint(5, 7));
+  QVERIFY(keyframe.session.stallHashes == (std::vector<std::uint64_t>{3U, 1U, 2U}));
+  QCOMPARE(keyframe.session.recentSpawnPoints, QList<QPoint>{QPoint(2, 2)});
+  nenoserpent::core::ReplayRng expected(42U);
+  expected.discard(9);
+  QVERIFY(keyframe.rng.has_value());
+  QVERIFY(*keyframe.rng == expected);
+
+  QCOMPARE(nenoserpent::adapter::encodeGhostV5(output, true), bytes);
 }
 
 QTEST_MAIN(TestGhostStoreAdapter)
@@ -0,0 +1,86 @@
+#include <QCoreApplication>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QtTest>
+
+#include "profile_manager.h"
+
+class TestProfileWriteBehindAdapter : public QObject {
+  Q_OBJECT
+
+private slots:
+  void initTestCase();
+  void init();
+  void testStatsAreNotWrittenPerEvent();
+  void testProfileValuesAreWrittenBehind();
+  void testTimerBoundsTheLossWindow();
+  void testDestructorFlushes();
+};
+
+void TestProfileWriteBehindAdapter::initTestCase() {
+  QStandardPaths::setTestModeEnabled(true);
+  QCoreApplication::setOrganizationName("NenoSerpentTests");
+  QCoreApplication::setApplicationName("ProfileWriteBehindTest");
+}
+
+void TestProfileWriteBehindAdapter::init() {
+  QSettings settings;
+  settings.clear();
+  settings.sync();
+}
+
+void TestProfileWriteBehindAdapter::testStatsAreNotWrittenPerEvent() {
+  ProfileManager profile;
+  for (int i = 0; i < 200; ++i) {
+    profile.logFoodEaten();
+  }
+  profile.incrementCrashes();
+  QCOMPARE(profile.totalFoodEaten(), 200);
+  QVERIFY(profile.hasPendingWrites());
+  QVERIFY(!QSettings().contains("stats/food"));
+
+  profile.flushPendingWrites();
+  QVERIFY(!profile.hasPendingWrites());
+  const QSettings settings;
+  QCOMPARE(settings.value("stats/food").toInt(), 200);
+  QCOMPARE(settings.value("stats/crashes").toInt(), 1);
+}
+
+void TestProfileWriteBehindAdapter::testProfileValuesAreWrittenBehind() {
+  {
+    ProfileManager profile;
+    profile.updateHighScore(42);
+    QVERIFY(profile.unlockMedal("Gold Medal (50 Pts)"));
+    QVERIFY(profile.discoverFruit(3));
+    QCOMPARE(profile.highScore(), 42);
+    QVERIFY(!QSettings().contains("highScore"));
+    profile.flushPendingWrites();
+  }
+  const ProfileManager reloaded;
+  QCOMPARE(reloaded.highScore(), 42);
+  QCOMPARE(reloaded.unlockedMedals(), QStringList{"Gold Medal (50 Pts)"});
+  QCOMPARE(reloaded.discoveredFruits(), QList<int>{3});
+}
+
+void TestProfileWriteBehindAdapter::testTimerBoundsTheLossWindow() {
+  ProfileManager profile;
+  profile.logFoodEaten();
+  QVERIFY(profile.hasPendingWrites());
+  QTRY_VERIFY_WITH_TIMEOUT(!profile.hasPendingWrites(),
+                           ProfileManager::WriteBehindIntervalMs + 2000);
+  QCOMPARE(QSettings().value("stats/food").toInt(), 1);
+}
+
+void TestProfileWriteBehindAdapter::testDestructorFlushes() {
+  {
+    ProfileManager profile;
+    profile.logFoodEaten();
+    profile.incrementCrashes();
+  }
+  const QSettings settings;
+  QCOMPARE(settings.value("stats/food").toInt(), 1);
+  QCOMPARE(settings.value("stats/crashes").toInt(), 1);
+}
+
+QTEST_MAIN(TestProfileWriteBehindAdapter)
+#include "test_profile_write_behind_adapter.moc"
@@ -0,0 +1,121 @@
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "adapter/session/store.h"
+
+using namespace Qt::StringLiterals;
+
+class TestSessionStoreAdapter : public QObject {
+  Q_OBJECT
+
+private slots:
+  void testEncodeDecodeRoundTrip();
+  void testDecodeRejectsBadHeaderAndTruncatedInput();
+  void testSaveAndLoadFileRoundTrip();
+};
+
+namespace {
+auto makeSession() -> nenoserpent::adapter::PersistedSession {
+  nenoserpent::adapter::PersistedSession session{
+    .randomSeed = 0xC0FFEEU,
+    .rngDraws = 41,
+    .levelIndex = 3,
+    .rollingChecksum = 0xDEADBEEFCAFEULL,
+    .recording = {QPoint(5, 4), QPoint(5, 3), QPoint(6, 3)},
+    .inputHistory = {{.frame = 2, .dx = 1, .dy = 0}},
+    .choiceHistory = {{.frame = 1, .index = 2}},
+    .checksumHistory = {{.frame = 0, .checksum = 7U}, {.frame = 2, .checksum = 9U}},
+  };
+  auto& snapshot = session.session.snapshot;
+  snapshot.state.score = 12;
+  snapshot.state.tickCounter = 3;
+  snapshot.state.food = QPoint(8, 9);
+  snapshot.state.direction = QPoint(1, 0);
+  snapshot.state.obstacles = {QPoint(0, 0), QPoint(1, 0)};
+  snapshot.body = {QPoint(6, 3), QPoint(5, 3), QPoint(5, 4)};
+  session.session.stallNoScoreTicks = 4;
+  session.session.stallHashes = {11U, 12U};
+  session.session.recentSpawnPoints = {QPoint(2, 2)};
+  session.rng.reseed(session.randomSeed);
+  session.rng.discard(session.rngDraws);
+  nenoserpent::core::ReplayRng keyframeRng(session.randomSeed);
+  keyframeRng.discard(17);
+  session.keyframes = {
+    {.frame = 2, .rngDraws = 17, .session = session.session, .rng = keyframeRng},
+  };
+  return session;
+}
+
+void verifySame(const nenoserpent::adapter::PersistedSession& actual,
+                const nenoserpent::adapter::PersistedSession& expected) {
+  QCOMPARE(actual.randomSeed, expected.randomSeed);
+  QCOMPARE(actual.rngDraws, expected.rngDraws);
+  QVERIFY(actual.rng == expected.rng);
+  QCOMPARE(actual.keyframes.size(), expected.keyframes.size());
+  QCOMPARE(actual.keyframes.front().frame, expected.keyframes.front().frame);
+  QVERIFY(actual.keyframes.front().rng == expected.keyframes.front().rng);
+  QCOMPARE(actual.levelIndex, expected.levelIndex);
+  QCOMPARE(actual.rollingChecksum, expected.rollingChecksum);
+  QCOMPARE(actual.recording, expected.recording);
+  QCOMPARE(actual.inputHistory.size(), expected.inputHistory.size());
+  QCOMPARE(actual.inputHistory.front().frame, expected.inputHistory.front().frame);
+  QCOMPARE(actual.choiceHistory.front().index, expected.choiceHistory.front().index);
+  QCOMPARE(actual.checksumHistory.back().checksum, expected.checksumHistory.back().checksum);
+  QVERIFY(actual.exact);
+
+  const auto& state = actual.session.snapshot.state;
+  QCOMPARE(state.score, expected.session.snapshot.state.score);
+  QCOMPARE(state.tickCounter, expected.session.snapshot.state.tickCounter);
+  QCOMPARE(state.food, expected.session.snapshot.state.food);
+  QCOMPARE(state.direction, expected.session.snapshot.state.direction);
+  QCOMPARE(state.obstacles, expected.session.snapshot.state.obstacles);
+  QVERIFY(actual.session.snapshot.body == expected.session.snapshot.body);
+  QCOMPARE(actual.session.stallNoScoreTicks, expected.session.stallNoScoreTicks);
+  QVERIFY(actual.session.stallHashes == expected.session.stallHashes);
+  QCOMPARE(actual.session.recentSpawnPoints, expected.session.recentSpawnPoints);
+}
+} // namespace
+
+void TestSessionStoreAdapter::testEncodeDecodeRoundTrip() {
+  const auto session = makeSession();
+  const QByteArray bytes = nenoserpent::adapter::encodePersistedSession(session);
+  const auto decoded = nenoserpent::adapter::decodePersistedSession(bytes);
+  QVERIFY(decoded.has_value());
+  verifySame(*decoded, session);
+}
+
+void TestSessionStoreAdapter::testDecodeRejectsBadHeaderAndTruncatedInput() {
+  const QByteArray bytes = nenoserpent::adapter::encodePersistedSession(makeSession());
+
+  QByteArray badMagic = bytes;
+  badMagic[0] = static_cast<char>(badMagic.at(0) ^ 0x40);
+  QVERIFY(!nenoserpent::adapter::decodePersistedSession(badMagic).has_value());
+
+  QByteArray badVersion = bytes;
+  badVersion[5] = static_cast<char>(nenoserpent::adapter::SessionFileVersion + 1);
+  QVERIFY(!nenoserpent::adapter::decodePersistedSession(badVersion).has_value());
+
+  QVERIFY(!nenoserpent::adapter::decodePersistedSession(bytes.left(bytes.size() - 3)).has_value());
+  QVERIFY(!nenoserpent::adapter::decodePersistedSession(bytes.left(6)).has_value());
+  QVERIFY(!nenoserpent::adapter::decodePersistedSession({}).has_value());
+}
+
+void TestSessionStoreAdapter::testSaveAndLoadFileRoundTrip() {
+  QTemporaryDir temporaryDir;
+  QVERIFY(temporaryDir.isValid());
+  const QString filePath = nenoserpent::adapter::sessionFilePathForDirectory(temporaryDir.path());
+  QVERIFY(!nenoserpent::adapter::loadPersistedSessionFromFile(filePath).has_value());
+
+  const auto session = makeSession();
+  QVERIFY(nenoserpent::adapter::savePersistedSessionToFile(filePath, session));
+  const auto loaded = nenoserpent::adapter::loadPersistedSessionFromFile(filePath);
+  QVERIFY(loaded.has_value());
+  verifySame(*loaded, session);
+
+  QVERIFY(QFile::remove(filePath));
+  QVERIFY(!nenoserpent::adapter::loadPersistedSessionFromFile(filePath).has_value());
+}
+
+QTEST_MAIN(TestSessionStoreAdapter)
+#include "test_session_store_adapter.moc"
@@ -1,14 +1,24 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <deque>
+#include <unordered_map>
+#include <vector>
 
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QRandomGenerator>
 #include <QtTest/QtTest>
 
 #include "core/achievement/rules.h"
 #include "core/buff/runtime.h"
 #include "core/choice/runtime.h"
+#include "core/game/body.h"
+#include "core/game/hash_window.h"
+#include "core/game/random.h"
 #include "core/game/rules.h"
+#include "core/game/zobrist.h"
 #include "core/level/runtime.h"
 #include "core/replay/timeline.h"
 #include "game_engine_interface.h"
@@ -20,21 +30,32 @@ class TestCoreRules : public QObject {
   Q_OBJECT
 
 private slots:
+  void testStandardBoardGeometryMatchesRuntimeGeometry();
   void testCollectFreeSpotsRespectsPredicate();
   void testPickRandomFreeSpotUsesProvidedIndexAndHandlesEdgeCases();
+  void testOccupancyFreeCellsMatchPredicateScanOrder();
+  void testHashWindowMatchesDequeAndMapBookkeeping();
+  void testZobristBodyHashUpdatesIncrementally();
+  void testSnakeBodyRingMatchesDequeAcrossWrapAndGrowth();
   void testMagnetCandidateSpotsPrioritizesXAxisWhenDistanceIsGreater();
   void testProbeCollisionRespectsGhostFlag();
+  void testOccupancyGridProbeMatchesListProbe();
   void testCollisionOutcomeMatchesPortalLaserAndShieldSemantics();
   void testTickIntervalForScoreUsesSpeedFloor();
   void testPickRoguelikeChoicesIsBoundedAndDeterministic();
   void testDynamicLevelFallbackProducesObstacles();
+  void testBuiltInLevelsComeFromCompiledCatalog();
   void testWallsFromJsonArrayParsesCoordinates();
   void testResolvedLevelDataFromJsonMapsIndexAndFields();
+  void testObstacleAnimationFromJsonLaysOutPhasedGroups();
+  void testMalformedLevelAnimationFallsBackToBuiltInLevel();
   void testResolvedLevelDataFromJsonBytesParsesDocumentEnvelope();
   void testLevelCountFromJsonBytesUsesFallbackOnInvalidData();
   void testBuffRuntimeRules();
   void testTickBuffCountdown();
   void testWeightedRandomBuffIdUsesWeightsAndFallback();
+  void testCounterRngIsSeekableSplittableAndBounded();
+  void testReplayRngMatchesQRandomGeneratorAndRestores();
   void testReplayTimelineAppliesOnlyOnMatchingTicks();
   void testAchievementRulesUseRuntimeStats();
 };
@@ -85,10 +106,6 @@ public:
   [[nodiscard]] auto hasReplay() const -> bool override {
     return !inputFrames.isEmpty();
   }
-  auto advanceSessionStep(const nenoserpent::core::SessionAdvanceConfig&)
-    -> nenoserpent::core::SessionAdvanceResult override {
-    return {};
-  }
   void restart() override {
   }
   void startReplay() override {
@@ -153,6 +170,34 @@ public:
   }
 };
 
+void TestCoreRules::testStandardBoardGeometryMatchesRuntimeGeometry() {
+  using nenoserpent::core::BoardGeometry;
+  using nenoserpent::core::BoardSteps;
+  using nenoserpent::core::StandardBoardGeometry;
+  const BoardGeometry runtime(nenoserpent::core::StandardBoardWidth,
+                              nenoserpent::core::StandardBoardHeight);
+  QCOMPARE(StandardBoardGeometry::cellCount(), runtime.cellCount());
+
+  for (int cell = 0; cell < static_cast<int>(runtime.cellCount()); ++cell) {
+    QCOMPARE(StandardBoardGeometry::cellPoint(cell), runtime.cellPoint(cell));
+    QCOMPARE(StandardBoardGeometry::cellIndex(runtime.cellPoint(cell)), cell);
+    for (std::size_t step = 0; step < BoardSteps.size(); ++step) {
+      QCOMPARE(StandardBoardGeometry::neighbor(cell, step), runtime.neighbor(cell, step));
+    }
+  }
+
+  // Inside the tables' one-board margin and well past it, where the fallback takes over.
+  for (int y = -40; y < 60; ++y) {
+    for (int x = -45; x < 65; ++x) {
+      const QPoint point(x, y);
+      QCOMPARE(StandardBoardGeometry::wrapPoint(point), runtime.wrapPoint(point));
+      QCOMPARE(nenoserpent::core::wrapPoint(point, 20, 18), runtime.wrapPoint(point));
+    }
+  }
+  QCOMPARE(nenoserpent::core::wrapPoint(QPoint(-1, 18), 7, 5), QPoint(6, 3));
+  QCOMPARE(nenoserpent::core::boardStepIndex(QPoint(0, -1)), std::size_t{3});
+}
+
 void TestCoreRules::testCollectFreeSpotsRespectsPredicate() {
   const QList<QPoint> freeSpots =
     nenoserpent::core::collectFreeSpots(3, 2, [](const QPoint& point) -> bool {
@@ -189,6 +234,161 @@ void TestCoreRules::testPickRandomFreeSpotUsesProvidedIndexAndHandlesEdgeCases()
   QVERIFY(!noFreeSpot);
 }
 
+void TestCoreRules::testOccupancyFreeCellsMatchPredicateScanOrder() {
+  nenoserpent::core::OccupancyGrid grid;
+  grid.resize(7, 5);
+  grid.addObstacle(QPoint(0, 0));
+  grid.addObstacle(QPoint(3, 2));
+  grid.addBody(QPoint(4, 4));
+  grid.addBody(QPoint(4, 3));
+  grid.addBody(QPoint(5, 3));
+  grid.removeBody(QPoint(4, 4));
+  grid.addBody(QPoint(3, 2));
+  grid.removeObstacle(QPoint(3, 2));
+  const QPoint reserved(6, 1);
+
+  const auto isBlocked = [&grid, &reserved](const QPoint& point) -> bool {
+    return grid.isOccupied(point) || point == reserved;
+  };
+  const QList<QPoint> expected = nenoserpent::core::collectFreeSpots(7, 5, isBlocked);
+  QCOMPARE(grid.freeCount(reserved), static_cast<int>(expected.size()));
+  QCOMPARE(grid.freeCount(), static_cast<int>(expected.size()) + 1);
+
+  QList<QPoint> dense;
+  for (int rank = 0; rank < expected.size(); ++rank) {
+    QPoint legacy;
+    QPoint fast;
+    const auto pickRank = [rank](int) -> int { return rank; };
+    QVERIFY(nenoserpent::core::pickRandomFreeSpot(7, 5, isBlocked, pickRank, legacy));
+    QVERIFY(nenoserpent::core::pickRandomFreeSpot(
+      grid, reserved, nenoserpent::core::FreeCellOrder::Scan, pickRank, fast));
+    QCOMPARE(fast, legacy);
+    dense.append(grid.freeCellAt(rank, nenoserpent::core::FreeCellOrder::Dense, reserved));
+  }
+
+  // Dense order is history dependent but must still cover every free cell exactly once.
+  std::ranges::sort(dense, [](const QPoint& a, const QPoint& b) {
+    return a.x() != b.x() ? a.x() < b.x() : a.y() < b.y();
+  });
+  QCOMPARE(dense, expected);
+
+  QPoint unused;
+  QVERIFY(!nenoserpent::core::pickRandomFreeSpot(
+    grid, reserved, nenoserpent::core::FreeCellOrder::Scan, [](int) { return -1; }, unused));
+}
+
+void TestCoreRules::testHashWindowMatchesDequeAndMapBookkeeping() {
+  constexpr int window = 24;
+  nenoserpent::core::HashWindow hashes(window);
+  std::deque<std::uint64_t> recent;
+  std::unordered_map<std::uint64_t, int> counts;
+
+  std::uint64_t lcg = 7;
+  for (int i = 0; i < 4000; ++i) {
+    lcg = (lcg * 6364136223846793005ULL) + 1442695040888963407ULL;
+    // Few distinct keys with colliding low bits keep probe runs long and deletions frequent.
+    const std::uint64_t hash = ((lcg >> 40U) % 37U) << 48U;
+
+    const int expected = ++counts[hash];
+    recent.push_back(hash);
+    while (static_cast<int>(recent.size()) > window) {
+      if (--counts[recent.front()] == 0) {
+        counts.erase(recent.front());
+      }
+      recent.pop_front();
+    }
+
+    QCOMPARE(hashes.observe(hash), expected);
+    QCOMPARE(hashes.size(), static_cast<int>(recent.size()));
+    for (std::uint64_t probe = 0; probe < 37U; ++probe) {
+      const auto it = counts.find(probe << 48U);
+      QCOMPARE(hashes.countOf(probe << 48U), it == counts.end() ? 0 : it->second);
+    }
+
+    // Clearing a wrapped, colliding window must empty every slot so later counts restart at one.
+    if (i % 1000 == 999) {
+      hashes.clear();
+      recent.clear();
+      counts.clear();
+      for (std::uint64_t probe = 0; probe < 37U; ++probe) {
+        QCOMPARE(hashes.countOf(probe << 48U), 0);
+      }
+    }
+  }
+
+  hashes.clear();
+  QCOMPARE(hashes.size(), 0);
+  QCOMPARE(hashes.countOf(recent.back()), 0);
+}
+
+void TestCoreRules::testSnakeBodyRingMatchesDequeAcrossWrapAndGrowth() {
+  nenoserpent::core::SnakeBody body{QPoint(2, 0), QPoint(1, 0), QPoint(0, 0)};
+  std::deque<QPoint> reference{QPoint(2, 0), QPoint(1, 0), QPoint(0, 0)};
+  body.reserve(8);
+  const std::size_t capacity = body.capacity();
+
+  auto matches = [&]() -> bool {
+    return body.size() == reference.size() &&
+           std::equal(body.begin(), body.end(), reference.begin(), reference.end());
+  };
+
+  // Slide far enough for the head to wrap around the ring several times.
+  for (int step = 3; step < 40; ++step) {
+    body.push_front(QPoint(step % 20, step / 20));
+    reference.push_front(QPoint(step % 20, step / 20));
+    if (step % 5 != 0) {
+      body.pop_back();
+      reference.pop_back();
+    }
+    QVERIFY(matches());
+    if (reference.size() < capacity) {
+      QCOMPARE(body.capacity(), capacity);
+    }
+  }
+  QVERIFY(body.capacity() >= body.size());
+  QCOMPARE(body.front(), reference.front());
+  QCOMPARE(body.back(), reference.back());
+  QCOMPARE(body[3], reference[3]);
+
+  nenoserpent::core::SnakeBody copy = body;
+  QVERIFY(copy == body);
+  QCOMPARE(std::ranges::find(copy, reference[4]) - copy.begin(), 4);
+
+  // Copy-assignment into a larger ring keeps that ring.
+  nenoserpent::core::SnakeBody board;
+  board.reserve(360);
+  board = copy;
+  QCOMPARE(board.capacity(), std::size_t{512});
+  QVERIFY(board == body);
+  board.pop_back();
+  QVERIFY(board != body);
+}
+
+void TestCoreRules::testZobristBodyHashUpdatesIncrementally() {
+  nenoserpent::core::SnakeBody body{QPoint(5, 5), QPoint(4, 5), QPoint(3, 5)};
+  std::uint64_t hash = nenoserpent::core::zobristBodyHash(body);
+
+  body.push_front(QPoint(6, 5));
+  hash ^= nenoserpent::core::zobristCellKey(QPoint(6, 5));
+  hash ^= nenoserpent::core::zobristCellKey(body.back());
+  body.pop_back();
+  QCOMPARE(hash, nenoserpent::core::zobristBodyHash(body));
+  QVERIFY(hash != nenoserpent::core::zobristBodyHash({QPoint(5, 5), QPoint(4, 5), QPoint(3, 5)}));
+
+  const nenoserpent::core::LoopStateKey key{
+    .bodyHash = hash,
+    .bodyLength = body.size(),
+    .head = body.front(),
+    .tail = body.back(),
+    .direction = QPoint(1, 0),
+    .food = QPoint(9, 9),
+  };
+  auto turned = key;
+  turned.direction = QPoint(0, 1);
+  QCOMPARE(nenoserpent::core::loopStateHash(key), nenoserpent::core::loopStateHash(key));
+  QVERIFY(nenoserpent::core::loopStateHash(key) != nenoserpent::core::loopStateHash(turned));
+}
+
 void TestCoreRules::testMagnetCandidateSpotsPrioritizesXAxisWhenDistanceIsGreater() {
   const QList<QPoint> candidates =
     nenoserpent::core::magnetCandidateSpots(QPoint(1, 1), QPoint(9, 2), 20, 20);
@@ -198,7 +398,7 @@ void TestCoreRules::testMagnetCandidateSpotsPrioritizesXAxisWhenDistanceIsGreate
 
 void TestCoreRules::testProbeCollisionRespectsGhostFlag() {
   const QList<QPoint> obstacles{QPoint(3, 3)};
-  const std::deque<QPoint> snakeBody{QPoint(5, 5), QPoint(4, 5)};
+  const nenoserpent::core::SnakeBody snakeBody{QPoint(5, 5), QPoint(4, 5)};
 
   const nenoserpent::core::CollisionProbe obstacleHit =
     nenoserpent::core::probeCollision(QPoint(3, 3), obstacles, snakeBody, false);
@@ -211,9 +411,49 @@ void TestCoreRules::testProbeCollisionRespectsGhostFlag() {
   QVERIFY(!ghostBodyProbe.hitsBody);
 }
 
+void TestCoreRules::testOccupancyGridProbeMatchesListProbe() {
+  const QList<QPoint> obstacles{QPoint(3, 3), QPoint(7, 2)};
+  const nenoserpent::core::SnakeBody snakeBody{QPoint(5, 5), QPoint(4, 5), QPoint(4, 5)};
+
+  nenoserpent::core::OccupancyGrid grid;
+  grid.resize(20, 18);
+  for (const QPoint& obstacle : obstacles) {
+    grid.addObstacle(obstacle);
+  }
+  for (const QPoint& segment : snakeBody) {
+    grid.addBody(segment);
+  }
+
+  for (int y = 0; y < 18; ++y) {
+    for (int x = 0; x < 20; ++x) {
+      const QPoint point(x, y);
+      for (const bool ghost : {false, true}) {
+        const auto fromList = nenoserpent::core::probeCollision(point, obstacles, snakeBody, ghost);
+        const auto fromGrid = nenoserpent::core::probeCollision(point, obstacles, grid, ghost);
+        QCOMPARE(fromGrid.hitsObstacle, fromList.hitsObstacle);
+        QCOMPARE(fromGrid.obstacleIndex, fromList.obstacleIndex);
+        QCOMPARE(fromGrid.hitsBody, fromList.hitsBody);
+      }
+    }
+  }
+
+  // Overlapping segments keep the cell occupied until the last one leaves.
+  grid.removeBody(QPoint(4, 5));
+  QVERIFY(grid.hasBody(QPoint(4, 5)));
+  grid.removeBody(QPoint(4, 5));
+  QVERIFY(!grid.hasBody(QPoint(4, 5)));
+  QVERIFY(grid.isOccupied(QPoint(7, 2)));
+  QVERIFY(!grid.isOccupied(QPoint(-1, 2)));
+
+  const auto laserOutcome = nenoserpent::core::collisionOutcomeForHead(
+    QPoint(27, 2), 20, 18, obstacles, grid, false, false, true, false);
+  QVERIFY(laserOutcome.consumeLaser);
+  QCOMPARE(laserOutcome.obstacleIndex, 1);
+}
+
 void TestCoreRules::testCollisionOutcomeMatchesPortalLaserAndShieldSemantics() {
   const QList<QPoint> obstacles{QPoint(3, 3)};
-  const std::deque<QPoint> snakeBody{QPoint(5, 5), QPoint(4, 5)};
+  const nenoserpent::core::SnakeBody snakeBody{QPoint(5, 5), QPoint(4, 5)};
 
   const nenoserpent::core::CollisionOutcome portalOutcome =
     nenoserpent::core::collisionOutcomeForHead(
@@ -290,6 +530,26 @@ void TestCoreRules::testDynamicLevelFallbackProducesObstacles() {
   QVERIFY(!unknown.has_value());
 }
 
+void TestCoreRules::testBuiltInLevelsComeFromCompiledCatalog() {
+  const auto& levels = nenoserpent::core::builtInLevels();
+  QCOMPARE(levels.size(), 6);
+  QCOMPARE(levels.at(0).name, QString("Classic"));
+  QVERIFY(levels.at(0).walls.isEmpty());
+  QCOMPARE(levels.at(1).walls.size(), 8);
+  QCOMPARE(levels.at(1).walls.first(), QPoint(5, 5));
+  QVERIFY(!levels.at(1).animation.has_value());
+
+  const auto& pulse = levels.at(2);
+  QCOMPARE(pulse.name, QString("Dynamic Pulse"));
+  QVERIFY(pulse.script.isEmpty());
+  QVERIFY(pulse.animation.has_value());
+  QCOMPARE(pulse.animation->periodTicks(), 72);
+  QCOMPARE(pulse.animation->groups.size(), 2);
+
+  QCOMPARE(nenoserpent::core::fallbackLevelData(8).name, levels.at(2).name);
+  QCOMPARE(nenoserpent::core::normalizedFallbackLevelIndex(-1), 5);
+}
+
 void TestCoreRules::testWallsFromJsonArrayParsesCoordinates() {
   QJsonArray wallsJson;
   wallsJson.append(QJsonObject{{"x", 1}, {"y", 2}});
@@ -303,7 +563,8 @@ void TestCoreRules::testWallsFromJsonArrayParsesCoordinates() {
 
 void TestCoreRules::testResolvedLevelDataFromJsonMapsIndexAndFields() {
   QJsonArray levels;
-  levels.append(QJsonObject{{"name", "L0"}, {"script", "function onTick(t){return [];}"}});
+  levels.append(QJsonObject{
+    {"name", "L0"}, {"script", "function onTick(t){return [];}"}, {"periodTicks", 24}});
   levels.append(QJsonObject{
     {"name", "L1"},
     {"script", ""},
@@ -314,11 +575,13 @@ void TestCoreRules::testResolvedLevelDataFromJsonMapsIndexAndFields() {
   QCOMPARE(resolvedScript->name, QString("L0"));
   QVERIFY(!resolvedScript->script.isEmpty());
   QVERIFY(resolvedScript->walls.isEmpty());
+  QCOMPARE(resolvedScript->scriptPeriodTicks, 24);
 
   const auto resolvedWalls = nenoserpent::core::resolvedLevelDataFromJson(levels, 3);
   QVERIFY(resolvedWalls.has_value());
   QCOMPARE(resolvedWalls->name, QString("L1"));
   QVERIFY(resolvedWalls->script.isEmpty());
+  QCOMPARE(resolvedWalls->scriptPeriodTicks, 0);
   QCOMPARE(resolvedWalls->walls.size(), 2);
   QCOMPARE(resolvedWalls->walls[0], QPoint(3, 4));
   QCOMPARE(resolvedWalls->walls[1], QPoint(5, 6));
@@ -327,6 +590,63 @@ void TestCoreRules::testResolvedLevelDataFromJsonMapsIndexAndFields() {
   QVERIFY(!empty.has_value());
 }
 
+void TestCoreRules::testObstacleAnimationFromJsonLaysOutPhasedGroups() {
+  const QJsonObject animationJson{
+    {"phaseTicks", 3},
+    {"phases", QJsonArray{0, 2, 1}},
+    {"groups",
+     QJsonArray{QJsonObject{{"walls", QJsonArray{QJsonObject{{"x", 4}, {"y", 1}}}},
+                            {"step", QJsonObject{{"x", 1}, {"y", 0}}}},
+                QJsonObject{{"walls", QJsonArray{QJsonObject{{"x", 9}, {"y", 9}}}},
+                            {"step", QJsonObject{{"x", 0}, {"y", -2}}}}}}};
+  const auto animation = nenoserpent::core::obstacleAnimationFromJson(animationJson);
+  QVERIFY(animation.has_value());
+  QCOMPARE(animation->periodTicks(), 9);
+  QCOMPARE(animation->obstaclesAt(2), (QList<QPoint>{QPoint(4, 1), QPoint(9, 9)}));
+  QCOMPARE(animation->obstaclesAt(3), (QList<QPoint>{QPoint(6, 1), QPoint(9, 5)}));
+  QCOMPARE(animation->obstaclesAt(15), (QList<QPoint>{QPoint(5, 1), QPoint(9, 7)}));
+
+  const auto schedule = nenoserpent::core::ObstacleSchedule::fromAnimation(*animation);
+  QVERIFY(schedule.has_value());
+  QCOMPARE(schedule->periodTicks(), 9);
+  QCOMPARE(schedule->phaseCount(), 3);
+  for (int tick = 0; tick < 20; ++tick) {
+    QCOMPARE(schedule->obstaclesAt(tick), animation->obstaclesAt(tick));
+  }
+  QVERIFY(schedule->obstaclesAt(3).isSharedWith(schedule->obstaclesAt(5)));
+
+  QJsonArray levels;
+  levels.append(QJsonObject{{"name", "Animated"}, {"animation", animationJson}});
+  const auto resolved = nenoserpent::core::resolvedLevelDataFromJson(levels, 0);
+  QVERIFY(resolved.has_value());
+  QVERIFY(resolved->animation.has_value());
+  QVERIFY(resolved->script.isEmpty());
+
+  QVERIFY(!nenoserpent::core::obstacleAnimationFromJson(QJsonObject{{"phases", QJsonArray{}}}));
+}
+
+void TestCoreRules::testMalformedLevelAnimationFallsBackToBuiltInLevel() {
+  const QJsonObject brokenAnimation{{"phaseTicks", 2}, {"phases", QJsonArray{0, 1}}};
+  QJsonArray levels;
+  levels.append(QJsonObject{{"name", "Broken"}, {"animation", brokenAnimation}});
+  levels.append(QJsonObject{{"name", "NotAnObject"}, {"animation", QJsonArray{1, 2}}});
+  levels.append(QJsonObject{{"name", "Walls"},
+                            {"walls", QJsonArray{QJsonObject{{"x", 3}, {"y", 4}}}}});
+  QVERIFY(!nenoserpent::core::resolvedLevelDataFromJson(levels, 0).has_value());
+  QVERIFY(!nenoserpent::core::resolvedLevelDataFromJson(levels, 1).has_value());
+  QVERIFY(nenoserpent::core::resolvedLevelDataFromJson(levels, 2).has_value());
+
+  QList<int> replaced;
+  const auto table = nenoserpent::core::resolvedLevelTableFromJsonBytes(
+    QJsonDocument(QJsonObject{{"levels", levels}}).toJson(), &replaced);
+  QCOMPARE(replaced, (QList<int>{0, 1}));
+  QCOMPARE(table.size(), 3);
+  QCOMPARE(table[0].name, nenoserpent::core::fallbackLevelData(0).name);
+  QCOMPARE(table[1].name, nenoserpent::core::fallbackLevelData(1).name);
+  QCOMPARE(table[2].name, QString("Walls"));
+  QCOMPARE(table[2].walls, (QList<QPoint>{QPoint(3, 4)}));
+}
+
 void TestCoreRules::testResolvedLevelDataFromJsonBytesParsesDocumentEnvelope() {
   const QJsonObject level{{"name", "BytesLevel"},
                           {"script", ""},
@@ -341,6 +661,11 @@ void TestCoreRules::testResolvedLevelDataFromJsonBytesParsesDocumentEnvelope() {
   const auto invalid =
     nenoserpent::core::resolvedLevelDataFromJsonBytes(QByteArrayLiteral("not-json"), 0);
   QVERIFY(!invalid.has_value());
+
+  const auto table = nenoserpent::core::resolvedLevelTableFromJsonBytes(document.toJson());
+  QCOMPARE(table.size(), 1);
+  QCOMPARE(table.first().walls, resolved->walls);
+  QVERIFY(nenoserpent::core::resolvedLevelTableFromJsonBytes(QByteArrayLiteral("x")).isEmpty());
 }
 
 void TestCoreRules::testLevelCountFromJsonBytesUsesFallbackOnInvalidData() {
@@ -388,6 +713,98 @@ void TestCoreRules::testWeightedRandomBuffIdUsesWeightsAndFallback() {
            nenoserpent::core::BuffId::Ghost);
 }
 
+void TestCoreRules::testCounterRngIsSeekableSplittableAndBounded() {
+  using nenoserpent::core::CounterRng;
+
+  CounterRng a(42);
+  CounterRng b(42);
+  std::vector<std::uint64_t> drawn;
+  for (int i = 0; i < 64; ++i) {
+    drawn.push_back(a.next());
+    QCOMPARE(b.next(), drawn.back());
+  }
+  QVERIFY(CounterRng(43).next() != drawn.front());
+
+  CounterRng seek(42);
+  seek.discard(10);
+  QCOMPARE(seek.next(), drawn[10]);
+  seek.setPosition(3);
+  QCOMPARE(seek.next(), drawn[3]);
+  QCOMPARE(seek.position(), std::uint64_t{4});
+
+  CounterRng restored;
+  restored.restore(a.key(), a.streamKey(), 20);
+  QCOMPARE(restored.next(), drawn[20]);
+
+  const CounterRng root(7);
+  CounterRng advanced(7);
+  advanced.discard(1000);
+  QVERIFY(root.split(1) == advanced.split(1));
+  CounterRng left = root.split(1);
+  CounterRng right = root.split(2);
+  QVERIFY(left.next() != right.next());
+  QVERIFY(CounterRng(7).split(0).next() != CounterRng(7).next());
+
+  CounterRng rng(99);
+  std::array<int, 5> buckets{};
+  for (int i = 0; i < 5000; ++i) {
+    const int value = rng.bounded(5);
+    QVERIFY(value >= 0 && value < 5);
+    ++buckets[static_cast<std::size_t>(value)];
+  }
+  for (const int count : buckets) {
+    QVERIFY(count > 800 && count < 1200);
+  }
+  QCOMPARE(rng.bounded(0), 0);
+  QCOMPARE(rng.bounded(-3), 0);
+
+  int calls = 0;
+  auto source = [&calls](const int bound) -> int {
+    ++calls;
+    return bound - 1;
+  };
+  const nenoserpent::core::RandomBounded view(source);
+  QCOMPARE(view(9), 8);
+  QCOMPARE(calls, 1);
+
+  CounterRng first(5);
+  CounterRng second(5);
+  QPoint pickedFirst;
+  QPoint pickedSecond;
+  const auto blocked = [](const QPoint& point) -> bool { return point.x() == point.y(); };
+  QVERIFY(nenoserpent::core::pickRandomFreeSpot(6, 6, blocked, first, pickedFirst));
+  QVERIFY(nenoserpent::core::pickRandomFreeSpot(6, 6, blocked, second, pickedSecond));
+  QCOMPARE(pickedFirst, pickedSecond);
+  QVERIFY(!blocked(pickedFirst));
+}
+
+void TestCoreRules::testReplayRngMatchesQRandomGeneratorAndRestores() {
+  using nenoserpent::core::ReplayRng;
+
+  for (const quint32 seed : {0U, 1U, 1337U, 0xdeadbeefU}) {
+    QRandomGenerator qt(seed);
+    ReplayRng rng(seed);
+    for (int i = 0; i < 2000; ++i) {
+      QCOMPARE(rng.generate(), qt.generate());
+      QCOMPARE(rng.bounded(19), qt.bounded(19));
+    }
+    for (const quint64 skip : {1ULL, 623ULL, 624ULL, 5000ULL}) {
+      qt.discard(skip);
+      rng.discard(skip);
+      QCOMPARE(rng.generate(), qt.generate());
+    }
+  }
+
+  ReplayRng original(42);
+  original.discard(777);
+  ReplayRng restored;
+  restored.restore(original.words(), original.index());
+  QVERIFY(restored == original);
+  for (int i = 0; i < 1000; ++i) {
+    QCOMPARE(restored.generate(), original.generate());
+  }
+}
+
 void TestCoreRules::testReplayTimelineAppliesOnlyOnMatchingTicks() {
   FakeReplayEngine engine;
   engine.inputFrames = {{1, 1, 0}, {3, 0, -1}, {3, -1, 0}, {6, 0, 1}};
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <QtTest>
+
+#include "core/session/runner.h"
+
+// QtTest slot-based tests intentionally stay as member functions and use assertion-heavy bodies.
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+class TestLargeBoardScaling : public QObject {
+  Q_OBJECT
+
+private slots:
+  void testRunnerClampsBoardSize();
+  void testLargeBoardSpawnsLandOnFreeCells();
+  void testLargeBoardSpawnsSkipWalledOffRegions();
+};
+
+namespace {
+auto makeRandomBounded(const unsigned seed) {
+  std::mt19937 rng(seed);
+  return [rng](const int upperBound) mutable -> int {
+    if (upperBound <= 1) {
+      return 0;
+    }
+    std::uniform_int_distribution<int> distribution(0, upperBound - 1);
+    return distribution(rng);
+  };
+}
+
+// A sparse lattice of single-cell pillars, leaving the start area open.
+auto buildPillars(const int boardWidth, const int boardHeight) -> QList<QPoint> {
+  QList<QPoint> obstacles;
+  for (int y = 3; y < boardHeight; y += 7) {
+    for (int x = 2; x < boardWidth; x += 9) {
+      if (x >= 8 && x <= 12 && y >= 5 && y <= 14) {
+        continue;
+      }
+      obstacles.push_back(QPoint(x, y));
+    }
+  }
+  return obstacles;
+}
+
+auto isOnBody(const nenoserpent::core::SessionCore& core, const QPoint& point) -> bool {
+  return std::ranges::find(core.body(), point) != core.body().end();
+}
+} // namespace
+
+void TestLargeBoardScaling::testRunnerClampsBoardSize() {
+  const nenoserpent::core::SessionRunner huge(1000, 1);
+  QCOMPARE(huge.boardWidth(), nenoserpent::core::MaxBoardSide);
+  QCOMPARE(huge.boardHeight(), nenoserpent::core::MinBoardSide);
+
+  const nenoserpent::core::SessionRunner standard;
+  QCOMPARE(standard.boardWidth(), nenoserpent::core::StandardBoardWidth);
+  QCOMPARE(standard.boardHeight(), nenoserpent::core::StandardBoardHeight);
+  QVERIFY(!nenoserpent::core::isLargeBoard(64, 64));
+  QVERIFY(nenoserpent::core::isLargeBoard(65, 64));
+}
+
+void TestLargeBoardScaling::testLargeBoardSpawnsLandOnFreeCells() {
+  constexpr int BoardSide = nenoserpent::core::MaxBoardSide;
+  const QList<QPoint> obstacles = buildPillars(BoardSide, BoardSide);
+  nenoserpent::core::SessionRunner runner(BoardSide, BoardSide);
+  runner.startSession(obstacles, 1234U);
+  auto randomBounded = makeRandomBounded(7U);
+
+  for (int i = 0; i < 300; ++i) {
+    auto& core = runner.core();
+    QVERIFY(core.spawnFood(BoardSide, BoardSide, randomBounded));
+    const QPoint food = core.state().food;
+    QVERIFY(food.x() >= 0 && food.y() >= 0 && food.x() < BoardSide && food.y() < BoardSide);
+    QVERIFY(!obstacles.contains(food));
+    QVERIFY(!isOnBody(core, food));
+
+    QVERIFY(core.spawnPowerUp(BoardSide, BoardSide, randomBounded));
+    const QPoint powerUp = core.state().powerUpPos;
+    QVERIFY(powerUp != food);
+    QVERIFY(!obstacles.contains(powerUp));
+    QVERIFY(!isOnBody(core, powerUp));
+  }
+}
+
+void TestLargeBoardScaling::testLargeBoardSpawnsSkipWalledOffRegions() {
+  constexpr int BoardSide = 128;
+  // A closed square wall around most of the board's lower-right quadrant; the snake starts
+  // outside it, so nothing inside is reachable.
+  constexpr int BoxMin = 64;
+  constexpr int BoxMax = 120;
+  QList<QPoint> obstacles;
+  for (int i = BoxMin; i <= BoxMax; ++i) {
+    obstacles.push_back(QPoint(i, BoxMin));
+    obstacles.push_back(QPoint(i, BoxMax));
+    if (i != BoxMin && i != BoxMax) {
+      obstacles.push_back(QPoint(BoxMin, i));
+      obstacles.push_back(QPoint(BoxMax, i));
+    }
+  }
+  nenoserpent::core::SessionRunner runner(BoardSide, BoardSide);
+  runner.startSession(obstacles, 55U);
+  auto randomBounded = makeRandomBounded(3U);
+
+  auto insideBox = [](const QPoint& point) -> bool {
+    return point.x() > BoxMin && point.x() < BoxMax && point.y() > BoxMin && point.y() < BoxMax;
+  };
+  QVERIFY(!insideBox(runner.core().headPosition()));
+  for (int i = 0; i < 400; ++i) {
+    QVERIFY(runner.core().spawnFood(BoardSide, BoardSide, randomBounded));
+    QVERIFY2(!insideBox(runner.core().state().food),
+             qPrintable(QStringLiteral("spawn %1 landed inside the walled box").arg(i)));
+  }
+}
+
+QTEST_MAIN(TestLargeBoardScaling)
+// NOLINTEND(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+#include "test_large_board_scaling.moc"
@@ -0,0 +1,473 @@
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+#include <QtTest>
+
+#include "core/replay/checksum.h"
+#include "core/replay/verify.h"
+
+// QtTest slot-based tests intentionally stay as member functions and use assertion-heavy bodies.
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+class TestReplayVerify : public QObject {
+  Q_OBJECT
+
+private slots:
+  void testRecordedRunVerifiesAsMatch();
+  void testTamperedRecordingDiverges();
+  void testTamperedInputIsRejected();
+  void testTruncatedRecordingOverruns();
+  void testPaddedRecordingEndsEarly();
+  void testRunWithManyChoicesIsNotOverrun();
+  void testRunnerIsReusableAcrossReplays();
+  void testChecksumsAreSampledAtTheInterval();
+  void testChecksummedRunVerifiesAsMatch();
+  void testChecksumMismatchStopsAtFirstDivergentTick();
+  void testTamperedChoiceIsCaughtByChecksum();
+  void testChecksumCoversWallPositions();
+  void testRunWithoutRecordingVerifiesMoveCountAndChecksums();
+  void testKeyframesAreCapturedAtTheInterval();
+  void testSeekMatchesStraightReplay();
+  void testSeekRestoresNearestKeyframe();
+  void testSpotCheckLocatesTamperedWindow();
+};
+
+namespace {
+constexpr int BoardWidth = nenoserpent::core::StandardBoardWidth;
+constexpr int BoardHeight = nenoserpent::core::StandardBoardHeight;
+
+struct RecordedRun {
+  nenoserpent::core::ReplayVerifyInput input;
+  int score = 0;
+};
+
+// A full row and a full column of walls: any stretch of straight travel ends in a crash.
+auto buildCrossWalls() -> QList<QPoint> {
+  QList<QPoint> walls;
+  for (int x = 0; x < BoardWidth; ++x) {
+    walls.push_back(QPoint(x, 0));
+  }
+  for (int y = 1; y < BoardHeight; ++y) {
+    walls.push_back(QPoint(0, y));
+  }
+  return walls;
+}
+
+auto safeStepTowardFood(const nenoserpent::core::SessionCore& core) -> QPoint {
+  const QPoint head = core.headPosition();
+  const QPoint food = core.state().food;
+  QPoint best(0, 0);
+  int bestDistance = std::numeric_limits<int>::max();
+  for (const QPoint& step : nenoserpent::core::BoardSteps) {
+    if (step == -core.direction()) {
+      continue;
+    }
+    const QPoint next = nenoserpent::core::wrapPoint(head + step, BoardWidth, BoardHeight);
+    const bool blocked = core.state().obstacles.contains(next) ||
+                         std::ranges::find(core.body(), next) != core.body().end();
+    if (blocked) {
+      continue;
+    }
+    const int distance = std::abs(next.x() - food.x()) + std::abs(next.y() - food.y());
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = step;
+    }
+  }
+  return best;
+}
+
+// Plays greedily for a while, then stops steering until the snake crashes.
+auto recordRun(const uint seed, const int checksumInterval = 0, const int keyframeInterval = 0)
+  -> RecordedRun {
+  const QList<QPoint> walls = buildCrossWalls();
+  nenoserpent::core::SessionRunner runner;
+  runner.setChecksumInterval(checksumInterval);
+  runner.setKeyframeInterval(keyframeInterval);
+  runner.startSession(walls, seed);
+  for (int tick = 0; tick < 4000; ++tick) {
+    if (runner.mode() == nenoserpent::core::SessionMode::ChoiceSelection) {
+      runner.selectChoice(tick % 3);
+      continue;
+    }
+    if (runner.mode() != nenoserpent::core::SessionMode::Playing) {
+      break;
+    }
+    if (tick < 300) {
+      if (const QPoint step = safeStepTowardFood(runner.core()); !step.isNull()) {
+        runner.enqueueDirection(step);
+      }
+    }
+    runner.tick();
+  }
+  return {
+    .input =
+      {
+        .obstacles = walls,
+        .randomSeed = seed,
+        .inputHistory = runner.inputHistory(),
+        .choiceHistory = runner.choiceHistory(),
+        .checksumHistory = runner.checksumHistory(),
+        .keyframes = runner.keyframes(),
+        .recording = runner.recording(),
+      },
+    .score = runner.mode() == nenoserpent::core::SessionMode::GameOver ? runner.core().state().score
+                                                                         : -1,
+  };
+}
+
+// Next step along a Hamiltonian cycle of the open board: right along row 0, then down and up the
+// columns from the right edge, and back up column 0.
+auto cycleStep(const QPoint& head) -> QPoint {
+  if (head.y() == 0) {
+    return head.x() < BoardWidth - 1 ? QPoint(1, 0) : QPoint(0, 1);
+  }
+  if (head.x() == 0) {
+    return {0, -1};
+  }
+  if ((BoardWidth - 1 - head.x()) % 2 == 0) {
+    return head.y() < BoardHeight - 1 ? QPoint(0, 1) : QPoint(-1, 0);
+  }
+  return head.y() > 1 ? QPoint(0, -1) : QPoint(-1, 0);
+}
+
+// Follows the cycle on an open board, which cannot crash, until `choices` choices were taken,
+// then stops steering until the snake runs into itself.
+auto recordLongRun(const uint seed, const int choices) -> RecordedRun {
+  nenoserpent::core::SessionRunner runner;
+  runner.startSession({}, seed);
+  while (runner.mode() == nenoserpent::core::SessionMode::Playing ||
+         runner.mode() == nenoserpent::core::SessionMode::ChoiceSelection) {
+    if (runner.mode() == nenoserpent::core::SessionMode::ChoiceSelection) {
+      runner.selectChoice(runner.core().tickCounter() % 3);
+      continue;
+    }
+    if (runner.choiceHistory().size() < choices) {
+      const auto& core = runner.core();
+      if (const QPoint step = cycleStep(core.headPosition()); step != core.direction()) {
+        runner.enqueueDirection(step);
+      }
+    }
+    runner.tick();
+  }
+  return {
+    .input =
+      {
+        .obstacles = {},
+        .randomSeed = seed,
+        .inputHistory = runner.inputHistory(),
+        .choiceHistory = runner.choiceHistory(),
+        .recording = runner.recording(),
+      },
+    .score = runner.core().state().score,
+  };
+}
+} // namespace
+
+void TestReplayVerify::testRecordedRunVerifiesAsMatch() {
+  for (const uint seed : {7U, 1337U, 90210U}) {
+    const RecordedRun run = recordRun(seed);
+    QVERIFY2(run.score >= 0, "recorded run must end in a crash");
+    QVERIFY(run.input.recording.size() > 20);
+
+    nenoserpent::core::SessionRunner runner;
+    const auto result = nenoserpent::core::verifyReplay(runner, run.input);
+    QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Match);
+    QCOMPARE(result.matchedFrames, static_cast<int>(run.input.recording.size()));
+    QCOMPARE(result.score, run.score);
+    QCOMPARE(runner.mode(), nenoserpent::core::SessionMode::ReplayFinished);
+  }
+}
+
+void TestReplayVerify::testRunWithManyChoicesIsNotOverrun() {
+  // Every choice costs the replay a tick without movement, more of them than the overrun slack.
+  const RecordedRun run = recordLongRun(4242U, 24);
+  QCOMPARE(run.input.choiceHistory.size(), 24);
+
+  nenoserpent::core::SessionRunner runner;
+  const auto result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Match);
+  QCOMPARE(result.matchedFrames, static_cast<int>(run.input.recording.size()));
+}
+
+void TestReplayVerify::testTamperedRecordingDiverges() {
+  RecordedRun run = recordRun(7U);
+  const int tampered = static_cast<int>(run.input.recording.size()) / 2;
+  const QPoint original = run.input.recording.at(tampered);
+  const QPoint forged(original.x(), (original.y() + 5) % BoardHeight);
+  run.input.recording[tampered] = forged;
+
+  nenoserpent::core::SessionRunner runner;
+  const auto result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Diverged);
+  QCOMPARE(result.matchedFrames, tampered);
+  QCOMPARE(result.expectedHead, forged);
+  QCOMPARE(result.actualHead, original);
+}
+
+void TestReplayVerify::testTamperedInputIsRejected() {
+  RecordedRun run = recordRun(1337U);
+  QVERIFY(!run.input.inputHistory.isEmpty());
+  ReplayFrame& frame = run.input.inputHistory[run.input.inputHistory.size() / 2];
+  std::swap(frame.dx, frame.dy);
+
+  nenoserpent::core::SessionRunner runner;
+  const auto result = nenoserpent::core::verifyReplay(runner, run.input);
+  QVERIFY(result.verdict != nenoserpent::core::ReplayVerdict::Match);
+}
+
+void TestReplayVerify::testTruncatedRecordingOverruns() {
+  RecordedRun run = recordRun(90210U);
+  const auto kept = run.input.recording.size() - 5;
+  run.input.recording.resize(kept);
+
+  nenoserpent::core::SessionRunner runner;
+  const auto result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Overran);
+  QCOMPARE(result.matchedFrames, static_cast<int>(kept));
+}
+
+void TestReplayVerify::testPaddedRecordingEndsEarly() {
+  RecordedRun run = recordRun(7U);
+  const auto recorded = static_cast<int>(run.input.recording.size());
+  run.input.recording.append(run.input.recording.back());
+
+  nenoserpent::core::SessionRunner runner;
+  const auto result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::EndedEarly);
+  QCOMPARE(result.matchedFrames, recorded);
+}
+
+void TestReplayVerify::testRunnerIsReusableAcrossReplays() {
+  const RecordedRun first = recordRun(7U);
+  const RecordedRun second = recordRun(1337U);
+  nenoserpent::core::SessionRunner runner;
+  for (int round = 0; round < 2; ++round) {
+    for (const RecordedRun* run : {&first, &second}) {
+      const auto result = nenoserpent::core::verifyReplay(runner, run->input);
+      QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Match);
+      QCOMPARE(result.score, run->score);
+    }
+  }
+}
+
+void TestReplayVerify::testChecksumsAreSampledAtTheInterval() {
+  QVERIFY(recordRun(7U).input.checksumHistory.isEmpty());
+
+  constexpr int Interval = 4;
+  const RecordedRun run = recordRun(7U, Interval);
+  const auto& checksums = run.input.checksumHistory;
+  QVERIFY(checksums.size() > 5);
+  for (qsizetype i = 0; i < checksums.size(); ++i) {
+    QCOMPARE(checksums.at(i).frame, static_cast<int>((i + 1) * Interval));
+    if (i > 0) {
+      QVERIFY(checksums.at(i).checksum != checksums.at(i - 1).checksum);
+    }
+  }
+}
+
+void TestReplayVerify::testChecksummedRunVerifiesAsMatch() {
+  for (const int interval : {1, 8}) {
+    const RecordedRun run = recordRun(1337U, interval);
+    QVERIFY(!run.input.checksumHistory.isEmpty());
+    nenoserpent::core::SessionRunner runner;
+    const auto result = nenoserpent::core::verifyReplay(runner, run.input);
+    QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Match);
+    QCOMPARE(result.score, run.score);
+    QCOMPARE(runner.firstDivergentTick(), -1);
+  }
+}
+
+void TestReplayVerify::testChecksumMismatchStopsAtFirstDivergentTick() {
+  RecordedRun run = recordRun(90210U, 1);
+  const auto tampered = run.input.checksumHistory.size() / 3;
+  const int tamperedFrame = run.input.checksumHistory.at(tampered).frame;
+  run.input.checksumHistory[tampered].checksum ^= 1U;
+
+  nenoserpent::core::SessionRunner runner;
+  const auto result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Diverged);
+  QCOMPARE(result.divergentTick, tamperedFrame);
+  QCOMPARE(result.ticks, tamperedFrame);
+  QCOMPARE(runner.firstDivergentTick(), tamperedFrame);
+  QCOMPARE(runner.mode(), nenoserpent::core::SessionMode::ReplayFinished);
+}
+
+void TestReplayVerify::testTamperedChoiceIsCaughtByChecksum() {
+  RecordedRun run = recordRun(7U, 1);
+  QVERIFY(!run.input.choiceHistory.isEmpty());
+  ChoiceRecord& choice = run.input.choiceHistory[0];
+  choice.index = (choice.index + 1) % 3;
+
+  // A different buff does not move the head right away, but the next sample already differs.
+  nenoserpent::core::SessionRunner runner;
+  const auto result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Diverged);
+  QCOMPARE(result.divergentTick, choice.frame + 1);
+  QCOMPARE(result.expectedHead, QPoint(-1, -1));
+}
+
+void TestReplayVerify::testChecksumCoversWallPositions() {
+  nenoserpent::core::SessionRunner runner(BoardWidth, BoardHeight);
+  runner.startSession({QPoint(3, 3), QPoint(16, 14)}, 77U);
+  const std::uint64_t before = nenoserpent::core::sessionStateChecksum(runner.core());
+
+  // Same number of walls, one of them elsewhere.
+  runner.core().state().obstacles[1] = QPoint(16, 15);
+  QVERIFY(nenoserpent::core::sessionStateChecksum(runner.core()) != before);
+  runner.core().state().obstacles[1] = QPoint(16, 14);
+  QCOMPARE(nenoserpent::core::sessionStateChecksum(runner.core()), before);
+}
+
+void TestReplayVerify::testRunWithoutRecordingVerifiesMoveCountAndChecksums() {
+  RecordedRun run = recordRun(1337U, 1);
+  const auto moves = static_cast<int>(run.input.recording.size());
+  run.input.recording.clear();
+  run.input.expectedMoves = moves;
+
+  nenoserpent::core::SessionRunner runner;
+  auto result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Match);
+  QCOMPARE(result.matchedFrames, moves);
+  QCOMPARE(result.score, run.score);
+
+  run.input.expectedMoves = moves - 3;
+  result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Overran);
+
+  run.input.expectedMoves = moves + 1;
+  result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::EndedEarly);
+
+  run.input.expectedMoves = moves;
+  run.input.checksumHistory[run.input.checksumHistory.size() / 2].checksum ^= 1U;
+  result = nenoserpent::core::verifyReplay(runner, run.input);
+  QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Diverged);
+}
+
+void TestReplayVerify::testKeyframesAreCapturedAtTheInterval() {
+  QVERIFY(recordRun(7U).input.keyframes.isEmpty());
+
+  constexpr int Interval = 16;
+  const RecordedRun run = recordRun(7U, 0, Interval);
+  const auto& keyframes = run.input.keyframes;
+  QVERIFY(keyframes.size() > 2);
+  int previous = 0;
+  for (const auto& keyframe : keyframes) {
+    QCOMPARE(keyframe.frame % Interval, 0);
+    QVERIFY(keyframe.frame > previous);
+    QCOMPARE(keyframe.session.snapshot.state.tickCounter, keyframe.frame);
+    QVERIFY(keyframe.recordedFrames <= keyframe.frame);
+    QVERIFY(keyframe.rngDraws > 0);
+    previous = keyframe.frame;
+  }
+}
+
+void TestReplayVerify::testSeekMatchesStraightReplay() {
+  const RecordedRun run = recordRun(1337U, 1, 16);
+  const auto& input = run.input;
+
+  // Reference digests from one straight replay.
+  nenoserpent::core::SessionRunner straight;
+  straight.startReplay(input.obstacles, input.randomSeed, input.inputHistory, input.choiceHistory);
+  QList<std::uint64_t> digests{nenoserpent::core::sessionStateChecksum(straight.core())};
+  while (straight.mode() == nenoserpent::core::SessionMode::Replaying) {
+    straight.tick();
+    digests.push_back(nenoserpent::core::sessionStateChecksum(straight.core()));
+  }
+  const auto lastTick = static_cast<int>(digests.size()) - 2;
+  QVERIFY(lastTick > 40);
+
+  nenoserpent::core::SessionRunner runner;
+  runner.startReplay(input.obstacles,
+                     input.randomSeed,
+                     input.inputHistory,
+                     input.choiceHistory,
+                     input.checksumHistory,
+                     input.keyframes);
+  // Forward, backward, across keyframes and onto them.
+  for (const int target : {lastTick - 3, 5, lastTick / 2, 16, 0, 17, lastTick - 3, 32, 31}) {
+    QVERIFY2(runner.seekToTick(target), qPrintable(QStringLiteral("seek to %1").arg(target)));
+    QCOMPARE(runner.core().tickCounter(), target);
+    QCOMPARE(nenoserpent::core::sessionStateChecksum(runner.core()), digests.at(target));
+  }
+
+  // Checksums keep validating after a seek, and the run still ends with the recorded score.
+  QVERIFY(runner.seekToTick(20));
+  while (runner.mode() == nenoserpent::core::SessionMode::Replaying) {
+    runner.tick();
+  }
+  QCOMPARE(runner.firstDivergentTick(), -1);
+  QCOMPARE(runner.core().state().score, run.score);
+  QCOMPARE(runner.recording().back(), input.recording.back());
+  QVERIFY(!runner.seekToTick(lastTick + 50));
+}
+
+void TestReplayVerify::testSeekRestoresNearestKeyframe() {
+  constexpr int Interval = 16;
+  const RecordedRun run = recordRun(90210U, 0, Interval);
+  const auto& input = run.input;
+  QVERIFY(input.keyframes.size() > 2);
+  const auto& keyframe = input.keyframes.at(input.keyframes.size() - 1);
+
+  nenoserpent::core::SessionRunner runner;
+  runner.startReplay(input.obstacles,
+                     input.randomSeed,
+                     input.inputHistory,
+                     input.choiceHistory,
+                     {},
+                     input.keyframes);
+  QVERIFY(runner.seekToTick(keyframe.frame + 3));
+  // Only the ticks after the keyframe were simulated.
+  QCOMPARE(runner.recordingOffset(), keyframe.recordedFrames);
+  QVERIFY(runner.recording().size() <= 3);
+  for (qsizetype i = 0; i < runner.recording().size(); ++i) {
+    QCOMPARE(runner.recording().at(i), input.recording.at(keyframe.recordedFrames + i));
+  }
+
+  // Keyframes saved without the generator state reseed and skip to it instead.
+  QVERIFY(keyframe.rng.has_value());
+  QList<nenoserpent::core::ReplayKeyframe> legacyKeyframes = input.keyframes;
+  for (auto& legacy : legacyKeyframes) {
+    legacy.rng.reset();
+  }
+  nenoserpent::core::SessionRunner legacyRunner;
+  legacyRunner.startReplay(input.obstacles,
+                           input.randomSeed,
+                           input.inputHistory,
+                           input.choiceHistory,
+                           {},
+                           legacyKeyframes);
+  QVERIFY(legacyRunner.seekToTick(keyframe.frame + 3));
+  QCOMPARE(legacyRunner.recording(), runner.recording());
+  QCOMPARE(nenoserpent::core::sessionStateChecksum(legacyRunner.core()),
+           nenoserpent::core::sessionStateChecksum(runner.core()));
+
+  // Going back before the first keyframe replays from the start.
+  QVERIFY(runner.seekToTick(2));
+  QCOMPARE(runner.recordingOffset(), 0);
+}
+
+void TestReplayVerify::testSpotCheckLocatesTamperedWindow() {
+  constexpr int Interval = 16;
+  RecordedRun run = recordRun(7U, 0, Interval);
+  QVERIFY(run.input.keyframes.size() > 2);
+  const auto& last = run.input.keyframes.at(run.input.keyframes.size() - 1);
+  const int tamperedFrame = last.recordedFrames + 1;
+  QVERIFY(tamperedFrame < run.input.recording.size());
+  run.input.recording[tamperedFrame] = QPoint(-5, -5);
+
+  nenoserpent::core::SessionRunner runner;
+  const auto early = nenoserpent::core::spotCheckReplay(runner, run.input, Interval, Interval);
+  QCOMPARE(early.verdict, nenoserpent::core::ReplayVerdict::Match);
+  QVERIFY(early.matchedFrames > 0);
+
+  const auto late = nenoserpent::core::spotCheckReplay(runner, run.input, last.frame, Interval);
+  QCOMPARE(late.verdict, nenoserpent::core::ReplayVerdict::Diverged);
+  QCOMPARE(late.matchedFrames, 1);
+  QCOMPARE(late.expectedHead, QPoint(-5, -5));
+}
+
+QTEST_MAIN(TestReplayVerify)
+// NOLINTEND(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+#include "test_replay_verify.moc"
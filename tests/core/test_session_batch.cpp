@@ -0,0 +1,227 @@
+#include <cstdint>
+#include <vector>
+
+#include <QtTest>
+
+#include "core/session/batch.h"
+#include "core/session/tick_driver.h"
+
+// QtTest slot-based tests intentionally stay as member functions and use assertion-heavy bodies.
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+class TestSessionBatch : public QObject {
+  Q_OBJECT
+
+private slots:
+  void testBatchLanesMatchStandaloneCoresOnSplitStreams();
+  void testBatchIsDeterministicPerSeedAndChoicesPauseLanes();
+  void testBatchDoneMaskTracksCollisionTimeoutAndRestart();
+  void testWorkerThreadsMatchSingleThreadedBatch();
+};
+
+namespace {
+// Turns toward the food along x first, never reversing.
+auto chaseFood(const QPoint& head, const QPoint& direction, const QPoint& food) -> QPoint {
+  QPoint wanted(0, 0);
+  if (food.x() != head.x()) {
+    wanted = QPoint(food.x() > head.x() ? 1 : -1, 0);
+  } else if (food.y() != head.y()) {
+    wanted = QPoint(0, food.y() > head.y() ? 1 : -1);
+  }
+  if (wanted == -direction) {
+    return QPoint(wanted.y(), wanted.x());
+  }
+  return wanted;
+}
+
+auto chaseAll(const nenoserpent::core::SessionBatch& batch) -> std::vector<QPoint> {
+  std::vector<QPoint> directions(batch.laneCount());
+  for (std::size_t lane = 0; lane < batch.laneCount(); ++lane) {
+    const auto& core = batch.lane(lane);
+    directions[lane] = chaseFood(core.headPosition(), core.direction(), core.state().food);
+  }
+  return directions;
+}
+
+// Plays a standalone core the way a batch lane does, drawing from the lane's stream.
+struct ReferenceLane {
+  nenoserpent::core::SessionCore& core;
+  nenoserpent::core::CounterRng& rng;
+  bool enteredChoice = false;
+
+  auto drawBounded(const int bound) -> int {
+    return rng.bounded(bound);
+  }
+  void selectReplayChoice(const int /*index*/) {
+  }
+  void applyStep(const nenoserpent::core::SessionAdvanceResult& step) {
+    if (!step.collision) {
+      nenoserpent::core::applyFoodConsumption(core, 20, 18, step, rng, *this);
+    }
+  }
+  void applyRuntimeUpdate(const nenoserpent::core::RuntimeUpdateResult& /*update*/) {
+  }
+  void enterChoice() {
+    static_cast<void>(rng.generate());
+    enteredChoice = true;
+  }
+};
+} // namespace
+
+void TestSessionBatch::testBatchLanesMatchStandaloneCoresOnSplitStreams() {
+  const QList<QPoint> obstacles{QPoint(4, 4), QPoint(15, 12)};
+  constexpr std::uint64_t Seed = 2024;
+  nenoserpent::core::SessionBatch batch(3);
+  batch.start(obstacles, Seed);
+
+  const nenoserpent::core::CounterRng root(Seed);
+  const std::size_t lane = 1;
+  auto rng = root.split(lane);
+  nenoserpent::core::SessionCore reference;
+  reference.setFreeCellOrder(nenoserpent::core::FreeCellOrder::Dense);
+  reference.applyMetaAction(nenoserpent::core::MetaAction::bootstrapForLevel(obstacles, 20, 18));
+  reference.spawnFood(20, 18, rng);
+  QCOMPARE(batch.lane(lane).state().food, reference.state().food);
+
+  ReferenceLane host{.core = reference, .rng = rng};
+  for (int tick = 0; tick < 120 && batch.done()[lane] == 0; ++tick) {
+    if (batch.modes()[lane] != nenoserpent::core::SessionMode::Playing) {
+      break;
+    }
+    const auto directions = chaseAll(batch);
+    reference.enqueueDirection(directions[lane]);
+    batch.tick(directions);
+
+    const auto outcome = nenoserpent::core::runSessionTick(reference, 20, 18, nullptr, host);
+    if (outcome.step.collision) {
+      QVERIFY(batch.done()[lane] != 0);
+      break;
+    }
+    const auto& core = batch.lane(lane);
+    QCOMPARE(core.headPosition(), reference.headPosition());
+    QCOMPARE(core.state().food, reference.state().food);
+    QCOMPARE(core.state().score, reference.state().score);
+    QCOMPARE(core.tickCounter(), reference.tickCounter());
+    QCOMPARE(core.bodyHash(), reference.bodyHash());
+    QCOMPARE(batch.modes()[lane] == nenoserpent::core::SessionMode::ChoiceSelection,
+             host.enteredChoice);
+  }
+  QVERIFY(batch.lane(lane).state().score > 0);
+}
+
+void TestSessionBatch::testBatchIsDeterministicPerSeedAndChoicesPauseLanes() {
+  nenoserpent::core::SessionBatch first(8);
+  nenoserpent::core::SessionBatch second(8);
+  first.start({}, 99);
+  second.start({}, 99);
+
+  bool sawChoice = false;
+  for (int tick = 0; tick < 600; ++tick) {
+    const auto directions = chaseAll(first);
+    first.tick(directions);
+    second.tick(chaseAll(second));
+    for (std::size_t lane = 0; lane < first.laneCount(); ++lane) {
+      QCOMPARE(first.lane(lane).headPosition(), second.lane(lane).headPosition());
+      QCOMPARE(first.lane(lane).state().score, second.lane(lane).state().score);
+      if ((first.events()[lane] & nenoserpent::core::LaneEnteredChoice) == 0) {
+        continue;
+      }
+      sawChoice = true;
+      QCOMPARE(first.modes()[lane], nenoserpent::core::SessionMode::ChoiceSelection);
+      QCOMPARE(first.choices(lane).size(), 3);
+      const int ticksBefore = first.ticks()[lane];
+      first.tick(std::vector<QPoint>(first.laneCount()));
+      second.tick(std::vector<QPoint>(second.laneCount()));
+      QCOMPARE(first.ticks()[lane], ticksBefore);
+      QVERIFY(!first.selectChoice(lane, 3));
+      QVERIFY(first.selectChoice(lane, 0));
+      QVERIFY(second.selectChoice(lane, 0));
+      QCOMPARE(first.modes()[lane], nenoserpent::core::SessionMode::Playing);
+    }
+  }
+  QVERIFY(sawChoice);
+
+  nenoserpent::core::SessionBatch other(8);
+  other.start({}, 100);
+  bool differs = false;
+  for (std::size_t lane = 0; lane < other.laneCount(); ++lane) {
+    differs = differs || other.lane(lane).state().food != first.lane(lane).state().food;
+  }
+  QVERIFY(differs);
+}
+
+void TestSessionBatch::testBatchDoneMaskTracksCollisionTimeoutAndRestart() {
+  nenoserpent::core::SessionBatch batch(2, {.boardWidth = 20, .boardHeight = 18, .maxTicks = 5});
+  QCOMPARE(batch.liveCount(), 0);
+  batch.start({QPoint(12, 10)}, 7);
+  QCOMPARE(batch.liveCount(), 2);
+  QCOMPARE(batch.lane(0).headPosition(), QPoint(10, 10));
+
+  // Lane 0 turns into the obstacle; lane 1 keeps heading up until the tick limit.
+  const std::vector<QPoint> directions{QPoint(1, 0), QPoint(0, 0)};
+  batch.tick(directions);
+  QCOMPARE(batch.lane(0).headPosition(), QPoint(11, 10));
+  QCOMPARE(batch.done()[0], std::uint8_t{0});
+  batch.tick(directions);
+  QVERIFY((batch.events()[0] & nenoserpent::core::LaneCollision) != 0);
+  QCOMPARE(batch.done()[0], std::uint8_t{1});
+  QCOMPARE(batch.modes()[0], nenoserpent::core::SessionMode::GameOver);
+  QCOMPARE(batch.liveCount(), 1);
+  QCOMPARE(batch.lane(1).headPosition(), QPoint(10, 8));
+
+  const int frozenTicks = batch.ticks()[0];
+  batch.tick(directions);
+  batch.tick(directions);
+  QCOMPARE(batch.tick(directions), 0);
+  QCOMPARE(batch.ticks()[0], frozenTicks);
+  QCOMPARE(batch.ticks()[1], 5);
+  QVERIFY((batch.events()[1] & nenoserpent::core::LaneTimedOut) != 0);
+  QCOMPARE(batch.done()[1], std::uint8_t{1});
+  QCOMPARE(batch.modes()[1], nenoserpent::core::SessionMode::Playing);
+
+  batch.restartLane(0);
+  QCOMPARE(batch.liveCount(), 1);
+  QCOMPARE(batch.done()[0], std::uint8_t{0});
+  QCOMPARE(batch.ticks()[0], 0);
+  batch.restartLane(0);
+  QCOMPARE(batch.liveCount(), 1);
+}
+
+void TestSessionBatch::testWorkerThreadsMatchSingleThreadedBatch() {
+  const auto schedule = nenoserpent::core::ObstacleSchedule::fromFrames(
+    {{QPoint(3, 3), QPoint(15, 4)}, {QPoint(4, 3), QPoint(15, 5)}});
+  QVERIFY(schedule.has_value());
+  nenoserpent::core::SessionBatch serial(13, {.maxTicks = 300});
+  nenoserpent::core::SessionBatch threaded(13, {.maxTicks = 300, .workers = 4});
+  QCOMPARE(serial.workerCount(), 1);
+  QCOMPARE(threaded.workerCount(), 4);
+  serial.setObstacleSchedule(schedule);
+  threaded.setObstacleSchedule(schedule);
+  serial.start({}, 404);
+  threaded.start({}, 404);
+  QCOMPARE(threaded.lane(0).state().obstacles, schedule->obstaclesAt(0));
+
+  bool wallsMoved = false;
+  for (int tick = 0; tick < 400 && serial.liveCount() > 0; ++tick) {
+    for (std::size_t lane = 0; lane < serial.laneCount(); ++lane) {
+      if (serial.modes()[lane] == nenoserpent::core::SessionMode::ChoiceSelection) {
+        QVERIFY(serial.selectChoice(lane, 0));
+        QVERIFY(threaded.selectChoice(lane, 0));
+      }
+    }
+    QCOMPARE(threaded.tick(chaseAll(threaded)), serial.tick(chaseAll(serial)));
+    for (std::size_t lane = 0; lane < serial.laneCount(); ++lane) {
+      QCOMPARE(threaded.lane(lane).headPosition(), serial.lane(lane).headPosition());
+      QCOMPARE(threaded.lane(lane).state().score, serial.lane(lane).state().score);
+      QCOMPARE(threaded.lane(lane).state().obstacles, serial.lane(lane).state().obstacles);
+      QCOMPARE(threaded.events()[lane], serial.events()[lane]);
+      QCOMPARE(threaded.done()[lane], serial.done()[lane]);
+      const auto& walls = serial.lane(lane).state().obstacles;
+      wallsMoved = wallsMoved || walls == schedule->obstaclesAt(1);
+    }
+  }
+  QVERIFY(wallsMoved);
+}
+
+QTEST_MAIN(TestSessionBatch)
+// NOLINTEND(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+#include "test_session_batch.moc"
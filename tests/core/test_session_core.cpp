@@ -1,8 +1,11 @@
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 #include <QtTest>
 
 #include "core/session/core.h"
+#include "core/session/spawn_cache.h"
 
 // QtTest slot-based tests intentionally stay as member functions and use assertion-heavy bodies.
 // NOLINTBEGIN(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
@@ -15,6 +18,9 @@ private slots:
   void testSnapshotRoundTripRestoresStateAndBody();
   void testBodyOwnershipAndMovement();
   void testCollisionConsumesLaserObstacleAndShield();
+  void testOccupancyFollowsMovementAndObstacleSwaps();
+  void testSpawnCacheDistanceFieldMatchesObstacleScan();
+  void testSpawnCacheRiskMatchesNearestPreviousScan();
   void testFoodAndPowerUpConsumptionMutateSessionState();
   void testSpawnMagnetAndBuffCountdownMutateCoreState();
   void testPowerUpExpiresWhenNotEaten();
@@ -90,7 +96,7 @@ void TestSessionCore::testSnapshotRoundTripRestoresStateAndBody() {
   state.obstacles = {QPoint(2, 2), QPoint(3, 2)};
   QVERIFY(core.enqueueDirection(QPoint(1, 0)));
 
-  const std::deque<QPoint> body = {QPoint(5, 5), QPoint(4, 5), QPoint(3, 5)};
+  const nenoserpent::core::SnakeBody body = {QPoint(5, 5), QPoint(4, 5), QPoint(3, 5)};
   const auto snapshot = core.snapshot(body);
   QCOMPARE(snapshot.body, body);
 
@@ -145,6 +151,142 @@ void TestSessionCore::testCollisionConsumesLaserObstacleAndShield() {
   QCOMPARE(core.state().buffTicksTotal, 0);
 }
 
+void TestSessionCore::testOccupancyFollowsMovementAndObstacleSwaps() {
+  nenoserpent::core::SessionCore core;
+  core.setBody({QPoint(5, 5), QPoint(4, 5), QPoint(3, 5)});
+  core.state().obstacles = {QPoint(8, 8)};
+
+  QVERIFY(core.checkCollision(QPoint(3, 5), 20, 18).collision);
+  QVERIFY(core.checkCollision(QPoint(8, 8), 20, 18).collision);
+
+  core.applyMovement(QPoint(6, 5), false);
+  QVERIFY(!core.checkCollision(QPoint(3, 5), 20, 18).collision);
+  QVERIFY(core.checkCollision(QPoint(6, 5), 20, 18).collision);
+
+  // Script-style swaps replace the list wholesale and must drop the old wall bits.
+  core.state().obstacles = {QPoint(9, 9), QPoint(10, 9)};
+  QVERIFY(!core.checkCollision(QPoint(8, 8), 20, 18).collision);
+  QVERIFY(core.checkCollision(QPoint(10, 9), 20, 18).collision);
+  core.state().obstacles.append(QPoint(11, 9));
+  QVERIFY(core.checkCollision(QPoint(11, 9), 20, 18).collision);
+
+  core.state().activeBuff = static_cast<int>(nenoserpent::core::BuffId::Laser);
+  const auto laserOutcome = core.checkCollision(QPoint(10, 9), 20, 18);
+  QVERIFY(laserOutcome.consumeLaser);
+  QCOMPARE(core.state().obstacles, QList<QPoint>({QPoint(9, 9), QPoint(11, 9)}));
+  QVERIFY(!core.checkCollision(QPoint(10, 9), 20, 18).collision);
+
+  const auto snapshot = core.snapshot({});
+  core.setBody({QPoint(1, 1), QPoint(1, 2), QPoint(1, 3)});
+  QVERIFY(!core.checkCollision(QPoint(4, 5), 20, 18).collision);
+  core.restoreSnapshot(snapshot);
+  QVERIFY(core.checkCollision(QPoint(4, 5), 20, 18).collision);
+  QVERIFY(!core.checkCollision(QPoint(1, 2), 20, 18).collision);
+  QCOMPARE(core.bodyHash(), nenoserpent::core::zobristBodyHash(core.body()));
+
+  core.applyMovement(QPoint(7, 5), true);
+  core.applyMovement(QPoint(8, 5), false);
+  QCOMPARE(core.bodyHash(), nenoserpent::core::zobristBodyHash(core.body()));
+}
+
+void TestSessionCore::testSpawnCacheDistanceFieldMatchesObstacleScan() {
+  constexpr int width = 20;
+  constexpr int height = 18;
+  nenoserpent::core::SpawnAnalysisCache cache;
+  cache.prepare(width, height, {}, {}, 0);
+  QCOMPARE(cache.obstacleDistance(0), nenoserpent::core::SpawnAnalysisCache::NoObstacleDistance);
+
+  // The second layout has an off-board point, which takes the scan fallback.
+  const QList<QList<QPoint>> layouts = {
+    {QPoint(0, 0), QPoint(19, 17), QPoint(7, 9), QPoint(7, 10)},
+    {QPoint(3, 4), QPoint(12, 2), QPoint(25, 4)},
+  };
+  for (const auto& obstacles : layouts) {
+    cache.prepare(width, height, obstacles, obstacles, 0);
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        int expected = std::numeric_limits<int>::max();
+        for (const QPoint& obstacle : obstacles) {
+          expected = std::min(
+            expected, nenoserpent::core::toroidalDistance(QPoint(x, y), obstacle, width, height));
+        }
+        QCOMPARE(cache.obstacleDistance(static_cast<std::size_t>((y * width) + x)), expected);
+      }
+    }
+  }
+}
+
+void TestSessionCore::testSpawnCacheRiskMatchesNearestPreviousScan() {
+  constexpr int width = 20;
+  constexpr int height = 18;
+  constexpr int horizon = 4;
+  auto signedDelta = [](const int from, const int to, const int size) {
+    int delta = (to - from) % size;
+    if (delta < -size / 2) {
+      delta += size;
+    } else if (delta > size / 2) {
+      delta -= size;
+    }
+    return delta;
+  };
+  auto referenceRisk = [&](const QList<QPoint>& previous, const QList<QPoint>& current) {
+    std::vector<int> risk(static_cast<std::size_t>(width * height), 0);
+    std::vector<bool> used(static_cast<std::size_t>(previous.size()), false);
+    for (const QPoint& point : current) {
+      int best = -1;
+      int bestDistance = std::numeric_limits<int>::max();
+      for (int i = 0; i < previous.size(); ++i) {
+        const int distance =
+          nenoserpent::core::toroidalDistance(point, previous[i], width, height);
+        if (!used[static_cast<std::size_t>(i)] && distance < bestDistance) {
+          best = i;
+          bestDistance = distance;
+        }
+      }
+      if (best < 0 || bestDistance > 3) {
+        continue;
+      }
+      used[static_cast<std::size_t>(best)] = true;
+      const int dx = signedDelta(previous[best].x(), point.x(), width);
+      const int dy = signedDelta(previous[best].y(), point.y(), height);
+      if (dx == 0 && dy == 0) {
+        continue;
+      }
+      for (int t = 1; t <= horizon; ++t) {
+        const QPoint projected = nenoserpent::core::wrapPoint(
+          QPoint(point.x() + (dx * t), point.y() + (dy * t)), width, height);
+        risk[static_cast<std::size_t>((projected.y() * width) + projected.x())] +=
+          (horizon - t + 1) * 8;
+      }
+    }
+    return risk;
+  };
+
+  std::uint32_t lcg = 11;
+  auto next = [&lcg](const int bound) {
+    lcg = (lcg * 1103515245U) + 12345U;
+    return static_cast<int>((lcg >> 8U) % static_cast<std::uint32_t>(bound));
+  };
+  nenoserpent::core::SpawnAnalysisCache cache;
+  for (int round = 0; round < 40; ++round) {
+    QList<QPoint> previous;
+    QList<QPoint> current;
+    const int count = 4 + next(30);
+    for (int i = 0; i < count; ++i) {
+      const QPoint point(next(width), next(height));
+      previous.append(point);
+      // Clustered moves across the wrap seam keep several candidates in range at once.
+      current.append(
+        nenoserpent::core::wrapPoint(point + QPoint(next(5) - 2, next(5) - 2), width, height));
+    }
+    cache.prepare(width, height, current, previous, horizon);
+    const auto expected = referenceRisk(previous, current);
+    for (std::size_t index = 0; index < expected.size(); ++index) {
+      QCOMPARE(cache.predictedRisk(index), expected[index]);
+    }
+  }
+}
+
 void TestSessionCore::testFoodAndPowerUpConsumptionMutateSessionState() {
   nenoserpent::core::SessionCore core;
   core.setBody({QPoint(10, 10), QPoint(10, 11), QPoint(10, 12), QPoint(10, 13)});
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include <QtTest>
+
+#include "core/replay/verify.h"
+
+// QtTest slot-based tests intentionally stay as member functions and use assertion-heavy bodies.
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+class TestSessionRewind : public QObject {
+  Q_OBJECT
+
+private slots:
+  void testStepBackRestoresEveryEarlierTick();
+  void testStepBackUndoesACrash();
+  void testSettledRunMatchesOneThatNeverRewound();
+  void testResumedRunStillVerifies();
+  void testMemoryBudgetIsNeverExceeded();
+  void testDisabledRewindRecordsNothing();
+};
+
+namespace {
+constexpr int BoardWidth = nenoserpent::core::StandardBoardWidth;
+constexpr int BoardHeight = nenoserpent::core::StandardBoardHeight;
+
+auto buildCrossWalls() -> QList<QPoint> {
+  QList<QPoint> walls;
+  for (int x = 0; x < BoardWidth; ++x) {
+    walls.push_back(QPoint(x, 0));
+  }
+  for (int y = 1; y < BoardHeight; ++y) {
+    walls.push_back(QPoint(0, y));
+  }
+  return walls;
+}
+
+auto safeStepTowardFood(const nenoserpent::core::SessionCore& core) -> QPoint {
+  const QPoint head = core.headPosition();
+  const QPoint food = core.state().food;
+  QPoint best(0, 0);
+  int bestDistance = std::numeric_limits<int>::max();
+  for (const QPoint& step : nenoserpent::core::BoardSteps) {
+    if (step == -core.direction()) {
+      continue;
+    }
+    const QPoint next = nenoserpent::core::wrapPoint(head + step, BoardWidth, BoardHeight);
+    const bool blocked = core.state().obstacles.contains(next) ||
+                         std::ranges::find(core.body(), next) != core.body().end();
+    if (blocked) {
+      continue;
+    }
+    const int distance = std::abs(next.x() - food.x()) + std::abs(next.y() - food.y());
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = step;
+    }
+  }
+  return best;
+}
+
+// One greedy tick, picking the first choice whenever one is offered.
+void playTick(nenoserpent::core::SessionRunner& runner, const bool steer = true) {
+  if (runner.mode() == nenoserpent::core::SessionMode::ChoiceSelection) {
+    runner.selectChoice(0);
+  }
+  if (steer) {
+    if (const QPoint step = safeStepTowardFood(runner.core()); !step.isNull()) {
+      runner.enqueueDirection(step);
+    }
+  }
+  runner.tick();
+}
+
+auto sameBoard(const nenoserpent::core::StateSnapshot& expected,
+               const nenoserpent::core::SessionCore& core) -> bool {
+  const auto& a = expected.state;
+  const auto& b = core.state();
+  return a.food == b.food && a.powerUpPos == b.powerUpPos && a.powerUpType == b.powerUpType &&
+         a.powerUpTicksRemaining == b.powerUpTicksRemaining && a.activeBuff == b.activeBuff &&
+         a.buffTicksRemaining == b.buffTicksRemaining && a.shieldActive == b.shieldActive &&
+         a.direction == b.direction && a.score == b.score && a.obstacles == b.obstacles &&
+         a.tickCounter == b.tickCounter && expected.body == core.body();
+}
+} // namespace
+
+void TestSessionRewind::testStepBackRestoresEveryEarlierTick() {
+  nenoserpent::core::SessionRunner runner;
+  runner.setRewindBudget(4U << 20);
+  runner.startSession(buildCrossWalls(), 4242U);
+
+  std::vector<nenoserpent::core::StateSnapshot> history;
+  for (int i = 0; i < 200 && runner.mode() != nenoserpent::core::SessionMode::GameOver; ++i) {
+    // A choice picked while paused belongs to the tick that follows it.
+    if (runner.mode() == nenoserpent::core::SessionMode::ChoiceSelection) {
+      runner.selectChoice(0);
+    }
+    history.push_back(runner.core().snapshot({}));
+    playTick(runner);
+  }
+  QCOMPARE(runner.rewind().depth(), static_cast<int>(history.size()));
+
+  while (!history.empty()) {
+    QVERIFY(runner.stepBack());
+    const int tick = history.back().state.tickCounter;
+    QVERIFY2(sameBoard(history.back(), runner.core()),
+             qPrintable(QStringLiteral("mismatch at tick %1").arg(tick)));
+    history.pop_back();
+  }
+  QVERIFY(!runner.stepBack());
+  QCOMPARE(runner.rewind().depth(), 0);
+}
+
+void TestSessionRewind::testStepBackUndoesACrash() {
+  nenoserpent::core::SessionRunner runner;
+  runner.setRewindBudget(1U << 20);
+  runner.startSession(buildCrossWalls(), 77U);
+  for (int i = 0; i < 400 && runner.mode() != nenoserpent::core::SessionMode::GameOver; ++i) {
+    playTick(runner, false);
+  }
+  QCOMPARE(runner.mode(), nenoserpent::core::SessionMode::GameOver);
+  const int crashTick = runner.core().tickCounter();
+
+  QVERIFY(runner.stepBack());
+  QCOMPARE(runner.mode(), nenoserpent::core::SessionMode::Playing);
+  // The crash tick does not count, so stepping back over it keeps the counter.
+  QCOMPARE(runner.core().tickCounter(), crashTick);
+}
+
+void TestSessionRewind::testSettledRunMatchesOneThatNeverRewound() {
+  const QList<QPoint> walls = buildCrossWalls();
+  nenoserpent::core::SessionRunner rewound;
+  rewound.setRewindBudget(4U << 20);
+  rewound.startSession(walls, 2024U);
+  nenoserpent::core::SessionRunner straight;
+  straight.startSession(walls, 2024U);
+
+  for (int i = 0; i < 100; ++i) {
+    playTick(rewound);
+    playTick(straight);
+  }
+  QCOMPARE(rewound.mode(), nenoserpent::core::SessionMode::Playing);
+  // Step back into the middle of a keyframe interval; settling must land there, not on the
+  // keyframe before it.
+  for (int i = 0; i < 45; ++i) {
+    playTick(rewound);
+  }
+  for (int i = 0; i < 45; ++i) {
+    QVERIFY(rewound.stepBack());
+  }
+  QCOMPARE(rewound.core().tickCounter(), straight.core().tickCounter());
+
+  for (int i = 0; i < 300 && straight.mode() != nenoserpent::core::SessionMode::GameOver; ++i) {
+    playTick(rewound);
+    playTick(straight);
+    QVERIFY2(sameBoard(straight.core().snapshot({}), rewound.core()),
+             qPrintable(QStringLiteral("diverged at tick %1").arg(straight.core().tickCounter())));
+  }
+  const auto expected = straight.core().captureKeyframe();
+  const auto actual = rewound.core().captureKeyframe();
+  QVERIFY(actual.stallHashes == expected.stallHashes);
+  QCOMPARE(actual.recentSpawnPoints, expected.recentSpawnPoints);
+  QCOMPARE(actual.stallNoScoreTicks, expected.stallNoScoreTicks);
+  QCOMPARE(rewound.recording(), straight.recording());
+  QCOMPARE(rewound.inputHistory().size(), straight.inputHistory().size());
+  QCOMPARE(rewound.choiceHistory().size(), straight.choiceHistory().size());
+}
+
+void TestSessionRewind::testResumedRunStillVerifies() {
+  const QList<QPoint> walls = buildCrossWalls();
+  for (const uint seed : {7U, 1337U, 90210U}) {
+    nenoserpent::core::SessionRunner runner;
+    runner.setChecksumInterval(4);
+    runner.setKeyframeInterval(50);
+    runner.setRewindBudget(1U << 20, 16);
+    runner.startSession(walls, seed);
+
+    for (int i = 0; i < 150 && runner.mode() != nenoserpent::core::SessionMode::GameOver; ++i) {
+      playTick(runner);
+    }
+    for (int i = 0; i < 37 && runner.stepBack(); ++i) {
+    }
+    // Play on, differently, after rewinding: the recorded logs must still describe one run.
+    for (int i = 0; i < 4000 && runner.mode() != nenoserpent::core::SessionMode::GameOver; ++i) {
+      playTick(runner, i < 120);
+    }
+    QCOMPARE(runner.mode(), nenoserpent::core::SessionMode::GameOver);
+
+    nenoserpent::core::SessionRunner verifier;
+    const auto result = nenoserpent::core::verifyReplay(verifier,
+                                                        {
+                                                          .obstacles = walls,
+                                                          .randomSeed = seed,
+                                                          .inputHistory = runner.inputHistory(),
+                                                          .choiceHistory = runner.choiceHistory(),
+                                                          .checksumHistory =
+                                                            runner.checksumHistory(),
+                                                          .keyframes = runner.keyframes(),
+                                                          .recording = runner.recording(),
+                                                        });
+    QCOMPARE(result.verdict, nenoserpent::core::ReplayVerdict::Match);
+    QCOMPARE(result.score, runner.core().state().score);
+  }
+}
+
+void TestSessionRewind::testMemoryBudgetIsNeverExceeded() {
+  constexpr std::size_t Budget = 32U * 1024U;
+  nenoserpent::core::SessionRunner runner;
+  runner.setRewindBudget(Budget, 16);
+  runner.startSession(buildCrossWalls(), 4242U);
+
+  int maxDepth = 0;
+  for (int i = 0; i < 3000 && runner.mode() != nenoserpent::core::SessionMode::GameOver; ++i) {
+    playTick(runner);
+    QVERIFY(runner.rewind().bytes() <= Budget);
+    maxDepth = std::max(maxDepth, runner.rewind().depth());
+  }
+  QVERIFY(runner.core().tickCounter() > maxDepth);
+  QVERIFY(runner.rewind().depth() > 16);
+
+  int stepped = 0;
+  while (runner.stepBack()) {
+    ++stepped;
+  }
+  QVERIFY(stepped > 16 && stepped <= maxDepth);
+  QVERIFY(runner.rewind().bytes() <= Budget);
+}
+
+void TestSessionRewind::testDisabledRewindRecordsNothing() {
+  nenoserpent::core::SessionRunner runner;
+  runner.startSession(buildCrossWalls(), 5U);
+  for (int i = 0; i < 50; ++i) {
+    playTick(runner);
+  }
+  QVERIFY(!runner.rewind().enabled());
+  QCOMPARE(runner.rewind().depth(), 0);
+  QCOMPARE(runner.rewind().bytes(), std::size_t{0});
+  QVERIFY(!runner.stepBack());
+}
+
+QTEST_MAIN(TestSessionRewind)
+// NOLINTEND(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+#include "test_session_rewind.moc"
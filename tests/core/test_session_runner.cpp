@@ -1,5 +1,6 @@
 #include <QtTest>
 
+#include "core/buff/runtime.h"
 #include "core/session/runner.h"
 
 // QtTest slot-based tests intentionally stay as member functions and use assertion-heavy bodies.
@@ -10,6 +11,7 @@ class TestSessionRunner : public QObject {
 private slots:
   void testRunnerCanAdvanceHeadlessSessionAndEnterChoice();
   void testRunnerCanReplayRecordedTimelineHeadlessly();
+  void testRunnerMovesScheduledWallsEachTickOutsideFreeze();
 };
 
 void TestSessionRunner::testRunnerCanAdvanceHeadlessSessionAndEnterChoice() {
@@ -85,6 +87,45 @@ void TestSessionRunner::testRunnerCanReplayRecordedTimelineHeadlessly() {
   QCOMPARE(replayRunner.recording(), expectedRecording);
 }
 
+void TestSessionRunner::testRunnerMovesScheduledWallsEachTickOutsideFreeze() {
+  const nenoserpent::core::ObstacleAnimation animation{
+    .phaseTicks = 2,
+    .phases = {0, 1},
+    .groups = {{.walls = {QPoint(3, 3), QPoint(3, 4)}, .step = QPoint(1, 0)}},
+  };
+  const auto schedule = nenoserpent::core::ObstacleSchedule::fromAnimation(animation);
+  QVERIFY(schedule.has_value());
+
+  nenoserpent::core::SessionRunner runner;
+  runner.setObstacleSchedule(schedule);
+  runner.startSession({QPoint(15, 15)}, 99U);
+  QCOMPARE(runner.core().state().obstacles, schedule->obstaclesAt(0));
+
+  // Like the adapter, the walls follow the tick counter as it read before the tick.
+  for (int tick = 0; tick < 6; ++tick) {
+    const int frame = runner.core().tickCounter();
+    runner.tick();
+    QCOMPARE(runner.mode(), nenoserpent::core::SessionMode::Playing);
+    QCOMPARE(runner.core().state().obstacles, animation.obstaclesAt(frame));
+    QVERIFY(runner.core().state().obstacles.isSharedWith(schedule->obstaclesAt(frame)));
+  }
+
+  auto& state = runner.core().state();
+  state.activeBuff = static_cast<int>(nenoserpent::core::BuffId::Freeze);
+  state.buffTicksRemaining = 10;
+  state.buffTicksTotal = 10;
+  const QList<QPoint> frozen = state.obstacles;
+  for (int tick = 0; tick < 4; ++tick) {
+    runner.tick();
+    QCOMPARE(runner.core().state().obstacles, frozen);
+  }
+
+  runner.setObstacleSchedule(std::nullopt);
+  runner.startSession({QPoint(15, 15)}, 99U);
+  runner.tick();
+  QCOMPARE(runner.core().state().obstacles, QList<QPoint>{QPoint(15, 15)});
+}
+
 QTEST_MAIN(TestSessionRunner)
 // NOLINTEND(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
 #include "test_session_runner.moc"
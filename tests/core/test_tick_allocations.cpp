@@ -0,0 +1,348 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <QtTest>
+
+#include "core/session/batch.h"
+#include "core/session/runner.h"
+
+// Counts heap allocations made by the test thread while a CountAllocations scope is active.
+// Qt containers allocate through QArrayData, which calls malloc and realloc directly, so on glibc
+// the C allocator is interposed for this binary as well as every form of global operator new.
+// Elsewhere only operator new is seen.
+#if defined(__GLIBC__)
+#define NENOSERPENT_COUNTS_MALLOC 1
+extern "C" {
+auto __libc_malloc(std::size_t size) -> void*;
+auto __libc_calloc(std::size_t count, std::size_t size) -> void*;
+auto __libc_realloc(void* memory, std::size_t size) -> void*;
+auto __libc_memalign(std::size_t alignment, std::size_t size) -> void*;
+void __libc_free(void* memory);
+}
+#endif
+
+namespace {
+thread_local bool g_countAllocations = false;
+thread_local std::int64_t g_allocationCount = 0;
+
+void noteAllocation() {
+  if (g_countAllocations) {
+    ++g_allocationCount;
+  }
+}
+
+auto rawAllocate(const std::size_t size) -> void* {
+#if defined(NENOSERPENT_COUNTS_MALLOC)
+  return __libc_malloc(size);
+#else
+  return std::malloc(size);
+#endif
+}
+
+auto rawAllocateAligned(const std::size_t size, const std::align_val_t alignment) -> void* {
+  const auto bytes = static_cast<std::size_t>(alignment);
+#if defined(NENOSERPENT_COUNTS_MALLOC)
+  return __libc_memalign(bytes, size);
+#else
+  return std::aligned_alloc(bytes, ((size + bytes - 1) / bytes) * bytes);
+#endif
+}
+
+void rawFree(void* memory) {
+#if defined(NENOSERPENT_COUNTS_MALLOC)
+  __libc_free(memory);
+#else
+  std::free(memory);
+#endif
+}
+
+auto allocate(const std::size_t size) -> void* {
+  noteAllocation();
+  if (void* memory = rawAllocate(size == 0 ? 1 : size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+auto allocateAligned(const std::size_t size, const std::align_val_t alignment) -> void* {
+  noteAllocation();
+  if (void* memory = rawAllocateAligned(size == 0 ? 1 : size, alignment)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+class CountAllocations {
+public:
+  CountAllocations() {
+    g_allocationCount = 0;
+    g_countAllocations = true;
+  }
+  ~CountAllocations() {
+    g_countAllocations = false;
+  }
+  CountAllocations(const CountAllocations&) = delete;
+  auto operator=(const CountAllocations&) -> CountAllocations& = delete;
+
+  [[nodiscard]] auto count() const -> std::int64_t {
+    return g_allocationCount;
+  }
+};
+} // namespace
+
+// NOLINTBEGIN(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory,misc-new-delete-overloads,bugprone-reserved-identifier)
+#if defined(NENOSERPENT_COUNTS_MALLOC)
+extern "C" {
+auto malloc(const std::size_t size) noexcept -> void* {
+  noteAllocation();
+  return __libc_malloc(size);
+}
+auto calloc(const std::size_t count, const std::size_t size) noexcept -> void* {
+  noteAllocation();
+  return __libc_calloc(count, size);
+}
+auto realloc(void* memory, const std::size_t size) noexcept -> void* {
+  noteAllocation();
+  return __libc_realloc(memory, size);
+}
+void free(void* memory) noexcept {
+  __libc_free(memory);
+}
+}
+#endif
+
+auto operator new(const std::size_t size) -> void* {
+  return allocate(size);
+}
+auto operator new[](const std::size_t size) -> void* {
+  return allocate(size);
+}
+auto operator new(const std::size_t size, const std::align_val_t alignment) -> void* {
+  return allocateAligned(size, alignment);
+}
+auto operator new[](const std::size_t size, const std::align_val_t alignment) -> void* {
+  return allocateAligned(size, alignment);
+}
+void operator delete(void* memory) noexcept {
+  rawFree(memory);
+}
+void operator delete[](void* memory) noexcept {
+  rawFree(memory);
+}
+void operator delete(void* memory, std::size_t) noexcept {
+  rawFree(memory);
+}
+void operator delete[](void* memory, std::size_t) noexcept {
+  rawFree(memory);
+}
+void operator delete(void* memory, std::align_val_t) noexcept {
+  rawFree(memory);
+}
+void operator delete[](void* memory, std::align_val_t) noexcept {
+  rawFree(memory);
+}
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+  rawFree(memory);
+}
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+  rawFree(memory);
+}
+// NOLINTEND(cppcoreguidelines-no-malloc,cppcoreguidelines-owning-memory,misc-new-delete-overloads,bugprone-reserved-identifier)
+
+// QtTest slot-based tests intentionally stay as member functions and use assertion-heavy bodies.
+// NOLINTBEGIN(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+class TestTickAllocations : public QObject {
+  Q_OBJECT
+
+private slots:
+  void testCounterSeesContainerDetachAndAlignedNew();
+  void testRunnerTicksDoNotAllocateOutsideChoices();
+  void testInputQueueChurnDoesNotAllocate();
+  void testRepeatedSpawnsReuseScratch();
+  void testBatchTicksDoNotAllocateOutsideChoices();
+};
+
+namespace {
+constexpr int BoardWidth = 20;
+constexpr int BoardHeight = 18;
+
+// Greedy step toward the food that avoids walls and the body, so sessions live long enough to
+// cycle the queues and rings several times.
+auto safeStepTowardFood(const nenoserpent::core::SessionCore& core) -> QPoint {
+  const QPoint head = core.headPosition();
+  const QPoint food = core.state().food;
+  QPoint best(0, 0);
+  int bestDistance = std::numeric_limits<int>::max();
+  for (const QPoint& step : {QPoint(1, 0), QPoint(-1, 0), QPoint(0, 1), QPoint(0, -1)}) {
+    if (step == -core.direction()) {
+      continue;
+    }
+    const QPoint next((head.x() + step.x() + BoardWidth) % BoardWidth,
+                      (head.y() + step.y() + BoardHeight) % BoardHeight);
+    const bool blocked = core.state().obstacles.contains(next) ||
+                         std::ranges::find(core.body(), next) != core.body().end();
+    if (blocked) {
+      continue;
+    }
+    const int distance = std::abs(next.x() - food.x()) + std::abs(next.y() - food.y());
+    if (distance < bestDistance) {
+      bestDistance = distance;
+      best = step;
+    }
+  }
+  return best;
+}
+} // namespace
+
+// The guard is only worth something if a regression trips it: a QList detach allocates through
+// QArrayData (malloc), and an over-aligned type goes through aligned operator new.
+void TestTickAllocations::testCounterSeesContainerDetachAndAlignedNew() {
+#if !defined(NENOSERPENT_COUNTS_MALLOC)
+  QSKIP("Qt container allocations are only counted where malloc can be interposed (glibc)");
+#else
+  QList<QPoint> original{QPoint(1, 2), QPoint(3, 4)};
+  QList<QPoint> shared = original;
+  std::int64_t detachAllocations = 0;
+  {
+    const CountAllocations counter;
+    shared[0] = QPoint(5, 6);
+    detachAllocations = counter.count();
+  }
+  QVERIFY(detachAllocations > 0);
+  QCOMPARE(original.first(), QPoint(1, 2));
+
+  struct alignas(64) Wide {
+    std::array<std::uint64_t, 8> words{};
+  };
+  std::int64_t alignedAllocations = 0;
+  {
+    const CountAllocations counter;
+    const auto wide = std::make_unique<Wide>();
+    QVERIFY(reinterpret_cast<std::uintptr_t>(wide.get()) % alignof(Wide) == 0);
+    alignedAllocations = counter.count();
+  }
+  QCOMPARE(alignedAllocations, std::int64_t{1});
+#endif
+}
+
+void TestTickAllocations::testRunnerTicksDoNotAllocateOutsideChoices() {
+  const QList<QPoint> obstacles{QPoint(3, 3), QPoint(15, 4), QPoint(6, 13), QPoint(16, 14)};
+  int measuredTicks = 0;
+  int spawnTicks = 0;
+  for (const uint seed : {1234U, 77U, 4242U, 9001U}) {
+    nenoserpent::core::SessionRunner runner;
+    runner.startSession(obstacles, seed);
+    for (int tick = 0; tick < 2000; ++tick) {
+      if (runner.mode() == nenoserpent::core::SessionMode::ChoiceSelection) {
+        QVERIFY(runner.selectChoice(0));
+        continue;
+      }
+      if (runner.mode() != nenoserpent::core::SessionMode::Playing) {
+        break;
+      }
+      const QPoint step = safeStepTowardFood(runner.core());
+      const int scoreBefore = runner.core().state().score;
+
+      nenoserpent::core::SessionTickResult result;
+      std::int64_t allocations = 0;
+      {
+        const CountAllocations counter;
+        if (!step.isNull()) {
+          runner.enqueueDirection(step);
+        }
+        result = runner.tick();
+        allocations = counter.count();
+      }
+      if (result.enteredChoice) {
+        // Building the choice list is the one event that still allocates.
+        continue;
+      }
+      if (runner.core().state().score != scoreBefore) {
+        ++spawnTicks;
+      }
+      ++measuredTicks;
+      QVERIFY2(allocations == 0,
+               qPrintable(QStringLiteral("seed %1 tick %2 allocated %3 time(s)")
+                            .arg(seed)
+                            .arg(tick)
+                            .arg(allocations)));
+    }
+  }
+  QVERIFY(measuredTicks > 200);
+  QVERIFY(spawnTicks > 20);
+}
+
+void TestTickAllocations::testInputQueueChurnDoesNotAllocate() {
+  nenoserpent::core::SessionCore core;
+  core.applyMetaAction(
+    nenoserpent::core::MetaAction::bootstrapForLevel({}, BoardWidth, BoardHeight));
+  const QPoint turns[] = {QPoint(1, 0), QPoint(0, 1), QPoint(-1, 0), QPoint(0, -1)};
+
+  const CountAllocations counter;
+  for (int i = 0; i < 1000; ++i) {
+    QVERIFY(core.enqueueDirection(turns[i % 4]));
+    QPoint next;
+    QVERIFY(core.consumeQueuedInput(next));
+    core.setDirection(next);
+  }
+  QCOMPARE(counter.count(), std::int64_t{0});
+}
+
+void TestTickAllocations::testRepeatedSpawnsReuseScratch() {
+  nenoserpent::core::SessionCore core;
+  core.applyMetaAction(nenoserpent::core::MetaAction::bootstrapForLevel(
+    {QPoint(2, 2), QPoint(12, 7), QPoint(12, 8), QPoint(12, 9)}, BoardWidth, BoardHeight));
+  std::uint32_t state = 17U;
+  auto nextBounded = [&state](const int bound) -> int {
+    state = (state * 1664525U) + 1013904223U;
+    return bound > 0 ? static_cast<int>(state % static_cast<std::uint32_t>(bound)) : 0;
+  };
+  QVERIFY(core.spawnFood(BoardWidth, BoardHeight, nextBounded));
+
+  const CountAllocations counter;
+  for (int i = 0; i < 200; ++i) {
+    QVERIFY(core.spawnFood(BoardWidth, BoardHeight, nextBounded));
+  }
+  QCOMPARE(counter.count(), std::int64_t{0});
+}
+
+void TestTickAllocations::testBatchTicksDoNotAllocateOutsideChoices() {
+  nenoserpent::core::SessionBatch batch(16);
+  batch.start({QPoint(3, 3), QPoint(15, 4)}, 31);
+  std::vector<QPoint> directions(batch.laneCount());
+  int measuredTicks = 0;
+  for (int tick = 0; tick < 400 && batch.liveCount() > 0; ++tick) {
+    for (std::size_t lane = 0; lane < batch.laneCount(); ++lane) {
+      if (batch.modes()[lane] == nenoserpent::core::SessionMode::ChoiceSelection) {
+        QVERIFY(batch.selectChoice(lane, 0));
+      }
+      directions[lane] = safeStepTowardFood(batch.lane(lane));
+    }
+    std::int64_t allocations = 0;
+    {
+      const CountAllocations counter;
+      batch.tick(directions);
+      allocations = counter.count();
+    }
+    const bool enteredChoice = std::ranges::any_of(batch.events(), [](const std::uint8_t events) {
+      return (events & nenoserpent::core::LaneEnteredChoice) != 0;
+    });
+    if (enteredChoice) {
+      continue;
+    }
+    ++measuredTicks;
+    QCOMPARE(allocations, std::int64_t{0});
+  }
+  QVERIFY(measuredTicks > 50);
+}
+
+QTEST_MAIN(TestTickAllocations)
+// NOLINTEND(readability-convert-member-functions-to-static,readability-function-cognitive-complexity)
+#include "test_tick_allocations.moc"
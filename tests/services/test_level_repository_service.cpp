@@ -14,6 +14,8 @@ class TestLevelRepositoryService : public QObject {
 private slots:
   void testReadLevelCount();
   void testLoadResolvedLevel();
+  void testParsesOnceUntilInvalidated();
+  void testDefaultServesBuiltInLevels();
 };
 
 void TestLevelRepositoryService::testReadLevelCount() {
@@ -73,5 +75,47 @@ void TestLevelRepositoryService::testLoadResolvedLevel() {
   QVERIFY(!missingRepository.loadResolvedLevel(0).has_value());
 }
 
+void TestLevelRepositoryService::testParsesOnceUntilInvalidated() {
+  QTemporaryDir tmpDir;
+  QVERIFY(tmpDir.isValid());
+
+  const auto writeLevels = [](const QString& path, const QJsonArray& levels) -> bool {
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) &&
+           file.write(QJsonDocument(QJsonObject{{"levels", levels}}).toJson()) > 0;
+  };
+  const QString filePath = QDir(tmpDir.path()).filePath("levels.json");
+  const QString overridePath = QDir(tmpDir.path()).filePath("override.json");
+  QVERIFY(writeLevels(filePath, QJsonArray{QJsonObject{{"name", "A"}}}));
+  QVERIFY(writeLevels(overridePath,
+                      QJsonArray{QJsonObject{{"name", "X"}}, QJsonObject{{"name", "Y"}}}));
+
+  nenoserpent::services::LevelRepository repository(filePath, 6);
+  QCOMPARE(repository.levelCount(), 1);
+  const nenoserpent::services::LevelRepository copy = repository;
+  QCOMPARE(copy.levels(), repository.levels());
+
+  QVERIFY(
+    writeLevels(filePath, QJsonArray{QJsonObject{{"name", "B"}}, QJsonObject{{"name", "C"}}}));
+  QCOMPARE(repository.loadResolvedLevel(0)->name, QString("A"));
+  QCOMPARE(repository.levelCount(), 1);
+
+  repository.invalidate();
+  QCOMPARE(repository.levelCount(), 2);
+  QCOMPARE(repository.loadResolvedLevel(0)->name, QString("B"));
+  QCOMPARE(copy.loadResolvedLevel(0)->name, QString("A"));
+
+  repository.setResourcePath(overridePath);
+  QCOMPARE(repository.loadResolvedLevel(3)->name, QString("Y"));
+}
+
+void TestLevelRepositoryService::testDefaultServesBuiltInLevels() {
+  const nenoserpent::services::LevelRepository repository;
+  QCOMPARE(repository.levelCount(), 6);
+  QCOMPARE(repository.loadResolvedLevel(1)->name, QString("The Cage"));
+  QVERIFY(repository.loadResolvedLevel(4)->animation.has_value());
+  QCOMPARE(repository.levels(), nenoserpent::services::LevelRepository().levels());
+}
+
 QTEST_MAIN(TestLevelRepositoryService)
 #include "test_level_repository_service.moc"
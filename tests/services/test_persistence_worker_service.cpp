@@ -0,0 +1,113 @@
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <QtTest/QtTest>
+
+#include "services/save/worker.h"
+
+class TestPersistenceWorkerService : public QObject {
+  Q_OBJECT
+
+private slots:
+  void testNewestKeyedJobWins();
+  void testPostedJobsRunInOrder();
+  void testFailedJobDoesNotStopTheWorker();
+  void testDestructorDrainsTheQueue();
+};
+
+namespace {
+// Holds the worker inside a job until released, so later submissions pile up in the queue.
+struct Gate {
+  std::promise<void> entered;
+  std::promise<void> release;
+
+  auto job() -> nenoserpent::services::PersistenceWorker::Job {
+    return [this]() {
+      entered.set_value();
+      release.get_future().wait();
+      return true;
+    };
+  }
+};
+} // namespace
+
+void TestPersistenceWorkerService::testNewestKeyedJobWins() {
+  nenoserpent::services::PersistenceWorker worker;
+  Gate gate;
+  worker.post(QStringLiteral("gate"), gate.job());
+  gate.entered.get_future().wait();
+
+  std::vector<int> written;
+  std::mutex writtenMutex;
+  for (int snapshot = 1; snapshot <= 5; ++snapshot) {
+    worker.submit(QStringLiteral("ghost"), [&written, &writtenMutex, snapshot]() {
+      const std::lock_guard lock(writtenMutex);
+      written.push_back(snapshot);
+      return true;
+    });
+  }
+  worker.submit(QStringLiteral("session"), [&written, &writtenMutex]() {
+    const std::lock_guard lock(writtenMutex);
+    written.push_back(100);
+    return true;
+  });
+  gate.release.set_value();
+  worker.flush();
+
+  QCOMPARE(written, (std::vector<int>{5, 100}));
+  QCOMPARE(worker.coalescedJobs(), 4);
+}
+
+void TestPersistenceWorkerService::testPostedJobsRunInOrder() {
+  nenoserpent::services::PersistenceWorker worker;
+  Gate gate;
+  worker.post(QStringLiteral("gate"), gate.job());
+  gate.entered.get_future().wait();
+
+  std::vector<int> appended;
+  for (int run = 0; run < 4; ++run) {
+    worker.post(QStringLiteral("archive"), [&appended, run]() {
+      appended.push_back(run);
+      return true;
+    });
+  }
+  gate.release.set_value();
+  worker.flush();
+
+  QCOMPARE(appended, (std::vector<int>{0, 1, 2, 3}));
+  QCOMPARE(worker.coalescedJobs(), 0);
+}
+
+void TestPersistenceWorkerService::testFailedJobDoesNotStopTheWorker() {
+  nenoserpent::services::PersistenceWorker worker;
+  std::atomic_int ran{0};
+  worker.post(QStringLiteral("broken"), [&ran]() {
+    ++ran;
+    return false;
+  });
+  worker.submit(QStringLiteral("ghost"), [&ran]() {
+    ++ran;
+    return true;
+  });
+  worker.flush();
+  QCOMPARE(ran.load(), 2);
+}
+
+void TestPersistenceWorkerService::testDestructorDrainsTheQueue() {
+  std::atomic_int ran{0};
+  {
+    nenoserpent::services::PersistenceWorker worker;
+    for (int i = 0; i < 32; ++i) {
+      worker.post(QStringLiteral("archive"), [&ran]() {
+        ++ran;
+        return true;
+      });
+    }
+  }
+  QCOMPARE(ran.load(), 32);
+}
+
+QTEST_MAIN(TestPersistenceWorkerService)
+#include "test_persistence_worker_service.moc"
@@ -0,0 +1,148 @@
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest/QtTest>
+
+#include "services/save/archive.h"
+
+class TestReplayArchiveService : public QObject {
+  Q_OBJECT
+
+private slots:
+  void testMissingArchiveIsEmpty();
+  void testAppendAndLoadRoundTrip();
+  void testTopByScoreIsPerLevel();
+  void testRefreshPicksUpLaterAppends();
+  void testTornTailIsIgnored();
+};
+
+namespace {
+auto makeRun(const uint seed, const int levelIndex, const int moves)
+  -> nenoserpent::adapter::GhostSnapshot {
+  nenoserpent::adapter::GhostSnapshot run{.randomSeed = seed, .levelIndex = levelIndex};
+  for (int i = 0; i < moves; ++i) {
+    run.recording.push_back(QPoint(i % 20, 3));
+    if (i % 4 == 0) {
+      run.inputHistory.push_back({.frame = i, .dx = 1, .dy = 0});
+    }
+  }
+  run.choiceHistory = {{.frame = 5, .index = 1}};
+  run.checksumHistory = {{.frame = 8, .checksum = seed * 31ULL}};
+  return run;
+}
+} // namespace
+
+void TestReplayArchiveService::testMissingArchiveIsEmpty() {
+  QTemporaryDir tmpDir;
+  QVERIFY(tmpDir.isValid());
+  nenoserpent::services::ReplayArchive archive(tmpDir.path());
+  QVERIFY(archive.refresh());
+  QCOMPARE(archive.size(), 0);
+  QVERIFY(archive.topByScore(0, 5).isEmpty());
+}
+
+void TestReplayArchiveService::testAppendAndLoadRoundTrip() {
+  QTemporaryDir tmpDir;
+  QVERIFY(tmpDir.isValid());
+  nenoserpent::services::ReplayArchive archive(tmpDir.path());
+  QVERIFY(archive.append(makeRun(11U, 2, 40), 7, 1000));
+  QVERIFY(archive.append(makeRun(12U, 3, 90), 19, 2000));
+  QVERIFY(archive.refresh());
+  QCOMPARE(archive.size(), 2);
+
+  const auto second = archive.entry(1);
+  QCOMPARE(second.levelIndex, 3);
+  QCOMPARE(second.score, 19);
+  QCOMPARE(second.randomSeed, 12U);
+  QCOMPARE(second.timestampMs, qint64{2000});
+
+  nenoserpent::adapter::GhostSnapshot loaded;
+  QVERIFY(archive.load(second, loaded));
+  const auto expected = makeRun(12U, 3, 90);
+  QCOMPARE(loaded.randomSeed, expected.randomSeed);
+  QCOMPARE(loaded.levelIndex, expected.levelIndex);
+  QCOMPARE(loaded.inputHistory.size(), expected.inputHistory.size());
+  QCOMPARE(loaded.choiceHistory.size(), 1);
+  QCOMPARE(loaded.checksumHistory.size(), 1);
+  QCOMPARE(loaded.checksumHistory[0].checksum, expected.checksumHistory[0].checksum);
+  // Archived runs keep the move count but not the head recording.
+  QVERIFY(loaded.recording.isEmpty());
+  QCOMPARE(loaded.recordedMoves, 90);
+}
+
+void TestReplayArchiveService::testTopByScoreIsPerLevel() {
+  QTemporaryDir tmpDir;
+  QVERIFY(tmpDir.isValid());
+  nenoserpent::services::ReplayArchive archive(tmpDir.path());
+  const QList<int> levelOneScores{5, 40, 12, 40, 3, 27, 18};
+  for (qsizetype i = 0; i < levelOneScores.size(); ++i) {
+    QVERIFY(archive.append(makeRun(static_cast<uint>(i), 1, 10), levelOneScores[i], i));
+    QVERIFY(archive.append(makeRun(100U, 0, 10), 1000, i));
+  }
+  QVERIFY(archive.refresh());
+
+  const auto top = archive.topByScore(1, 3);
+  QCOMPARE(top.size(), 3);
+  QCOMPARE(top[0].score, 40);
+  QCOMPARE(top[0].randomSeed, 1U);
+  QCOMPARE(top[1].score, 40);
+  QCOMPARE(top[1].randomSeed, 3U);
+  QCOMPARE(top[2].score, 27);
+
+  QCOMPARE(archive.topByScore(1, 100).size(), levelOneScores.size());
+  QCOMPARE(archive.topByScore(0, 2)[0].score, 1000);
+  QVERIFY(archive.topByScore(9, 3).isEmpty());
+  QVERIFY(archive.topByScore(1, 0).isEmpty());
+}
+
+void TestReplayArchiveService::testRefreshPicksUpLaterAppends() {
+  QTemporaryDir tmpDir;
+  QVERIFY(tmpDir.isValid());
+  nenoserpent::services::ReplayArchive archive(tmpDir.path());
+  QVERIFY(archive.append(makeRun(1U, 0, 10), 1, 1));
+  QVERIFY(archive.refresh());
+  QCOMPARE(archive.size(), 1);
+
+  QVERIFY(archive.append(makeRun(2U, 0, 10), 2, 2));
+  QCOMPARE(archive.size(), 1);
+  QVERIFY(archive.refresh());
+  QCOMPARE(archive.size(), 2);
+  nenoserpent::adapter::GhostSnapshot loaded;
+  QVERIFY(archive.load(archive.entry(1), loaded));
+  QCOMPARE(loaded.randomSeed, 2U);
+}
+
+void TestReplayArchiveService::testTornTailIsIgnored() {
+  QTemporaryDir tmpDir;
+  QVERIFY(tmpDir.isValid());
+  const QDir dir(tmpDir.path());
+  nenoserpent::services::ReplayArchive archive(tmpDir.path());
+  QVERIFY(archive.append(makeRun(1U, 0, 10), 1, 1));
+  QVERIFY(archive.append(makeRun(2U, 0, 10), 2, 2));
+
+  // A record whose payload never reached the data file, then half a record.
+  QFile data(dir.filePath(QStringLiteral("replays.dat")));
+  QVERIFY(data.open(QIODevice::ReadWrite));
+  QVERIFY(data.resize(data.size() - 1));
+  data.close();
+  QFile index(dir.filePath(QStringLiteral("replays.idx")));
+  QVERIFY(index.open(QIODevice::Append));
+  QVERIFY(index.write(QByteArray(10, '\x7f')) == 10);
+  index.close();
+
+  QVERIFY(archive.refresh());
+  QCOMPARE(archive.size(), 1);
+
+  // The next append drops both damaged records and lands right behind the intact one.
+  QVERIFY(archive.append(makeRun(3U, 0, 10), 3, 3));
+  QVERIFY(archive.refresh());
+  QCOMPARE(archive.size(), 2);
+  QCOMPARE(archive.entry(1).randomSeed, 3U);
+  nenoserpent::adapter::GhostSnapshot loaded;
+  QVERIFY(archive.load(archive.entry(1), loaded));
+  QCOMPARE(loaded.randomSeed, 3U);
+  QCOMPARE(index.size(), qint64{8 + (2 * 32)});
+}
+
+QTEST_MAIN(TestReplayArchiveService)
+#include "test_replay_archive_service.moc"